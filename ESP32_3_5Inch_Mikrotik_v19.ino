@@ -8,13 +8,19 @@
 #include <TFT_eSPI.h>
 #include <WiFi.h>
 #include <HTTPClient.h>
+#include <WiFiClientSecure.h>
+#include <base64.h>
+#include <StreamString.h>
 #include <ArduinoJson.h>
 #include <ESPAsyncWebServer.h>
 #include <Preferences.h>
 #include <ElegantOTA.h>
-#include <map>
+#include <atomic>
+#include <memory>
+#include <algorithm>
 #include <stdlib.h>
 #include "web_interface.h"
+#include "web_interface_gz.h"
 
 #define SMALL_FONT "fonts/NSBold15"
 #define LARGE_FONT "fonts/NSBold36"
@@ -39,22 +45,175 @@ const int GRAPH_INNER_H = GRAPH_H - LINE_THICKNESS + 1;
 
 TFT_eSPI tft = TFT_eSPI();
 TFT_eSprite graphSprite = TFT_eSprite(&tft);
-TFT_eSprite gaugeSprite = TFT_eSprite(&tft);
+TFT_eSprite gaugeSprite = TFT_eSprite(&tft);      // RAM gauge
+TFT_eSprite gaugeRxSprite = TFT_eSprite(&tft);    // RX% gauge
+TFT_eSprite gaugeBgSprite = TFT_eSprite(&tft);    // empty ring both start from
+TFT_eSprite graphSpriteAlt = TFT_eSprite(&tft);   // second graph buffer, DMA only
 static bool sprite_created = false;
 static bool gauge_sprite_created = false;
 
+// Sprite pushes go out by DMA when TFT_eSPI supports it for the panel
+// (ESP32_DMA is not defined for ILI9488/18-bit or parallel buses). Set to 0
+// to compare against plain blocking pushes.
+#define USE_DMA_PUSH 1
+static bool dma_ready = false;
+static const TFT_eSprite* dma_inflight = nullptr;   // sprite being transferred
+static uint64_t spi_blocked_us = 0;                 // CPU time spent waiting on pushes
+static uint32_t spi_pushes = 0;
+
+// Incremental graph state, per buffer: what is already in each sprite
+typedef struct {
+  TFT_eSprite* spr;
+  bool valid;
+  uint32_t generation;
+  uint32_t newest;
+} graph_buffer_t;
+
+static graph_buffer_t graph_bufs[2] = { { &graphSprite, false, 0, 0 }, { &graphSpriteAlt, false, 0, 0 } };
+static int graph_buf_count = 1;
+static int graph_buf_next = 0;
+
+// What the panel currently shows
+static uint32_t graph_generation_drawn = 0;
+static uint32_t graph_newest_drawn = 0;
+static int graph_band_top = 0;      // rows touched by the plot in the last frame
+static int graph_band_bottom = -1;
+static uint32_t graph_frames = 0;
+static uint32_t graph_full_redraws = 0;
+static uint64_t graph_bytes_pushed = 0;
+static uint64_t graph_render_us = 0;
+
+// Screen layouts. The multi-interface ones replace the graph, totals and
+// billing lines with a grid of tiles, each showing an interface's name, its
+// current rates and a sparkline of its history ring. Every tile is composed
+// in the same tile-sized sprite (two with DMA) and pushed in turn.
+typedef enum {
+  LAYOUT_SINGLE = 0,        // graph of graph_interface_id
+  LAYOUT_MULTI_8,           // 2 x 4 tiles
+  LAYOUT_MULTI_16,          // 4 x 4 tiles
+  LAYOUT_COUNT
+} display_layout_t;
+
+const char* const LAYOUT_NAMES[LAYOUT_COUNT] = { "single", "multi8", "multi16" };
+static int display_layout = LAYOUT_SINGLE;   // applied at boot, each layout has its own sprites
+
+#define DASH_MAX_TILES 16
+const int DASH_Y = 76;
+const int DASH_ROWS = 4;
+const int DASH_TILE_H = 60;
+const int DASH_SPARK_Y = 22;                          // below the name and rate lines
+const int DASH_SPARK_H = DASH_TILE_H - DASH_SPARK_Y - 3;
+// Each frame adds this much push credit, about what the single graph pushes
+// per frame on average with counters polled once per bucket; a tile is drawn
+// once the credit covers it. Tiles left waiting are drawn first on a later
+// frame.
+const uint32_t DASH_FRAME_BUDGET_BYTES = GRAPH_W * GRAPH_H * 2 / 24;
+
+TFT_eSprite dashSprite = TFT_eSprite(&tft);
+TFT_eSprite dashSpriteAlt = TFT_eSprite(&tft);    // second tile buffer, DMA only
+static TFT_eSprite* const dash_bufs[2] = { &dashSprite, &dashSpriteAlt };
+static int dash_buf_count = 0;
+static int dash_buf_next = 0;
+static int dash_tile_next = 0;                    // slot the next frame starts from
+static int32_t dash_drawn_id[DASH_MAX_TILES];     // what each slot shows, 0 = blank
+static uint32_t dash_drawn_samples[DASH_MAX_TILES];
+static uint32_t dash_push_credit = 0;             // bytes the next tiles may push
+static uint32_t dash_tiles_drawn = 0;
+static uint32_t dash_frames_deferred = 0;
+
+// Render timing per stage of loop(), for comparing changes on the device
+typedef enum {
+  RENDER_STAGE_TEXT,
+  RENDER_STAGE_GAUGES,
+  RENDER_STAGE_TOTALS,
+  RENDER_STAGE_GRAPH,
+  RENDER_STAGE_COUNT
+} render_stage_t;
+
+static const char* const RENDER_STAGE_NAMES[RENDER_STAGE_COUNT] = { "text", "gauges", "totals", "graph" };
+
+// Fixed-bucket latency histogram, exported on /metrics. Bucket b counts
+// observations <= PERF_BUCKET_US[b]; the last one is +Inf.
+#define PERF_BUCKETS 14
+const uint32_t PERF_BUCKET_US[PERF_BUCKETS - 1] = {
+  100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 500000, 1000000
+};
+const char* const PERF_BUCKET_LE[PERF_BUCKETS] = {
+  "0.0001", "0.00025", "0.0005", "0.001", "0.0025", "0.005", "0.01",
+  "0.025", "0.05", "0.1", "0.25", "0.5", "1", "+Inf"
+};
+
+typedef struct {
+  uint64_t total_us;
+  uint32_t max_us;
+  uint32_t runs;
+  uint32_t buckets[PERF_BUCKETS];
+} perf_hist_t;
+
+static perf_hist_t render_stages[RENDER_STAGE_COUNT];
+static perf_hist_t render_frame;                 // whole frame, excluding the wait
+static perf_hist_t flash_write_hist;             // saveUsageTotals()
+static uint32_t perf_overhead_ns = 0;            // measured at boot by perfCalibrate()
+static uint32_t metrics_render_us = 0;
+static uint32_t render_frames = 0;
+static uint64_t spi_bytes_pushed = 0;
+static uint32_t font_fs_loads = 0;               // fonts parsed straight from LittleFS
+static volatile bool render_stats_reset = false;  // set by /api/perf/reset
+
 static const int SCREEN_WIDTH = 480;
 static const int SCREEN_HEIGHT = 320;
 #define HISTORY_SIZE 40
 
+// Graph time windows. Each plot column is the min/max envelope of one bucket
+// of bucket_s seconds, so span_s / bucket_s columns (at most GRAPH_MAX_POINTS,
+// which fits in GRAPH_W) cover the window and bursts stay visible.
+typedef struct {
+  const char* name;
+  uint32_t span_s;
+  uint32_t bucket_s;
+  uint32_t label_s;       // x axis label spacing
+} graph_window_def_t;
+
+#define GRAPH_WINDOW_COUNT 5
+#define GRAPH_MAX_POINTS 360
+const graph_window_def_t GRAPH_WINDOWS[GRAPH_WINDOW_COUNT] = {
+  { "1m",  60,     1,    15 },
+  { "10m", 600,    2,    120 },
+  { "1h",  3600,   10,   900 },
+  { "24h", 86400,  240,  21600 },
+  { "7d",  604800, 1800, 86400 },
+};
+static volatile int graph_window = 0;   // set from /save-graph, applied by the poller
+
+// Router polling runs in its own task so a slow router never stalls rendering.
+// POLL_INTERVAL_MS is the API transport's cycle and the REST counters' starting
+// interval; after that POLL_SCHED_DEFS decides.
+const unsigned long POLL_INTERVAL_MS = 500;
+const unsigned long FRAME_INTERVAL_MS = 500;
+const int POLLER_CORE = 0;            // loop() and the renderer run on core 1
+const uint32_t POLLER_STACK_SIZE = 8192;
+
 // WiFi Configuration
 Preferences preferences;
 AsyncWebServer server(80);
+AsyncEventSource events("/api/events");   // live stats push, see pushStatsFrame()
+static std::atomic<bool> events_resync(false);  // a subscriber joined, send the whole ring
+static uint32_t events_frames = 0;
+static uint64_t events_bytes = 0;
+static perf_hist_t events_frame_hist;      // build + queue one frame for all subscribers
+static std::atomic<int> exports_active(0);
+static uint32_t exports_total = 0;
+static uint64_t export_bytes_total = 0;
+static uint64_t export_last_bytes = 0;
+static uint32_t export_last_ms = 0;
+static uint32_t export_last_min_heap = 0;  // lowest free heap seen while it streamed
 String wifi_ssid = "";
 String wifi_password = "";
 String router_address = "";
 String router_login = "";
 String router_password = "";
+int router_transport = 0;       // ROUTER_TRANSPORT_*
+int router_api_port = 0;        // 0 = 8728 / 8729 depending on transport
 int graph_interface_id = 2;
 int backlight_brightness = 100; // 0-100%
 
@@ -65,42 +224,222 @@ bool hotspot_mode = false;
 unsigned long last_wifi_retry = 0;
 const unsigned long WIFI_RETRY_INTERVAL = 300000; // 5 minutes
 
+// Background WiFi scans for /api/scan
+const unsigned long WIFI_SCAN_CACHE_MS = 60000;
+const unsigned long WIFI_SCAN_REFRESH_MS = 5000;
+static String wifi_scan_result = "";
+static unsigned long wifi_scan_ms = 0;
+static uint32_t wifi_scan_job = 0;
+
+// Main page delivery, see setupWebServer()
+static bool web_page_gz_current = false;   // web_interface_gz.h matches html_page
+static uint32_t web_page_sends[3] = { 0, 0, 0 };   // gzip, plain, not modified
+const char* const WEB_PAGE_RESULTS[3] = { "gzip", "plain", "not_modified" };
+
 char routerTimeStr[16] = "00:00:00";
 char routerDateStr[20] = "01-Jan-1970";
 int routerCurrentMinute = -1;
 
-static float last_ram_percent = -1.0f;
-static float last_rx_percent = -1.0f;
+// Router wall clock as seconds since 1970 in the router's local time, and the
+// millis() it corresponds to. 0 until the first clock reply.
+static uint32_t router_epoch = 0;
+static uint32_t router_epoch_ms = 0;
+
+// Gauges: arc of ticks from 150 to 390 degrees, a filled tick every 2 degrees
+// over the grey ring drawn every 5 degrees
+const int GAUGE_RADIUS = 30;
+const int GAUGE_THICKNESS = 8;
+const int GAUGE_SIZE = 70;
+const int GAUGE_START_ANGLE = 150;
+const int GAUGE_SWEEP = 240;
+static int8_t gauge_ticks[GAUGE_SWEEP + 1][4];   // inner x, y, outer x, y per degree
+
+typedef struct {
+  TFT_eSprite* spr;
+  int x, y;              // centre on screen
+  const char* label;
+  bool valid;            // sprite holds this gauge as last drawn
+  int filled;            // degrees of arc drawn
+  uint16_t color;
+  float percent;
+} gauge_t;
+
+static gauge_t ram_gauge = { &gaugeSprite, 380, 35, "RAM", false, 0, 0, -1.0f };
+static gauge_t rx_gauge = { &gaugeRxSprite, 446, 35, "RX%", false, 0, 0, -1.0f };
+static uint32_t gauge_full_draws = 0;
+static uint32_t gauge_delta_draws = 0;
+static uint64_t gauge_draw_us = 0;
 static bool graph_static_elements_drawn = false;
-static int last_minute = -1;
+static int graph_axis_window = -1;     // window the x axis labels show
+
+// A line of dashboard text and what is currently drawn for it
+#define TEXT_FIELD_LEN 100
+typedef struct {
+  int x, y;
+  int clear_w;          // cleared on the first draw, as the old padding did
+  uint16_t color;
+  bool drawn;
+  int16_t width;        // px width of text as drawn
+  char text[TEXT_FIELD_LEN];
+} text_field_t;
+
+static text_field_t time_field   = { 10, 8, 338, TFT_YELLOW, false, 0, "" };
+static text_field_t sys_field    = { 10, 30, 338, TFT_YELLOW, false, 0, "" };
+static text_field_t speed_field  = { 10, 52, 338, TFT_WHITE, false, 0, "" };
+static text_field_t billing_field = { 60, 84, 415, TFT_ORANGE, false, 0, "" };
+static text_field_t totals_field = { 10, 285, 465, TFT_CYAN, false, 0, "" };
+static uint64_t text_px_painted = 0;
+
+// Traffic accounting periods, aligned to the router's wall clock
+typedef enum {
+  USAGE_HOUR = 0,
+  USAGE_DAY,
+  USAGE_WEEK,               // ISO week, Monday to Sunday
+  USAGE_MONTH,              // calendar month
+  USAGE_PERIODS
+} usage_period_t;
+
+const char* const USAGE_PERIOD_NAMES[USAGE_PERIODS] = { "hour", "day", "week", "month" };
+const int USAGE_HISTORY[USAGE_PERIODS] = { 24, 31, 12, 12 };   // closed periods kept in USAGE_PATH
+#define USAGE_HISTORY_MAX 31
+#define USAGE_PATH "/usage.bin"
+
+typedef struct __attribute__((packed)) {
+  uint32_t key;             // period number, see usagePeriodKey(); 0 = not yet keyed
+  uint64_t rx;
+  uint64_t tx;
+} usage_entry_t;
 
 typedef struct {
-  uint64_t rx_hour;
-  uint64_t rx_day;
-  uint64_t rx_week;
-  uint64_t rx_month;
-  long last_update_ts;
-} rx_totals_t;
-
-static rx_totals_t rx_totals = {0, 0, 0, 0, 0};
-static unsigned long hour_start_time = 0;
-static unsigned long day_start_time = 0;
-static unsigned long week_start_time = 0;
-static unsigned long month_start_time = 0;
-static uint64_t hour_start_bytes = 0;
-static uint64_t day_start_bytes = 0;
-static uint64_t week_start_bytes = 0;
-static uint64_t month_start_bytes = 0;
+  usage_entry_t period[USAGE_PERIODS];   // the current hour, day, week and month
+} usage_totals_t;
+
+static usage_totals_t usage_totals;
+static int usage_iface = 0;               // interface usage_last_* belong to, 0 = none yet
+static uint64_t usage_last_rx = 0;        // interface counters at the last sample
+static uint64_t usage_last_tx = 0;
+static uint64_t usage_pending_rx = 0;     // counted before the router clock was known
+static uint64_t usage_pending_tx = 0;
+static uint32_t usage_counter_resets = 0;
+static uint32_t usage_counter_wraps = 0;
+
+// 95th-percentile billing on 5-minute average rates of the graphed interface.
+// The month's samples go into a log-bucket sketch (constant RAM and time per
+// sample, ~1% relative error) and are appended to BILLING_PATH, which rebuilds
+// the sketch after a reboot and allows an exact check.
+#define BILLING_PATH "/billing.bin"
+#define BILLING_SLOT_S 300
+#define BILLING_BUCKETS 1024
+#define BILLING_MAX_GAP_S 30        // longer poll gaps leave the slot unbilled
+const float BILLING_GAMMA = 1.02f;  // bucket width; values are within 1%
+const char BILLING_MAGIC[4] = { 'B', 'I', 'L', '1' };
+
+typedef struct __attribute__((packed)) {
+  uint32_t slot;            // 5-minute slot number since 1970, router clock
+  uint32_t rx_kbps;
+  uint32_t tx_kbps;
+} billing_sample_t;
 
+typedef struct {
+  uint32_t month;           // usagePeriodKey(USAGE_MONTH), 0 = none yet
+  uint32_t samples;
+  uint32_t missed;          // slots skipped for lack of complete data
+  uint32_t rx_p95, rx_p99, rx_max;   // kbps
+  uint32_t tx_p95, tx_p99, tx_max;
+} billing_view_t;
+
+static uint16_t billing_rx_counts[BILLING_BUCKETS];
+static uint16_t billing_tx_counts[BILLING_BUCKETS];
+static billing_view_t billing_view;
+static uint32_t billing_slot = 0;            // slot being accumulated
+static uint64_t billing_slot_rx = 0;
+static uint64_t billing_slot_tx = 0;
+static bool billing_slot_complete = false;
+
+// Exact quantiles for /api/billing?exact=1. Sorting a month of samples
+// takes too long for async_tcp, so the handler asks the poller for them and
+// answers 202 until the result for the current sample count is in.
+typedef struct {
+  bool done;                // computed at least once
+  bool valid;               // the samples could be read
+  uint32_t month;           // billing_view.month and .samples it covers
+  uint32_t samples;
+  uint32_t n;               // samples read from BILLING_PATH
+  uint32_t rx_p95, rx_p99, tx_p95, tx_p99;
+  uint32_t ms;              // time the poller spent on it
+} billing_exact_t;
+
+static billing_exact_t billing_exact;
+static volatile uint32_t billing_exact_job = 0;   // last requested, web handler
+static volatile uint32_t billing_exact_done = 0;  // last computed, poller
+static portMUX_TYPE billing_exact_mux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t usage_last_time = 0;         // routerNow() of the last counted sample
+
+// Persisted accounting state: one journal record (see USAGE ACCOUNTING)
+#define TOTALS_JOURNAL_PATH "/totals.jnl"
+#define TOTALS_JOURNAL_NEW_PATH "/totals.jnl.new"
+#define TOTALS_LEGACY_PATH "/rx_totals.json"
+#define TOTALS_JOURNAL_MAX_BYTES 8192
+const uint32_t TOTALS_RECORD_MAGIC = 0x32544F54;   // "TOT2"
+
+typedef struct __attribute__((packed)) {
+  uint32_t magic;
+  uint32_t seq;
+  int32_t iface_id;
+  uint64_t last_rx;
+  uint64_t last_tx;
+  usage_totals_t totals;
+  uint32_t crc;                            // CRC-32 of everything above
+} totals_record_t;
+
+static uint32_t totals_flush_s = 60;       // preference "totals_flush_s", 5..3600
+static uint32_t totals_seq = 0;
+static int totals_records = 0;             // valid records in the journal file
+static uint32_t totals_compactions = 0;
+static uint32_t totals_bad_records = 0;    // torn or corrupt records found at boot
+static totals_record_t totals_last_record;
+
+// Renderer-side view of one interface (see router_snapshot_t)
 typedef struct {
   uint64_t rx;
   uint64_t tx;
-  uint64_t time;
   int pos;
-  uint64_t hist_rx[HISTORY_SIZE];
-  uint64_t hist_tx[HISTORY_SIZE];
+  uint32_t samples;                 // total samples pushed, for incremental redraws
+  uint32_t hist_rx[HISTORY_SIZE];   // kbps (1 kbps = 1024 bit/s)
+  uint32_t hist_tx[HISTORY_SIZE];
 } mt_data_t;
 
+// Interface table: flat, preallocated once at boot, keyed by RouterOS .id.
+// Lookups go through an open-addressed index (linear probing), and RX/TX
+// histories live in one arena of HISTORY_RINGS rings shared by all entries.
+//
+// Memory budget per interface:
+//   iface_entry_t   40 B  counters, last rate and ring bookkeeping
+//   index slots      4 B  two int16_t slots keep the load factor at 0.5
+//   history ring   320 B  only for the first HISTORY_RINGS interfaces seen;
+//                         one ring is always kept free for graph_interface_id
+// MAX_IFACES = 512 and HISTORY_RINGS = 32 comes to 32 KB in total.
+#define MAX_IFACES 512
+#define IFACE_INDEX_SIZE 1024       // power of two, 2x MAX_IFACES
+#define HISTORY_RINGS 32
+
+typedef struct {
+  int32_t id;                       // RouterOS .id, 0 = unused
+  uint32_t time;                    // millis() of the last counter sample
+  uint64_t rx;
+  uint64_t tx;
+  uint32_t last_rx_kbps;
+  uint32_t last_tx_kbps;
+  int16_t ring;                     // history ring, -1 if none
+  uint8_t pos;
+  uint32_t samples;
+} iface_entry_t;
+
+typedef struct {
+  uint32_t rx[HISTORY_SIZE];
+  uint32_t tx[HISTORY_SIZE];
+} iface_ring_t;
+
 typedef struct {
   uint32_t uptime;
   uint32_t memoryFree;
@@ -108,9 +447,393 @@ typedef struct {
   float cpuLoad;
 } router_info_t;
 
-std::map<int, mt_data_t*> ifaces;
+static iface_entry_t* iface_table = nullptr;
+static int16_t* iface_index = nullptr;
+static iface_ring_t* iface_rings = nullptr;
+static int iface_count = 0;
+static int iface_rings_used = 0;
 router_info_t routerInfo = {0, 0, 0, 0.0f};
 
+// Round-robin archive of the graphed interface's rates. Slot i of a tier
+// covers [t, t + step) with t the slot's own start time, so the slot for any
+// time is found in O(1) and slots left over from before a gap are recognised
+// by their timestamp. Closed slots are queued in RAM and written once a
+// minute, which bounds flash wear and keeps file I/O off every poll.
+//
+// LittleFS is copy-on-write: changing bytes in a file rewrites it from the
+// changed block to its end. Each tier is therefore split into segment files
+// of one flash block, created when first written, so a flush rewrites a few
+// 4 KB blocks rather than the tail of a 118 KB file. /rrd_<id>.bin holds
+// just the header.
+#define RRD_TIERS 3
+#define RRD_PENDING_MAX 96
+#define RRD_SEG_SLOTS 144          // 4032 bytes, one 4 KB LittleFS block
+#define RRD_FS_BLOCK 4096
+#define RRD_FS_RESERVE (8 * RRD_FS_BLOCK)   // left for the totals and captures
+const unsigned long RRD_FLUSH_INTERVAL_MS = 60000;
+const char RRD_MAGIC[4] = { 'R', 'R', 'D', '1' };
+
+typedef struct {
+  uint32_t step_s;
+  uint32_t slots;
+} rrd_tier_def_t;
+
+// 10 minutes at 1 s, 24 hours at 1 min, 30 days at 15 min: 118 KB per interface
+const rrd_tier_def_t RRD_TIER_DEFS[RRD_TIERS] = { { 1, 600 }, { 60, 1440 }, { 900, 2880 } };
+
+typedef struct __attribute__((packed)) {
+  char magic[4];
+  int32_t iface_id;
+  rrd_tier_def_t tiers[RRD_TIERS];
+} rrd_header_t;
+
+typedef struct __attribute__((packed)) {
+  uint32_t t;                // slot start, router clock seconds; 0 = never written
+  uint32_t rx_min, rx_avg, rx_max;   // kbps, like the history rings
+  uint32_t tx_min, tx_avg, tx_max;
+} rrd_slot_t;
+
+typedef struct {
+  uint32_t t;
+  uint32_t count;
+  uint64_t rx_sum, tx_sum;
+  uint32_t rx_min, rx_max, tx_min, tx_max;
+} rrd_accum_t;
+
+typedef struct {
+  uint8_t tier;
+  rrd_slot_t slot;
+} rrd_pending_t;
+
+const char* const RRD_TIER_NAMES[RRD_TIERS] = { "1s", "1m", "15m" };
+
+// History export (/api/export): rows are produced one at a time straight
+// from the files, so RAM use doesn't depend on the range
+typedef enum {
+  EXPORT_TRAFFIC = 0,       // archive slots of one interface and tier
+  EXPORT_USAGE,             // closed period totals plus the current period
+  EXPORT_BILLING,           // this month's 5-minute billing samples
+  EXPORT_SERIES
+} export_series_t;
+
+typedef enum {
+  EXPORT_CSV = 0,
+  EXPORT_NDJSON,
+  EXPORT_BIN                // see exportBinaryRow()
+} export_format_t;
+
+#define EXPORT_MAX_FIELDS 6
+#define EXPORT_MAX_ACTIVE 2
+#define EXPORT_BLOCK_SLOTS 32
+const char* const EXPORT_SERIES_NAMES[EXPORT_SERIES] = { "traffic", "usage", "billing" };
+const char* const EXPORT_FORMAT_NAMES[3] = { "csv", "ndjson", "bin" };
+const int EXPORT_FIELD_COUNT[EXPORT_SERIES] = { 6, 2, 2 };
+const char* const EXPORT_FIELDS[EXPORT_SERIES][EXPORT_MAX_FIELDS] = {
+  { "rx_min_kbps", "rx_avg_kbps", "rx_max_kbps", "tx_min_kbps", "tx_avg_kbps", "tx_max_kbps" },
+  { "rx_bytes", "tx_bytes" },
+  { "rx_kbps", "tx_kbps" },
+};
+
+typedef struct {
+  uint8_t series;
+  uint8_t format;
+  uint8_t tier;             // traffic
+  uint8_t period;           // usage
+  int iface_id;             // traffic
+  File file;                // usage, billing
+  uint32_t t;               // traffic: next slot time
+  uint32_t from, to;        // router clock seconds, inclusive
+  bool header_done;
+  bool done;
+  rrd_slot_t block[EXPORT_BLOCK_SLOTS];   // traffic: slots read ahead
+  int block_len, block_pos;
+  usage_entry_t usage[USAGE_HISTORY_MAX + 1];
+  int usage_len, usage_pos;
+  int64_t prev[EXPORT_MAX_FIELDS + 1];    // binary: last key and fields
+  uint8_t row[160];                       // current row, partly sent
+  uint16_t row_len, row_pos;
+  uint32_t rows;
+  uint64_t bytes;
+  unsigned long start_ms;
+  uint32_t min_heap;
+} export_ctx_t;
+
+// One plot column: heights (0..GRAPH_INNER_H) of the bucket's min and max
+typedef struct {
+  uint8_t present;
+  uint8_t rx_lo, rx_hi;
+  uint8_t tx_lo, tx_hi;
+} graph_column_t;
+
+// Decimated graph of graph_interface_id. Closed buckets only, in a ring
+// indexed by bucket % points; newest is the bucket number of the last one.
+typedef struct {
+  uint8_t window;
+  uint8_t step;             // px between columns
+  uint16_t points;
+  uint32_t generation;      // bumped whenever the columns are rebuilt
+  uint32_t newest;
+  graph_column_t col[GRAPH_MAX_POINTS];
+} graph_view_t;
+
+// One tile of the multi-interface layouts, sparkline already scaled to the
+// tile's own peak so the renderer only draws
+typedef struct {
+  int32_t id;
+  char name[16];
+  uint32_t rx_kbps;
+  uint32_t tx_kbps;
+  uint32_t samples;                 // changes whenever the tile needs a redraw
+  uint8_t online;                   // 0 for a fleet router that isn't answering
+  uint8_t points;                   // valid history entries, newest last
+  uint8_t rx_h[HISTORY_SIZE];       // oldest first, 0..DASH_SPARK_H
+  uint8_t tx_h[HISTORY_SIZE];
+} dash_tile_t;
+
+typedef struct {
+  uint8_t count;
+  dash_tile_t tile[DASH_MAX_TILES];
+} dash_view_t;
+
+// Everything the renderer and web handlers need from one poll cycle.
+// Filled by the poller task and handed over through a double-buffered seqlock.
+typedef struct {
+  bool iface_valid;
+  mt_data_t iface;          // copy of graph_interface_id
+  graph_view_t graph;
+  dash_view_t dash;         // empty in the single layout
+  router_info_t info;
+  usage_totals_t totals;
+  billing_view_t billing;
+  char timeStr[16];
+  char dateStr[20];
+  unsigned long updated_ms;
+  uint32_t counters_ms;     // millis() of the graphed interface's last counter sample
+} router_snapshot_t;
+
+static router_snapshot_t snapshot_buf[2];
+static std::atomic<uint32_t> snapshot_published(0); // seq of last complete snapshot
+static std::atomic<uint32_t> snapshot_writing(0);   // seq currently being written
+static TaskHandle_t poller_task = nullptr;
+
+// One keep-alive HTTP/1.1 connection to the router shared by every REST call
+typedef enum {
+  ROUTER_EP_INTERFACES = 0,
+  ROUTER_EP_RESOURCE,
+  ROUTER_EP_CLOCK,
+  ROUTER_EP_IFACE_LIST,
+  ROUTER_EP_COUNT
+} router_endpoint_t;
+
+typedef struct {
+  uint32_t requests;
+  uint32_t reused;           // served on an already-open connection
+  uint32_t connects;
+  uint32_t failures;
+  uint32_t dropped;          // connections closed because a reply was left unread
+  uint32_t skipped;          // not sent because of busy session or backoff
+  uint32_t last_latency_ms;
+  uint32_t max_latency_ms;
+  uint32_t total_latency_ms;
+} router_endpoint_stats_t;
+
+const char* const ROUTER_EP_NAMES[ROUTER_EP_COUNT] = {"interfaces", "resource", "clock", "iface_list"};
+const int ROUTER_ERR_BUSY = -100;
+const int ROUTER_ERR_BACKOFF = -101;
+const unsigned long ROUTER_LOCK_TIMEOUT_MS = 6000;
+const unsigned long ROUTER_BACKOFF_MIN_MS = 500;
+const unsigned long ROUTER_BACKOFF_MAX_MS = 30000;
+
+static WiFiClient router_client;
+static HTTPClient router_http;
+static String router_auth_header = "";
+static SemaphoreHandle_t router_session_lock = nullptr;
+static router_endpoint_stats_t router_stats[ROUTER_EP_COUNT];
+static router_endpoint_t router_request_ep = ROUTER_EP_INTERFACES;
+static unsigned long router_request_start = 0;
+static unsigned long router_backoff_ms = 0;
+static unsigned long router_backoff_until = 0;
+static perf_hist_t router_http_hist[ROUTER_EP_COUNT];   // POST until response headers
+static perf_hist_t router_parse_hist[ROUTER_EP_COUNT];  // body read + JSON parse
+
+// Adaptive poll scheduler (REST transport). Every endpoint has its own
+// interval and a deadline, how late a due poll may start before it counts as
+// missed; due polls run earliest deadline first on the shared session.
+// Counters drop to the burst interval when the rate jumps and stretch toward
+// the graph's bucket width while it is steady, and to the idle interval only
+// on an idle link. Resource and clock are polled rarely,
+// the clock being interpolated with millis() in between. With the backlight
+// off and no web client for SCHED_WEB_IDLE_MS, every endpoint (and the fleet)
+// falls back to its unattended interval.
+typedef struct {
+  uint32_t min_ms;          // counters: burst interval
+  uint32_t max_ms;          // counters: idle-link interval
+  uint32_t deadline_ms;
+  uint32_t unattended_ms;
+} poll_sched_def_t;
+
+const poll_sched_def_t POLL_SCHED_DEFS[ROUTER_EP_COUNT] = {
+  { 250,   4000,  250,   15000 },    // interfaces
+  { 10000, 10000, 5000,  120000 },   // resource
+  { 60000, 60000, 10000, 600000 },   // clock
+  { 60000, 60000, 10000, 600000 },   // iface_list: renames; due at once for a new interface
+};
+const uint32_t SCHED_BURST_FLOOR_KBPS = 256;    // smaller rate changes never count as a burst
+const unsigned long SCHED_TICK_MAX_MS = 1000;   // archive, graph and snapshot still run this often
+const unsigned long SCHED_WEB_IDLE_MS = 60000;
+
+typedef struct {
+  uint32_t interval_ms;
+  uint32_t next_due;        // millis()
+  uint32_t runs;
+  uint32_t misses;          // started after next_due + deadline_ms
+  uint32_t last_kbps;       // counters: rx + tx of the previous sample
+} poll_sched_t;
+
+static poll_sched_t poll_sched[ROUTER_EP_COUNT];
+static std::atomic<bool> poll_attended(true);    // set by loop(), read by the pollers
+static std::atomic<uint32_t> web_demand_ms(0);   // millis() of the last /api/stats request
+static uint32_t sched_started_ms = 0;
+
+// Display freshness: age of the graphed interface's counters when a frame shows them
+static uint32_t display_age_last_ms = 0;
+static uint32_t display_age_max_ms = 0;
+static uint64_t display_age_sum_ms = 0;
+static uint32_t display_age_frames = 0;
+
+// Fleet: further routers watched next to the main one, one interface each,
+// shown as tiles in the multi-interface layouts. Accounting, billing and the
+// archive stay with the main router. Every member has its own REST
+// connection and task, so a dead device only stalls itself; a counting
+// semaphore caps the requests in flight across the fleet, and each request
+// times out after FLEET_TIMEOUT_MS.
+//
+// Memory per member: fleet_router_t (about 0.5 KB with its history ring),
+// one HTTPClient/WiFiClient pair and FLEET_STACK_SIZE of task stack.
+#define FLEET_MAX 4
+#define FLEET_MAX_INFLIGHT 2
+const uint32_t FLEET_STACK_SIZE = 6144;
+const unsigned long FLEET_POLL_INTERVAL_MS = 1000;
+const unsigned long FLEET_TIMEOUT_MS = 2000;        // connect and read, per request
+
+typedef struct {
+  // Configuration, fixed once the member's task is running
+  char name[16];
+  char address[64];                 // "http://host[:port]"
+  char login[32];
+  char password[64];
+  int32_t iface_id;
+  
+  // Written by the member's task under fleet_mux
+  bool online;
+  int last_code;                    // HTTP status or HTTPClient error
+  uint32_t requests;
+  uint32_t failures;
+  uint32_t last_latency_ms;
+  uint64_t rx;
+  uint64_t tx;
+  uint32_t time;                    // millis() of the last counter sample
+  uint32_t last_rx_kbps;
+  uint32_t last_tx_kbps;
+  uint32_t samples;
+  uint8_t pos;
+  uint32_t hist_rx[HISTORY_SIZE];
+  uint32_t hist_tx[HISTORY_SIZE];
+} fleet_router_t;
+
+static fleet_router_t fleet[FLEET_MAX];
+static int fleet_count = 0;
+static SemaphoreHandle_t fleet_slots = nullptr;     // FLEET_MAX_INFLIGHT requests
+static portMUX_TYPE fleet_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// Capture of raw REST replies to LittleFS, for download and on-device replay.
+// File: "MTCAP1", then per reply a capture_record_t followed by len body bytes.
+#define CAPTURE_PATH "/capture.bin"
+const uint32_t CAPTURE_MAX_BYTES = 512 * 1024;
+const char CAPTURE_MAGIC[6] = { 'M', 'T', 'C', 'A', 'P', '1' };
+
+typedef struct __attribute__((packed)) {
+  uint32_t ms;          // millis() when the request was sent
+  uint8_t ep;           // router_endpoint_t
+  uint8_t reserved;
+  uint16_t len;
+} capture_record_t;
+
+typedef enum {
+  CAPTURE_CMD_NONE = 0,
+  CAPTURE_CMD_START,
+  CAPTURE_CMD_STOP,
+  CAPTURE_CMD_REPLAY
+} capture_cmd_t;
+
+typedef struct {
+  bool valid;
+  uint32_t records;
+  uint32_t errors;          // replies the parser rejected
+  uint32_t span_ms;         // router time covered by the capture
+  uint32_t elapsed_ms;      // time the replay took
+  uint32_t samples;         // rate samples for the graphed interface
+  uint32_t rejections;      // rates over MAX_REASONABLE_BPS
+  usage_totals_t totals;    // totals the replay accumulated
+  // The capture run through the poll scheduler, see replayCapture()
+  uint32_t counter_replies;
+  uint32_t sched_polls;             // counter replies the scheduler would have asked for
+  uint32_t captured_per_hour;       // router requests per hour in the capture
+  uint32_t sched_per_hour;          // the same with the scheduler's intervals
+  uint32_t freshness_avg_ms;        // age of the shown counters
+  uint32_t freshness_max_ms;
+} replay_result_t;
+
+static File capture_file;
+static volatile bool capture_active = false;
+static volatile capture_cmd_t capture_cmd = CAPTURE_CMD_NONE;  // applied by the poller
+static volatile bool replay_running = false;
+static uint32_t capture_bytes = 0;
+static uint32_t capture_records = 0;
+static uint32_t capture_dropped = 0;
+static replay_result_t replay_result;
+static uint32_t rate_rejections = 0;
+
+// Native RouterOS API (binary sentence protocol) as an alternative to REST
+#define ROUTER_TRANSPORT_REST    0
+#define ROUTER_TRANSPORT_API     1
+#define ROUTER_TRANSPORT_API_SSL 2
+
+#define API_MAX_WORDS 24
+#define API_SENTENCE_BUF 768
+#define API_MAX_IFACES 32          // interfaces subscribed to monitor-traffic
+#define IFACE_NAMES_MAX 64         // names kept for /api/interfaces and the tiles
+const unsigned long API_READ_TIMEOUT_MS = 2000;
+const unsigned long API_IDLE_TIMEOUT_MS = 15000;  // reconnect if the router goes quiet
+const int API_COUNTER_INTERVAL_S = 5;
+const int API_RESOURCE_INTERVAL_S = 2;
+const int API_CLOCK_INTERVAL_S = 5;
+
+typedef struct {
+  char buf[API_SENTENCE_BUF];
+  const char* words[API_MAX_WORDS];
+  int count;
+} api_sentence_t;
+
+typedef struct {
+  int id;
+  char name[32];
+} api_iface_t;
+
+static WiFiClient api_plain_client;
+static WiFiClientSecure api_tls_client;
+static Client* api_client = nullptr;
+static bool api_ready = false;
+static unsigned long api_last_rx = 0;
+static unsigned long api_backoff_ms = 0;
+static unsigned long api_retry_at = 0;
+static api_iface_t api_ifaces[IFACE_NAMES_MAX];
+static int api_iface_count = 0;
+static bool iface_names_stale = true;          // REST: an interface without a name was seen
+static portMUX_TYPE iface_names_mux = portMUX_INITIALIZER_UNLOCKED;   // poller writes, web handlers copy
+static api_sentence_t api_sentence;
+static uint8_t api_tx_buf[512];
+
 // ==================== FORWARD DECLARATIONS ====================
 
 void loadPreferences();
@@ -126,17 +849,164 @@ uint32_t parseUptimeToSeconds(const String& s);
 uint32_t parseMemoryToBytes(const String& s);
 void formatUptime(uint32_t sec, char* buf, size_t len);
 String convertDateFormat(const char* mt_date);
+void routerSessionInit();
+int routerPost(router_endpoint_t ep, const char* path, const String& body);
+void routerRequestEnd(int code, bool body_read);
+bool initIfaceTable();
+iface_entry_t* findIface(int id);
+iface_entry_t* addIface(int id, uint64_t rx, uint64_t tx, uint32_t nowMs);
+void pushRateSample(iface_entry_t* iface, uint64_t rx_bps, uint64_t tx_bps);
+bool copyIfaceView(const iface_entry_t* iface, mt_data_t& out);
+int peekNonSpace(Stream& stream);
+Stream& restReplyStream(StreamString& fallback);
+int parseRestArray(Stream& stream, JsonDocument& item, JsonDocument& filter,
+                   std::function<void(JsonObject)> onItem);
+int parseInterfaceReply(Stream& stream, uint32_t nowMs);
+int parseResourceReply(Stream& stream);
+int parseClockReply(Stream& stream);
+int parseInterfaceNames(Stream& stream);
+bool fetchInterfaceStats();
+void fetchInterfaceNames();
+void applyRouterClock(const char* time_24hr, const char* date_mt);
 void fetchRouterInfo();
 void fetchTimeFromRouter();
-void loadRxTotals();
-void resetRxTotals();
-void saveRxTotals();
-void updateRxTotals(uint64_t current_rx_bytes);
+uint32_t schedCounterInterval(uint32_t interval, uint32_t prev_kbps, uint32_t kbps);
+void schedInit();
+void schedRunDue();
+unsigned long schedWaitMs();
+void tickRouterClock();
+void publishSnapshot();
+uint32_t readSnapshot(router_snapshot_t& out);
+void routerPollTask(void* param);
+void startRouterPoller();
+String routerHost();
+bool apiConnect();
+void apiDisconnect();
+bool apiSend(const char* const* words, int count);
+bool apiReadSentence(api_sentence_t& out);
+const char* apiAttr(const api_sentence_t& s, const char* key);
+void apiHandleSentence(const api_sentence_t& s);
+size_t apiEncodeLength(uint32_t len, uint8_t* out);
+bool apiReadBytes(uint8_t* buf, size_t len);
+bool apiReadLength(uint32_t& len);
+const char* apiTag(const api_sentence_t& s);
+bool apiCommand(const char* const* words, int count, void (*onReply)(const api_sentence_t&));
+void apiRememberIface(const api_sentence_t& s);
+void rememberIfaceName(int id, const char* name);
+const char* ifaceName(int id);
+void apiPollCycle();
+void captureReply(router_endpoint_t ep, const String& body, uint32_t ms);
+bool captureStart();
+void captureStop();
+void replayCapture();
+void captureService();
+void loadUsageTotals();
+void resetUsageTotals();
+void saveUsageTotals();
+uint64_t usageCounterDelta(uint64_t last, uint64_t now);
+uint32_t usagePeriodKey(int period, uint32_t epoch);
+void formatUsagePeriod(int period, uint32_t key, char* buf, size_t len);
+void addUsageEntry(JsonObject obj, int period, const usage_entry_t& entry);
+uint32_t usageSlotOffset(int period, uint32_t key);
+bool initUsageHistory();
+void archiveUsagePeriod(int period, const usage_entry_t& entry);
+void updateUsage(uint64_t rx_bytes, uint64_t tx_bytes, uint32_t now);
+int billingBucket(uint32_t kbps);
+uint32_t billingBucketValue(int b);
+uint32_t billingQuantile(const uint16_t* counts, uint32_t n, float q);
+void billingReset(uint32_t month);
+void billingObserve(const billing_sample_t& s);
+void billingRefreshView();
+void loadBilling();
+void billingRecord(const billing_sample_t& s);
+void billingAdd(uint32_t prev, uint32_t now, uint64_t rx_bytes, uint64_t tx_bytes);
+void billingStartMonth(uint32_t month);
+bool billingExact(bool tx, uint32_t& p95, uint32_t& p99, uint32_t& n);
+void billingExactService();
+uint32_t journalCrc(const uint8_t* data, size_t len);
+void fillTotalsRecord(totals_record_t& rec);
+void applyTotalsRecord(const totals_record_t& rec);
+bool totalsRecordValid(const totals_record_t& rec);
+int scanTotalsJournal(const char* path, totals_record_t& best, bool& found, bool& clean);
+bool importRxTotalsJson();
+int32_t daysFromCivil(int y, int m, int d);
+void civilFromDays(int32_t days, int& y, int& m, int& d);
+bool parseRouterDate(const char* s, int& year, int& month, int& day);
+uint32_t routerNow();
+void rrdPath(int iface_id, char* buf, size_t len);
+void rrdSegmentPath(int iface_id, int tier, uint32_t seg, char* buf, size_t len);
+uint32_t rrdSlotIndex(int tier, uint32_t t);
+uint32_t rrdSegments(int tier);
+uint32_t rrdSegmentSlots(int tier, uint32_t seg);
+uint32_t rrdFileSize();
+void rrdRemove(int iface_id);
+void rrdPrune(int keep_id, int keep_prev);
+uint32_t rrdFlashBytes();
+uint32_t rrdFreeBytes();
+uint32_t rrdReadSlots(int iface_id, int tier, uint32_t idx, rrd_slot_t* out, uint32_t n);
+File rrdOpenSegment(int tier, uint32_t seg);
+bool rrdOpen(int iface_id);
+void rrdFlush();
+void rrdCloseSlot(int tier, const rrd_accum_t& acc);
+void rrdAccumulate(rrd_accum_t& acc, uint32_t t, uint32_t rx_kbps, uint32_t tx_kbps);
+void rrdAddSample(uint32_t now, uint32_t rx_kbps, uint32_t tx_kbps);
+void rrdService();
+size_t exportVarint(uint64_t v, uint8_t* out);
+size_t exportBinaryRow(export_ctx_t& c, int64_t key, const int64_t* v, uint8_t* out);
+size_t exportTextRow(export_ctx_t& c, uint32_t key, const int64_t* v, uint8_t* out, size_t cap);
+size_t exportNextRow(export_ctx_t& c);
+size_t exportFill(export_ctx_t& c, uint8_t* buf, size_t max_len);
+bool exportOpen(export_ctx_t& c);
+int findGraphWindow(const char* name);
+const graph_column_t* graphColumn(const graph_view_t& view, int i);
+int graphBridgeBuckets(const graph_view_t& view);
+const graph_column_t* graphPrevColumn(const graph_view_t& view, int i, int& prev);
+int graphColumnX(const graph_view_t& view, int i);
+void graphViewReset(int window, uint32_t now);
+void graphViewClose(const rrd_accum_t& acc);
+void graphViewSeed();
+void graphViewService();
+int dashTileCount();
+void dashTileFill(dash_tile_t& t, int id, const char* name, uint32_t samples, int pos,
+                  const uint32_t* hist_rx, const uint32_t* hist_tx);
+void loadFleet();
+bool saveFleet(JsonArray routers);
+void fleetApplySample(fleet_router_t& r, uint64_t rx, uint64_t tx, uint32_t nowMs);
+void fleetPollTask(void* param);
+void startFleet();
+int dashColumns();
+void dashViewFill(dash_view_t& out);
 void draw_thick_line_sprite(TFT_eSprite &spr, int x0, int y0, int x1, int y1, uint16_t color, int thickness);
-void drawGauge(int x, int y, int radius, int thickness, float valuePercent, const char* label);
+uint16_t gaugeColor(float percent);
+void initGaugeGeometry();
+void drawGaugeTick(TFT_eSprite& spr, int i, uint16_t color);
+void drawGauge(gauge_t& g, float valuePercent);
+bool createGaugeSprite(TFT_eSprite& spr);
+int textSpanWidth(const char* s, int from, int to);
+void drawTextField(text_field_t& f, const char* text);
 void initGraphSprite();
+int graphSampleHeight(uint32_t kbps);
+void drawGraphColumn(TFT_eSprite& spr, const graph_view_t& view, int i);
+void drawGraphSprite(const graph_view_t* view);
+void drawGraphTimeAxis(const graph_view_t& view);
+uint32_t drawDashTile(const dash_tile_t& t, int slot);
+void drawDashboard(const dash_view_t& view);
+void initDashSprite();
+void formatAge(uint32_t age_s, char* buf, size_t len);
 void initGaugeSprite();
-String scanWiFiNetworks();
+void initDisplayDMA();
+void perfObserve(perf_hist_t& h, uint32_t us);
+void perfRecord(perf_hist_t& h, unsigned long start_us);
+void perfCalibrate();
+void writeMetrics(Print& out);
+void resetRenderStats();
+void reportRenderStats();
+bool initFonts();
+void loadDisplayFont(TFT_eSPI& gfx, const char* name);
+void pushStatsFrame(const router_snapshot_t& snap, uint32_t seq);
+void spiFlush();
+void pushSpriteRows(TFT_eSprite& spr, int x, int y, int sy, int w, int h);
+String formatWiFiScan(int n);
 
 // ==================== PREFERENCES FUNCTIONS ====================
 
@@ -147,10 +1017,15 @@ void loadPreferences() {
   router_address = preferences.getString("router_addr", "http://192.168.1.1");
   router_login = preferences.getString("router_user", "APIUser");
   router_password = preferences.getString("router_pass", "myleetkey");
+  router_transport = preferences.getInt("router_proto", ROUTER_TRANSPORT_REST);
+  router_api_port = preferences.getInt("api_port", 0);
   graph_interface_id = preferences.getInt("interface_id", 2);
   backlight_brightness = preferences.getInt("backlight", 100);
   FIXED_MAX_MBPS = preferences.getUInt("max_mbps", 480);
   FIXED_MIN_MBPS = preferences.getUInt("min_mbps", 0);
+  graph_window = constrain(preferences.getUChar("graph_window", 0), 0, GRAPH_WINDOW_COUNT - 1);
+  display_layout = constrain(preferences.getUChar("layout", LAYOUT_SINGLE), 0, LAYOUT_COUNT - 1);
+  totals_flush_s = constrain(preferences.getUInt("totals_flush_s", 60), 5, 3600);
   preferences.end();
   
   // Recalculate BPS values
@@ -161,10 +1036,13 @@ void loadPreferences() {
   Serial.println("WiFi SSID: " + (wifi_ssid.length() > 0 ? wifi_ssid : "(none)"));
   Serial.println("Router: " + router_address);
   Serial.println("Router User: " + router_login);
+  Serial.println("Router Transport: " + String(router_transport == ROUTER_TRANSPORT_REST ? "REST" :
+                                               router_transport == ROUTER_TRANSPORT_API ? "API" : "API-SSL"));
   Serial.println("Interface ID: " + String(graph_interface_id));
   Serial.println("Backlight: " + String(backlight_brightness) + "%");
   Serial.println("Graph Max: " + String((uint32_t)FIXED_MAX_MBPS) + " Mbps");
   Serial.println("Graph Min: " + String((uint32_t)FIXED_MIN_MBPS) + " Mbps");
+  Serial.println("Layout: " + String(LAYOUT_NAMES[display_layout]));
 }
 
 void savePreferences(String ssid, String pass, String rtr_addr, String rtr_user, String rtr_pass, int iface_id) {
@@ -201,10 +1079,8 @@ void setBacklight(int brightness) {
 
 // ==================== WIFI SCANNING ====================
 
-String scanWiFiNetworks() {
-  Serial.println("Scanning WiFi networks...");
-  int n = WiFi.scanNetworks();
-  
+// JSON for the n results of a finished scan; frees the driver's copy
+String formatWiFiScan(int n) {
   DynamicJsonDocument doc(4096);
   JsonArray networks = doc.createNestedArray("networks");
   
@@ -290,72 +1166,100 @@ void tryWiFiConnection() {
 // ==================== WEB SERVER FUNCTIONS ====================
 
 void setupWebServer() {
-  // Main page
+  // Main page: the gzipped copy from web_interface_gz.h with a strong ETag,
+  // so reloads are answered with a 304. Clients without gzip, or a build
+  // whose web_interface_gz.h wasn't regenerated, get the plain page.
+  web_page_gz_current = journalCrc((const uint8_t*)html_page, strlen(html_page)) == HTML_PAGE_SOURCE_CRC;
+  if (!web_page_gz_current) {
+    Serial.println("⚠ web_interface_gz.h is stale, run tools/gzip_web_interface.py - serving the plain page");
+  }
+  
   server.on("/", HTTP_GET, [](AsyncWebServerRequest *request){
-    request->send(200, "text/html", html_page);
+    bool gzip_ok = web_page_gz_current && request->hasHeader("Accept-Encoding") &&
+                   request->getHeader("Accept-Encoding")->value().indexOf("gzip") >= 0;
+    if (!gzip_ok) {
+      web_page_sends[1]++;
+      request->send(200, "text/html", html_page);
+      return;
+    }
+    
+    AsyncWebServerResponse *response;
+    if (request->hasHeader("If-None-Match") &&
+        request->getHeader("If-None-Match")->value() == HTML_PAGE_GZ_ETAG) {
+      web_page_sends[2]++;
+      response = request->beginResponse(304);
+    } else {
+      web_page_sends[0]++;
+      response = request->beginResponse_P(200, "text/html", html_page_gz, html_page_gz_len);
+      response->addHeader("Content-Encoding", "gzip");
+    }
+    response->addHeader("ETag", HTML_PAGE_GZ_ETAG);
+    response->addHeader("Cache-Control", "no-cache");   // always revalidate, usually a 304
+    request->send(response);
   });
   
-  // WiFi scan endpoint
+  // WiFi scan: answers from the last result, or starts a background scan
+  // and answers 202 until it is done. ?refresh=1 only accepts a result from
+  // the last few seconds.
   server.on("/api/scan", HTTP_GET, [](AsyncWebServerRequest *request){
-    String result = scanWiFiNetworks();
-    request->send(200, "application/json", result);
+    int n = WiFi.scanComplete();
+    if (n >= 0) {
+      wifi_scan_result = formatWiFiScan(n);
+      wifi_scan_ms = millis();
+    }
+    
+    unsigned long max_age = request->hasParam("refresh") ? WIFI_SCAN_REFRESH_MS : WIFI_SCAN_CACHE_MS;
+    if (wifi_scan_result.length() > 0 && millis() - wifi_scan_ms < max_age) {
+      request->send(200, "application/json", wifi_scan_result);
+      return;
+    }
+    
+    if (n != WIFI_SCAN_RUNNING) {
+      WiFi.scanNetworks(true);
+      wifi_scan_job++;
+      Serial.printf("WiFi scan %u started\n", wifi_scan_job);
+    }
+    char body[64];
+    snprintf(body, sizeof(body), "{\"status\":\"scanning\",\"job\":%u,\"retry_ms\":1000}", wifi_scan_job);
+    request->send(202, "application/json", body);
   });
   
-  // Get interfaces
+  // Interface names as the poller last saw them; never asks the router, so
+  // the async_tcp task is not held up by a slow or dead one
   server.on("/api/interfaces", HTTP_GET, [](AsyncWebServerRequest *request){
     if (hotspot_mode || router_address.length() == 0) {
       request->send(200, "application/json", "{\"interfaces\":[]}");
       return;
     }
     
-    String url = router_address + "/rest/interface/ethernet/print";
-    String q = "{\".proplist\": \".id,name\"}";
-    HTTPClient http;
-    http.setTimeout(5000);
-    http.begin(url);
-    http.setAuthorization(router_login.c_str(), router_password.c_str());
-    http.addHeader("Content-Type", "application/json");
-    int code = http.POST(q);
+    static api_iface_t names[IFACE_NAMES_MAX];
+    portENTER_CRITICAL(&iface_names_mux);
+    int count = api_iface_count;
+    memcpy(names, api_ifaces, count * sizeof(api_iface_t));
+    portEXIT_CRITICAL(&iface_names_mux);
     
-    if (code == 200) {
-      String resp = http.getString();
-      DynamicJsonDocument inDoc(2048);
-      DeserializationError error = deserializeJson(inDoc, resp);
-      
-      if (!error && inDoc.is<JsonArray>()) {
-        DynamicJsonDocument outDoc(2048);
-        JsonArray interfaces = outDoc.createNestedArray("interfaces");
-        
-        for (JsonVariant item : inDoc.as<JsonArray>()) {
-          const char* sid = item[".id"] | "";
-          const char* name = item["name"] | "";
-          if (sid && sid[0] != '\0') {
-            int id = id2int(sid);
-            if (id > 0) {
-              JsonObject iface = interfaces.createNestedObject();
-              iface["id"] = id;
-              iface["name"] = name;
-            }
-          }
-        }
-        
-        String response;
-        serializeJson(outDoc, response);
-        request->send(200, "application/json", response);
-      } else {
-        request->send(200, "application/json", "{\"interfaces\":[]}");
-      }
-    } else {
-      request->send(200, "application/json", "{\"interfaces\":[]}");
+    if (count == 0) {
+      request->send(202, "application/json", "{\"status\":\"waiting for the first router poll\",\"retry_ms\":1000}");
+      return;
+    }
+    
+    DynamicJsonDocument outDoc(4096);
+    JsonArray interfaces = outDoc.createNestedArray("interfaces");
+    for (int i = 0; i < count; i++) {
+      JsonObject iface = interfaces.createNestedObject();
+      iface["id"] = names[i].id;
+      iface["name"] = (const char*)names[i].name;
     }
-    http.end();
+    String response;
+    serializeJson(outDoc, response);
+    request->send(200, "application/json", response);
   });
   
   // Save WiFi configuration only
-  server.on("/save-wifi", HTTP_POST, [](AsyncWebServerRequest *request){}, NULL,
-    [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
+  server.on("/save-wifi", HTTP_POST, [](AsyncWebServerRequest*){}, NULL,
+    [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t, size_t){
       DynamicJsonDocument doc(512);
-      DeserializationError error = deserializeJson(doc, (const char*)data);
+      DeserializationError error = deserializeJson(doc, (const char*)data, len);
       
       if (error) {
         request->send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
@@ -386,10 +1290,10 @@ void setupWebServer() {
     });
   
   // Save router configuration only
-  server.on("/save-router", HTTP_POST, [](AsyncWebServerRequest *request){}, NULL,
-    [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
+  server.on("/save-router", HTTP_POST, [](AsyncWebServerRequest*){}, NULL,
+    [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t, size_t){
       DynamicJsonDocument doc(512);
-      DeserializationError error = deserializeJson(doc, (const char*)data);
+      DeserializationError error = deserializeJson(doc, (const char*)data, len);
       
       if (error) {
         request->send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
@@ -400,6 +1304,8 @@ void setupWebServer() {
       String rtr_user = doc["router_user"].as<String>();
       String rtr_pass = doc["router_pass"].as<String>();
       int iface_id = doc["interface_id"] | graph_interface_id;
+      String transport = doc["transport"] | "rest";
+      int api_port = doc["api_port"] | 0;
       
       if (rtr_addr.length() == 0) {
         request->send(400, "application/json", "{\"error\":\"Router address required\"}");
@@ -410,12 +1316,18 @@ void setupWebServer() {
       router_login = rtr_user;
       router_password = rtr_pass;
       graph_interface_id = iface_id;
+      if (transport == "api") router_transport = ROUTER_TRANSPORT_API;
+      else if (transport == "api-ssl") router_transport = ROUTER_TRANSPORT_API_SSL;
+      else router_transport = ROUTER_TRANSPORT_REST;
+      router_api_port = constrain(api_port, 0, 65535);
       
       preferences.begin("wifi-config", false);
       preferences.putString("router_addr", rtr_addr);
       preferences.putString("router_user", rtr_user);
       preferences.putString("router_pass", rtr_pass);
       preferences.putInt("interface_id", iface_id);
+      preferences.putInt("router_proto", router_transport);
+      preferences.putInt("api_port", router_api_port);
       preferences.end();
       
       Serial.println("Router settings saved");
@@ -426,36 +1338,71 @@ void setupWebServer() {
     });
   
   // Save graph settings only
-  server.on("/save-graph", HTTP_POST, [](AsyncWebServerRequest *request){}, NULL,
-    [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
+  server.on("/save-graph", HTTP_POST, [](AsyncWebServerRequest*){}, NULL,
+    [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t, size_t){
       DynamicJsonDocument doc(256);
-      DeserializationError error = deserializeJson(doc, (const char*)data);
+      DeserializationError error = deserializeJson(doc, (const char*)data, len);
       
       if (error) {
         request->send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
         return;
       }
       
+      int window = graph_window;
+      if (doc.containsKey("window")) {
+        window = findGraphWindow(doc["window"] | "");
+        if (window < 0) {
+          request->send(400, "application/json", "{\"error\":\"Unknown window, use 1m, 10m, 1h, 24h or 7d\"}");
+          return;
+        }
+      }
+      
+      int layout = display_layout;
+      if (doc.containsKey("layout")) {
+        const char* name = doc["layout"] | "";
+        for (layout = LAYOUT_COUNT - 1; layout >= 0; layout--) {
+          if (strcmp(LAYOUT_NAMES[layout], name) == 0) break;
+        }
+        if (layout < 0) {
+          request->send(400, "application/json", "{\"error\":\"Unknown layout, use single, multi8 or multi16\"}");
+          return;
+        }
+      }
+      
+      // The Y scale is baked into the axis labels and the stored columns, and
+      // each layout allocates its own sprites at boot, so those two need a
+      // restart; the window applies live
+      bool scale_changed = (layout != display_layout);
       if (doc.containsKey("max_mbps")) {
-        FIXED_MAX_MBPS = doc["max_mbps"].as<uint32_t>();
+        uint32_t max_mbps = doc["max_mbps"].as<uint32_t>();
+        scale_changed |= max_mbps != FIXED_MAX_MBPS;
+        FIXED_MAX_MBPS = max_mbps;
         FIXED_MAX_BPS = FIXED_MAX_MBPS * 1024ULL * 1024;
       }
       
       if (doc.containsKey("min_mbps")) {
-        FIXED_MIN_MBPS = doc["min_mbps"].as<uint32_t>();
+        uint32_t min_mbps = doc["min_mbps"].as<uint32_t>();
+        scale_changed |= min_mbps != FIXED_MIN_MBPS;
+        FIXED_MIN_MBPS = min_mbps;
         FIXED_MIN_BPS = FIXED_MIN_MBPS * 1024ULL * 1024;
       }
       
       preferences.begin("wifi-config", false);
       preferences.putUInt("max_mbps", (uint32_t)FIXED_MAX_MBPS);
       preferences.putUInt("min_mbps", (uint32_t)FIXED_MIN_MBPS);
+      preferences.putUChar("graph_window", window);
+      preferences.putUChar("layout", layout);
       preferences.end();
+      graph_window = window;
       
-      Serial.println("Graph settings saved");
-      request->send(200, "application/json", "{\"status\":\"ok\"}");
+      Serial.printf("Graph settings saved (window %s, layout %s)\n", GRAPH_WINDOWS[window].name, LAYOUT_NAMES[layout]);
+      request->send(200, "application/json", scale_changed ? "{\"status\":\"ok\",\"restart\":true}" :
+                                                             "{\"status\":\"ok\",\"restart\":false}");
       
-      delay(1000);
-      ESP.restart();
+      if (scale_changed) {
+        delay(1000);
+        ESP.restart();
+      }
     });
   
   // Get current config
@@ -465,9 +1412,14 @@ void setupWebServer() {
     doc["router_addr"] = router_address;
     doc["router_user"] = router_login;
     doc["interface_id"] = graph_interface_id;
+    doc["transport"] = router_transport == ROUTER_TRANSPORT_API ? "api" :
+                       router_transport == ROUTER_TRANSPORT_API_SSL ? "api-ssl" : "rest";
+    doc["api_port"] = router_api_port;
     doc["backlight"] = backlight_brightness;
     doc["max_mbps"] = (uint32_t)FIXED_MAX_MBPS;
     doc["min_mbps"] = (uint32_t)FIXED_MIN_MBPS;
+    doc["graph_window"] = GRAPH_WINDOWS[graph_window].name;
+    doc["layout"] = LAYOUT_NAMES[display_layout];
     
     preferences.begin("wifi-config", true);
     String theme = preferences.getString("theme", "light");
@@ -487,16 +1439,19 @@ void setupWebServer() {
   
   // Get stats
   server.on("/api/stats", HTTP_GET, [](AsyncWebServerRequest *request){
+    web_demand_ms = millis();
     DynamicJsonDocument doc(512);
+    static router_snapshot_t snap;   // too big for the async_tcp stack; handlers run one at a time
+    readSnapshot(snap);
     
     uint32_t usedMB = 0;
     uint32_t totalMB = 0;
-    if (routerInfo.memoryTotal > 0) {
-      usedMB = (routerInfo.memoryTotal - routerInfo.memoryFree) / 1024 / 1024;
-      totalMB = routerInfo.memoryTotal / 1024 / 1024;
+    if (snap.info.memoryTotal > 0) {
+      usedMB = (snap.info.memoryTotal - snap.info.memoryFree) / 1024 / 1024;
+      totalMB = snap.info.memoryTotal / 1024 / 1024;
     }
     
-    doc["cpu"] = String(routerInfo.cpuLoad, 0);
+    doc["cpu"] = String(snap.info.cpuLoad, 0);
     
     char ramBuf[32];
     snprintf(ramBuf, sizeof(ramBuf), "%u/%u MB (%.0f%%)", 
@@ -504,10 +1459,10 @@ void setupWebServer() {
              totalMB > 0 ? (usedMB * 100.0 / totalMB) : 0.0);
     doc["ram"] = String(ramBuf);
     
-    mt_data_t* iface = ifaces.count(graph_interface_id) ? ifaces[graph_interface_id] : nullptr;
+    mt_data_t* iface = snap.iface_valid ? &snap.iface : nullptr;
     int lastIdx = iface ? ((iface->pos == 0) ? HISTORY_SIZE - 1 : iface->pos - 1) : 0;
-    double rx_mbps = iface ? iface->hist_rx[lastIdx] / 1024.0 / 1024.0 : 0.0;
-    double tx_mbps = iface ? iface->hist_tx[lastIdx] / 1024.0 / 1024.0 : 0.0;
+    double rx_mbps = iface ? iface->hist_rx[lastIdx] / 1024.0 : 0.0;
+    double tx_mbps = iface ? iface->hist_tx[lastIdx] / 1024.0 : 0.0;
     
     doc["rx"] = String(rx_mbps, 2);
     doc["tx"] = String(tx_mbps, 2);
@@ -523,11 +1478,438 @@ void setupWebServer() {
     request->send(200, "application/json", response);
   });
   
+  // Router session counters
+  server.on("/api/router-session", HTTP_GET, [](AsyncWebServerRequest *request){
+    DynamicJsonDocument doc(1024);
+    JsonArray endpoints = doc.createNestedArray("endpoints");
+    
+    for (int i = 0; i < ROUTER_EP_COUNT; i++) {
+      const router_endpoint_stats_t& st = router_stats[i];
+      JsonObject ep = endpoints.createNestedObject();
+      ep["name"] = ROUTER_EP_NAMES[i];
+      ep["requests"] = st.requests;
+      ep["reused"] = st.reused;
+      ep["connects"] = st.connects;
+      ep["failures"] = st.failures;
+      ep["dropped"] = st.dropped;
+      ep["skipped"] = st.skipped;
+      ep["last_ms"] = st.last_latency_ms;
+      ep["avg_ms"] = st.requests > 0 ? st.total_latency_ms / st.requests : 0;
+      ep["max_ms"] = st.max_latency_ms;
+    }
+    doc["backoff_ms"] = router_backoff_ms;
+    
+    String response;
+    serializeJson(doc, response);
+    request->send(200, "application/json", response);
+  });
+  
+  // Render timing per stage, SPI traffic and heap watermarks
+  server.on("/api/perf", HTTP_GET, [](AsyncWebServerRequest *request){
+    DynamicJsonDocument doc(1536);
+    uint32_t frames = render_frames;
+    
+    doc["frames"] = frames;
+    doc["frame_avg_us"] = frames > 0 ? (uint32_t)(render_frame.total_us / frames) : 0;
+    doc["frame_max_us"] = render_frame.max_us;
+    
+    JsonArray stages = doc.createNestedArray("stages");
+    for (int i = 0; i < RENDER_STAGE_COUNT; i++) {
+      const perf_hist_t& st = render_stages[i];
+      JsonObject stage = stages.createNestedObject();
+      stage["name"] = RENDER_STAGE_NAMES[i];
+      stage["runs"] = st.runs;
+      stage["avg_us"] = st.runs > 0 ? (uint32_t)(st.total_us / st.runs) : 0;
+      stage["max_us"] = st.max_us;
+    }
+    
+    JsonObject spi = doc.createNestedObject("spi");
+    spi["dma"] = dma_ready;
+    spi["pushes"] = spi_pushes;
+    spi["bytes"] = spi_bytes_pushed;
+    spi["blocked_us"] = spi_blocked_us;
+    
+    JsonObject pixels = doc.createNestedObject("pixels");
+    pixels["sprites"] = spi_bytes_pushed / 2;
+    pixels["text"] = text_px_painted;
+    
+    doc["graph_full_redraws"] = graph_full_redraws;
+    doc["gauge_delta_draws"] = gauge_delta_draws;
+    doc["gauge_full_draws"] = gauge_full_draws;
+    doc["font_fs_loads"] = font_fs_loads;
+    
+    JsonObject heap = doc.createNestedObject("heap");
+    heap["free"] = ESP.getFreeHeap();
+    heap["min_free"] = ESP.getMinFreeHeap();
+    heap["max_alloc"] = ESP.getMaxAllocHeap();
+    heap["loop_stack_free"] = uxTaskGetStackHighWaterMark(NULL);
+    if (poller_task != nullptr) {
+      heap["poller_stack_free"] = uxTaskGetStackHighWaterMark(poller_task);
+    }
+    
+    String response;
+    serializeJson(doc, response);
+    request->send(200, "application/json", response);
+  });
+  
+  // Prometheus text exposition format
+  server.on("/metrics", HTTP_GET, [](AsyncWebServerRequest *request){
+    AsyncResponseStream* response = request->beginResponseStream("text/plain; version=0.0.4");
+    writeMetrics(*response);
+    request->send(response);
+  });
+  
+  // Counters are cleared by loop() at the start of the next frame
+  server.on("/api/perf/reset", HTTP_POST, [](AsyncWebServerRequest *request){
+    render_stats_reset = true;
+    request->send(200, "application/json", "{\"success\":true}");
+  });
+  
+  // Usage in the current periods, journal state and flush interval
+  server.on("/api/totals", HTTP_GET, [](AsyncWebServerRequest *request){
+    DynamicJsonDocument doc(1024);
+    static router_snapshot_t snap;
+    readSnapshot(snap);
+    for (int p = 0; p < USAGE_PERIODS; p++) {
+      addUsageEntry(doc.createNestedObject(USAGE_PERIOD_NAMES[p]), p, snap.totals.period[p]);
+    }
+    doc["counter_resets"] = usage_counter_resets;
+    doc["counter_wraps"] = usage_counter_wraps;
+    doc["flush_s"] = totals_flush_s;
+    doc["seq"] = totals_seq;
+    doc["journal_records"] = totals_records;
+    doc["journal_max_records"] = TOTALS_JOURNAL_MAX_BYTES / sizeof(totals_record_t);
+    doc["compactions"] = totals_compactions;
+    doc["bad_records"] = totals_bad_records;
+    
+    String response;
+    serializeJson(doc, response);
+    request->send(200, "application/json", response);
+  });
+  
+  // 95th-percentile billing for this month; ?exact=1 adds exact values
+  // computed from the stored samples to check the sketch against
+  server.on("/api/billing", HTTP_GET, [](AsyncWebServerRequest *request){
+    static router_snapshot_t snap;
+    readSnapshot(snap);
+    const billing_view_t& b = snap.billing;
+    
+    DynamicJsonDocument doc(768);
+    char month[16] = "";
+    if (b.month != 0) formatUsagePeriod(USAGE_MONTH, b.month, month, sizeof(month));
+    doc["month"] = month;
+    doc["slot_s"] = BILLING_SLOT_S;
+    doc["samples"] = b.samples;
+    doc["missed"] = b.missed;
+    
+    bool exact = request->hasParam("exact");
+    billing_exact_t e;
+    if (exact) {
+      if (poller_task == nullptr) {
+        request->send(503, "application/json", "{\"error\":\"Router poller not running\"}");
+        return;
+      }
+      portENTER_CRITICAL(&billing_exact_mux);
+      e = billing_exact;
+      portEXIT_CRITICAL(&billing_exact_mux);
+      
+      if (!e.done || e.month != b.month || e.samples != b.samples) {
+        uint32_t job = billing_exact_job;
+        if (job == billing_exact_done) billing_exact_job = ++job;
+        char body[72];
+        snprintf(body, sizeof(body), "{\"status\":\"computing\",\"job\":%u,\"retry_ms\":500}", job);
+        request->send(202, "application/json", body);
+        return;
+      }
+    }
+    
+    for (int dir = 0; dir < 2; dir++) {
+      JsonObject o = doc.createNestedObject(dir ? "tx" : "rx");
+      o["p95_kbps"] = dir ? b.tx_p95 : b.rx_p95;
+      o["p99_kbps"] = dir ? b.tx_p99 : b.rx_p99;
+      o["max_kbps"] = dir ? b.tx_max : b.rx_max;
+      
+      if (exact && e.valid) {
+        JsonObject x = o.createNestedObject("exact");
+        x["samples"] = e.n;
+        x["p95_kbps"] = dir ? e.tx_p95 : e.rx_p95;
+        x["p99_kbps"] = dir ? e.tx_p99 : e.rx_p99;
+      }
+    }
+    if (exact) doc["exact_ms"] = e.ms;
+    
+    String response;
+    serializeJson(doc, response);
+    request->send(200, "application/json", response);
+  });
+  
+  // Closed periods, newest first
+  server.on("/api/usage", HTTP_GET, [](AsyncWebServerRequest *request){
+    File file = LittleFS.open(USAGE_PATH, "r");
+    if (!file) {
+      request->send(500, "application/json", "{\"error\":\"No usage history\"}");
+      return;
+    }
+    
+    DynamicJsonDocument doc(12288);
+    for (int p = 0; p < USAGE_PERIODS; p++) {
+      usage_entry_t entries[USAGE_HISTORY_MAX];
+      int n = USAGE_HISTORY[p];
+      file.seek(usageSlotOffset(p, 0));
+      if (file.read((uint8_t*)entries, n * sizeof(usage_entry_t)) != n * sizeof(usage_entry_t)) n = 0;
+      
+      // Insertion sort by key, descending; at most USAGE_HISTORY_MAX entries
+      for (int i = 1; i < n; i++) {
+        usage_entry_t e = entries[i];
+        int j = i - 1;
+        for (; j >= 0 && entries[j].key < e.key; j--) entries[j + 1] = entries[j];
+        entries[j + 1] = e;
+      }
+      
+      JsonArray arr = doc.createNestedArray(USAGE_PERIOD_NAMES[p]);
+      for (int i = 0; i < n && entries[i].key != 0; i++) {
+        addUsageEntry(arr.createNestedObject(), p, entries[i]);
+      }
+    }
+    file.close();
+    
+    AsyncResponseStream *response = request->beginResponseStream("application/json");
+    serializeJson(doc, *response);
+    request->send(response);
+  });
+  
+  server.on("/api/totals", HTTP_POST, [](AsyncWebServerRequest*){}, NULL,
+    [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t, size_t){
+      StaticJsonDocument<64> doc;
+      DeserializationError error = deserializeJson(doc, (const char*)data, len);
+      
+      if (error) {
+        request->send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
+        return;
+      }
+      
+      uint32_t flush_s = doc["flush_s"] | 0;
+      if (flush_s < 5 || flush_s > 3600) {
+        request->send(400, "application/json", "{\"error\":\"flush_s must be 5..3600\"}");
+        return;
+      }
+      
+      totals_flush_s = flush_s;
+      preferences.begin("wifi-config", false);
+      preferences.putUInt("totals_flush_s", totals_flush_s);
+      preferences.end();
+      
+      Serial.printf("Totals flush interval: %u s\n", totals_flush_s);
+      request->send(200, "application/json", "{\"success\":true}");
+    });
+  
+  server.on("/api/fleet", HTTP_GET, [](AsyncWebServerRequest *request){
+    DynamicJsonDocument doc(2048);
+    doc["max"] = FLEET_MAX;
+    doc["max_inflight"] = FLEET_MAX_INFLIGHT;
+    doc["timeout_ms"] = FLEET_TIMEOUT_MS;
+    doc["polling"] = fleet_slots != nullptr;    // not in the single layout
+    JsonArray routers = doc.createNestedArray("routers");
+    
+    static fleet_router_t r;
+    for (int i = 0; i < fleet_count; i++) {
+      portENTER_CRITICAL(&fleet_mux);
+      memcpy(&r, &fleet[i], sizeof(r));
+      portEXIT_CRITICAL(&fleet_mux);
+      
+      JsonObject o = routers.createNestedObject();
+      o["name"] = r.name;
+      o["address"] = r.address;
+      o["login"] = r.login;
+      o["interface_id"] = r.iface_id;
+      o["online"] = r.online;
+      o["last_code"] = r.last_code;
+      o["latency_ms"] = r.last_latency_ms;
+      o["requests"] = r.requests;
+      o["failures"] = r.failures;
+      o["rx_kbps"] = r.last_rx_kbps;
+      o["tx_kbps"] = r.last_tx_kbps;
+    }
+    
+    String response;
+    serializeJson(doc, response);
+    request->send(200, "application/json", response);
+  });
+  
+  // Replaces the fleet list; members start after the restart
+  server.on("/api/fleet", HTTP_POST, [](AsyncWebServerRequest*){}, NULL,
+    [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t, size_t){
+      DynamicJsonDocument doc(2048);
+      DeserializationError error = deserializeJson(doc, (const char*)data, len);
+      
+      if (error || !doc["routers"].is<JsonArray>()) {
+        request->send(400, "application/json", "{\"error\":\"Invalid JSON or no routers array\"}");
+        return;
+      }
+      
+      if (!saveFleet(doc["routers"].as<JsonArray>())) {
+        request->send(400, "application/json", "{\"error\":\"At most 4 routers, each with an address\"}");
+        return;
+      }
+      
+      Serial.println("Fleet settings saved");
+      // Members are only polled where they have tiles to show in
+      if (doc["routers"].size() > 0 && display_layout == LAYOUT_SINGLE) {
+        Serial.println("⚠ Fleet routers are not polled in the single layout - switch to multi8 or multi16");
+        request->send(200, "application/json",
+                      "{\"status\":\"ok\",\"restart\":true,\"polling\":false,"
+                      "\"warning\":\"Fleet routers are only polled in the multi8 and multi16 layouts\"}");
+      } else {
+        request->send(200, "application/json", "{\"status\":\"ok\",\"restart\":true}");
+      }
+      
+      delay(1000);
+      ESP.restart();
+    });
+  
+  // History export, streamed in chunks straight from flash:
+  // ?series=traffic|usage|billing &format=csv|ndjson|bin &from=&to= (router
+  // clock seconds), plus &tier=1s|1m|15m &iface= for traffic and
+  // &period=hour|day|week|month for usage
+  server.on("/api/export", HTTP_GET, [](AsyncWebServerRequest *request){
+    auto param = [request](const char* name, const char* def) -> String {
+      return request->hasParam(name) ? request->getParam(name)->value() : String(def);
+    };
+    auto find = [](const String& value, const char* const* names, int count) -> int {
+      for (int i = 0; i < count; i++) {
+        if (value == names[i]) return i;
+      }
+      return -1;
+    };
+    
+    int series = find(param("series", "traffic"), EXPORT_SERIES_NAMES, EXPORT_SERIES);
+    int format = find(param("format", "csv"), EXPORT_FORMAT_NAMES, 3);
+    int tier = find(param("tier", "1m"), RRD_TIER_NAMES, RRD_TIERS);
+    int period = find(param("period", "day"), USAGE_PERIOD_NAMES, USAGE_PERIODS);
+    if (series < 0 || format < 0 || tier < 0 || period < 0) {
+      request->send(400, "application/json", "{\"error\":\"Unknown series, format, tier or period\"}");
+      return;
+    }
+    
+    uint32_t now = routerNow();
+    if (now == 0) {
+      request->send(503, "application/json", "{\"error\":\"Router clock not known yet\"}");
+      return;
+    }
+    if (exports_active.fetch_add(1) >= EXPORT_MAX_ACTIVE) {
+      exports_active--;
+      request->send(503, "application/json", "{\"error\":\"Too many exports running\"}");
+      return;
+    }
+    
+    // The context lives as long as the response; the deleter closes the file
+    std::shared_ptr<export_ctx_t> ctx(new export_ctx_t(), [](export_ctx_t* c) {
+      exports_active--;
+      delete c;
+    });
+    ctx->series = series;
+    ctx->format = format;
+    ctx->tier = tier;
+    ctx->period = period;
+    ctx->from = (uint32_t)strtoul(param("from", "0").c_str(), nullptr, 10);
+    ctx->to = min((uint32_t)strtoul(param("to", "4294967295").c_str(), nullptr, 10), now);
+    ctx->start_ms = millis();
+    ctx->min_heap = ESP.getFreeHeap();
+    
+    if (series == EXPORT_TRAFFIC) {
+      ctx->iface_id = param("iface", String(graph_interface_id).c_str()).toInt();
+    } else {
+      const char* path = series == EXPORT_USAGE ? USAGE_PATH : BILLING_PATH;
+      if (LittleFS.exists(path)) ctx->file = LittleFS.open(path, "r");
+    }
+    if (!exportOpen(*ctx)) {
+      request->send(404, "application/json", "{\"error\":\"No history for this series\"}");
+      return;
+    }
+    
+    const char* type = format == EXPORT_CSV ? "text/csv" :
+                       format == EXPORT_NDJSON ? "application/x-ndjson" : "application/octet-stream";
+    exports_total++;
+    request->send(request->beginChunkedResponse(type, [ctx](uint8_t* buf, size_t max_len, size_t) -> size_t {
+      return exportFill(*ctx, buf, max_len);
+    }));
+  });
+  
+  // Raw REST reply capture: status, start/stop/replay, download
+  server.on("/api/capture", HTTP_GET, [](AsyncWebServerRequest *request){
+    DynamicJsonDocument doc(1280);
+    doc["active"] = capture_active;
+    doc["replaying"] = replay_running;
+    doc["records"] = capture_records;
+    doc["bytes"] = capture_bytes;
+    doc["dropped"] = capture_dropped;
+    doc["max_bytes"] = CAPTURE_MAX_BYTES;
+    doc["available"] = LittleFS.exists(CAPTURE_PATH);
+    
+    if (replay_result.valid) {
+      JsonObject r = doc.createNestedObject("replay");
+      r["records"] = replay_result.records;
+      r["errors"] = replay_result.errors;
+      r["span_ms"] = replay_result.span_ms;
+      r["elapsed_ms"] = replay_result.elapsed_ms;
+      r["samples"] = replay_result.samples;
+      r["rejected_rates"] = replay_result.rejections;
+      JsonObject sched = r.createNestedObject("schedule");
+      sched["counter_replies"] = replay_result.counter_replies;
+      sched["counter_polls"] = replay_result.sched_polls;
+      sched["captured_requests_per_hour"] = replay_result.captured_per_hour;
+      sched["requests_per_hour"] = replay_result.sched_per_hour;
+      sched["freshness_avg_ms"] = replay_result.freshness_avg_ms;
+      sched["freshness_max_ms"] = replay_result.freshness_max_ms;
+      for (int p = 0; p < USAGE_PERIODS; p++) {
+        addUsageEntry(r.createNestedObject(USAGE_PERIOD_NAMES[p]), p, replay_result.totals.period[p]);
+      }
+    }
+    
+    String response;
+    serializeJson(doc, response);
+    request->send(200, "application/json", response);
+  });
+  
+  server.on("/api/capture", HTTP_POST, [](AsyncWebServerRequest*){}, NULL,
+    [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t, size_t){
+      StaticJsonDocument<64> doc;
+      DeserializationError error = deserializeJson(doc, (const char*)data, len);
+      
+      if (error) {
+        request->send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
+        return;
+      }
+      
+      const char* action = doc["action"] | "";
+      if (strcmp(action, "start") == 0) {
+        capture_cmd = CAPTURE_CMD_START;
+      } else if (strcmp(action, "stop") == 0) {
+        capture_cmd = CAPTURE_CMD_STOP;
+      } else if (strcmp(action, "replay") == 0) {
+        capture_cmd = CAPTURE_CMD_REPLAY;
+      } else {
+        request->send(400, "application/json", "{\"error\":\"action must be start, stop or replay\"}");
+        return;
+      }
+      
+      Serial.printf("Capture command: %s\n", action);
+      request->send(202, "application/json", "{\"success\":true}");
+    });
+  
+  server.on("/capture.bin", HTTP_GET, [](AsyncWebServerRequest *request){
+    if (!LittleFS.exists(CAPTURE_PATH)) {
+      request->send(404, "application/json", "{\"error\":\"No capture\"}");
+      return;
+    }
+    request->send(LittleFS, CAPTURE_PATH, "application/octet-stream", true);
+  });
+  
   // Set backlight
-  server.on("/api/backlight", HTTP_POST, [](AsyncWebServerRequest *request){}, NULL,
-    [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
+  server.on("/api/backlight", HTTP_POST, [](AsyncWebServerRequest*){}, NULL,
+    [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t, size_t){
       StaticJsonDocument<128> doc;
-      DeserializationError error = deserializeJson(doc, (const char*)data);
+      DeserializationError error = deserializeJson(doc, (const char*)data, len);
       
       if (error) {
         request->send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
@@ -548,10 +1930,10 @@ void setupWebServer() {
     });
   
   // Save theme preference
-  server.on("/api/theme", HTTP_POST, [](AsyncWebServerRequest *request){}, NULL,
-    [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
+  server.on("/api/theme", HTTP_POST, [](AsyncWebServerRequest*){}, NULL,
+    [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t, size_t){
       StaticJsonDocument<128> doc;
-      DeserializationError error = deserializeJson(doc, (const char*)data);
+      DeserializationError error = deserializeJson(doc, (const char*)data, len);
       
       if (error) {
         request->send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
@@ -569,6 +1951,12 @@ void setupWebServer() {
       request->send(200, "application/json", "{\"status\":\"ok\"}");
     });
   
+  // Live stats for the web UI; frames are sent from loop() by pushStatsFrame()
+  events.onConnect([](AsyncEventSourceClient*){
+    events_resync = true;
+  });
+  server.addHandler(&events);
+  
   ElegantOTA.begin(&server);
   
   server.begin();
@@ -576,21 +1964,68 @@ void setupWebServer() {
   Serial.println("✓ ElegantOTA initialized at /update");
 }
 
-// ==================== SPLASH SCREEN ====================
-
-void showSplashScreen() {
-  tft.fillScreen(TFT_BLACK);
+// ==================== FONTS ====================
+
+// The small font is read from LittleFS once and kept in RAM. tft and the
+// gauge sprites load it from that copy and keep it loaded, so drawing text
+// never touches the filesystem. The large font is only used on the splash
+// and config screens and is still read from flash when needed.
+static uint8_t* small_font_data = nullptr;
+static size_t small_font_size = 0;
+
+bool initFonts() {
+  String path = String("/") + SMALL_FONT + ".vlw";
+  File f = LittleFS.open(path, "r");
+  if (!f) {
+    Serial.println("ERROR: Font not found: " + path);
+    return false;
+  }
   
-  tft.setTextColor(TFT_CYAN);
-  tft.loadFont(LARGE_FONT, LittleFS);
-  tft.drawCentreString("Mikrotik", SCREEN_WIDTH / 2, 40, 0);
+  small_font_size = f.size();
+  small_font_data = (uint8_t*)malloc(small_font_size);
+  if (small_font_data == nullptr) {
+    Serial.printf("⚠ No RAM to cache font (%u bytes), loading from LittleFS\n", (unsigned)small_font_size);
+    f.close();
+    return false;
+  }
+  
+  size_t got = f.read(small_font_data, small_font_size);
+  f.close();
+  if (got != small_font_size) {
+    Serial.println("ERROR: Short read on " + path);
+    free(small_font_data);
+    small_font_data = nullptr;
+    return false;
+  }
+  
+  Serial.printf("✓ Font cached in RAM: %s (%u bytes)\n", path.c_str(), (unsigned)small_font_size);
+  return true;
+}
+
+void loadDisplayFont(TFT_eSPI& gfx, const char* name) {
+  if (small_font_data && strcmp(name, SMALL_FONT) == 0) {
+    gfx.loadFont(small_font_data);
+    return;
+  }
+  gfx.loadFont(name, LittleFS);
+  font_fs_loads++;
+}
+
+// ==================== SPLASH SCREEN ====================
+
+void showSplashScreen() {
+  tft.fillScreen(TFT_BLACK);
+  
+  tft.setTextColor(TFT_CYAN);
+  loadDisplayFont(tft, LARGE_FONT);
+  tft.drawCentreString("Mikrotik", SCREEN_WIDTH / 2, 40, 0);
   tft.setTextColor(TFT_YELLOW);
   tft.drawCentreString("Data Display", SCREEN_WIDTH / 2, 85, 0);
-  tft.unloadFont();
   
   tft.fillRect(100, 130, 280, 3, TFT_BLUE);
   
-  tft.loadFont(SMALL_FONT, LittleFS);
+  // Stays loaded for the dashboard
+  loadDisplayFont(tft, SMALL_FONT);
   
   if (hotspot_mode) {
     tft.setTextColor(TFT_ORANGE);
@@ -632,8 +2067,6 @@ void showSplashScreen() {
     tft.drawString("http://" + WiFi.localIP().toString(), 80, 300, 0);
   }
   
-  tft.unloadFont();
-  
   Serial.println("Splash screen displayed for 10 seconds");
   delay(10000);
 }
@@ -649,10 +2082,11 @@ uint32_t parseUptimeToSeconds(const String& s) {
   String str = s;
   str.trim();
   uint32_t total = 0;
+  const int len = str.length();
   int pos = 0;
-  while (pos < str.length()) {
+  while (pos < len) {
     int alpha = -1;
-    for (int i = pos; i < str.length(); i++) {
+    for (int i = pos; i < len; i++) {
       if (isalpha(str[i])) {
         alpha = i;
         break;
@@ -719,17 +2153,495 @@ String convertDateFormat(const char* mt_date) {
   return String(mt_date);
 }
 
+// Days since 1970-01-01 for a proleptic Gregorian date
+int32_t daysFromCivil(int y, int m, int d) {
+  y -= m <= 2;
+  int32_t era = (y >= 0 ? y : y - 399) / 400;
+  uint32_t yoe = (uint32_t)(y - era * 400);
+  uint32_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + (int32_t)doe - 719468;
+}
+
+void civilFromDays(int32_t days, int& y, int& m, int& d) {
+  days += 719468;
+  int32_t era = (days >= 0 ? days : days - 146096) / 146097;
+  uint32_t doe = (uint32_t)(days - era * 146097);
+  uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  uint32_t mp = (5 * doy + 2) / 153;
+  d = doy - (153 * mp + 2) / 5 + 1;
+  m = mp < 10 ? mp + 3 : mp - 9;
+  y = (int)yoe + era * 400 + (m <= 2);
+}
+
+// Accepts both RouterOS date formats: "jan/02/2024" and "2024-01-02"
+bool parseRouterDate(const char* s, int& year, int& month, int& day) {
+  char mon[4];
+  if (sscanf(s, "%3[A-Za-z]/%d/%d", mon, &day, &year) == 3) {
+    const char* names = "janfebmaraprmayjunjulaugsepoctnovdec";
+    for (int i = 0; i < 3; i++) mon[i] = tolower(mon[i]);
+    const char* found = strstr(names, mon);
+    if (!found || (found - names) % 3 != 0) return false;
+    month = (found - names) / 3 + 1;
+  } else if (sscanf(s, "%d-%d-%d", &year, &month, &day) != 3) {
+    return false;
+  }
+  return year >= 2000 && month >= 1 && month <= 12 && day >= 1 && day <= 31;
+}
+
+uint32_t routerNow() {
+  if (router_epoch == 0) return 0;
+  return router_epoch + (millis() - router_epoch_ms) / 1000;
+}
+
+// ==================== ROUTER SESSION ====================
+
+void routerSessionInit() {
+  if (router_session_lock == nullptr) {
+    router_session_lock = xSemaphoreCreateMutex();
+  }
+  memset(router_stats, 0, sizeof(router_stats));
+  router_auth_header = "Basic " + base64::encode(router_login + ":" + router_password);
+  router_http.setReuse(true);
+  router_http.setTimeout(5000);
+  router_http.setConnectTimeout(3000);
+}
+
+// Starts a POST on the shared connection. Every call must be paired with
+// routerRequestEnd(code, body_read), saying whether the body was read to
+// its end.
+int routerPost(router_endpoint_t ep, const char* path, const String& body) {
+  router_endpoint_stats_t& st = router_stats[ep];
+  
+  if (router_session_lock == nullptr ||
+      xSemaphoreTake(router_session_lock, pdMS_TO_TICKS(ROUTER_LOCK_TIMEOUT_MS)) != pdTRUE) {
+    st.skipped++;
+    return ROUTER_ERR_BUSY;
+  }
+  
+  if (router_backoff_until != 0 && (long)(millis() - router_backoff_until) < 0) {
+    st.skipped++;
+    xSemaphoreGive(router_session_lock);
+    return ROUTER_ERR_BACKOFF;
+  }
+  
+  st.requests++;
+  if (router_client.connected()) {
+    st.reused++;
+  } else {
+    st.connects++;
+  }
+  
+  router_request_ep = ep;
+  router_request_start = millis();
+  
+  router_http.begin(router_client, router_address + path);
+  router_http.addHeader("Authorization", router_auth_header);
+  router_http.addHeader("Content-Type", "application/json");
+  unsigned long post_start_us = micros();
+  int code = router_http.POST(body);
+  perfRecord(router_http_hist[ep], post_start_us);
+  return code;
+}
+
+void routerRequestEnd(int code, bool body_read) {
+  if (code == ROUTER_ERR_BUSY || code == ROUTER_ERR_BACKOFF) return;
+  
+  router_endpoint_stats_t& st = router_stats[router_request_ep];
+  uint32_t latency = millis() - router_request_start;
+  st.last_latency_ms = latency;
+  st.total_latency_ms += latency;
+  if (latency > st.max_latency_ms) st.max_latency_ms = latency;
+  
+  if (code != 200) st.failures++;
+  
+  // Whatever is left of a reply (an error page, a body the parser gave up
+  // on) would be read as the start of the next reply on a kept-alive socket
+  bool unread = code > 0 && (code != 200 || !body_read || router_client.available() > 0);
+  
+  router_http.end();
+  
+  if (unread) {
+    router_client.stop();
+    st.dropped++;
+  }
+  
+  if (code < 0) {
+    // Transport error: drop the socket and back off before reconnecting
+    router_client.stop();
+    router_backoff_ms = (router_backoff_ms == 0) ? ROUTER_BACKOFF_MIN_MS
+                                                 : min(router_backoff_ms * 2, ROUTER_BACKOFF_MAX_MS);
+    router_backoff_until = millis() + router_backoff_ms;
+    Serial.printf("Router %s failed (%s), retry in %lu ms\n", ROUTER_EP_NAMES[router_request_ep],
+                  HTTPClient::errorToString(code).c_str(), router_backoff_ms);
+  } else {
+    router_backoff_ms = 0;
+    router_backoff_until = 0;
+  }
+  
+  xSemaphoreGive(router_session_lock);
+}
+
 // ==================== ROUTER DATA FUNCTIONS ====================
 
-void fetchRouterInfo() {
+int peekNonSpace(Stream& stream) {
+  unsigned long start = millis();
+  while (millis() - start < API_READ_TIMEOUT_MS) {
+    int c = stream.peek();
+    if (c < 0) {
+      delay(1);
+      continue;
+    }
+    if (!isspace(c)) return c;
+    stream.read();
+  }
+  return -1;
+}
+
+// Body of the current REST reply as a stream. Replies with a known length
+// are read straight off the socket; chunked ones are decoded into `fallback`.
+// While capturing, every poller reply is buffered and logged first.
+Stream& restReplyStream(StreamString& fallback) {
+  if (capture_active && router_request_ep != ROUTER_EP_IFACE_LIST) {
+    router_http.writeToStream(&fallback);
+    captureReply(router_request_ep, fallback, router_request_start);
+    return fallback;
+  }
+  if (router_http.getSize() >= 0) {
+    return router_http.getStream();
+  }
+  router_http.writeToStream(&fallback);
+  return fallback;
+}
+
+// Hands a REST reply to ArduinoJson while following the JSON nesting, so
+// that an element the parser gave up on part-way through can be read to
+// its end and the rest of the array parsed normally.
+class RestItemStream : public Stream {
+ public:
+  explicit RestItemStream(Stream& in) : in_(in) { setTimeout(in.getTimeout()); }
+  
+  int available() override { return in_.available(); }
+  int peek() override { return in_.peek(); }
+  int read() override {
+    int c = in_.read();
+    if (c < 0) return c;
+    if (in_string_) {
+      if (escaped_) escaped_ = false;
+      else if (c == '\\') escaped_ = true;
+      else if (c == '"') in_string_ = false;
+    } else if (c == '"') {
+      in_string_ = true;
+    } else if (c == '{' || c == '[') {
+      depth_++;
+    } else if ((c == '}' || c == ']') && depth_ > 0) {
+      depth_--;
+    }
+    return c;
+  }
+  size_t write(uint8_t) override { return 0; }
+  
+  // Reads what is left of the current element; false if the reply ends first
+  bool skipRest() {
+    char c;
+    while (depth_ > 0 || in_string_) {
+      if (readBytes(&c, 1) != 1) return false;
+    }
+    return true;
+  }
+  
+ private:
+  Stream& in_;
+  int depth_ = 0;
+  bool in_string_ = false;
+  bool escaped_ = false;
+};
+
+// Walks a RouterOS REST array reply one element at a time, keeping only the
+// fields in `filter`, so memory use is bounded by a single element whatever
+// the number of items. An element too big for `item` (a very long interface
+// name, say) is skipped instead of failing the whole reply. Returns the
+// number of elements passed to onItem, or -1 on a malformed reply.
+int parseRestArray(Stream& stream, JsonDocument& item, JsonDocument& filter,
+                   std::function<void(JsonObject)> onItem) {
+  if (!stream.find("[")) return -1;
+  
+  int count = 0;
+  int c = peekNonSpace(stream);
+  if (c == ']') {
+    stream.read();
+    return 0;
+  }
+  
+  RestItemStream element(stream);
+  for (;;) {
+    DeserializationError error = deserializeJson(item, element, DeserializationOption::Filter(filter));
+    if (error == DeserializationError::NoMemory) {
+      Serial.printf("⚠ REST reply element over %u bytes skipped\n", (unsigned)item.capacity());
+      if (!element.skipRest()) return -1;
+    } else if (error) {
+      Serial.println("REST reply parse error: " + String(error.c_str()));
+      return -1;
+    } else {
+      onItem(item.as<JsonObject>());
+      count++;
+    }
+    
+    c = peekNonSpace(stream);
+    if (c == ',') {
+      stream.read();
+    } else if (c == ']') {
+      stream.read();
+      return count;
+    } else {
+      return -1;
+    }
+  }
+}
+
+iface_entry_t* findIface(int id) {
+  if (!iface_index || id <= 0) return nullptr;
+  
+  uint32_t slot = ((uint32_t)id * 2654435761UL) & (IFACE_INDEX_SIZE - 1);
+  for (;;) {
+    int16_t idx = iface_index[slot];
+    if (idx < 0) return nullptr;
+    if (iface_table[idx].id == id) return &iface_table[idx];
+    slot = (slot + 1) & (IFACE_INDEX_SIZE - 1);
+  }
+}
+
+iface_entry_t* addIface(int id, uint64_t rx, uint64_t tx, uint32_t nowMs) {
+  if (!iface_index || id <= 0) return nullptr;
+  if (iface_count >= MAX_IFACES) {
+    static bool warned = false;
+    if (!warned) {
+      Serial.printf("WARNING: Interface table full (%d), ignoring new interfaces\n", MAX_IFACES);
+      warned = true;
+    }
+    return nullptr;
+  }
+  
+  uint32_t slot = ((uint32_t)id * 2654435761UL) & (IFACE_INDEX_SIZE - 1);
+  while (iface_index[slot] >= 0) {
+    slot = (slot + 1) & (IFACE_INDEX_SIZE - 1);
+  }
+  
+  iface_entry_t* iface = &iface_table[iface_count];
+  memset(iface, 0, sizeof(iface_entry_t));
+  iface->id = id;
+  iface->rx = rx;
+  iface->tx = tx;
+  iface->time = nowMs;
+  iface->ring = -1;
+  iface_names_stale = true;
+  
+  // Keep the last ring for the graphed interface in case it shows up late
+  if (iface_rings_used < HISTORY_RINGS - 1 ||
+      (iface_rings_used < HISTORY_RINGS && id == graph_interface_id)) {
+    iface->ring = iface_rings_used++;
+    memset(&iface_rings[iface->ring], 0, sizeof(iface_ring_t));
+  }
+  
+  iface_index[slot] = iface_count++;
+  Serial.printf("Initialized interface %d%s\n", id, iface->ring < 0 ? " (no history)" : "");
+  return iface;
+}
+
+void pushRateSample(iface_entry_t* iface, uint64_t rx_bps, uint64_t tx_bps) {
+  iface->last_rx_kbps = (uint32_t)min(rx_bps / 1024, (uint64_t)UINT32_MAX);
+  iface->last_tx_kbps = (uint32_t)min(tx_bps / 1024, (uint64_t)UINT32_MAX);
+  
+  iface->samples++;
+  if (iface->ring < 0) return;
+  
+  iface_ring_t& ring = iface_rings[iface->ring];
+  ring.rx[iface->pos] = iface->last_rx_kbps;
+  ring.tx[iface->pos] = iface->last_tx_kbps;
+  
+  if (++iface->pos >= HISTORY_SIZE) {
+    iface->pos = 0;
+  }
+}
+
+bool copyIfaceView(const iface_entry_t* iface, mt_data_t& out) {
+  if (!iface || iface->ring < 0) return false;
+  
+  out.rx = iface->rx;
+  out.tx = iface->tx;
+  out.pos = iface->pos;
+  out.samples = iface->samples;
+  memcpy(out.hist_rx, iface_rings[iface->ring].rx, sizeof(out.hist_rx));
+  memcpy(out.hist_tx, iface_rings[iface->ring].tx, sizeof(out.hist_tx));
+  return true;
+}
+
+bool initIfaceTable() {
+  iface_table = (iface_entry_t*)calloc(MAX_IFACES, sizeof(iface_entry_t));
+  iface_index = (int16_t*)malloc(IFACE_INDEX_SIZE * sizeof(int16_t));
+  iface_rings = (iface_ring_t*)calloc(HISTORY_RINGS, sizeof(iface_ring_t));
+  
+  if (!iface_table || !iface_index || !iface_rings) {
+    Serial.println("ERROR: Failed to allocate interface table");
+    free(iface_table);
+    free(iface_index);
+    free(iface_rings);
+    iface_table = nullptr;
+    iface_index = nullptr;
+    iface_rings = nullptr;
+    return false;
+  }
+  
+  memset(iface_index, 0xFF, IFACE_INDEX_SIZE * sizeof(int16_t));
+  Serial.printf("✓ Interface table: %d entries, %d history rings (%u bytes)\n", MAX_IFACES, HISTORY_RINGS,
+                (unsigned)(MAX_IFACES * sizeof(iface_entry_t) + IFACE_INDEX_SIZE * sizeof(int16_t) +
+                           HISTORY_RINGS * sizeof(iface_ring_t)));
+  return true;
+}
+
+// Applies one /interface/ethernet/print reply taken at nowMs: updates
+// counters and pushes a rate sample for every interface seen before.
+// Returns the item count, or -1 on a malformed reply.
+int parseInterfaceReply(Stream& stream, uint32_t nowMs) {
+  StaticJsonDocument<96> filter;
+  filter[".id"] = true;
+  filter["rx-bytes"] = true;
+  filter["tx-bytes"] = true;
+  filter["running"] = true;
+  StaticJsonDocument<256> item;
+  
+  return parseRestArray(stream, item, filter, [nowMs](JsonObject o) {
+    const char* sid = o[".id"] | "";
+    int id = id2int(sid);
+    if (id == 0) return;
+    
+
+    uint64_t rx = (uint64_t)atoll(o["rx-bytes"] | "0");
+    uint64_t tx = (uint64_t)atoll(o["tx-bytes"] | "0");
+    
+    iface_entry_t* iface = findIface(id);
+    if (!iface) {
+      addIface(id, rx, tx, nowMs);
+      return;
+    }
+    
+    uint32_t elapsed_ms = nowMs - iface->time;
+    
+    if (elapsed_ms < 100) {
+      return;
+    }
+    
+    double dt = elapsed_ms / 1000.0;
+    
+    uint64_t drx = (rx >= iface->rx) ? (rx - iface->rx) : rx;
+    uint64_t dtx = (tx >= iface->tx) ? (tx - iface->tx) : tx;
+    
+    uint64_t rx_bps = (uint64_t)((drx / dt) * 8.0);
+    uint64_t tx_bps = (uint64_t)((dtx / dt) * 8.0);
+    
+    const uint64_t MAX_REASONABLE_BPS = 10ULL * 1024 * 1024 * 1024;
+    
+    if (rx_bps > MAX_REASONABLE_BPS) {
+      Serial.printf("Interface %d: Rejected unrealistic RX: %llu bps\n", id, (unsigned long long)rx_bps);
+      rx_bps = 0;
+      rate_rejections++;
+    }
+    
+    if (tx_bps > MAX_REASONABLE_BPS) {
+      Serial.printf("Interface %d: Rejected unrealistic TX: %llu bps\n", id, (unsigned long long)tx_bps);
+      tx_bps = 0;
+      rate_rejections++;
+    }
+    
+    uint64_t prev_rx = (uint64_t)iface->last_rx_kbps * 1024;
+    uint64_t prev_tx = (uint64_t)iface->last_tx_kbps * 1024;
+    
+    rx_bps = (rx_bps * 7 + prev_rx * 3) / 10;
+    tx_bps = (tx_bps * 7 + prev_tx * 3) / 10;
+    
+    pushRateSample(iface, rx_bps, tx_bps);
+    
+    iface->rx = rx;
+    iface->tx = tx;
+    iface->time = nowMs;
+  });
+}
+
+bool fetchInterfaceStats() {
+  if (hotspot_mode || router_address.length() == 0) return false;
+  
+  bool fresh = false;
+  String q = "{\".proplist\": \".id,rx-bytes,tx-bytes,running\"}";
+  int code = routerPost(ROUTER_EP_INTERFACES, "/rest/interface/ethernet/print", q);
+  
+  if (code == 200) {
+    StreamString fallback;
+    uint32_t nowMs = millis();
+    unsigned long parse_start_us = micros();
+    fresh = (parseInterfaceReply(restReplyStream(fallback), nowMs) >= 0);
+    perfRecord(router_parse_hist[ROUTER_EP_INTERFACES], parse_start_us);
+  } else if (code > 0) {
+    Serial.printf("Interface fetch HTTP error: %d\n", code);
+  }
+  routerRequestEnd(code, fresh);
+  return fresh;
+}
+
+// Names come in their own request, so an element too long for the parse
+// document costs only its name, never an interface's counters
+int parseInterfaceNames(Stream& stream) {
+  StaticJsonDocument<48> filter;
+  filter[".id"] = true;
+  filter["name"] = true;
+  StaticJsonDocument<192> item;
+  
+  return parseRestArray(stream, item, filter, [](JsonObject o) {
+    rememberIfaceName(id2int(o[".id"] | ""), o["name"]);
+  });
+}
+
+// Names for /api/interfaces and the tiles. The scheduler runs it once a
+// minute for renames and right after a stats poll that found a new
+// interface. The API transport learns them when it subscribes.
+void fetchInterfaceNames() {
   if (hotspot_mode || router_address.length() == 0) return;
   
-  String url = router_address + "/rest/system/resource/print";
-  HTTPClient http;
-  http.setTimeout(5000);
-  http.begin(url);
-  http.setAuthorization(router_login.c_str(), router_password.c_str());
+  String q = "{\".proplist\": \".id,name\"}";
+  int code = routerPost(ROUTER_EP_IFACE_LIST, "/rest/interface/ethernet/print", q);
+  
+  bool parsed = false;
+  if (code == 200) {
+    StreamString fallback;
+    unsigned long parse_start_us = micros();
+    parsed = parseInterfaceNames(restReplyStream(fallback)) >= 0;
+    perfRecord(router_parse_hist[ROUTER_EP_IFACE_LIST], parse_start_us);
+  } else if (code > 0) {
+    Serial.printf("Interface names HTTP error: %d\n", code);
+  }
+  routerRequestEnd(code, parsed);
+  if (parsed) iface_names_stale = false;
+}
 
+int parseResourceReply(Stream& stream) {
+  StaticJsonDocument<96> filter;
+  filter["uptime"] = true;
+  filter["cpu-load"] = true;
+  filter["free-memory"] = true;
+  filter["total-memory"] = true;
+  StaticJsonDocument<256> item;
+  
+  return parseRestArray(stream, item, filter, [](JsonObject o) {
+    routerInfo.uptime = parseUptimeToSeconds(o["uptime"] | "0s");
+    routerInfo.cpuLoad = String(o["cpu-load"] | "0%").toFloat();
+    routerInfo.memoryFree = parseMemoryToBytes(o["free-memory"] | "0");
+    routerInfo.memoryTotal = parseMemoryToBytes(o["total-memory"] | "0");
+  });
+}
+
+void fetchRouterInfo() {
+  if (hotspot_mode || router_address.length() == 0) return;
+  
   StaticJsonDocument<128> q;
   JsonArray arr = q.createNestedArray(".proplist");
   arr.add("uptime");
@@ -740,255 +2652,2497 @@ void fetchRouterInfo() {
   String body;
   serializeJson(q, body);
 
-  http.addHeader("Content-Type", "application/json");
-  int code = http.POST(body);
+  int code = routerPost(ROUTER_EP_RESOURCE, "/rest/system/resource/print", body);
   
+  bool parsed = false;
   if (code == 200) {
-    String resp = http.getString();
-    DynamicJsonDocument doc(256);
-    DeserializationError error = deserializeJson(doc, resp);
-    
-    if (error) {
-      Serial.println("Router info parse error: " + String(error.c_str()));
-    } else if (doc.is<JsonArray>() && doc.size() > 0) {
-      JsonObject o = doc[0].as<JsonObject>();
-      routerInfo.uptime = parseUptimeToSeconds(o["uptime"] | "0s");
-      routerInfo.cpuLoad = String(o["cpu-load"] | "0%").toFloat();
-      routerInfo.memoryFree = parseMemoryToBytes(o["free-memory"] | "0");
-      routerInfo.memoryTotal = parseMemoryToBytes(o["total-memory"] | "0");
-    }
+    StreamString fallback;
+    unsigned long parse_start_us = micros();
+    parsed = parseResourceReply(restReplyStream(fallback)) >= 0;
+    perfRecord(router_parse_hist[ROUTER_EP_RESOURCE], parse_start_us);
   } else if (code > 0) {
     Serial.printf("Router info HTTP error: %d\n", code);
   }
-  http.end();
+  routerRequestEnd(code, parsed);
+}
+
+void applyRouterClock(const char* time_24hr, const char* date_mt) {
+  int hour = 0, minute = 0, second = 0;
+  sscanf(time_24hr, "%d:%d:%d", &hour, &minute, &second);
+  routerCurrentMinute = minute;
+  
+  int year, month, day;
+  if (parseRouterDate(date_mt, year, month, day)) {
+    uint32_t epoch = (uint32_t)daysFromCivil(year, month, day) * 86400UL + hour * 3600UL + minute * 60UL + second;
+    // The reply only has whole seconds; keep interpolating with millis()
+    // unless the router clock really moved
+    uint32_t now = routerNow();
+    if (now == 0 || epoch > now + 1 || epoch + 1 < now) {
+      router_epoch = epoch;
+      router_epoch_ms = millis();
+    }
+  }
+
+  const char* ampm = (hour >= 12) ? "PM" : "AM";
+  int display_hour = hour;
+  if (display_hour == 0) display_hour = 12;
+  else if (display_hour > 12) display_hour -= 12;
+
+  snprintf(routerTimeStr, sizeof(routerTimeStr), "%02d:%02d %s", display_hour, minute, ampm);
+  String formattedDate = convertDateFormat(date_mt);
+  strncpy(routerDateStr, formattedDate.c_str(), sizeof(routerDateStr) - 1);
+  routerDateStr[sizeof(routerDateStr) - 1] = '\0';
+}
+
+int parseClockReply(Stream& stream) {
+  StaticJsonDocument<48> filter;
+  filter["time"] = true;
+  filter["date"] = true;
+  StaticJsonDocument<128> item;
+  
+  return parseRestArray(stream, item, filter, [](JsonObject o) {
+    applyRouterClock(o["time"] | "00:00:00", o["date"] | "Jan/01/1970");
+  });
 }
 
 void fetchTimeFromRouter() {
   if (hotspot_mode || router_address.length() == 0) return;
   
-  String url = router_address + "/rest/system/clock/print";
-  HTTPClient http;
-  http.setTimeout(5000);
-  http.begin(url);
-  http.setAuthorization(router_login.c_str(), router_password.c_str());
-
   String q = "{\".proplist\": \"time,date\"}";
-  http.addHeader("Content-Type", "application/json");
-  int code = http.POST(q);
+  int code = routerPost(ROUTER_EP_CLOCK, "/rest/system/clock/print", q);
 
+  bool parsed = false;
   if (code == 200) {
-    String resp = http.getString();
-    DynamicJsonDocument doc(128);
-    DeserializationError error = deserializeJson(doc, resp);
-    
-    if (error) {
-      Serial.println("Time parse error: " + String(error.c_str()));
-    } else if (doc.is<JsonArray>() && doc.size() > 0) {
-      JsonObject o = doc[0].as<JsonObject>();
-      const char* time_24hr = o["time"] | "00:00:00";
-      const char* date_mt = o["date"] | "Jan/01/1970";
-
-      int hour = 0, minute = 0, second = 0;
-      sscanf(time_24hr, "%d:%d:%d", &hour, &minute, &second);
-      routerCurrentMinute = minute;
-
-      const char* ampm = (hour >= 12) ? "PM" : "AM";
-      int display_hour = hour;
-      if (display_hour == 0) display_hour = 12;
-      else if (display_hour > 12) display_hour -= 12;
-
-      snprintf(routerTimeStr, sizeof(routerTimeStr), "%02d:%02d %s", display_hour, minute, ampm);
-      String formattedDate = convertDateFormat(date_mt);
-      strncpy(routerDateStr, formattedDate.c_str(), sizeof(routerDateStr) - 1);
-      routerDateStr[sizeof(routerDateStr) - 1] = '\0';
-    }
+    StreamString fallback;
+    unsigned long parse_start_us = micros();
+    parsed = parseClockReply(restReplyStream(fallback)) >= 0;
+    perfRecord(router_parse_hist[ROUTER_EP_CLOCK], parse_start_us);
   } else if (code > 0) {
     Serial.printf("Time fetch HTTP error: %d\n", code);
   }
-  http.end();
+  routerRequestEnd(code, parsed);
 }
 
-// ==================== RX TOTALS FUNCTIONS ====================
+// ==================== CAPTURE & REPLAY ====================
 
-void loadRxTotals() {
-  if (!LittleFS.exists("/rx_totals.json")) {
-    Serial.println("No saved RX totals file found - starting fresh");
+// Called with the session lock held, from restReplyStream()
+void captureReply(router_endpoint_t ep, const String& body, uint32_t ms) {
+  uint32_t len = body.length();
+  if (len > 0xFFFF) {
+    capture_dropped++;
+    return;
+  }
+  if (capture_bytes + sizeof(capture_record_t) + len > CAPTURE_MAX_BYTES) {
+    Serial.printf("Capture full (%u bytes, %u replies), stopping\n", capture_bytes, capture_records);
+    captureStop();
     return;
   }
   
-  File file = LittleFS.open("/rx_totals.json", "r");
-  if (!file) {
-    Serial.println("Failed to open RX totals file");
+  capture_record_t rec;
+  rec.ms = ms;
+  rec.ep = ep;
+  rec.reserved = 0;
+  rec.len = len;
+  
+  if (capture_file.write((const uint8_t*)&rec, sizeof(rec)) != sizeof(rec) ||
+      capture_file.write((const uint8_t*)body.c_str(), len) != len) {
+    Serial.println("ERROR: Capture write failed, stopping");
+    captureStop();
     return;
   }
+  capture_file.flush();
+  capture_bytes += sizeof(rec) + len;
+  capture_records++;
+}
+
+bool captureStart() {
+  captureStop();
+  LittleFS.remove(CAPTURE_PATH);
+  capture_file = LittleFS.open(CAPTURE_PATH, "w");
+  if (!capture_file || capture_file.write((const uint8_t*)CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC)) != sizeof(CAPTURE_MAGIC)) {
+    Serial.println("ERROR: Failed to create " CAPTURE_PATH);
+    if (capture_file) capture_file.close();
+    return false;
+  }
   
-  Serial.println("Loading RX totals from file...");
-  StaticJsonDocument<256> doc;
-  DeserializationError error = deserializeJson(doc, file);
-  file.close();
+  capture_bytes = sizeof(CAPTURE_MAGIC);
+  capture_records = 0;
+  capture_dropped = 0;
+  capture_active = true;
+  Serial.println("✓ Capturing router replies to " CAPTURE_PATH);
+  if (router_transport != ROUTER_TRANSPORT_REST) {
+    Serial.println("⚠ Only REST replies are captured - switch the router connection to REST");
+  }
+  return true;
+}
+
+void captureStop() {
+  if (!capture_active) return;
+  capture_active = false;
+  capture_file.close();
+  Serial.printf("Capture stopped: %u replies, %u bytes\n", capture_records, capture_bytes);
+}
+
+// Feeds a capture back through the same parsers, rate computation and
+// totals as live polling, using the recorded timestamps, as fast as the
+// parser allows. The replay gets an interface table of its own; the live
+// one, totals, router info and clock are put back afterwards untouched.
+void replayCapture() {
+  File f = LittleFS.open(CAPTURE_PATH, "r");
+  char magic[sizeof(CAPTURE_MAGIC)];
+  if (!f || f.read((uint8_t*)magic, sizeof(magic)) != sizeof(magic) ||
+      memcmp(magic, CAPTURE_MAGIC, sizeof(magic)) != 0) {
+    Serial.println("ERROR: No valid capture to replay");
+    if (f) f.close();
+    return;
+  }
   
-  if (error) {
-    Serial.println("RX totals parse error: " + String(error.c_str()));
+  iface_entry_t* live_table = iface_table;
+  int16_t* live_index = iface_index;
+  iface_ring_t* live_rings = iface_rings;
+  int live_count = iface_count;
+  int live_rings_used = iface_rings_used;
+  iface_count = 0;
+  iface_rings_used = 0;
+  if (!initIfaceTable()) {
+    Serial.println("ERROR: No memory for a replay interface table");
+    iface_table = live_table;
+    iface_index = live_index;
+    iface_rings = live_rings;
+    iface_count = live_count;
+    iface_rings_used = live_rings_used;
+    f.close();
     return;
   }
   
-  uint64_t loaded_hour = doc["rx_hour"] | 0;
-  uint64_t loaded_day = doc["rx_day"] | 0;
-  uint64_t loaded_week = doc["rx_week"] | 0;
-  uint64_t loaded_month = doc["rx_month"] | 0;
-  unsigned long loaded_hour_start = doc["hour_start"] | 0;
-  unsigned long loaded_day_start = doc["day_start"] | 0;
-  unsigned long loaded_week_start = doc["week_start"] | 0;
-  unsigned long loaded_month_start = doc["month_start"] | 0;
-  uint64_t loaded_hour_bytes = doc["hour_bytes"] | 0;
-  uint64_t loaded_day_bytes = doc["day_bytes"] | 0;
-  uint64_t loaded_week_bytes = doc["week_bytes"] | 0;
-  uint64_t loaded_month_bytes = doc["month_bytes"] | 0;
-  
-  bool data_valid = true;
-  
-  if (loaded_hour > 0 && loaded_hour == loaded_week && loaded_hour == loaded_month) {
-    Serial.println("WARNING: Identical values detected - data likely corrupt");
-    data_valid = false;
-  }
-  
-  if (loaded_hour_start == loaded_day_start &&
-      loaded_day_start == loaded_week_start &&
-      loaded_week_start == loaded_month_start &&
-      loaded_hour_start != 0) {
-    Serial.println("WARNING: All start times identical - improper initialization");
-    data_valid = false;
-  }
-  
-  unsigned long current_millis = millis();
-  const unsigned long MAX_REASONABLE_TIME = 4200000000UL;
-  
-  if (loaded_hour_start > current_millis && loaded_hour_start < MAX_REASONABLE_TIME) {
-    Serial.println("WARNING: Saved times in future - device was reset");
-    data_valid = false;
-  }
-  
-  if (data_valid) {
-    rx_totals.rx_hour = loaded_hour;
-    rx_totals.rx_day = loaded_day;
-    rx_totals.rx_week = loaded_week;
-    rx_totals.rx_month = loaded_month;
-    hour_start_time = loaded_hour_start;
-    day_start_time = loaded_day_start;
-    week_start_time = loaded_week_start;
-    month_start_time = loaded_month_start;
-    hour_start_bytes = loaded_hour_bytes;
-    day_start_bytes = loaded_day_bytes;
-    week_start_bytes = loaded_week_bytes;
-    month_start_bytes = loaded_month_bytes;
-    
-    Serial.println("✓ Loaded data passed validation");
-  } else {
-    Serial.println("✗ Validation failed - resetting totals");
-    resetRxTotals();
+  Serial.println("Replaying " CAPTURE_PATH "...");
+  replay_running = true;
+  
+  usage_totals_t saved_totals = usage_totals;
+  int saved_usage_iface = usage_iface;
+  uint64_t saved_last[2] = { usage_last_rx, usage_last_tx };
+  uint64_t saved_pending[2] = { usage_pending_rx, usage_pending_tx };
+  uint32_t saved_usage_time = usage_last_time;
+  uint32_t saved_epoch[2] = { router_epoch, router_epoch_ms };
+  router_info_t saved_info = routerInfo;
+  char saved_time[sizeof(routerTimeStr)], saved_date[sizeof(routerDateStr)];
+  memcpy(saved_time, routerTimeStr, sizeof(saved_time));
+  memcpy(saved_date, routerDateStr, sizeof(saved_date));
+  int saved_minute = routerCurrentMinute;
+  
+  // Count from the first replayed reply, in the periods of the replayed clock
+  memset(&usage_totals, 0, sizeof(usage_totals));
+  usage_iface = 0;
+  usage_pending_rx = 0;
+  usage_pending_tx = 0;
+  
+  replay_result_t r;
+  memset(&r, 0, sizeof(r));
+  uint32_t rejections_before = rate_rejections;
+  uint32_t first_ms = 0, last_ms = 0;
+  unsigned long start = millis();
+  uint8_t chunk[256];
+  
+  // Run the counter replies through the scheduler as if the display were on:
+  // a reply counts as polled once its interval has passed, and every reply's
+  // time is a moment the screen could be showing the last polled counters
+  uint32_t sim_interval = POLL_INTERVAL_MS;
+  uint32_t sim_next_due = 0, sim_polled_ms = 0, sim_kbps = 0;
+  uint64_t sim_age_sum = 0;
+  capture_record_t rec;
+  
+  while (f.read((uint8_t*)&rec, sizeof(rec)) == sizeof(rec)) {
+    StreamString body;
+    body.reserve(rec.len);
+    uint32_t left = rec.len;
+    while (left > 0) {
+      size_t n = f.read(chunk, min(left, (uint32_t)sizeof(chunk)));
+      if (n == 0) break;
+      body.write(chunk, n);
+      left -= n;
+    }
+    if (left > 0) {
+      r.errors++;       // truncated last record
+      break;
+    }
+    
+    if (r.records == 0) first_ms = rec.ms;
+    last_ms = rec.ms;
+    
+    int items = -1;
+    switch (rec.ep) {
+      case ROUTER_EP_INTERFACES: {
+        items = parseInterfaceReply(body, rec.ms);
+        iface_entry_t* iface = findIface(graph_interface_id);
+        if (iface && items >= 0) {
+          updateUsage(iface->rx, iface->tx, routerNow());
+        }
+        
+        if (r.counter_replies++ == 0 || (int32_t)(rec.ms - sim_next_due) >= 0) {
+          uint32_t kbps = iface ? iface->last_rx_kbps + iface->last_tx_kbps : 0;
+          sim_interval = schedCounterInterval(sim_interval, sim_kbps, kbps);
+          sim_kbps = kbps;
+          sim_next_due = rec.ms + sim_interval;
+          sim_polled_ms = rec.ms;
+          r.sched_polls++;
+        }
+        uint32_t age = rec.ms - sim_polled_ms;
+        sim_age_sum += age;
+        r.freshness_max_ms = max(r.freshness_max_ms, age);
+        break;
+      }
+      case ROUTER_EP_RESOURCE:
+        items = parseResourceReply(body);
+        break;
+      case ROUTER_EP_CLOCK:
+        items = parseClockReply(body);
+        break;
+    }
+    if (items < 0) r.errors++;
+    r.records++;
+    
+    // Let the idle task run so the task watchdog stays quiet on long captures
+    if ((r.records & 63) == 0) vTaskDelay(1);
+  }
+  f.close();
+  
+  iface_entry_t* iface = findIface(graph_interface_id);
+  r.valid = true;
+  r.elapsed_ms = millis() - start;
+  r.span_ms = last_ms - first_ms;
+  r.samples = iface ? iface->samples : 0;
+  r.rejections = rate_rejections - rejections_before;
+  r.totals = usage_totals;
+  if (r.counter_replies > 0) r.freshness_avg_ms = sim_age_sum / r.counter_replies;
+  if (r.span_ms > 0) {
+    uint64_t span = r.span_ms;
+    uint64_t sched = r.sched_polls +
+                     span / POLL_SCHED_DEFS[ROUTER_EP_RESOURCE].min_ms +
+                     span / POLL_SCHED_DEFS[ROUTER_EP_CLOCK].min_ms +
+                     span / POLL_SCHED_DEFS[ROUTER_EP_IFACE_LIST].min_ms;
+    r.captured_per_hour = (uint64_t)r.records * 3600000 / span;
+    r.sched_per_hour = sched * 3600000 / span;
+  }
+  replay_result = r;
+  
+  usage_totals = saved_totals;
+  usage_iface = saved_usage_iface;
+  usage_last_rx = saved_last[0];
+  usage_last_tx = saved_last[1];
+  usage_pending_rx = saved_pending[0];
+  usage_pending_tx = saved_pending[1];
+  usage_last_time = saved_usage_time;
+  router_epoch = saved_epoch[0];
+  router_epoch_ms = saved_epoch[1];
+  routerInfo = saved_info;
+  memcpy(routerTimeStr, saved_time, sizeof(saved_time));
+  memcpy(routerDateStr, saved_date, sizeof(saved_date));
+  routerCurrentMinute = saved_minute;
+  
+  free(iface_table);
+  free(iface_index);
+  free(iface_rings);
+  iface_table = live_table;
+  iface_index = live_index;
+  iface_rings = live_rings;
+  iface_count = live_count;
+  iface_rings_used = live_rings_used;
+  replay_running = false;
+  
+  Serial.printf("✓ Replay: %u replies (%u errors) covering %u s in %u ms, %u samples, %u rejected rates\n",
+                r.records, r.errors, r.span_ms / 1000, r.elapsed_ms, r.samples, r.rejections);
+  Serial.printf("  Replay totals: 1H %llu, Day %llu, Wk %llu, Mo %llu RX bytes\n",
+                (unsigned long long)r.totals.period[USAGE_HOUR].rx, (unsigned long long)r.totals.period[USAGE_DAY].rx,
+                (unsigned long long)r.totals.period[USAGE_WEEK].rx, (unsigned long long)r.totals.period[USAGE_MONTH].rx);
+  Serial.printf("  Replay schedule: %u of %u counter replies polled, %u req/h (captured %u req/h), counters shown %u ms old on average, %u ms at most\n",
+                r.sched_polls, r.counter_replies, r.sched_per_hour, r.captured_per_hour,
+                r.freshness_avg_ms, r.freshness_max_ms);
+}
+
+// Applies commands from the web handlers; runs on the poller task, which
+// owns the capture file
+void captureService() {
+  capture_cmd_t cmd = capture_cmd;
+  if (cmd == CAPTURE_CMD_NONE) return;
+  capture_cmd = CAPTURE_CMD_NONE;
+  
+  switch (cmd) {
+    case CAPTURE_CMD_START:
+      captureStart();
+      break;
+    case CAPTURE_CMD_STOP:
+      captureStop();
+      break;
+    case CAPTURE_CMD_REPLAY:
+      captureStop();
+      replayCapture();
+      break;
+    default:
+      break;
+  }
+}
+
+// ==================== ROUTEROS API CLIENT ====================
+
+String routerHost() {
+  String host = router_address;
+  int scheme = host.indexOf("://");
+  if (scheme >= 0) host = host.substring(scheme + 3);
+  int slash = host.indexOf('/');
+  if (slash >= 0) host = host.substring(0, slash);
+  int colon = host.indexOf(':');
+  if (colon >= 0) host = host.substring(0, colon);
+  return host;
+}
+
+size_t apiEncodeLength(uint32_t len, uint8_t* out) {
+  if (len < 0x80) {
+    out[0] = len;
+    return 1;
+  } else if (len < 0x4000) {
+    len |= 0x8000;
+    out[0] = len >> 8; out[1] = len;
+    return 2;
+  } else if (len < 0x200000) {
+    len |= 0xC00000;
+    out[0] = len >> 16; out[1] = len >> 8; out[2] = len;
+    return 3;
+  } else if (len < 0x10000000) {
+    len |= 0xE0000000;
+    out[0] = len >> 24; out[1] = len >> 16; out[2] = len >> 8; out[3] = len;
+    return 4;
   }
+  out[0] = 0xF0;
+  out[1] = len >> 24; out[2] = len >> 16; out[3] = len >> 8; out[4] = len;
+  return 5;
 }
 
-void resetRxTotals() {
-  Serial.println("!!! RESETTING ALL RX TOTALS !!!");
-  rx_totals.rx_hour = 0;
-  rx_totals.rx_day = 0;
-  rx_totals.rx_week = 0;
-  rx_totals.rx_month = 0;
-  hour_start_time = 0;
-  day_start_time = 0;
-  week_start_time = 0;
-  month_start_time = 0;
-  hour_start_bytes = 0;
-  day_start_bytes = 0;
-  week_start_bytes = 0;
-  month_start_bytes = 0;
+bool apiSend(const char* const* words, int count) {
+  if (!api_client) return false;
   
-  if (LittleFS.exists("/rx_totals.json")) {
-    LittleFS.remove("/rx_totals.json");
-    Serial.println("Deleted saved totals file");
+  // Assemble the whole sentence first so it leaves in as few segments as possible
+  size_t n = 0;
+  for (int i = 0; i < count; i++) {
+    size_t len = strlen(words[i]);
+    if (n + len + 6 > sizeof(api_tx_buf)) {
+      Serial.println("ERROR: RouterOS API sentence too long");
+      return false;
+    }
+    n += apiEncodeLength(len, api_tx_buf + n);
+    memcpy(api_tx_buf + n, words[i], len);
+    n += len;
   }
+  api_tx_buf[n++] = 0;
   
-  saveRxTotals();
-  Serial.println("Reset complete");
+  return api_client->write(api_tx_buf, n) == n;
 }
 
-void saveRxTotals() {
-  StaticJsonDocument<256> doc;
-  doc["rx_hour"] = rx_totals.rx_hour;
-  doc["rx_day"] = rx_totals.rx_day;
-  doc["rx_week"] = rx_totals.rx_week;
-  doc["rx_month"] = rx_totals.rx_month;
-  doc["hour_start"] = hour_start_time;
-  doc["day_start"] = day_start_time;
-  doc["week_start"] = week_start_time;
-  doc["month_start"] = month_start_time;
-  doc["hour_bytes"] = hour_start_bytes;
-  doc["day_bytes"] = day_start_bytes;
-  doc["week_bytes"] = week_start_bytes;
-  doc["month_bytes"] = month_start_bytes;
-
-  File file = LittleFS.open("/rx_totals.json", "w");
-  if (file) {
-    serializeJson(doc, file);
-    file.close();
+bool apiReadBytes(uint8_t* buf, size_t len) {
+  return api_client->readBytes(buf, len) == len;
+}
+
+bool apiReadLength(uint32_t& len) {
+  uint8_t b[4];
+  if (!apiReadBytes(b, 1)) return false;
+  
+  if ((b[0] & 0x80) == 0x00) {
+    len = b[0];
+  } else if ((b[0] & 0xC0) == 0x80) {
+    if (!apiReadBytes(b + 1, 1)) return false;
+    len = ((b[0] & 0x3F) << 8) | b[1];
+  } else if ((b[0] & 0xE0) == 0xC0) {
+    if (!apiReadBytes(b + 1, 2)) return false;
+    len = ((uint32_t)(b[0] & 0x1F) << 16) | (b[1] << 8) | b[2];
+  } else if ((b[0] & 0xF0) == 0xE0) {
+    if (!apiReadBytes(b + 1, 3)) return false;
+    len = ((uint32_t)(b[0] & 0x0F) << 24) | ((uint32_t)b[1] << 16) | (b[2] << 8) | b[3];
+  } else if (b[0] == 0xF0) {
+    if (!apiReadBytes(b, 4)) return false;
+    len = ((uint32_t)b[0] << 24) | ((uint32_t)b[1] << 16) | (b[2] << 8) | b[3];
   } else {
-    Serial.println("ERROR: Failed to save RX totals");
-  }
-}
-
-void updateRxTotals(uint64_t current_rx_bytes) {
-  unsigned long now = millis();
-  
-  if (hour_start_time == 0) {
-    Serial.println("=== INITIALIZING RX TOTALS ===");
-    hour_start_time = now;
-    day_start_time = now;
-    week_start_time = now;
-    month_start_time = now;
-    hour_start_bytes = current_rx_bytes;
-    day_start_bytes = current_rx_bytes;
-    week_start_bytes = current_rx_bytes;
-    month_start_bytes = current_rx_bytes;
-    rx_totals.rx_hour = 0;
-    rx_totals.rx_day = 0;
-    rx_totals.rx_week = 0;
-    rx_totals.rx_month = 0;
-    return;
+    return false;  // reserved control byte
   }
+  return true;
+}
 
-  rx_totals.rx_hour = (current_rx_bytes >= hour_start_bytes) ? current_rx_bytes - hour_start_bytes : 0;
-  rx_totals.rx_day = (current_rx_bytes >= day_start_bytes) ? current_rx_bytes - day_start_bytes : 0;
-  rx_totals.rx_week = (current_rx_bytes >= week_start_bytes) ? current_rx_bytes - week_start_bytes : 0;
-  rx_totals.rx_month = (current_rx_bytes >= month_start_bytes) ? current_rx_bytes - month_start_bytes : 0;
-
-  const unsigned long MS_PER_HOUR = 3600000UL;
-  const unsigned long MS_PER_DAY = 86400000UL;
-  const unsigned long MS_PER_WEEK = 604800000UL;
-  const unsigned long MS_PER_MONTH = 2592000000UL;
+// Reads one sentence into a fixed buffer. Words that don't fit are dropped.
+bool apiReadSentence(api_sentence_t& out) {
+  out.count = 0;
+  size_t used = 0;
+  
+  for (;;) {
+    uint32_t len;
+    if (!apiReadLength(len)) return false;
+    if (len == 0) break;
+    
+    if (out.count < API_MAX_WORDS && used + len + 1 <= sizeof(out.buf)) {
+      char* word = out.buf + used;
+      if (!apiReadBytes((uint8_t*)word, len)) return false;
+      word[len] = '\0';
+      out.words[out.count++] = word;
+      used += len + 1;
+    } else {
+      uint8_t scratch[64];
+      while (len > 0) {
+        size_t chunk = min((size_t)len, sizeof(scratch));
+        if (!apiReadBytes(scratch, chunk)) return false;
+        len -= chunk;
+      }
+    }
+  }
+  
+  api_last_rx = millis();
+  return out.count > 0;
+}
 
-  if (now - hour_start_time >= MS_PER_HOUR) {
-    Serial.println(">>> Hour period reset");
-    hour_start_time = now;
-    hour_start_bytes = current_rx_bytes;
+const char* apiAttr(const api_sentence_t& s, const char* key) {
+  size_t klen = strlen(key);
+  for (int i = 1; i < s.count; i++) {
+    const char* w = s.words[i];
+    if (w[0] == '=' && strncmp(w + 1, key, klen) == 0 && w[klen + 1] == '=') {
+      return w + klen + 2;
+    }
   }
+  return nullptr;
+}
 
-  if (now - day_start_time >= MS_PER_DAY) {
-    Serial.println(">>> Day period reset");
-    day_start_time = now;
-    day_start_bytes = current_rx_bytes;
+const char* apiTag(const api_sentence_t& s) {
+  for (int i = 1; i < s.count; i++) {
+    if (strncmp(s.words[i], ".tag=", 5) == 0) return s.words[i] + 5;
   }
+  return "";
+}
 
-  if (now - week_start_time >= MS_PER_WEEK) {
-    Serial.println(">>> Week period reset");
-    week_start_time = now;
-    week_start_bytes = current_rx_bytes;
+// Reads untagged replies until !done; !re sentences are passed to onReply.
+// Returns false on I/O errors and when the router answered with !trap.
+bool apiCommand(const char* const* words, int count, void (*onReply)(const api_sentence_t&)) {
+  if (!apiSend(words, count)) return false;
+  
+  bool trapped = false;
+  for (;;) {
+    if (!apiReadSentence(api_sentence)) return false;
+    const char* type = api_sentence.words[0];
+    
+    if (strcmp(type, "!re") == 0) {
+      if (onReply) onReply(api_sentence);
+    } else if (strcmp(type, "!done") == 0) {
+      return !trapped;
+    } else if (strcmp(type, "!trap") == 0 || strcmp(type, "!fatal") == 0) {
+      const char* msg = apiAttr(api_sentence, "message");
+      Serial.printf("RouterOS API %s: %s\n", words[0], msg ? msg : type);
+      if (strcmp(type, "!fatal") == 0) return false;
+      trapped = true;  // a !trap is always followed by !done
+    }
   }
+}
 
-  if (now - month_start_time >= MS_PER_MONTH) {
-    Serial.println(">>> Month period reset");
-    month_start_time = now;
-    month_start_bytes = current_rx_bytes;
+void apiRememberIface(const api_sentence_t& s) {
+  rememberIfaceName(id2int(apiAttr(s, ".id")), apiAttr(s, "name"));
+}
+
+// api_ifaces doubles as the name cache behind /api/interfaces and the
+// multi-interface tiles, which the REST poll fills from its own replies
+void rememberIfaceName(int id, const char* name) {
+  if (id == 0 || !name) return;
+  
+  int i = 0;
+  while (i < api_iface_count && api_ifaces[i].id != id) i++;
+  if (i < api_iface_count && strcmp(api_ifaces[i].name, name) == 0) return;
+  if (i == api_iface_count && api_iface_count >= IFACE_NAMES_MAX) return;
+  
+  portENTER_CRITICAL(&iface_names_mux);
+  api_ifaces[i].id = id;
+  strncpy(api_ifaces[i].name, name, sizeof(api_ifaces[0].name) - 1);
+  api_ifaces[i].name[sizeof(api_ifaces[0].name) - 1] = '\0';
+  if (i == api_iface_count) api_iface_count++;
+  portEXIT_CRITICAL(&iface_names_mux);
+}
+
+const char* ifaceName(int id) {
+  for (int i = 0; i < api_iface_count; i++) {
+    if (api_ifaces[i].id == id) return api_ifaces[i].name;
+  }
+  return nullptr;
+}
+
+bool apiConnect() {
+  bool tls = (router_transport == ROUTER_TRANSPORT_API_SSL);
+  uint16_t port = router_api_port > 0 ? router_api_port : (tls ? 8729 : 8728);
+  String host = routerHost();
+  
+  if (tls) {
+    // RouterOS ships self-signed certificates
+    api_tls_client.setInsecure();
+    api_client = &api_tls_client;
+  } else {
+    api_client = &api_plain_client;
+  }
+  api_client->setTimeout(API_READ_TIMEOUT_MS);
+  
+  Serial.printf("Connecting to RouterOS API %s:%u%s\n", host.c_str(), port, tls ? " (TLS)" : "");
+  if (!api_client->connect(host.c_str(), port)) {
+    Serial.println("✗ RouterOS API connect failed");
+    return false;
+  }
+  
+  // Post-6.43 login: plain credentials in one sentence
+  String name = "=name=" + router_login;
+  String pass = "=password=" + router_password;
+  const char* login[] = {"/login", name.c_str(), pass.c_str()};
+  if (!apiCommand(login, 3, nullptr)) {
+    Serial.println("✗ RouterOS API login failed");
+    return false;
+  }
+  
+  // Interfaces that appear later are picked up on the next reconnect
+  portENTER_CRITICAL(&iface_names_mux);
+  api_iface_count = 0;
+  portEXIT_CRITICAL(&iface_names_mux);
+  const char* list[] = {"/interface/ethernet/print", "=.proplist=.id,name"};
+  if (!apiCommand(list, 2, apiRememberIface)) return false;
+  
+  char counterInterval[24], resourceInterval[24], clockInterval[24];
+  snprintf(counterInterval, sizeof(counterInterval), "=interval=%d", API_COUNTER_INTERVAL_S);
+  snprintf(resourceInterval, sizeof(resourceInterval), "=interval=%d", API_RESOURCE_INTERVAL_S);
+  snprintf(clockInterval, sizeof(clockInterval), "=interval=%d", API_CLOCK_INTERVAL_S);
+  
+  const char* counters[] = {"/interface/ethernet/print", "=.proplist=.id,rx-bytes,tx-bytes",
+                            counterInterval, ".tag=c"};
+  const char* resource[] = {"/system/resource/print", "=.proplist=uptime,cpu-load,free-memory,total-memory",
+                            resourceInterval, ".tag=r"};
+  const char* clock[] = {"/system/clock/print", "=.proplist=time,date", clockInterval, ".tag=t"};
+  if (!apiSend(counters, 4) || !apiSend(resource, 4) || !apiSend(clock, 4)) return false;
+  
+  if (api_iface_count > 0) {
+    // The graphed interface goes first so it is never the one left out
+    String names = "=interface=";
+    const char* graphed = ifaceName(graph_interface_id);
+    int listed = 0;
+    if (graphed) {
+      names += graphed;
+      listed++;
+    }
+    for (int i = 0; i < api_iface_count && listed < API_MAX_IFACES; i++) {
+      if (api_ifaces[i].id == graph_interface_id) continue;
+      if (listed > 0) names += ",";
+      names += api_ifaces[i].name;
+      listed++;
+    }
+    if (listed < api_iface_count) {
+      Serial.printf("⚠ monitor-traffic limited to %d of %d interfaces\n", listed, api_iface_count);
+    }
+    const char* monitor[] = {"/interface/monitor-traffic", names.c_str(),
+                             "=.proplist=name,rx-bits-per-second,tx-bits-per-second", ".tag=m"};
+    if (!apiSend(monitor, 4)) return false;
+  }
+  
+  Serial.printf("✓ RouterOS API subscribed (%d interfaces)\n", api_iface_count);
+  api_last_rx = millis();
+  return true;
+}
+
+void apiDisconnect() {
+  if (api_client) api_client->stop();
+  api_ready = false;
+}
+
+void apiHandleSentence(const api_sentence_t& s) {
+  const char* type = s.words[0];
+  const char* tag = apiTag(s);
+  
+  if (strcmp(type, "!trap") == 0) {
+    const char* msg = apiAttr(s, "message");
+    Serial.printf("RouterOS API trap (tag %s): %s\n", tag, msg ? msg : "");
+    return;
+  }
+  if (strcmp(type, "!fatal") == 0) {
+    Serial.println("RouterOS API fatal - reconnecting");
+    apiDisconnect();
+    return;
+  }
+  if (strcmp(type, "!re") != 0) return;
+  
+  uint32_t nowMs = millis();
+  
+  if (strcmp(tag, "m") == 0) {
+    const char* name = apiAttr(s, "name");
+    if (!name) return;
+    for (int i = 0; i < api_iface_count; i++) {
+      if (strcmp(api_ifaces[i].name, name) != 0) continue;
+      
+      iface_entry_t* iface = findIface(api_ifaces[i].id);
+      if (!iface) iface = addIface(api_ifaces[i].id, 0, 0, nowMs);
+      if (!iface) return;
+      
+      // Router-side rates are already averaged, so no extra smoothing here
+      const char* rx = apiAttr(s, "rx-bits-per-second");
+      const char* tx = apiAttr(s, "tx-bits-per-second");
+      pushRateSample(iface, rx ? (uint64_t)atoll(rx) : 0, tx ? (uint64_t)atoll(tx) : 0);
+      return;
+    }
+  } else if (strcmp(tag, "c") == 0) {
+    int id = id2int(apiAttr(s, ".id"));
+    if (id == 0) return;
+    uint64_t rx = (uint64_t)atoll(apiAttr(s, "rx-bytes") ? apiAttr(s, "rx-bytes") : "0");
+    uint64_t tx = (uint64_t)atoll(apiAttr(s, "tx-bytes") ? apiAttr(s, "tx-bytes") : "0");
+    
+    iface_entry_t* iface = findIface(id);
+    if (!iface) iface = addIface(id, rx, tx, nowMs);
+    if (!iface) return;
+    iface->rx = rx;
+    iface->tx = tx;
+    iface->time = nowMs;
+    
+    if (id == graph_interface_id) {
+      updateUsage(rx, tx, routerNow());
+    }
+  } else if (strcmp(tag, "r") == 0) {
+    const char* v;
+    if ((v = apiAttr(s, "uptime"))) routerInfo.uptime = parseUptimeToSeconds(v);
+    if ((v = apiAttr(s, "cpu-load"))) routerInfo.cpuLoad = atof(v);
+    if ((v = apiAttr(s, "free-memory"))) routerInfo.memoryFree = parseMemoryToBytes(v);
+    if ((v = apiAttr(s, "total-memory"))) routerInfo.memoryTotal = parseMemoryToBytes(v);
+  } else if (strcmp(tag, "t") == 0) {
+    const char* t = apiAttr(s, "time");
+    const char* d = apiAttr(s, "date");
+    applyRouterClock(t ? t : "00:00:00", d ? d : "Jan/01/1970");
+  }
+}
+
+// Called from the poller task: keeps the subscriptions alive and drains
+// whatever the router pushed since the last cycle
+void apiPollCycle() {
+  if (hotspot_mode || router_address.length() == 0) return;
+  
+  if (!api_ready) {
+    if (api_retry_at != 0 && (long)(millis() - api_retry_at) < 0) return;
+    
+    api_ready = apiConnect();
+    if (!api_ready) {
+      apiDisconnect();
+      api_backoff_ms = (api_backoff_ms == 0) ? ROUTER_BACKOFF_MIN_MS
+                                             : min(api_backoff_ms * 2, ROUTER_BACKOFF_MAX_MS);
+      api_retry_at = millis() + api_backoff_ms;
+      return;
+    }
+    api_backoff_ms = 0;
+    api_retry_at = 0;
+  }
+  
+  while (api_ready && api_client->available() > 0) {
+    if (!apiReadSentence(api_sentence)) {
+      Serial.println("RouterOS API read failed - reconnecting");
+      apiDisconnect();
+      return;
+    }
+    apiHandleSentence(api_sentence);
+  }
+  
+  if (api_ready && (!api_client->connected() || millis() - api_last_rx > API_IDLE_TIMEOUT_MS)) {
+    Serial.println("RouterOS API connection lost - reconnecting");
+    apiDisconnect();
+  }
+}
+
+// ==================== USAGE ACCOUNTING ====================
+
+// Every poll adds the growth of the graphed interface's RX/TX counters to the
+// current hour, day, ISO week and calendar month, picked by the router clock.
+// Periods roll over at the router's top of the hour and local midnight, and
+// closed periods go to a small round-robin table in USAGE_PATH.
+//
+// Because the last counter values are persisted with the totals, bytes that
+// pass while the display is off or between two saves are still counted at
+// the first poll after boot (in the period that poll falls in).
+
+// Counter growth between two samples. RouterOS counters are 64-bit and
+// only go back when they are reset (router reboot, reset-counters), so the
+// new value is all that accrued since. A 32-bit counter near the top that
+// comes back small is taken as a wrap.
+uint64_t usageCounterDelta(uint64_t last, uint64_t now) {
+  if (now >= last) return now - last;
+  if (last >= 0xC0000000ULL && last <= 0xFFFFFFFFULL && now < 0x40000000ULL) {
+    usage_counter_wraps++;
+    return now + 0x100000000ULL - last;
+  }
+  usage_counter_resets++;
+  return now;
+}
+
+// Period numbers: hours and days since 1970, weeks since Monday 1969-12-29
+// (1970-01-01 was a Thursday) and months since year 0
+uint32_t usagePeriodKey(int period, uint32_t epoch) {
+  uint32_t days = epoch / 86400;
+  switch (period) {
+    case USAGE_HOUR: return epoch / 3600;
+    case USAGE_DAY: return days;
+    case USAGE_WEEK: return (days + 3) / 7;
+    default: {
+      int y, m, d;
+      civilFromDays(days, y, m, d);
+      return y * 12 + (m - 1);
+    }
+  }
+}
+
+void formatUsagePeriod(int period, uint32_t key, char* buf, size_t len) {
+  int y, m, d;
+  switch (period) {
+    case USAGE_HOUR:
+      civilFromDays(key / 24, y, m, d);
+      snprintf(buf, len, "%04d-%02d-%02d %02u:00", y, m, d, key % 24);
+      break;
+    case USAGE_DAY:
+      civilFromDays(key, y, m, d);
+      snprintf(buf, len, "%04d-%02d-%02d", y, m, d);
+      break;
+    case USAGE_WEEK: {
+      // The ISO week belongs to the year its Thursday is in
+      int32_t thursday = (int32_t)key * 7;
+      civilFromDays(thursday, y, m, d);
+      snprintf(buf, len, "%04d-W%02d", y, (thursday - daysFromCivil(y, 1, 1)) / 7 + 1);
+      break;
+    }
+    default:
+      snprintf(buf, len, "%04u-%02u", key / 12, key % 12 + 1);
+      break;
+  }
+}
+
+void addUsageEntry(JsonObject obj, int period, const usage_entry_t& entry) {
+  char label[24] = "";
+  if (entry.key != 0) formatUsagePeriod(period, entry.key, label, sizeof(label));
+  obj["period"] = label;
+  obj["rx"] = entry.rx;
+  obj["tx"] = entry.tx;
+}
+
+uint32_t usageSlotOffset(int period, uint32_t key) {
+  uint32_t offset = 0;
+  for (int p = 0; p < period; p++) {
+    offset += USAGE_HISTORY[p] * sizeof(usage_entry_t);
+  }
+  return offset + (key % USAGE_HISTORY[period]) * sizeof(usage_entry_t);
+}
+
+bool initUsageHistory() {
+  uint32_t size = 0;
+  for (int p = 0; p < USAGE_PERIODS; p++) {
+    size += USAGE_HISTORY[p] * sizeof(usage_entry_t);
+  }
+  File file = LittleFS.open(USAGE_PATH, "r");
+  if (file && file.size() == size) {
+    file.close();
+    return true;
+  }
+  if (file) file.close();
+  
+  file = LittleFS.open(USAGE_PATH, "w");
+  if (!file) {
+    Serial.println("ERROR: Failed to create " USAGE_PATH);
+    return false;
+  }
+  usage_entry_t empty;
+  memset(&empty, 0, sizeof(empty));
+  for (uint32_t written = 0; written < size; written += sizeof(empty)) {
+    file.write((const uint8_t*)&empty, sizeof(empty));
+  }
+  file.close();
+  Serial.printf("✓ Created " USAGE_PATH " (%u bytes)\n", size);
+  return true;
+}
+
+// One write per closed period: a few hundred bytes a day
+void archiveUsagePeriod(int period, const usage_entry_t& entry) {
+  if (replay_running) return;      // replayed periods aren't real
+  
+  File file = LittleFS.open(USAGE_PATH, "r+");
+  if (!file) {
+    Serial.println("ERROR: Failed to open " USAGE_PATH);
+    return;
+  }
+  if (file.seek(usageSlotOffset(period, entry.key))) {
+    file.write((const uint8_t*)&entry, sizeof(entry));
+  }
+  file.close();
+}
+
+// Called with the graphed interface's counters after each poll; now is
+// routerNow(), 0 while the router clock is unknown
+void updateUsage(uint64_t rx_bytes, uint64_t tx_bytes, uint32_t now) {
+  if (usage_iface != graph_interface_id) {
+    // First sample for this interface: only a baseline
+    usage_iface = graph_interface_id;
+    usage_last_rx = rx_bytes;
+    usage_last_tx = tx_bytes;
+    usage_last_time = now;
+    return;
+  }
+  
+  usage_pending_rx += usageCounterDelta(usage_last_rx, rx_bytes);
+  usage_pending_tx += usageCounterDelta(usage_last_tx, tx_bytes);
+  usage_last_rx = rx_bytes;
+  usage_last_tx = tx_bytes;
+  if (now == 0) {
+    usage_last_time = 0;
+    return;
+  }
+  
+  for (int p = 0; p < USAGE_PERIODS; p++) {
+    usage_entry_t& entry = usage_totals.period[p];
+    uint32_t key = usagePeriodKey(p, now);
+    
+    if (entry.key == 0) {
+      entry.key = key;            // imported or restored without a period
+    } else if (key > entry.key) {
+      archiveUsagePeriod(p, entry);
+      Serial.printf(">>> %s period closed: %llu RX, %llu TX bytes\n",
+                    USAGE_PERIOD_NAMES[p], (unsigned long long)entry.rx, (unsigned long long)entry.tx);
+      entry.key = key;
+      entry.rx = 0;
+      entry.tx = 0;
+    }
+    // A router clock that stepped back keeps counting into the current period
+    entry.rx += usage_pending_rx;
+    entry.tx += usage_pending_tx;
+  }
+  
+  billingAdd(usage_last_time, now, usage_pending_rx, usage_pending_tx);
+  usage_last_time = now;
+  usage_pending_rx = 0;
+  usage_pending_tx = 0;
+}
+
+// The accounting state is appended to /totals.jnl as fixed-size
+// CRC-protected records. LittleFS programs appends into the erased tail of
+// the file's last block, so a flush costs one record instead of a
+// whole-file rewrite, and blocks are only erased as the journal grows. When
+// it reaches TOTALS_JOURNAL_MAX_BYTES the latest record is written to a fresh
+// file that is renamed over the journal (an atomic replace on LittleFS),
+// which puts the next run of appends on other blocks.
+//
+// After a power cut the last record may be torn; loading takes the valid
+// record with the highest sequence number from both files.
+
+uint32_t journalCrc(const uint8_t* data, size_t len) {
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (int b = 0; b < 8; b++) {
+      crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+void fillTotalsRecord(totals_record_t& rec) {
+  memset(&rec, 0, sizeof(rec));
+  rec.magic = TOTALS_RECORD_MAGIC;
+  rec.seq = totals_seq;
+  rec.iface_id = usage_iface;
+  rec.last_rx = usage_last_rx;
+  rec.last_tx = usage_last_tx;
+  rec.totals = usage_totals;
+  rec.crc = journalCrc((const uint8_t*)&rec, offsetof(totals_record_t, crc));
+}
+
+void applyTotalsRecord(const totals_record_t& rec) {
+  usage_iface = rec.iface_id;
+  usage_last_rx = rec.last_rx;
+  usage_last_tx = rec.last_tx;
+  usage_totals = rec.totals;
+}
+
+bool totalsRecordValid(const totals_record_t& rec) {
+  return rec.magic == TOTALS_RECORD_MAGIC &&
+         rec.crc == journalCrc((const uint8_t*)&rec, offsetof(totals_record_t, crc));
+}
+
+// Returns the number of valid records; clean is false if anything after them
+// couldn't be read. Records are only ever appended, so scanning stops at the
+// first bad one: that is the torn tail.
+int scanTotalsJournal(const char* path, totals_record_t& best, bool& found, bool& clean) {
+  clean = true;
+  File file = LittleFS.open(path, "r");
+  if (!file) return 0;
+  
+  int valid = 0;
+  totals_record_t rec;
+  int got;
+  while ((got = file.read((uint8_t*)&rec, sizeof(rec))) == sizeof(rec)) {
+    if (!totalsRecordValid(rec)) {
+      clean = false;
+      break;
+    }
+    valid++;
+    if (!found || rec.seq > best.seq) {
+      best = rec;
+      found = true;
+    }
+  }
+  // A short read is a record cut off by the power failing mid-append
+  if (clean && got > 0) clean = false;
+  if (!clean) {
+    totals_bad_records++;
+    Serial.printf("⚠ %s: unreadable data after record %d, ignoring it\n", path, valid);
+  }
+  file.close();
+  return valid;
+}
+
+// One-time import of the JSON totals written by earlier firmware. They carry
+// no period, so they are counted into the periods of the first clocked poll.
+bool importRxTotalsJson() {
+  File file = LittleFS.open(TOTALS_LEGACY_PATH, "r");
+  if (!file) return false;
+  
+  StaticJsonDocument<256> doc;
+  DeserializationError error = deserializeJson(doc, file);
+  file.close();
+  LittleFS.remove(TOTALS_LEGACY_PATH);
+  
+  if (error) {
+    Serial.println("RX totals parse error: " + String(error.c_str()));
+    return false;
+  }
+  
+  usage_totals.period[USAGE_HOUR].rx = doc["rx_hour"] | 0;
+  usage_totals.period[USAGE_DAY].rx = doc["rx_day"] | 0;
+  usage_totals.period[USAGE_WEEK].rx = doc["rx_week"] | 0;
+  usage_totals.period[USAGE_MONTH].rx = doc["rx_month"] | 0;
+  Serial.println("✓ Imported RX totals from " TOTALS_LEGACY_PATH);
+  return true;
+}
+
+void loadUsageTotals() {
+  initUsageHistory();
+  
+  totals_record_t best;
+  bool found = false, clean, new_clean;
+  totals_records = scanTotalsJournal(TOTALS_JOURNAL_PATH, best, found, clean);
+  // Left behind if power failed during compaction, before the rename
+  scanTotalsJournal(TOTALS_JOURNAL_NEW_PATH, best, found, new_clean);
+  
+  // Appends after a torn record would never be read back: compact first
+  if (!clean) {
+    totals_records = TOTALS_JOURNAL_MAX_BYTES / sizeof(totals_record_t);
+  }
+  
+  if (found) {
+    applyTotalsRecord(best);
+    totals_seq = best.seq;
+    totals_last_record = best;
+    Serial.printf("✓ Loaded usage totals: record %u of %d in journal\n", best.seq, totals_records);
+    return;
+  }
+  
+  if (importRxTotalsJson()) {
+    saveUsageTotals();
+    return;
+  }
+  Serial.println("No saved usage totals found - starting fresh");
+}
+
+void resetUsageTotals() {
+  Serial.println("!!! RESETTING ALL USAGE TOTALS !!!");
+  memset(&usage_totals, 0, sizeof(usage_totals));
+  usage_iface = 0;
+  usage_pending_rx = 0;
+  usage_pending_tx = 0;
+  
+  LittleFS.remove(TOTALS_LEGACY_PATH);
+  LittleFS.remove(TOTALS_JOURNAL_NEW_PATH);
+  LittleFS.remove(TOTALS_JOURNAL_PATH);
+  LittleFS.remove(USAGE_PATH);
+  initUsageHistory();
+  totals_records = 0;
+  
+  saveUsageTotals();
+  Serial.println("Reset complete");
+}
+
+// Appends a record, or compacts the journal into one when it is full.
+// Nothing is written while the counters and totals stay the same.
+void saveUsageTotals() {
+  totals_record_t rec;
+  fillTotalsRecord(rec);
+  
+  if (totals_records > 0 &&
+      memcmp(&rec.iface_id, &totals_last_record.iface_id,
+             offsetof(totals_record_t, crc) - offsetof(totals_record_t, iface_id)) == 0) {
+    return;
+  }
+  
+  totals_seq++;
+  fillTotalsRecord(rec);
+  
+  unsigned long write_start_us = micros();
+  bool compact = (totals_records + 1) * sizeof(rec) > TOTALS_JOURNAL_MAX_BYTES;
+  File file = LittleFS.open(compact ? TOTALS_JOURNAL_NEW_PATH : TOTALS_JOURNAL_PATH, compact ? "w" : "a");
+  if (!file) {
+    Serial.println("ERROR: Failed to save usage totals");
+    return;
+  }
+  bool ok = file.write((const uint8_t*)&rec, sizeof(rec)) == sizeof(rec);
+  file.close();
+  
+  if (ok && compact) {
+    ok = LittleFS.rename(TOTALS_JOURNAL_NEW_PATH, TOTALS_JOURNAL_PATH);
+    if (ok) {
+      totals_records = 0;
+      totals_compactions++;
+    }
+  }
+  if (!ok) {
+    Serial.println("ERROR: Failed to save usage totals");
+    return;
+  }
+  
+  totals_records++;
+  totals_last_record = rec;
+  perfRecord(flash_write_hist, write_start_us);
+}
+
+// ==================== BILLING PERCENTILES ====================
+
+int billingBucket(uint32_t kbps) {
+  if (kbps == 0) return 0;
+  static const float inv_log_gamma = 1.0f / logf(BILLING_GAMMA);
+  int b = 1 + (int)(logf((float)kbps) * inv_log_gamma);
+  return min(b, BILLING_BUCKETS - 1);
+}
+
+// Geometric middle of the bucket, so both edges are within half a step
+uint32_t billingBucketValue(int b) {
+  if (b == 0) return 0;
+  return (uint32_t)(powf(BILLING_GAMMA, b - 0.5f) + 0.5f);
+}
+
+// Nearest-rank quantile: the value at position ceil(q * n) of the sorted
+// samples, which drops the top 5% for q = 0.95
+uint32_t billingQuantile(const uint16_t* counts, uint32_t n, float q) {
+  if (n == 0) return 0;
+  uint32_t rank = (uint32_t)ceilf(q * n);
+  uint32_t seen = 0;
+  for (int b = 0; b < BILLING_BUCKETS; b++) {
+    seen += counts[b];
+    if (seen >= rank) return billingBucketValue(b);
+  }
+  return billingBucketValue(BILLING_BUCKETS - 1);
+}
+
+void billingReset(uint32_t month) {
+  memset(billing_rx_counts, 0, sizeof(billing_rx_counts));
+  memset(billing_tx_counts, 0, sizeof(billing_tx_counts));
+  memset(&billing_view, 0, sizeof(billing_view));
+  billing_view.month = month;
+}
+
+void billingObserve(const billing_sample_t& s) {
+  billing_rx_counts[billingBucket(s.rx_kbps)]++;
+  billing_tx_counts[billingBucket(s.tx_kbps)]++;
+  billing_view.samples++;
+  billing_view.rx_max = max(billing_view.rx_max, s.rx_kbps);
+  billing_view.tx_max = max(billing_view.tx_max, s.tx_kbps);
+}
+
+void billingRefreshView() {
+  billing_view.rx_p95 = billingQuantile(billing_rx_counts, billing_view.samples, 0.95f);
+  billing_view.rx_p99 = billingQuantile(billing_rx_counts, billing_view.samples, 0.99f);
+  billing_view.tx_p95 = billingQuantile(billing_tx_counts, billing_view.samples, 0.95f);
+  billing_view.tx_p99 = billingQuantile(billing_tx_counts, billing_view.samples, 0.99f);
+}
+
+// Rebuilds the sketch from this month's samples
+void loadBilling() {
+  File file = LittleFS.open(BILLING_PATH, "r");
+  if (!file) return;
+  
+  char magic[4];
+  uint32_t month = 0;
+  if (file.read((uint8_t*)magic, sizeof(magic)) != sizeof(magic) ||
+      memcmp(magic, BILLING_MAGIC, sizeof(magic)) != 0 ||
+      file.read((uint8_t*)&month, sizeof(month)) != sizeof(month)) {
+    file.close();
+    return;
+  }
+  
+  billingReset(month);
+  billing_sample_t s;
+  while (file.read((uint8_t*)&s, sizeof(s)) == sizeof(s)) {
+    billingObserve(s);
+  }
+  file.close();
+  billingRefreshView();
+  Serial.printf("✓ Billing: %u samples this month\n", billing_view.samples);
+}
+
+// Empties the sketch and starts BILLING_PATH over for a new month
+void billingStartMonth(uint32_t month) {
+  if (billing_view.month != 0) {
+    char label[16];
+    formatUsagePeriod(USAGE_MONTH, month, label, sizeof(label));
+    Serial.printf(">>> Billing month %s started (%u samples last month)\n", label, billing_view.samples);
+  }
+  billingReset(month);
+  
+  File file = LittleFS.open(BILLING_PATH, "w");
+  if (!file) {
+    Serial.println("ERROR: Failed to write " BILLING_PATH);
+    return;
+  }
+  file.write((const uint8_t*)BILLING_MAGIC, sizeof(BILLING_MAGIC));
+  file.write((const uint8_t*)&month, sizeof(month));
+  file.close();
+}
+
+void billingRecord(const billing_sample_t& s) {
+  uint32_t month = usagePeriodKey(USAGE_MONTH, s.slot * BILLING_SLOT_S);
+  if (month != billing_view.month) billingStartMonth(month);
+  
+  billingObserve(s);
+  billingRefreshView();
+  
+  File file = LittleFS.open(BILLING_PATH, "a");
+  if (!file) {
+    Serial.println("ERROR: Failed to write " BILLING_PATH);
+    return;
+  }
+  file.write((const uint8_t*)&s, sizeof(s));
+  file.close();
+}
+
+// Adds counter growth seen at now (the previous sample was at prev, 0 if
+// unknown) to the 5-minute slot. A slot is billed only if polling covered
+// all of it; its average rate is then one sample.
+void billingAdd(uint32_t prev, uint32_t now, uint64_t rx_bytes, uint64_t tx_bytes) {
+  if (replay_running) return;
+  
+  uint32_t slot = now / BILLING_SLOT_S;
+  bool continuous = prev != 0 && now >= prev && now - prev <= BILLING_MAX_GAP_S;
+  bool first = billing_slot == 0;
+  
+  if (slot != billing_slot) {
+    // A poll that straddles the boundary is split by time: the growth from
+    // before it belongs to the slot being closed, billed or not
+    uint32_t boundary = slot * BILLING_SLOT_S;
+    if (continuous && prev < boundary) {
+      uint64_t rx_before = rx_bytes * (boundary - prev) / (now - prev);
+      uint64_t tx_before = tx_bytes * (boundary - prev) / (now - prev);
+      billing_slot_rx += rx_before;
+      billing_slot_tx += tx_before;
+      rx_bytes -= rx_before;
+      tx_bytes -= tx_before;
+    }
+    
+    if (billing_slot != 0) {
+      if (billing_slot_complete && continuous && slot == billing_slot + 1) {
+        billing_sample_t s;
+        s.slot = billing_slot;
+        s.rx_kbps = (uint32_t)(billing_slot_rx * 8 / 1024 / BILLING_SLOT_S);
+        s.tx_kbps = (uint32_t)(billing_slot_tx * 8 / 1024 / BILLING_SLOT_S);
+        billingRecord(s);
+      } else {
+        billing_view.missed++;
+      }
+    }
+    billing_slot = slot;
+    billing_slot_rx = 0;
+    billing_slot_tx = 0;
+    billing_slot_complete = continuous && prev / BILLING_SLOT_S == slot - 1;
+  } else if (!continuous) {
+    billing_slot_complete = false;
+  }
+  
+  // loadBilling() runs before the router clock is known, so the stored month
+  // is checked on the first sample: one that ended while the device was off
+  // is not carried into this one. After that, only a new month resets.
+  uint32_t month = usagePeriodKey(USAGE_MONTH, now);
+  if (first ? month != billing_view.month : month > billing_view.month) {
+    billingStartMonth(month);
+  }
+  
+  billing_slot_rx += rx_bytes;
+  billing_slot_tx += tx_bytes;
+}
+
+// Exact nearest-rank quantiles of one direction from BILLING_PATH, for
+// checking the sketch. Needs 4 bytes of heap per sample.
+bool billingExact(bool tx, uint32_t& p95, uint32_t& p99, uint32_t& n) {
+  File file = LittleFS.open(BILLING_PATH, "r");
+  if (!file || file.size() < 8) {
+    if (file) file.close();
+    return false;
+  }
+  
+  n = (file.size() - 8) / sizeof(billing_sample_t);
+  uint32_t* values = (uint32_t*)malloc(max(n, (uint32_t)1) * sizeof(uint32_t));
+  if (!values) {
+    file.close();
+    return false;
+  }
+  
+  file.seek(8);
+  billing_sample_t s;
+  for (uint32_t i = 0; i < n && file.read((uint8_t*)&s, sizeof(s)) == sizeof(s); i++) {
+    values[i] = tx ? s.tx_kbps : s.rx_kbps;
+  }
+  file.close();
+  
+  std::sort(values, values + n);
+  p95 = n ? values[(uint32_t)ceilf(0.95f * n) - 1] : 0;
+  p99 = n ? values[(uint32_t)ceilf(0.99f * n) - 1] : 0;
+  free(values);
+  return true;
+}
+
+// Runs on the poller after the snapshot is published: computes the exact
+// quantiles if a web request asked for them since the last time
+void billingExactService() {
+  uint32_t job = billing_exact_job;
+  if (job == billing_exact_done) return;
+  
+  billing_exact_t e;
+  memset(&e, 0, sizeof(e));
+  unsigned long start_ms = millis();
+  uint32_t n_tx;
+  e.valid = billingExact(false, e.rx_p95, e.rx_p99, e.n) && billingExact(true, e.tx_p95, e.tx_p99, n_tx);
+  e.done = true;
+  e.month = billing_view.month;
+  e.samples = billing_view.samples;
+  e.ms = millis() - start_ms;
+  
+  portENTER_CRITICAL(&billing_exact_mux);
+  billing_exact = e;
+  portEXIT_CRITICAL(&billing_exact_mux);
+  billing_exact_done = job;
+}
+
+// ==================== TRAFFIC ARCHIVE ====================
+
+static rrd_accum_t rrd_accum[RRD_TIERS];
+static rrd_pending_t rrd_pending[RRD_PENDING_MAX];
+static int rrd_pending_count = 0;
+static int rrd_iface_id = 0;          // interface whose file is in use, 0 = none
+static int rrd_prev_iface_id = 0;     // graphed before it; its archive is kept
+static int rrd_failed_id = 0;         // open failed (flash full), retried at rrd_retry_at
+static unsigned long rrd_retry_at = 0;
+static uint32_t rrd_last_samples = 0;
+static unsigned long rrd_last_flush = 0;
+static uint32_t rrd_slots_written = 0;
+static perf_hist_t rrd_flush_hist;
+
+void rrdPath(int iface_id, char* buf, size_t len) {
+  snprintf(buf, len, "/rrd_%d.bin", iface_id);
+}
+
+void rrdSegmentPath(int iface_id, int tier, uint32_t seg, char* buf, size_t len) {
+  snprintf(buf, len, "/rrd_%d_%d_%u.bin", iface_id, tier, seg);
+}
+
+uint32_t rrdSlotIndex(int tier, uint32_t t) {
+  const rrd_tier_def_t& def = RRD_TIER_DEFS[tier];
+  return (t / def.step_s) % def.slots;
+}
+
+uint32_t rrdSegments(int tier) {
+  return (RRD_TIER_DEFS[tier].slots + RRD_SEG_SLOTS - 1) / RRD_SEG_SLOTS;
+}
+
+// The last segment of a tier holds what is left over
+uint32_t rrdSegmentSlots(int tier, uint32_t seg) {
+  return min((uint32_t)RRD_SEG_SLOTS, RRD_TIER_DEFS[tier].slots - seg * RRD_SEG_SLOTS);
+}
+
+// Header plus every segment, as the archive takes once all have been written
+uint32_t rrdFileSize() {
+  uint32_t size = sizeof(rrd_header_t);
+  for (int k = 0; k < RRD_TIERS; k++) {
+    size += RRD_TIER_DEFS[k].slots * sizeof(rrd_slot_t);
+  }
+  return size;
+}
+
+// Flash the archive takes with every segment written: one block each
+uint32_t rrdFlashBytes() {
+  uint32_t blocks = 1;
+  for (int k = 0; k < RRD_TIERS; k++) {
+    blocks += rrdSegments(k);
+  }
+  return blocks * RRD_FS_BLOCK;
+}
+
+uint32_t rrdFreeBytes() {
+  size_t total = LittleFS.totalBytes(), used = LittleFS.usedBytes();
+  return used < total ? total - used : 0;
+}
+
+void rrdRemove(int iface_id) {
+  char path[32];
+  for (int k = 0; k < RRD_TIERS; k++) {
+    for (uint32_t seg = 0; seg < rrdSegments(k); seg++) {
+      rrdSegmentPath(iface_id, k, seg, path, sizeof(path));
+      if (LittleFS.exists(path)) LittleFS.remove(path);
+    }
+  }
+  rrdPath(iface_id, path, sizeof(path));
+  if (LittleFS.exists(path)) LittleFS.remove(path);
+}
+
+// Reads up to n slots of a tier from ring index idx, stopping at the end of
+// its segment; slots of a segment never written read as empty. Returns the
+// number of slots in `out`.
+uint32_t rrdReadSlots(int iface_id, int tier, uint32_t idx, rrd_slot_t* out, uint32_t n) {
+  uint32_t seg = idx / RRD_SEG_SLOTS;
+  uint32_t first = idx % RRD_SEG_SLOTS;
+  n = min(n, rrdSegmentSlots(tier, seg) - first);
+  
+  char path[32];
+  rrdSegmentPath(iface_id, tier, seg, path, sizeof(path));
+  File f;
+  if (LittleFS.exists(path)) f = LittleFS.open(path, "r");
+  size_t got = 0;
+  if (f && f.seek(first * sizeof(rrd_slot_t))) {
+    got = f.read((uint8_t*)out, n * sizeof(rrd_slot_t)) / sizeof(rrd_slot_t);
+  }
+  if (f) f.close();
+  memset(out + got, 0, (n - got) * sizeof(rrd_slot_t));
+  return n;
+}
+
+// Deletes the archives of every interface but these two, so changing the
+// graphed interface doesn't leave 140 KB behind each time
+void rrdPrune(int keep_id, int keep_prev) {
+  const int MAX_STALE = 8;
+  int stale[MAX_STALE];
+  int count = 0;
+  
+  File root = LittleFS.open("/");
+  if (!root || !root.isDirectory()) return;
+  for (File f = root.openNextFile(); f && count < MAX_STALE; f = root.openNextFile()) {
+    const char* name = strrchr(f.path(), '/');
+    name = name ? name + 1 : f.path();
+    int id, tier;
+    unsigned seg;
+    char ext;
+    bool ours = sscanf(name, "rrd_%d_%d_%u.bi%c", &id, &tier, &seg, &ext) == 4 ||
+                sscanf(name, "rrd_%d.bi%c", &id, &ext) == 2;
+    if (!ours || id == keep_id || id == keep_prev) continue;
+    
+    int i = 0;
+    while (i < count && stale[i] != id) i++;
+    if (i == count) stale[count++] = id;
+  }
+  root.close();
+  
+  for (int i = 0; i < count; i++) {
+    rrdRemove(stale[i]);
+    Serial.printf("Removed stale traffic archive of interface %d\n", stale[i]);
+  }
+}
+
+// Opens the archive for an interface, writing its header (and dropping the
+// old segments, if the tier layout changed). Segments are created by the
+// first flush that reaches them; a new archive is only started if there is
+// room for all of them.
+bool rrdOpen(int iface_id) {
+  char path[24];
+  rrdPath(iface_id, path, sizeof(path));
+  rrdPrune(iface_id, rrd_prev_iface_id);
+  
+  rrd_header_t want;
+  memcpy(want.magic, RRD_MAGIC, sizeof(want.magic));
+  want.iface_id = iface_id;
+  memcpy(want.tiers, RRD_TIER_DEFS, sizeof(want.tiers));
+  
+  File f = LittleFS.open(path, "r");
+  if (f) {
+    rrd_header_t have;
+    bool ok = f.size() == sizeof(have) &&
+              f.read((uint8_t*)&have, sizeof(have)) == sizeof(have) &&
+              memcmp(&have, &want, sizeof(want)) == 0;
+    f.close();
+    if (ok) {
+      Serial.printf("✓ Traffic archive %s\n", path);
+      return true;
+    }
+    Serial.printf("Traffic archive %s has an old layout, recreating\n", path);
+    rrdRemove(iface_id);
+  }
+  
+  uint32_t need = rrdFlashBytes() + RRD_FS_RESERVE;
+  if (rrdFreeBytes() < need && rrd_prev_iface_id != 0 && rrd_prev_iface_id != iface_id) {
+    Serial.printf("Removing traffic archive of interface %d to make room\n", rrd_prev_iface_id);
+    rrdRemove(rrd_prev_iface_id);
+    rrd_prev_iface_id = 0;
+  }
+  if (rrdFreeBytes() < need) {
+    Serial.printf("ERROR: Not enough flash for %s (%u bytes needed, %u free)\n", path, need, rrdFreeBytes());
+    return false;
+  }
+  
+  f = LittleFS.open(path, "w");
+  bool ok = f && f.write((const uint8_t*)&want, sizeof(want)) == sizeof(want);
+  if (f) f.close();
+  if (!ok) {
+    Serial.printf("ERROR: Failed to create %s\n", path);
+    LittleFS.remove(path);
+    return false;
+  }
+  Serial.printf("✓ Created traffic archive %s (up to %u bytes)\n", path, rrdFileSize());
+  return true;
+}
+
+// Opens a segment for update, creating it zero-filled the first time.
+// Other files may have grown since rrdOpen() checked, so the reserve is
+// checked again for every new segment.
+File rrdOpenSegment(int tier, uint32_t seg) {
+  char path[32];
+  rrdSegmentPath(rrd_iface_id, tier, seg, path, sizeof(path));
+  if (LittleFS.exists(path)) return LittleFS.open(path, "r+");
+  if (rrdFreeBytes() < RRD_FS_BLOCK + RRD_FS_RESERVE) return File();
+  
+  File f = LittleFS.open(path, "w");
+  if (!f) return f;
+  uint8_t zeros[512];
+  memset(zeros, 0, sizeof(zeros));
+  uint32_t left = rrdSegmentSlots(tier, seg) * sizeof(rrd_slot_t);
+  bool ok = true;
+  while (ok && left > 0) {
+    size_t n = min(left, (uint32_t)sizeof(zeros));
+    ok = f.write(zeros, n) == n;
+    left -= n;
+  }
+  f.close();
+  if (!ok) {
+    LittleFS.remove(path);
+    return File();
+  }
+  return LittleFS.open(path, "r+");
+}
+
+// Writes the queued slots one segment at a time, so each segment file is
+// opened and committed once per flush
+void rrdFlush() {
+  if (rrd_pending_count == 0 || rrd_iface_id == 0) {
+    rrd_pending_count = 0;
+    return;
+  }
+  
+  unsigned long start_us = micros();
+  bool done[RRD_PENDING_MAX] = { false };
+  int dropped = 0;
+  
+  for (int i = 0; i < rrd_pending_count; i++) {
+    if (done[i]) continue;
+    const int tier = rrd_pending[i].tier;
+    const uint32_t seg = rrdSlotIndex(tier, rrd_pending[i].slot.t) / RRD_SEG_SLOTS;
+    File f = rrdOpenSegment(tier, seg);
+    
+    for (int j = i; j < rrd_pending_count; j++) {
+      const rrd_pending_t& p = rrd_pending[j];
+      uint32_t idx = rrdSlotIndex(p.tier, p.slot.t);
+      if (done[j] || p.tier != tier || idx / RRD_SEG_SLOTS != seg) continue;
+      done[j] = true;
+      if (f && f.seek((idx % RRD_SEG_SLOTS) * sizeof(rrd_slot_t)) &&
+          f.write((const uint8_t*)&p.slot, sizeof(p.slot)) == sizeof(p.slot)) {
+        rrd_slots_written++;
+      } else {
+        dropped++;
+      }
+    }
+    if (f) f.close();
+  }
+  
+  if (dropped > 0) {
+    Serial.printf("ERROR: Traffic archive %d: dropped %d slots\n", rrd_iface_id, dropped);
+  }
+  rrd_pending_count = 0;
+  perfRecord(rrd_flush_hist, start_us);
+}
+
+void rrdCloseSlot(int tier, const rrd_accum_t& acc) {
+  if (rrd_pending_count >= RRD_PENDING_MAX) {
+    rrdFlush();
+  }
+  
+  rrd_pending_t& p = rrd_pending[rrd_pending_count++];
+  p.tier = tier;
+  p.slot.t = acc.t;
+  p.slot.rx_min = acc.rx_min;
+  p.slot.rx_avg = (uint32_t)(acc.rx_sum / acc.count);
+  p.slot.rx_max = acc.rx_max;
+  p.slot.tx_min = acc.tx_min;
+  p.slot.tx_avg = (uint32_t)(acc.tx_sum / acc.count);
+  p.slot.tx_max = acc.tx_max;
+}
+
+void rrdAccumulate(rrd_accum_t& acc, uint32_t t, uint32_t rx_kbps, uint32_t tx_kbps) {
+  if (acc.count == 0) {
+    acc.t = t;
+    acc.rx_sum = 0;
+    acc.tx_sum = 0;
+    acc.rx_min = acc.rx_max = rx_kbps;
+    acc.tx_min = acc.tx_max = tx_kbps;
+  }
+  
+  acc.count++;
+  acc.rx_sum += rx_kbps;
+  acc.tx_sum += tx_kbps;
+  acc.rx_min = min(acc.rx_min, rx_kbps);
+  acc.rx_max = max(acc.rx_max, rx_kbps);
+  acc.tx_min = min(acc.tx_min, tx_kbps);
+  acc.tx_max = max(acc.tx_max, tx_kbps);
+}
+
+// Every tier consolidates the raw samples itself, so min and max are exact.
+// A rate is the average since the previous poll, so the slots an idle link's
+// longer interval skipped get it too; a gap longer than the idle interval
+// (router unreachable) stays empty.
+void rrdAddSample(uint32_t now, uint32_t rx_kbps, uint32_t tx_kbps) {
+  const uint32_t bridge_s = (POLL_SCHED_DEFS[ROUTER_EP_INTERFACES].max_ms + 999) / 1000;
+  for (int k = 0; k < RRD_TIERS; k++) {
+    rrd_accum_t& acc = rrd_accum[k];
+    const uint32_t step = RRD_TIER_DEFS[k].step_s;
+    uint32_t start = now - now % step;
+    
+    if (acc.count > 0 && acc.t != start) {
+      uint32_t skipped = acc.t + step;
+      rrdCloseSlot(k, acc);
+      acc.count = 0;
+      if (start - skipped <= bridge_s) {
+        for (; skipped < start; skipped += step) {
+          rrdAccumulate(acc, skipped, rx_kbps, tx_kbps);
+          rrdCloseSlot(k, acc);
+          acc.count = 0;
+        }
+      }
+    }
+    rrdAccumulate(acc, start, rx_kbps, tx_kbps);
+  }
+}
+
+// Runs on the poller after each cycle: feeds the newest rate sample of the
+// graphed interface into the archive and flushes closed slots once a minute
+void rrdService() {
+  uint32_t now = routerNow();
+  if (now == 0) return;      // no router clock yet
+  
+  if (graph_interface_id != rrd_iface_id) {
+    if (rrd_iface_id != 0) {
+      rrdFlush();
+      rrd_prev_iface_id = rrd_iface_id;
+    }
+    memset(rrd_accum, 0, sizeof(rrd_accum));
+    rrd_iface_id = 0;
+    if (graph_interface_id <= 0) return;
+    // A failed open is retried once a flush interval, not every poll
+    if (graph_interface_id == rrd_failed_id && (long)(millis() - rrd_retry_at) < 0) return;
+    if (!rrdOpen(graph_interface_id)) {
+      rrd_failed_id = graph_interface_id;
+      rrd_retry_at = millis() + RRD_FLUSH_INTERVAL_MS;
+      return;
+    }
+    rrd_failed_id = 0;
+    rrd_iface_id = graph_interface_id;
+    rrd_last_flush = millis();
+  }
+  
+  iface_entry_t* iface = findIface(rrd_iface_id);
+  if (iface && iface->samples != rrd_last_samples) {
+    rrd_last_samples = iface->samples;
+    rrdAddSample(now, iface->last_rx_kbps, iface->last_tx_kbps);
+  }
+  
+  if (millis() - rrd_last_flush >= RRD_FLUSH_INTERVAL_MS) {
+    rrdFlush();
+    rrd_last_flush = millis();
+  }
+}
+
+// ==================== HISTORY EXPORT ====================
+
+size_t exportVarint(uint64_t v, uint8_t* out) {
+  size_t n = 0;
+  while (v >= 0x80) {
+    out[n++] = (uint8_t)(v | 0x80);
+    v >>= 7;
+  }
+  out[n++] = (uint8_t)v;
+  return n;
+}
+
+// Binary rows: the key and then every field as the difference from the
+// previous row, zigzag-encoded and written as LEB128 varints. The key is
+// the slot number (time / step_s) for traffic and billing and the period
+// number for usage, so a steady series costs a few bytes per row.
+size_t exportBinaryRow(export_ctx_t& c, int64_t key, const int64_t* v, uint8_t* out) {
+  size_t n = 0;
+  for (int i = 0; i <= EXPORT_FIELD_COUNT[c.series]; i++) {
+    int64_t value = (i == 0) ? key : v[i - 1];
+    int64_t d = value - c.prev[i];
+    c.prev[i] = value;
+    n += exportVarint(((uint64_t)d << 1) ^ (uint64_t)(d >> 63), out + n);
+  }
+  return n;
+}
+
+size_t exportTextRow(export_ctx_t& c, uint32_t key, const int64_t* v, uint8_t* out, size_t cap) {
+  char* p = (char*)out;
+  char label[24];
+  if (c.series == EXPORT_USAGE) {
+    formatUsagePeriod(c.period, key, label, sizeof(label));
+  } else {
+    snprintf(label, sizeof(label), "%u", key);
+  }
+  
+  int n;
+  if (c.format == EXPORT_CSV) {
+    n = snprintf(p, cap, "%s", label);
+    for (int i = 0; i < EXPORT_FIELD_COUNT[c.series]; i++) {
+      n += snprintf(p + n, cap - n, ",%lld", (long long)v[i]);
+    }
+    n += snprintf(p + n, cap - n, "\n");
+  } else {
+    n = snprintf(p, cap, c.series == EXPORT_USAGE ? "{\"period\":\"%s\"" : "{\"t\":%s", label);
+    for (int i = 0; i < EXPORT_FIELD_COUNT[c.series]; i++) {
+      n += snprintf(p + n, cap - n, ",\"%s\":%lld", EXPORT_FIELDS[c.series][i], (long long)v[i]);
+    }
+    n += snprintf(p + n, cap - n, "}\n");
+  }
+  return min((size_t)n, cap - 1);
+}
+
+// Puts the next row (or the header) in c.row; returns its length, 0 at the end
+size_t exportNextRow(export_ctx_t& c) {
+  if (!c.header_done) {
+    c.header_done = true;
+    if (c.format == EXPORT_BIN) {
+      // char[4] "MTX1", uint8 series, uint8 fields, uint16 0, uint32 step_s
+      uint32_t step = c.series == EXPORT_TRAFFIC ? RRD_TIER_DEFS[c.tier].step_s :
+                      c.series == EXPORT_BILLING ? BILLING_SLOT_S : 0;
+      memcpy(c.row, "MTX1", 4);
+      c.row[4] = c.series;
+      c.row[5] = EXPORT_FIELD_COUNT[c.series];
+      c.row[6] = c.row[7] = 0;
+      memcpy(c.row + 8, &step, sizeof(step));
+      return 12;
+    }
+    if (c.format == EXPORT_CSV) {
+      int n = snprintf((char*)c.row, sizeof(c.row), "%s", c.series == EXPORT_USAGE ? "period" : "time");
+      for (int i = 0; i < EXPORT_FIELD_COUNT[c.series]; i++) {
+        n += snprintf((char*)c.row + n, sizeof(c.row) - n, ",%s", EXPORT_FIELDS[c.series][i]);
+      }
+      n += snprintf((char*)c.row + n, sizeof(c.row) - n, "\n");
+      return n;
+    }
+  }
+  
+  int64_t v[EXPORT_MAX_FIELDS];
+  uint32_t key;
+  
+  if (c.series == EXPORT_TRAFFIC) {
+    const uint32_t step = RRD_TIER_DEFS[c.tier].step_s;
+    const uint32_t slots = RRD_TIER_DEFS[c.tier].slots;
+    for (;;) {
+      if (c.block_pos >= c.block_len) {
+        if (c.t > c.to) return 0;
+        // Read ahead up to the end of the range or of the segment, whichever is first
+        uint32_t idx = rrdSlotIndex(c.tier, c.t);
+        uint32_t want = min((uint32_t)EXPORT_BLOCK_SLOTS, min((c.to - c.t) / step + 1, slots - idx));
+        c.block_len = rrdReadSlots(c.iface_id, c.tier, idx, c.block, want);
+        c.block_pos = 0;
+        if (c.block_len == 0) return 0;
+      }
+      const rrd_slot_t& slot = c.block[c.block_pos++];
+      uint32_t t = c.t;
+      c.t += step;
+      if (slot.t != t) continue;     // empty or left over from an older pass
+      key = t;
+      v[0] = slot.rx_min; v[1] = slot.rx_avg; v[2] = slot.rx_max;
+      v[3] = slot.tx_min; v[4] = slot.tx_avg; v[5] = slot.tx_max;
+      break;
+    }
+  } else if (c.series == EXPORT_USAGE) {
+    if (c.usage_pos >= c.usage_len) return 0;
+    const usage_entry_t& e = c.usage[c.usage_pos++];
+    key = e.key;
+    v[0] = (int64_t)e.rx;
+    v[1] = (int64_t)e.tx;
+  } else {
+    billing_sample_t b;
+    do {
+      if (c.file.read((uint8_t*)&b, sizeof(b)) != sizeof(b)) return 0;
+    } while (b.slot * BILLING_SLOT_S < c.from || b.slot * BILLING_SLOT_S > c.to);
+    key = b.slot * BILLING_SLOT_S;
+    v[0] = b.rx_kbps;
+    v[1] = b.tx_kbps;
+  }
+  
+  c.rows++;
+  if (c.format == EXPORT_BIN) {
+    int64_t bin_key = c.series == EXPORT_USAGE ? key :
+                      key / (c.series == EXPORT_TRAFFIC ? RRD_TIER_DEFS[c.tier].step_s : BILLING_SLOT_S);
+    return exportBinaryRow(c, bin_key, v, c.row);
+  }
+  return exportTextRow(c, key, v, c.row, sizeof(c.row));
+}
+
+// Chunked response filler: copies rows into the TCP buffer, carrying a row
+// that doesn't fit over to the next call
+size_t exportFill(export_ctx_t& c, uint8_t* buf, size_t max_len) {
+  size_t n = 0;
+  while (n < max_len) {
+    if (c.row_pos >= c.row_len) {
+      if (c.done) break;
+      c.row_len = exportNextRow(c);
+      c.row_pos = 0;
+      if (c.row_len == 0) {
+        c.done = true;
+        break;
+      }
+    }
+    size_t k = min(max_len - n, (size_t)(c.row_len - c.row_pos));
+    memcpy(buf + n, c.row + c.row_pos, k);
+    c.row_pos += k;
+    n += k;
+  }
+  
+  c.bytes += n;
+  c.min_heap = min(c.min_heap, (uint32_t)ESP.getFreeHeap());
+  if (n == 0) {
+    uint32_t ms = millis() - c.start_ms;
+    export_last_bytes = c.bytes;
+    export_last_ms = ms;
+    export_last_min_heap = c.min_heap;
+    export_bytes_total += c.bytes;
+    Serial.printf("✓ Export %s/%s: %u rows, %llu bytes in %u ms (%.1f KB/s), min free heap %u\n",
+                  EXPORT_SERIES_NAMES[c.series], EXPORT_FORMAT_NAMES[c.format], c.rows,
+                  (unsigned long long)c.bytes, ms,
+                  ms > 0 ? c.bytes / 1.024 / ms : 0.0, c.min_heap);
+  }
+  return n;
+}
+
+// Opens the series' file and positions the context at the first row
+bool exportOpen(export_ctx_t& c) {
+  if (c.series == EXPORT_TRAFFIC) {
+    // Nothing older than the tier's span can still be in the ring
+    const rrd_tier_def_t& def = RRD_TIER_DEFS[c.tier];
+    uint32_t span = def.step_s * (def.slots - 1);
+    if (c.to > span && c.from < c.to - span) c.from = c.to - span;
+    c.t = c.from - c.from % def.step_s;
+    char path[24];
+    rrdPath(c.iface_id, path, sizeof(path));
+    return LittleFS.exists(path);
+  }
+  
+  if (c.series == EXPORT_BILLING) {
+    if (!c.file || !c.file.seek(sizeof(BILLING_MAGIC) + sizeof(uint32_t))) return false;
+    return true;
+  }
+  
+  // Usage: at most 31 closed periods plus the open one, sorted by period
+  const int n = USAGE_HISTORY[c.period];
+  if (c.file && c.file.seek(usageSlotOffset(c.period, 0))) {
+    c.usage_len = c.file.read((uint8_t*)c.usage, n * sizeof(usage_entry_t)) / sizeof(usage_entry_t);
+  }
+  static router_snapshot_t snap;
+  readSnapshot(snap);
+  if (snap.totals.period[c.period].key != 0) {
+    c.usage[c.usage_len++] = snap.totals.period[c.period];
+  }
+  
+  uint32_t from_key = usagePeriodKey(c.period, c.from);
+  uint32_t to_key = usagePeriodKey(c.period, c.to);
+  int kept = 0;
+  for (int i = 0; i < c.usage_len; i++) {
+    const usage_entry_t& e = c.usage[i];
+    if (e.key == 0 || e.key < from_key || e.key > to_key) continue;
+    c.usage[kept++] = e;
+  }
+  c.usage_len = kept;
+  std::sort(c.usage, c.usage + kept, [](const usage_entry_t& a, const usage_entry_t& b) { return a.key < b.key; });
+  return true;
+}
+
+// ==================== GRAPH WINDOW ====================
+
+// The poller reduces the graphed interface's samples to one min/max column
+// per bucket as they arrive. Only closed buckets enter the view, so a column
+// never changes once the renderer has drawn it.
+static graph_view_t graph_view;
+static rrd_accum_t graph_open;        // bucket still filling, t = bucket number
+static int graph_view_iface = 0;
+static bool graph_view_router_clock = false;
+static uint32_t graph_view_last_samples = 0;
+
+int findGraphWindow(const char* name) {
+  for (int i = 0; i < GRAPH_WINDOW_COUNT; i++) {
+    if (strcmp(GRAPH_WINDOWS[i].name, name) == 0) return i;
+  }
+  return -1;
+}
+
+// Column i = 0 is the oldest, points - 1 the newest; nullptr if the bucket
+// has no samples
+const graph_column_t* graphColumn(const graph_view_t& view, int i) {
+  if (i < 0 || i >= view.points) return nullptr;
+  uint32_t age = view.points - 1 - i;
+  if (age > view.newest) return nullptr;
+  const graph_column_t& c = view.col[(view.newest - age) % view.points];
+  return c.present ? &c : nullptr;
+}
+
+// The column a line into column i starts from: the empty buckets an idle
+// link's poll interval leaves (plus one for a late poll) are bridged, longer
+// gaps are left open
+int graphBridgeBuckets(const graph_view_t& view) {
+  const uint32_t bucket_ms = GRAPH_WINDOWS[view.window].bucket_s * 1000;
+  return (POLL_SCHED_DEFS[ROUTER_EP_INTERFACES].max_ms + bucket_ms - 1) / bucket_ms;
+}
+
+const graph_column_t* graphPrevColumn(const graph_view_t& view, int i, int& prev) {
+  for (prev = i - 1; prev >= i - 1 - graphBridgeBuckets(view); prev--) {
+    const graph_column_t* c = graphColumn(view, prev);
+    if (c) return c;
+  }
+  return nullptr;
+}
+
+int graphColumnX(const graph_view_t& view, int i) {
+  return (GRAPH_W - 1) - (view.points - 1 - i) * view.step;
+}
+
+void graphViewReset(int window, uint32_t now) {
+  const graph_window_def_t& def = GRAPH_WINDOWS[window];
+  memset(graph_view.col, 0, sizeof(graph_view.col));
+  graph_view.window = window;
+  graph_view.points = def.span_s / def.bucket_s;
+  graph_view.step = max(1, (GRAPH_W - 1) / (graph_view.points - 1));
+  graph_view.newest = now / def.bucket_s;   // the partial bucket is left to the archive
+  graph_view.generation++;
+  graph_open.count = 0;
+}
+
+void graphViewClose(const rrd_accum_t& acc) {
+  uint32_t b = acc.t;
+  if (b <= graph_view.newest) return;
+  
+  uint32_t points = graph_view.points;
+  if (b - graph_view.newest >= points) {
+    memset(graph_view.col, 0, sizeof(graph_view.col));
+  } else {
+    for (uint32_t e = graph_view.newest + 1; e < b; e++) {
+      graph_view.col[e % points].present = 0;
+    }
+  }
+  
+  graph_column_t& c = graph_view.col[b % points];
+  c.present = 1;
+  c.rx_lo = graphSampleHeight(acc.rx_min);
+  c.rx_hi = graphSampleHeight(acc.rx_max);
+  c.tx_lo = graphSampleHeight(acc.tx_min);
+  c.tx_hi = graphSampleHeight(acc.tx_max);
+  graph_view.newest = b;
+}
+
+// Fills the view from the traffic archive so long windows aren't empty after
+// a reboot or a window change. Each bucket takes the finest tier that has
+// data for it; coarser slots are spread over all the buckets they cover.
+void graphViewSeed() {
+  if (rrd_iface_id == 0 || rrd_iface_id != graph_view_iface) return;
+  rrdFlush();
+  
+  const uint32_t bucket_s = GRAPH_WINDOWS[graph_view.window].bucket_s;
+  const uint32_t points = graph_view.points;
+  const uint32_t newest = graph_view.newest;
+  const uint32_t oldest = newest >= points - 1 ? newest - (points - 1) : 0;
+  uint8_t tier_of[GRAPH_MAX_POINTS];  // tier + 1 that filled the column
+  memset(tier_of, 0, sizeof(tier_of));
+  int seeded = 0;
+  
+  for (int k = 0; k < RRD_TIERS; k++) {
+    const rrd_tier_def_t& def = RRD_TIER_DEFS[k];
+    
+    rrd_slot_t chunk[32];
+    for (uint32_t i = 0; i < def.slots;) {
+      uint32_t n = rrdReadSlots(rrd_iface_id, k, i, chunk, 32);
+      i += n;
+      
+      for (size_t j = 0; j < n; j++) {
+        const rrd_slot_t& s = chunk[j];
+        if (s.t == 0) continue;
+        uint32_t first = max(s.t / bucket_s, oldest);
+        uint32_t last = min((s.t + def.step_s - 1) / bucket_s, newest);
+        for (uint32_t b = first; b <= last; b++) {
+          uint32_t idx = b % points;
+          graph_column_t& c = graph_view.col[idx];
+          if (tier_of[idx] == 0) {
+            c.present = 1;
+            c.rx_lo = graphSampleHeight(s.rx_min);
+            c.rx_hi = graphSampleHeight(s.rx_max);
+            c.tx_lo = graphSampleHeight(s.tx_min);
+            c.tx_hi = graphSampleHeight(s.tx_max);
+            tier_of[idx] = k + 1;
+            seeded++;
+          } else if (tier_of[idx] == k + 1) {
+            c.rx_lo = min(c.rx_lo, (uint8_t)graphSampleHeight(s.rx_min));
+            c.rx_hi = max(c.rx_hi, (uint8_t)graphSampleHeight(s.rx_max));
+            c.tx_lo = min(c.tx_lo, (uint8_t)graphSampleHeight(s.tx_min));
+            c.tx_hi = max(c.tx_hi, (uint8_t)graphSampleHeight(s.tx_max));
+          }
+        }
+      }
+      vTaskDelay(1);
+    }
+  }
+  
+  Serial.printf("✓ Graph window %s: %d of %u columns from the archive\n",
+                GRAPH_WINDOWS[graph_view.window].name, seeded, points);
+}
+
+// Runs on the poller after each cycle, after rrdService() has the archive of
+// the same interface open
+void graphViewService() {
+  bool router_clock = routerNow() != 0;
+  uint32_t now = router_clock ? routerNow() : millis() / 1000;
+  int window = graph_window;
+  
+  // A router clock that stepped back would leave the view stuck in the future
+  if (graph_view.points == 0 || window != graph_view.window ||
+      graph_interface_id != graph_view_iface || router_clock != graph_view_router_clock ||
+      now / GRAPH_WINDOWS[graph_view.window].bucket_s < graph_view.newest) {
+    graph_view_iface = graph_interface_id;
+    graph_view_router_clock = router_clock;
+    graphViewReset(window, now);
+    if (router_clock) graphViewSeed();
+  }
+  
+  iface_entry_t* iface = findIface(graph_view_iface);
+  if (!iface || iface->samples == graph_view_last_samples) return;
+  graph_view_last_samples = iface->samples;
+  
+  uint32_t b = now / GRAPH_WINDOWS[graph_view.window].bucket_s;
+  if (graph_open.count > 0 && graph_open.t != b) {
+    graphViewClose(graph_open);
+    graph_open.count = 0;
+  }
+  rrdAccumulate(graph_open, b, iface->last_rx_kbps, iface->last_tx_kbps);
+}
+
+// ==================== MULTI-INTERFACE VIEW ====================
+
+int dashTileCount() {
+  return display_layout == LAYOUT_MULTI_16 ? 16 : display_layout == LAYOUT_MULTI_8 ? 8 : 0;
+}
+
+int dashColumns() {
+  return display_layout == LAYOUT_MULTI_16 ? 4 : 2;
+}
+
+// Each sparkline is scaled to its own peak over both directions, so quiet
+// links stay readable next to busy ones. pos is the ring's next slot to be
+// written, i.e. its oldest sample.
+void dashTileFill(dash_tile_t& t, int id, const char* name, uint32_t samples, int pos,
+                  const uint32_t* hist_rx, const uint32_t* hist_tx) {
+  t.id = id;
+  strncpy(t.name, name, sizeof(t.name) - 1);
+  t.name[sizeof(t.name) - 1] = '\0';
+  t.samples = samples;
+  t.online = 1;
+  t.points = (uint8_t)min(samples, (uint32_t)HISTORY_SIZE);
+  
+  uint32_t peak = 1;
+  for (int k = 0; k < HISTORY_SIZE; k++) {
+    peak = max(peak, max(hist_rx[k], hist_tx[k]));
+  }
+  for (int k = 0; k < HISTORY_SIZE; k++) {
+    int idx = (pos + k) % HISTORY_SIZE;
+    t.rx_h[k] = (uint8_t)((uint64_t)hist_rx[idx] * DASH_SPARK_H / peak);
+    t.tx_h[k] = (uint8_t)((uint64_t)hist_tx[idx] * DASH_SPARK_H / peak);
+  }
+}
+
+// Tiles for the first interfaces that have a history ring, in the order the
+// router listed them, then one per fleet router. The fleet's tiles are
+// always kept.
+void dashViewFill(dash_view_t& out) {
+  const int max_tiles = dashTileCount();
+  const int local_tiles = max(0, max_tiles - fleet_count);
+  out.count = 0;
+  
+  for (int i = 0; i < iface_count && out.count < local_tiles; i++) {
+    const iface_entry_t& e = iface_table[i];
+    if (e.ring < 0) continue;
+    const iface_ring_t& ring = iface_rings[e.ring];
+    dash_tile_t& t = out.tile[out.count++];
+    
+    char fallback[16];
+    const char* name = ifaceName(e.id);
+    if (!name) {
+      snprintf(fallback, sizeof(fallback), "if%d", e.id);
+      name = fallback;
+    }
+    dashTileFill(t, e.id, name, e.samples, e.pos, ring.rx, ring.tx);
+    t.rx_kbps = e.last_rx_kbps;
+    t.tx_kbps = e.last_tx_kbps;
+  }
+  
+  // Fleet tiles use negative ids so they never match a local interface
+  static fleet_router_t r;
+  for (int i = 0; i < fleet_count && out.count < max_tiles; i++) {
+    portENTER_CRITICAL(&fleet_mux);
+    memcpy(&r, &fleet[i], sizeof(r));
+    portEXIT_CRITICAL(&fleet_mux);
+    
+    dash_tile_t& t = out.tile[out.count++];
+    // A failed poll also changes the tile: its name turns red
+    dashTileFill(t, -(i + 1), r.name, r.samples, r.pos, r.hist_rx, r.hist_tx);
+    t.samples = r.samples + r.failures;
+    t.online = r.online;
+    t.rx_kbps = r.last_rx_kbps;
+    t.tx_kbps = r.last_tx_kbps;
+  }
+}
+
+// ==================== FLEET ====================
+
+// Members are kept as one JSON array in the "fleet" preference:
+// [{"name", "address", "login", "password", "interface_id"}, ...]
+void loadFleet() {
+  preferences.begin("wifi-config", true);
+  String json = preferences.getString("fleet", "[]");
+  preferences.end();
+  
+  DynamicJsonDocument doc(2048);
+  if (deserializeJson(doc, json)) {
+    Serial.println("✗ Fleet settings unreadable, ignoring");
+    return;
+  }
+  
+  fleet_count = 0;
+  for (JsonObject o : doc.as<JsonArray>()) {
+    if (fleet_count >= FLEET_MAX) break;
+    fleet_router_t& r = fleet[fleet_count];
+    memset(&r, 0, sizeof(r));
+    strncpy(r.name, o["name"] | "", sizeof(r.name) - 1);
+    strncpy(r.address, o["address"] | "", sizeof(r.address) - 1);
+    strncpy(r.login, o["login"] | "", sizeof(r.login) - 1);
+    strncpy(r.password, o["password"] | "", sizeof(r.password) - 1);
+    r.iface_id = o["interface_id"] | 1;
+    if (r.address[0] == '\0') continue;
+    if (r.name[0] == '\0') snprintf(r.name, sizeof(r.name), "router%u", (uint8_t)(fleet_count + 2));
+    fleet_count++;
+  }
+  if (fleet_count > 0) {
+    Serial.printf("✓ Fleet: %d routers besides %s\n", fleet_count, router_address.c_str());
+  }
+}
+
+// Validates and stores a new member list. A member sent without a password
+// keeps the one already stored for the same address, so the list read from
+// GET /api/fleet can be edited and posted back.
+bool saveFleet(JsonArray routers) {
+  if (routers.size() > FLEET_MAX) return false;
+  
+  DynamicJsonDocument out(2048);
+  JsonArray arr = out.to<JsonArray>();
+  for (JsonObject o : routers) {
+    const char* address = o["address"] | "";
+    if (address[0] == '\0' || strlen(address) >= sizeof(fleet[0].address)) return false;
+    
+    JsonObject m = arr.createNestedObject();
+    m["name"] = o["name"] | "";
+    m["address"] = address;
+    m["login"] = o["login"] | "";
+    m["interface_id"] = o["interface_id"] | 1;
+    if (o.containsKey("password")) {
+      m["password"] = o["password"] | "";
+    } else {
+      for (int i = 0; i < fleet_count; i++) {
+        if (strcmp(fleet[i].address, address) == 0) m["password"] = fleet[i].password;
+      }
+    }
+  }
+  
+  String json;
+  serializeJson(out, json);
+  preferences.begin("wifi-config", false);
+  preferences.putString("fleet", json);
+  preferences.end();
+  return true;
+}
+
+// Same smoothing and sanity limit as parseInterfaceReply
+void fleetApplySample(fleet_router_t& r, uint64_t rx, uint64_t tx, uint32_t nowMs) {
+  if (r.time == 0) {
+    r.rx = rx;
+    r.tx = tx;
+    r.time = nowMs;
+    return;
+  }
+  
+  uint32_t elapsed_ms = nowMs - r.time;
+  if (elapsed_ms < 100) return;
+  double dt = elapsed_ms / 1000.0;
+  
+  uint64_t drx = (rx >= r.rx) ? (rx - r.rx) : rx;
+  uint64_t dtx = (tx >= r.tx) ? (tx - r.tx) : tx;
+  uint64_t rx_bps = (uint64_t)((drx / dt) * 8.0);
+  uint64_t tx_bps = (uint64_t)((dtx / dt) * 8.0);
+  
+  const uint64_t MAX_REASONABLE_BPS = 10ULL * 1024 * 1024 * 1024;
+  if (rx_bps > MAX_REASONABLE_BPS) rx_bps = 0;
+  if (tx_bps > MAX_REASONABLE_BPS) tx_bps = 0;
+  
+  rx_bps = (rx_bps * 7 + (uint64_t)r.last_rx_kbps * 1024 * 3) / 10;
+  tx_bps = (tx_bps * 7 + (uint64_t)r.last_tx_kbps * 1024 * 3) / 10;
+  
+  r.last_rx_kbps = (uint32_t)min(rx_bps / 1024, (uint64_t)UINT32_MAX);
+  r.last_tx_kbps = (uint32_t)min(tx_bps / 1024, (uint64_t)UINT32_MAX);
+  r.hist_rx[r.pos] = r.last_rx_kbps;
+  r.hist_tx[r.pos] = r.last_tx_kbps;
+  r.pos = (r.pos + 1) % HISTORY_SIZE;
+  r.samples++;
+  r.rx = rx;
+  r.tx = tx;
+  r.time = nowMs;
+}
+
+// One task per member. The HTTP client lives on the task's stack and keeps
+// its connection open between polls; after a transport error the member
+// backs off on its own like the main router session does.
+void fleetPollTask(void* param) {
+  fleet_router_t& r = fleet[(int)(intptr_t)param];
+  WiFiClient client;
+  HTTPClient http;
+  http.setReuse(true);
+  http.setTimeout(FLEET_TIMEOUT_MS);
+  http.setConnectTimeout(FLEET_TIMEOUT_MS);
+  const String auth = "Basic " + base64::encode(String(r.login) + ":" + r.password);
+  const String url = String(r.address) + "/rest/interface/ethernet/print";
+  const String query = "{\".proplist\": \".id,rx-bytes,tx-bytes\"}";
+  const int iface_id = r.iface_id;
+  unsigned long backoff_ms = 0;
+  TickType_t last_wake = xTaskGetTickCount();
+  uint32_t idle_cycles = 0;
+  
+  for (;;) {
+    // With nobody watching, a tile only needs a sample every unattended counter interval
+    bool due = poll_attended ||
+               ++idle_cycles * FLEET_POLL_INTERVAL_MS >= POLL_SCHED_DEFS[ROUTER_EP_INTERFACES].unattended_ms;
+    if (due) idle_cycles = 0;
+    
+    if (due && WiFi.status() == WL_CONNECTED &&
+        xSemaphoreTake(fleet_slots, pdMS_TO_TICKS(FLEET_POLL_INTERVAL_MS)) == pdTRUE) {
+      uint32_t start_ms = millis();
+      http.begin(client, url);
+      http.addHeader("Authorization", auth);
+      http.addHeader("Content-Type", "application/json");
+      int code = http.POST(query);
+      
+      bool found = false, parsed = false;
+      uint64_t rx = 0, tx = 0;
+      if (code == 200) {
+        StaticJsonDocument<48> filter;
+        filter[".id"] = true;
+        filter["rx-bytes"] = true;
+        filter["tx-bytes"] = true;
+        StaticJsonDocument<192> item;
+        StreamString fallback;
+        if (http.getSize() < 0) http.writeToStream(&fallback);
+        Stream& body = (http.getSize() >= 0) ? http.getStream() : (Stream&)fallback;
+        
+        parsed = parseRestArray(body, item, filter, [&](JsonObject o) {
+          if (id2int(o[".id"] | "") != iface_id) return;
+          rx = (uint64_t)atoll(o["rx-bytes"] | "0");
+          tx = (uint64_t)atoll(o["tx-bytes"] | "0");
+          found = true;
+        }) >= 0;
+      }
+      // Same rule as routerRequestEnd(): never keep a socket with a reply left on it
+      bool unread = code > 0 && (code != 200 || !parsed || client.available() > 0);
+      http.end();
+      if (code < 0 || unread) client.stop();
+      xSemaphoreGive(fleet_slots);
+      
+      uint32_t now = millis();
+      portENTER_CRITICAL(&fleet_mux);
+      r.requests++;
+      r.last_code = code;
+      r.last_latency_ms = now - start_ms;
+      r.online = found;
+      if (found) {
+        fleetApplySample(r, rx, tx, now);
+      } else {
+        r.failures++;
+      }
+      portEXIT_CRITICAL(&fleet_mux);
+      
+      if (code < 0) {
+        backoff_ms = (backoff_ms == 0) ? ROUTER_BACKOFF_MIN_MS : min(backoff_ms * 2, ROUTER_BACKOFF_MAX_MS);
+        Serial.printf("Fleet %s failed (%s), retry in %lu ms\n", r.name,
+                      HTTPClient::errorToString(code).c_str(), backoff_ms);
+        vTaskDelay(pdMS_TO_TICKS(backoff_ms));
+        last_wake = xTaskGetTickCount();
+      } else {
+        backoff_ms = 0;
+      }
+    }
+    
+    if (xTaskGetTickCount() - last_wake > pdMS_TO_TICKS(FLEET_POLL_INTERVAL_MS)) {
+      last_wake = xTaskGetTickCount();
+    }
+    vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(FLEET_POLL_INTERVAL_MS));
+  }
+}
+
+// Members run on the poller's core at the poller's priority, so a busy
+// fleet isn't starved by the main router's polls. The single layout has no
+// tiles to show them in, so they aren't polled there.
+void startFleet() {
+  if (fleet_count == 0 || fleet_slots != nullptr) return;
+  if (display_layout == LAYOUT_SINGLE) {
+    Serial.printf("Fleet: %d routers configured, shown only in the multi layouts; not polling\n", fleet_count);
+    return;
+  }
+  fleet_slots = xSemaphoreCreateCounting(FLEET_MAX_INFLIGHT, FLEET_MAX_INFLIGHT);
+  
+  for (int i = 0; i < fleet_count; i++) {
+    char task_name[16];
+    snprintf(task_name, sizeof(task_name), "fleet_%u", (uint8_t)i);
+    if (xTaskCreatePinnedToCore(fleetPollTask, task_name, FLEET_STACK_SIZE, (void*)(intptr_t)i,
+                                1, nullptr, POLLER_CORE) != pdPASS) {
+      Serial.printf("ERROR: Failed to start poller for %s\n", fleet[i].name);
+    }
+  }
+}
+
+// ==================== POLL SCHEDULER ====================
+
+// Next counter interval after a sample: back to the burst interval when the
+// combined rate moved by more than a quarter (and at least the floor),
+// otherwise half again as long. While traffic flows it stops at the graph
+// window's bucket width so every column (and every 1 s archive slot) gets a
+// sample; only an idle link stretches to the idle interval.
+uint32_t schedCounterInterval(uint32_t interval, uint32_t prev_kbps, uint32_t kbps) {
+  const poll_sched_def_t& def = POLL_SCHED_DEFS[ROUTER_EP_INTERFACES];
+  uint32_t change = (kbps > prev_kbps) ? kbps - prev_kbps : prev_kbps - kbps;
+  if (change > max(SCHED_BURST_FLOOR_KBPS, prev_kbps / 4)) return def.min_ms;
+  uint32_t cap = def.max_ms;
+  if (kbps >= SCHED_BURST_FLOOR_KBPS || prev_kbps >= SCHED_BURST_FLOOR_KBPS) {
+    cap = constrain(GRAPH_WINDOWS[graph_window].bucket_s * 1000, def.min_ms, def.max_ms);
+  }
+  return constrain(interval + interval / 2, def.min_ms, cap);
+}
+
+void schedInit() {
+  memset(poll_sched, 0, sizeof(poll_sched));
+  uint32_t now = millis();
+  for (int i = 0; i < ROUTER_EP_COUNT; i++) {
+    poll_sched[i].interval_ms = POLL_SCHED_DEFS[i].min_ms;
+    poll_sched[i].next_due = now;
+  }
+  poll_sched[ROUTER_EP_INTERFACES].interval_ms = POLL_INTERVAL_MS;
+  sched_started_ms = now;
+}
+
+// Runs every endpoint that is due, earliest deadline first, each at most once
+void schedRunDue() {
+  static bool was_attended = true;
+  bool attended = poll_attended;
+  uint32_t now = millis();
+  
+  // Someone turned the screen on or opened the page: refresh everything now
+  if (attended && !was_attended) {
+    for (int i = 0; i < ROUTER_EP_COUNT; i++) {
+      poll_sched[i].next_due = now;
+    }
+    poll_sched[ROUTER_EP_INTERFACES].interval_ms = POLL_SCHED_DEFS[ROUTER_EP_INTERFACES].min_ms;
+  }
+  was_attended = attended;
+  
+  bool clock_polled = false;
+  bool ran[ROUTER_EP_COUNT] = { false };
+  for (;;) {
+    now = millis();
+    int pick = ROUTER_EP_COUNT;
+    uint32_t pick_deadline = 0;
+    for (int i = 0; i < ROUTER_EP_COUNT; i++) {
+      if (ran[i] || (int32_t)(now - poll_sched[i].next_due) < 0) continue;
+      uint32_t deadline = poll_sched[i].next_due + POLL_SCHED_DEFS[i].deadline_ms;
+      if (pick == ROUTER_EP_COUNT || (int32_t)(deadline - pick_deadline) < 0) {
+        pick = i;
+        pick_deadline = deadline;
+      }
+    }
+    if (pick == ROUTER_EP_COUNT) break;       // nothing due
+    
+    poll_sched_t& s = poll_sched[pick];
+    const poll_sched_def_t& def = POLL_SCHED_DEFS[pick];
+    ran[pick] = true;
+    s.runs++;
+    if ((int32_t)(now - pick_deadline) > 0) s.misses++;
+    
+    switch (pick) {
+      case ROUTER_EP_INTERFACES: {
+        bool fresh = fetchInterfaceStats();
+        iface_entry_t* iface = findIface(graph_interface_id);
+        if (iface && fresh) {
+          updateUsage(iface->rx, iface->tx, routerNow());
+          uint32_t kbps = iface->last_rx_kbps + iface->last_tx_kbps;
+          s.interval_ms = schedCounterInterval(s.interval_ms, s.last_kbps, kbps);
+          s.last_kbps = kbps;
+        }
+        if (iface_names_stale) poll_sched[ROUTER_EP_IFACE_LIST].next_due = now;
+        break;
+      }
+      case ROUTER_EP_RESOURCE:
+        fetchRouterInfo();
+        break;
+      case ROUTER_EP_CLOCK:
+        fetchTimeFromRouter();
+        clock_polled = true;
+        break;
+      case ROUTER_EP_IFACE_LIST:
+        fetchInterfaceNames();
+        break;
+    }
+    
+    // Counted from the start of the request so a slow reply doesn't stretch the interval
+    s.next_due = now + (attended ? s.interval_ms : def.unattended_ms);
+    // Until the first clock reply there is nothing to interpolate from
+    if (pick == ROUTER_EP_CLOCK && routerNow() == 0) s.next_due = now + SCHED_TICK_MAX_MS;
+  }
+  
+  if (!clock_polled) tickRouterClock();
+}
+
+// How long the poller may sleep before the next endpoint is due
+unsigned long schedWaitMs() {
+  uint32_t now = millis();
+  unsigned long wait = SCHED_TICK_MAX_MS;
+  for (int i = 0; i < ROUTER_EP_COUNT; i++) {
+    int32_t left = (int32_t)(poll_sched[i].next_due - now);
+    wait = min(wait, (unsigned long)max(left, (int32_t)1));
+  }
+  return wait;
+}
+
+// Advances the shown time from the interpolated router clock between clock polls
+void tickRouterClock() {
+  static uint32_t last_minute = 0;
+  uint32_t now = routerNow();
+  if (now == 0 || now / 60 == last_minute) return;     // the screen shows minutes
+  last_minute = now / 60;
+  
+  int y, m, d;
+  civilFromDays(now / 86400, y, m, d);
+  uint32_t sec = now % 86400;
+  char time_24hr[12], date_iso[12];
+  snprintf(time_24hr, sizeof(time_24hr), "%02u:%02u:%02u", sec / 3600, sec / 60 % 60, sec % 60);
+  snprintf(date_iso, sizeof(date_iso), "%04d-%02d-%02d", y, m, d);
+  applyRouterClock(time_24hr, date_iso);
+}
+
+// ==================== ROUTER POLLER TASK ====================
+
+void publishSnapshot() {
+  uint32_t seq = snapshot_published.load(std::memory_order_relaxed) + 1;
+  
+  // Mark the slot as being written before touching it so readers still
+  // copying the previous occupant of this slot know to retry
+  snapshot_writing.store(seq, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  
+  router_snapshot_t& snap = snapshot_buf[seq & 1];
+  iface_entry_t* graph_entry = findIface(graph_interface_id);
+  snap.iface_valid = copyIfaceView(graph_entry, snap.iface);
+  snap.counters_ms = graph_entry ? graph_entry->time : 0;
+  snap.graph = graph_view;
+  dashViewFill(snap.dash);
+  snap.info = routerInfo;
+  snap.totals = usage_totals;
+  snap.billing = billing_view;
+  snprintf(snap.timeStr, sizeof(snap.timeStr), "%s", routerTimeStr);
+  snprintf(snap.dateStr, sizeof(snap.dateStr), "%s", routerDateStr);
+  snap.updated_ms = millis();
+  
+  snapshot_published.store(seq, std::memory_order_release);
+}
+
+uint32_t readSnapshot(router_snapshot_t& out) {
+  for (;;) {
+    uint32_t seq = snapshot_published.load(std::memory_order_acquire);
+    if (seq == 0) {
+      memset(&out, 0, sizeof(out));
+      strcpy(out.timeStr, "00:00:00");
+      strcpy(out.dateStr, "01-Jan-1970");
+      return 0;
+    }
+    
+    memcpy(&out, &snapshot_buf[seq & 1], sizeof(out));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    
+    // The writer only reuses our slot two publishes later
+    if (snapshot_writing.load(std::memory_order_relaxed) - seq < 2) {
+      return seq;
+    }
+  }
+}
+
+void routerPollTask(void*) {
+  TickType_t last_wake = xTaskGetTickCount();
+  unsigned long last_save_time = millis();
+  
+  Serial.printf("✓ Router poller running on core %d\n", xPortGetCoreID());
+  
+  schedInit();
+  
+  for (;;) {
+    captureService();
+    
+    if (WiFi.status() == WL_CONNECTED) {
+      if (router_transport == ROUTER_TRANSPORT_REST) {
+        schedRunDue();
+      } else {
+        apiPollCycle();
+      }
+      
+      rrdService();
+      graphViewService();
+      publishSnapshot();
+      
+      unsigned long now = millis();
+      if (now - last_save_time >= totals_flush_s * 1000UL) {
+        saveUsageTotals();
+        last_save_time = now;
+      }
+    }
+    billingExactService();
+    
+    if (router_transport == ROUTER_TRANSPORT_REST) {
+      vTaskDelay(pdMS_TO_TICKS(schedWaitMs()));
+      continue;
+    }
+    
+    // Don't fire a burst of catch-up polls after a slow router reply
+    if (xTaskGetTickCount() - last_wake > pdMS_TO_TICKS(POLL_INTERVAL_MS)) {
+      last_wake = xTaskGetTickCount();
+    }
+    vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(POLL_INTERVAL_MS));
+  }
+}
+
+void startRouterPoller() {
+  if (poller_task != nullptr) return;
+  
+  BaseType_t ok = xTaskCreatePinnedToCore(routerPollTask, "router_poll", POLLER_STACK_SIZE,
+                                          nullptr, 1, &poller_task, POLLER_CORE);
+  if (ok != pdPASS) {
+    Serial.println("ERROR: Failed to start router poller task");
+    poller_task = nullptr;
   }
 }
 
@@ -1012,63 +5166,453 @@ void draw_thick_line_sprite(TFT_eSprite &spr, int x0, int y0, int x1, int y1, ui
   }
 }
 
-void drawGauge(int x, int y, int radius, int thickness, float valuePercent, const char* label) {
-  const int startAngle = 150;
-  const int endAngle = 390;
-  const int totalAngleRange = endAngle - startAngle;
+int graphSampleHeight(uint32_t kbps) {
+  uint64_t bits = (uint64_t)kbps * 1024;
+  uint64_t range_bps = FIXED_MAX_BPS - FIXED_MIN_BPS;
+  if (range_bps == 0) range_bps = 1;
+  
+  if (bits <= FIXED_MIN_BPS) return 0;
+  if (bits >= FIXED_MAX_BPS) return GRAPH_INNER_H;
+  return constrain((int)(((bits - FIXED_MIN_BPS) * (uint64_t)GRAPH_INNER_H) / range_bps), 0, GRAPH_INNER_H);
+}
 
-  gaugeSprite.fillSprite(TFT_BLACK);
+// Wait for the DMA transfer in flight (if any) to finish and release the bus.
+// Must run before anything else touches the panel or the sprite being sent.
+void spiFlush() {
+  if (dma_inflight == nullptr) return;
+#if USE_DMA_PUSH && defined(ESP32_DMA)
+  unsigned long t0 = micros();
+  tft.dmaWait();
+  tft.endWrite();
+  spi_blocked_us += micros() - t0;
+#endif
+  dma_inflight = nullptr;
+}
 
-  for (int i = 0; i < totalAngleRange; i += 5) {
-    int segmentStartAngle = startAngle + i;
-    float sx1 = radius + (radius - thickness) * cos(segmentStartAngle * DEG_TO_RAD);
-    float sy1 = radius + (radius - thickness) * sin(segmentStartAngle * DEG_TO_RAD);
-    float sx2 = radius + radius * cos(segmentStartAngle * DEG_TO_RAD);
-    float sy2 = radius + radius * sin(segmentStartAngle * DEG_TO_RAD);
-    gaugeSprite.drawLine((int)sx1, (int)sy1, (int)sx2, (int)sy2, TFT_DARKGREY);
+// Push rows [sy, sy + h) of a full-width sprite to (x, y). With DMA the call
+// returns as soon as the transfer is queued, so the caller can compose the
+// next region in the other buffer while the panel is fed.
+void pushSpriteRows(TFT_eSprite& spr, int x, int y, int sy, int w, int h) {
+  spiFlush();
+  unsigned long t0 = micros();
+#if USE_DMA_PUSH && defined(ESP32_DMA)
+  if (dma_ready) {
+    uint16_t* pixels = (uint16_t*)spr.getPointer() + (size_t)sy * w;
+    bool swap = tft.getSwapBytes();
+    tft.setSwapBytes(false);           // sprite pixels are already in panel order
+    tft.startWrite();
+    tft.pushImageDMA(x, y, w, h, pixels);
+    tft.setSwapBytes(swap);
+    dma_inflight = &spr;
+    spi_blocked_us += micros() - t0;
+    spi_pushes++;
+    spi_bytes_pushed += (uint64_t)w * h * 2;
+    return;
   }
+#endif
+  spr.pushSprite(x, y, 0, sy, w, h);
+  spi_blocked_us += micros() - t0;
+  spi_pushes++;
+  spi_bytes_pushed += (uint64_t)w * h * 2;
+}
 
-  float cappedPercent = constrain(valuePercent, 0.0f, 100.0f);
-  int filledAngle = (int)(totalAngleRange * (cappedPercent / 100.0f));
+// Column i of the view: the line from the previous column's peak to this
+// one, plus a bar over the bucket's min..max so short bursts stay visible
+void drawGraphColumn(TFT_eSprite& spr, const graph_view_t& view, int i) {
+  const graph_column_t* c = graphColumn(view, i);
+  if (!c) return;
+  const int bottom = GRAPH_H - 1;
+  int x = graphColumnX(view, i);
+  int prev;
+  const graph_column_t* p = graphPrevColumn(view, i, prev);
+  
+  if (p) {
+    draw_thick_line_sprite(spr, graphColumnX(view, prev), bottom - p->tx_hi, x, bottom - c->tx_hi, GRAPH_COLOR_TX, LINE_THICKNESS);
+  }
+  if (c->tx_lo != c->tx_hi) {
+    draw_thick_line_sprite(spr, x, bottom - c->tx_hi, x, bottom - c->tx_lo, GRAPH_COLOR_TX, LINE_THICKNESS);
+  }
+  if (p) {
+    draw_thick_line_sprite(spr, graphColumnX(view, prev), bottom - p->rx_hi, x, bottom - c->rx_hi, GRAPH_COLOR_RX, LINE_THICKNESS);
+  }
+  if (c->rx_lo != c->rx_hi) {
+    draw_thick_line_sprite(spr, x, bottom - c->rx_hi, x, bottom - c->rx_lo, GRAPH_COLOR_RX, LINE_THICKNESS);
+  }
+}
+
+// Scrolling strip chart of the decimated view. When k new columns were
+// closed, the sprite is shifted left by k * step, the grid is re-stamped in
+// the exposed strip and only the k new columns are drawn. Closed columns
+// never change, so this is exact. Because the scroll is horizontal, rows the
+// plot didn't touch in this or the previous frame are unchanged, so only
+// that band of rows is pushed to the panel.
+//
+// With two buffers the frames alternate between them; each buffer catches up
+// on the columns it missed, so it may scroll by more than one step.
+void drawGraphSprite(const graph_view_t* view) {
+  unsigned long start_us = micros();
+  const int graph_width = GRAPH_W;
+  const int graph_height = GRAPH_H;
+  
+  if (graph_frames > 0 && view->generation == graph_generation_drawn && view->newest == graph_newest_drawn) return;
+  graph_buffer_t& buf = graph_bufs[graph_buf_next];
+  TFT_eSprite& spr = *buf.spr;
+  if (dma_inflight == &spr) spiFlush();
+  
+  const int points = view->points;
+  uint32_t k = view->newest - buf.newest;
+  bool full = !buf.valid || buf.generation != view->generation || k >= (uint32_t)points - 1;
+  
+  int band_top = graph_height, band_bottom = -1;
+  for (int i = 0; i < points; i++) {
+    const graph_column_t* c = graphColumn(*view, i);
+    if (!c) continue;
+    band_top = min(band_top, (graph_height - 1) - max(c->rx_hi, c->tx_hi));
+    band_bottom = max(band_bottom, (graph_height - 1) - min(c->rx_lo, c->tx_lo));
+  }
+  band_top = max(band_top - LINE_THICKNESS, 0);
+  band_bottom = min(band_bottom + LINE_THICKNESS, graph_height - 1);
+  
+  int first_column;
+  if (full) {
+    spr.fillSprite(TFT_BLACK);
+    for (int i = 1; i < 4; i++) {
+      spr.drawFastHLine(0, i * (graph_height / 4), graph_width, TFT_DARKGREY);
+    }
+    spr.drawFastHLine(0, graph_height - 1, graph_width, TFT_DARKGREY);
+    first_column = 0;
+  } else {
+    int shift = k * view->step;
+    spr.scroll(-shift, 0);
+    for (int i = 1; i < 4; i++) {
+      spr.drawFastHLine(graph_width - shift, i * (graph_height / 4), shift, TFT_DARKGREY);
+    }
+    spr.drawFastHLine(graph_width - shift, graph_height - 1, shift, TFT_DARKGREY);
+    first_column = points - k;
+  }
+  
+  for (int i = first_column; i < points; i++) {
+    drawGraphColumn(spr, *view, i);
+  }
+  
+  if (!full) {
+    // What scrolled out past the oldest column, the line into it included,
+    // is not part of the view: repaint the left edge as a full redraw would,
+    // clipped so the columns right of it keep their drawing order. A line
+    // reaches back as far as graphPrevColumn() bridges.
+    const int edge = graphColumnX(*view, 0) + LINE_THICKNESS;
+    const int reach = (graphBridgeBuckets(*view) + 1) * view->step + LINE_THICKNESS;
+    spr.setViewport(0, 0, edge, graph_height, false);
+    spr.fillRect(0, 0, edge, graph_height, TFT_BLACK);
+    for (int i = 1; i < 4; i++) {
+      spr.drawFastHLine(0, i * (graph_height / 4), edge, TFT_DARKGREY);
+    }
+    spr.drawFastHLine(0, graph_height - 1, edge, TFT_DARKGREY);
+    for (int i = 0; i < points && graphColumnX(*view, i) < edge + reach; i++) {
+      drawGraphColumn(spr, *view, i);
+    }
+    spr.resetViewport();
+  }
+  
+  // Outside the plot bands of the frame on the panel and of this one, both
+  // hold only background and grid, whichever buffer they came from
+  int push_top = 0, push_bottom = graph_height - 1;
+  if (!full) {
+    push_top = min(band_top, graph_band_top);
+    push_bottom = max(band_bottom, graph_band_bottom);
+  }
+  
+  if (push_bottom >= push_top) {
+    int rows = push_bottom - push_top + 1;
+    pushSpriteRows(spr, GRAPH_X + 1, GRAPH_Y + 1 + push_top, push_top, graph_width, rows);
+    graph_bytes_pushed += (uint64_t)graph_width * rows * 2;
+  }
+  
+  graph_band_top = band_top;
+  graph_band_bottom = band_bottom;
+  graph_generation_drawn = view->generation;
+  graph_newest_drawn = view->newest;
+  buf.generation = view->generation;
+  buf.newest = view->newest;
+  buf.valid = true;
+  graph_buf_next = (graph_buf_next + 1) % graph_buf_count;
+  graph_frames++;
+  if (full) graph_full_redraws++;
+  graph_render_us += micros() - start_us;
+}
+
+void formatAge(uint32_t age_s, char* buf, size_t len) {
+  if (age_s > 0 && age_s % 86400 == 0) {
+    snprintf(buf, len, "%ud", age_s / 86400);
+  } else if (age_s > 0 && age_s % 3600 == 0) {
+    snprintf(buf, len, "%uh", age_s / 3600);
+  } else if (age_s > 0 && age_s % 60 == 0) {
+    snprintf(buf, len, "%um", age_s / 60);
+  } else {
+    snprintf(buf, len, "%us", age_s);
+  }
+}
+
+// X axis labels of the selected window, redrawn when the window changes
+void drawGraphTimeAxis(const graph_view_t& view) {
+  const graph_window_def_t& def = GRAPH_WINDOWS[view.window];
+  int font_h = tft.fontHeight(0);
+  // The oldest label is always well right of the Y axis labels
+  tft.fillRect(GRAPH_X, GRAPH_BOTTOM + 3, SCREEN_WIDTH - GRAPH_X, font_h + 4, TFT_BLACK);
+  tft.setTextColor(TFT_WHITE);
+  
+  char xbuf[8];
+  for (uint32_t age = 0; age <= def.span_s; age += def.label_s) {
+    int x = GRAPH_X + 1 + (GRAPH_W - 1) - (int)(age / def.bucket_s) * view.step;
+    formatAge(age, xbuf, sizeof(xbuf));
+    tft.drawCentreString(xbuf, x, GRAPH_BOTTOM + 5, 0);
+  }
+  graph_axis_window = view.window;
+}
 
-  for (int i = 0; i < filledAngle; i += 2) {
-    int currentAngle = startAngle + i;
-    uint16_t color;
+// Width in pixels of s[from, to) in the loaded font. VLW glyphs have no
+// kerning, so a character's x offset is the width of the text before it.
+int textSpanWidth(const char* s, int from, int to) {
+  char span[TEXT_FIELD_LEN];
+  int n = min(to - from, TEXT_FIELD_LEN - 1);
+  if (n <= 0) return 0;
+  memcpy(span, s + from, n);
+  span[n] = '\0';
+  return tft.textWidth(span);
+}
 
-    if (cappedPercent < 50) {
-      uint8_t r = map((int)cappedPercent, 0, 50, 0, 255);
-      color = gaugeSprite.color565(r, 255, 0);
+// Retained text: compares the new string with what is on the panel and
+// repaints only the changed glyph cells. If the changed run keeps its width
+// (e.g. a digit ticking over) the text after it is left alone; otherwise
+// everything from the first change to the end of the old or new text is
+// repainted.
+void drawTextField(text_field_t& f, const char* text) {
+  const int h = tft.fontHeight();
+  int len_new = min((int)strlen(text), TEXT_FIELD_LEN - 1);
+  
+  tft.setTextColor(f.color, TFT_BLACK);
+  tft.setTextPadding(0);
+  
+  if (!f.drawn) {
+    tft.fillRect(f.x, f.y, f.clear_w, h, TFT_BLACK);
+    tft.drawString(text, f.x, f.y, 0);
+    text_px_painted += f.clear_w * h;
+  } else {
+    int len_old = strlen(f.text);
+    int i = 0;
+    while (i < len_old && i < len_new && f.text[i] == text[i]) i++;
+    if (i == len_old && i == len_new) return;
+    
+    int end_old = len_old, end_new = len_new;
+    while (end_old > i && end_new > i && f.text[end_old - 1] == text[end_new - 1]) {
+      end_old--;
+      end_new--;
+    }
+    
+    int x0 = f.x + textSpanWidth(text, 0, i);
+    int w_old = textSpanWidth(f.text, i, end_old);
+    int w_new = textSpanWidth(text, i, end_new);
+    int repaint_w;
+    if (w_old == w_new) {
+      repaint_w = w_new;
+      tft.fillRect(x0, f.y, repaint_w, h, TFT_BLACK);
+      char span[TEXT_FIELD_LEN];
+      memcpy(span, text + i, end_new - i);
+      span[end_new - i] = '\0';
+      tft.drawString(span, x0, f.y, 0);
     } else {
-      uint8_t g = map((int)cappedPercent, 50, 100, 255, 0);
-      color = gaugeSprite.color565(255, g, 0);
+      int new_width = (x0 - f.x) + textSpanWidth(text, i, len_new);
+      repaint_w = max((int)f.width, new_width) - (x0 - f.x);
+      tft.fillRect(x0, f.y, repaint_w, h, TFT_BLACK);
+      tft.drawString(text + i, x0, f.y, 0);
     }
+    text_px_painted += repaint_w * h;
+  }
+  
+  memcpy(f.text, text, len_new);
+  f.text[len_new] = '\0';
+  f.width = tft.textWidth(f.text);
+  f.drawn = true;
+}
+
+// Arc colour for a percentage: green -> yellow -> red, stepping per whole percent
+uint16_t gaugeColor(float percent) {
+  if (percent < 50) {
+    uint8_t r = map((int)percent, 0, 50, 0, 255);
+    return tft.color565(r, 255, 0);
+  }
+  uint8_t g = map((int)percent, 50, 100, 255, 0);
+  return tft.color565(255, g, 0);
+}
 
-    float sx1 = radius + (radius - thickness) * cos(currentAngle * DEG_TO_RAD);
-    float sy1 = radius + (radius - thickness) * sin(currentAngle * DEG_TO_RAD);
-    float sx2 = radius + radius * cos(currentAngle * DEG_TO_RAD);
-    float sy2 = radius + radius * sin(currentAngle * DEG_TO_RAD);
-    gaugeSprite.drawLine((int)sx1, (int)sy1, (int)sx2, (int)sy2, color);
+// Tick endpoints for every degree of the sweep, relative to the sprite.
+// Computed once; drawing a gauge then needs no trigonometry.
+void initGaugeGeometry() {
+  const int radius = GAUGE_RADIUS;
+  const int thickness = GAUGE_THICKNESS;
+  for (int i = 0; i <= GAUGE_SWEEP; i++) {
+    int angle = GAUGE_START_ANGLE + i;
+    gauge_ticks[i][0] = (int)(radius + (radius - thickness) * cos(angle * DEG_TO_RAD));
+    gauge_ticks[i][1] = (int)(radius + (radius - thickness) * sin(angle * DEG_TO_RAD));
+    gauge_ticks[i][2] = (int)(radius + radius * cos(angle * DEG_TO_RAD));
+    gauge_ticks[i][3] = (int)(radius + radius * sin(angle * DEG_TO_RAD));
   }
+}
+
+void drawGaugeTick(TFT_eSprite& spr, int i, uint16_t color) {
+  const int8_t* t = gauge_ticks[i];
+  spr.drawLine(t[0], t[1], t[2], t[3], color);
+}
 
-  gaugeSprite.setTextColor(TFT_WHITE);
-  gaugeSprite.loadFont(SMALL_FONT, LittleFS);
+// Each gauge keeps its sprite between redraws. While the arc colour is the
+// same and the arc only grows, just the new ticks are drawn and the
+// percentage text is replaced; otherwise the sprite is restored from the
+// cached background ring and the arc redrawn from the tick table.
+void drawGauge(gauge_t& g, float valuePercent) {
+  if (!gauge_sprite_created) return;
+  unsigned long start_us = micros();
+  TFT_eSprite& spr = *g.spr;
+  if (dma_inflight == &spr) spiFlush();
+  
+  const int size = GAUGE_SIZE;
+  float cappedPercent = constrain(valuePercent, 0.0f, 100.0f);
+  int filledAngle = (int)(GAUGE_SWEEP * (cappedPercent / 100.0f));
+  uint16_t color = gaugeColor(cappedPercent);
+  
+  spr.setTextColor(TFT_WHITE);
+  const int text_y = GAUGE_RADIUS - 10;
+  const int text_h = min((int)spr.fontHeight(), size - text_y);
+  
+  if (!g.valid || color != g.color || filledAngle < g.filled) {
+    memcpy(spr.getPointer(), gaugeBgSprite.getPointer(), size * size * 2);
+    for (int i = 0; i < filledAngle; i += 2) {
+      drawGaugeTick(spr, i, color);
+    }
+    spr.drawCentreString(g.label, GAUGE_RADIUS, GAUGE_RADIUS + 10, 0);
+    gauge_full_draws++;
+  } else {
+    // Put the ring back under the old percentage, then the ticks crossing it
+    memcpy((uint16_t*)spr.getPointer() + text_y * size,
+           (uint16_t*)gaugeBgSprite.getPointer() + text_y * size, text_h * size * 2);
+    for (int i = 0; i < g.filled; i += 2) {
+      const int8_t* t = gauge_ticks[i];
+      if (max(t[1], t[3]) >= text_y && min(t[1], t[3]) < text_y + text_h) {
+        drawGaugeTick(spr, i, color);
+      }
+    }
+    for (int i = (g.filled + 1) & ~1; i < filledAngle; i += 2) {
+      drawGaugeTick(spr, i, color);
+    }
+    gauge_delta_draws++;
+  }
+  
   char percentStr[10];
   snprintf(percentStr, sizeof(percentStr), "%.1f%%", cappedPercent);
-  gaugeSprite.drawCentreString(percentStr, radius, radius - 10, 0);
-  gaugeSprite.drawCentreString(label, radius, radius + 10, 0);
-  gaugeSprite.unloadFont();
+  spr.drawCentreString(percentStr, GAUGE_RADIUS, text_y, 0);
+  
+  pushSpriteRows(spr, g.x - GAUGE_RADIUS, g.y - GAUGE_RADIUS, 0, size, size);
+  
+  g.valid = true;
+  g.filled = filledAngle;
+  g.color = color;
+  g.percent = valuePercent;
+  gauge_draw_us += micros() - start_us;
+}
+
+// Composes one tile in the next tile buffer and pushes it to its slot.
+// Tiles use the built-in 6x8 font, which needs no smooth font in the sprite.
+// Returns the bytes pushed.
+uint32_t drawDashTile(const dash_tile_t& t, int slot) {
+  TFT_eSprite& spr = *dash_bufs[dash_buf_next];
+  if (dma_inflight == &spr) spiFlush();
+  
+  const int w = SCREEN_WIDTH / dashColumns();
+  const int left = 4;
+  const int right = w - 5;
+  const int bottom = DASH_SPARK_Y + DASH_SPARK_H;
+  
+  spr.fillSprite(TFT_BLACK);
+  spr.drawRect(0, 0, w, DASH_TILE_H, TFT_DARKGREY);
+  spr.setTextColor(t.online ? TFT_WHITE : TFT_RED, TFT_BLACK);
+  spr.drawString(t.name, left, 4, 1);
+  
+  char buf[16];
+  snprintf(buf, sizeof(buf), "R %.1f", t.rx_kbps / 1024.0);
+  spr.setTextColor(GRAPH_COLOR_RX, TFT_BLACK);
+  int x = left + spr.drawString(buf, left, 13, 1) + 6;
+  snprintf(buf, sizeof(buf), "T %.1f", t.tx_kbps / 1024.0);
+  spr.setTextColor(GRAPH_COLOR_TX, TFT_BLACK);
+  spr.drawString(buf, x, 13, 1);
+  
+  spr.drawFastHLine(left, bottom, right - left + 1, TFT_DARKGREY);
+  for (int k = HISTORY_SIZE - t.points + 1; k < HISTORY_SIZE; k++) {
+    int x0 = left + (k - 1) * (right - left) / (HISTORY_SIZE - 1);
+    int x1 = left + k * (right - left) / (HISTORY_SIZE - 1);
+    spr.drawLine(x0, bottom - t.tx_h[k - 1], x1, bottom - t.tx_h[k], GRAPH_COLOR_TX);
+    spr.drawLine(x0, bottom - t.rx_h[k - 1], x1, bottom - t.rx_h[k], GRAPH_COLOR_RX);
+  }
+  
+  pushSpriteRows(spr, (slot % dashColumns()) * w, DASH_Y + (slot / dashColumns()) * DASH_TILE_H, 0, w, DASH_TILE_H);
+  dash_buf_next = (dash_buf_next + 1) % dash_buf_count;
+  dash_tiles_drawn++;
+  return (uint32_t)w * DASH_TILE_H * 2;
+}
 
-  gaugeSprite.pushSprite(x - radius, y - radius);
+// Redraws the tiles whose interface has new samples, starting where the
+// last frame stopped, while the push credit lasts. Credit left over is kept
+// up to one tile, so a quiet frame doesn't make room for a burst later.
+void drawDashboard(const dash_view_t& view) {
+  if (dash_buf_count == 0) return;
+  const int tiles = dashTileCount();
+  const uint32_t tile_bytes = (uint32_t)(SCREEN_WIDTH / dashColumns()) * DASH_TILE_H * 2;
+  dash_push_credit = min(dash_push_credit + DASH_FRAME_BUDGET_BYTES, max(tile_bytes, DASH_FRAME_BUDGET_BYTES));
+  
+  for (int n = 0; n < tiles; n++) {
+    int slot = (dash_tile_next + n) % tiles;
+    
+    if (slot >= view.count) {
+      if (dash_drawn_id[slot] != 0) {
+        const int w = SCREEN_WIDTH / dashColumns();
+        spiFlush();
+        tft.fillRect((slot % dashColumns()) * w, DASH_Y + (slot / dashColumns()) * DASH_TILE_H, w, DASH_TILE_H, TFT_BLACK);
+        dash_drawn_id[slot] = 0;
+      }
+      continue;
+    }
+    
+    const dash_tile_t& t = view.tile[slot];
+    if (t.id == dash_drawn_id[slot] && t.samples == dash_drawn_samples[slot]) continue;
+    if (tile_bytes > dash_push_credit) {
+      dash_tile_next = slot;
+      dash_frames_deferred++;
+      return;
+    }
+    
+    dash_push_credit -= drawDashTile(t, slot);
+    dash_drawn_id[slot] = t.id;
+    dash_drawn_samples[slot] = t.samples;
+  }
 }
 
+// Sprites meant for DMA must live in internal RAM: the ESP32 SPI DMA can't
+// read PSRAM. The second graph buffer is optional; without it a push waits
+// for the previous transfer of the sprite before drawing into it again.
 void initGraphSprite() {
   const int graph_width = GRAPH_W;
   const int graph_height = GRAPH_H; 
   
   graphSprite.setColorDepth(16);
+  if (dma_ready) graphSprite.setAttribute(PSRAM_ENABLE, false);
   
   void* spritePtr = graphSprite.createSprite(graph_width, graph_height);
   
+  if (spritePtr == nullptr && dma_ready) {
+    Serial.println("⚠ No internal RAM for graph sprite, trying PSRAM without DMA");
+    dma_ready = false;
+    graphSprite.setAttribute(PSRAM_ENABLE, true);
+    spritePtr = graphSprite.createSprite(graph_width, graph_height);
+  }
+  
   if (spritePtr == nullptr) {
     Serial.println("ERROR: Failed to create graph sprite - not enough RAM!");
     Serial.println("Falling back to direct rendering");
@@ -1079,24 +5623,379 @@ void initGraphSprite() {
   sprite_created = true;
   Serial.println("✓ Graph sprite created successfully");
   Serial.printf("Sprite size: %d bytes\n", graph_width * graph_height * 2);
+  
+  if (!dma_ready) return;
+  graphSpriteAlt.setColorDepth(16);
+  graphSpriteAlt.setAttribute(PSRAM_ENABLE, false);
+  if (graphSpriteAlt.createSprite(graph_width, graph_height) == nullptr) {
+    Serial.println("⚠ No RAM for second graph buffer - single-buffered DMA");
+    return;
+  }
+  graph_buf_count = 2;
+  Serial.println("✓ Graph sprite double-buffered");
 }
 
-void initGaugeSprite() {
-  const int gauge_size = 70;
+// Tile buffers for the multi-interface layouts, in internal RAM like the
+// graph sprite. With DMA a second one lets the next tile be composed while
+// the previous one is still being sent. Without any, the single layout is
+// used instead.
+void initDashSprite() {
+  const int w = SCREEN_WIDTH / dashColumns();
   
-  gaugeSprite.setColorDepth(16);
+  for (int i = 0; i < 2; i++) {
+    TFT_eSprite& spr = *dash_bufs[i];
+    spr.setColorDepth(16);
+    if (dma_ready) spr.setAttribute(PSRAM_ENABLE, false);
+    if (spr.createSprite(w, DASH_TILE_H) == nullptr) break;
+    dash_buf_count++;
+    if (!dma_ready) break;
+  }
   
-  void* spritePtr = gaugeSprite.createSprite(gauge_size, gauge_size);
+  if (dash_buf_count == 0) {
+    Serial.println("ERROR: Failed to create tile sprite - falling back to the single layout");
+    display_layout = LAYOUT_SINGLE;
+    return;
+  }
+  Serial.printf("✓ Tile sprite created: %d tiles of %dx%d, %d buffers\n",
+                dashTileCount(), w, DASH_TILE_H, dash_buf_count);
+}
+
+bool createGaugeSprite(TFT_eSprite& spr) {
+  spr.setColorDepth(16);
+  if (dma_ready) spr.setAttribute(PSRAM_ENABLE, false);
+  return spr.createSprite(GAUGE_SIZE, GAUGE_SIZE) != nullptr;
+}
+
+// One sprite per gauge so each can be updated in place, plus the shared
+// background ring they are restored from
+void initGaugeSprite() {
+  const int gauge_size = GAUGE_SIZE;
   
-  if (spritePtr == nullptr) {
+  if (!createGaugeSprite(gaugeBgSprite) || !createGaugeSprite(gaugeSprite) ||
+      !createGaugeSprite(gaugeRxSprite)) {
     Serial.println("ERROR: Failed to create gauge sprite - not enough RAM!");
+    gaugeBgSprite.deleteSprite();
+    gaugeSprite.deleteSprite();
     gauge_sprite_created = false;
     return;
   }
   
+  initGaugeGeometry();
+  gaugeBgSprite.fillSprite(TFT_BLACK);
+  for (int i = 0; i < GAUGE_SWEEP; i += 5) {
+    drawGaugeTick(gaugeBgSprite, i, TFT_DARKGREY);
+  }
+  
+  loadDisplayFont(gaugeSprite, SMALL_FONT);
+  loadDisplayFont(gaugeRxSprite, SMALL_FONT);
+  ram_gauge.valid = false;
+  rx_gauge.valid = false;
+  
   gauge_sprite_created = true;
   Serial.println("✓ Gauge sprite created successfully");
-  Serial.printf("Gauge sprite size: %d bytes\n", gauge_size * gauge_size * 2);
+  Serial.printf("Gauge sprite size: %d bytes x 3\n", gauge_size * gauge_size * 2);
+}
+
+// Route sprite pushes through DMA when this TFT_eSPI build supports it
+void initDisplayDMA() {
+#if USE_DMA_PUSH && defined(ESP32_DMA)
+  dma_ready = tft.initDMA();
+  Serial.println(dma_ready ? "✓ SPI DMA enabled for sprite pushes" : "⚠ SPI DMA init failed - blocking pushes");
+#else
+  dma_ready = false;
+  Serial.println("SPI DMA not available for this display - blocking pushes");
+#endif
+}
+
+// ==================== LIVE EVENTS ====================
+
+// One stats frame per published snapshot, serialized once into a shared
+// buffer and handed to AsyncEventSource, which queues the same message to
+// every subscriber. rx/tx are the graphed interface's samples since the
+// previous frame, oldest first in kbps, the last one being sample number
+// `samples`. After a subscriber joins, the next frame carries the whole ring
+// so its graph starts full; pages skip samples they already have.
+void pushStatsFrame(const router_snapshot_t& snap, uint32_t seq) {
+  static uint32_t last_samples = 0;
+  static StaticJsonDocument<1536> doc;
+  static char frame[1280];
+  
+  if (events.count() == 0) return;
+  unsigned long start_us = micros();
+  
+  const mt_data_t& iface = snap.iface;
+  uint32_t n = 0;
+  if (snap.iface_valid) {
+    n = events_resync.exchange(false) ? iface.samples : iface.samples - last_samples;
+    n = min(n, (uint32_t)HISTORY_SIZE);
+  }
+  
+  doc.clear();
+  doc["seq"] = seq;
+  doc["cpu"] = (int)(snap.info.cpuLoad + 0.5f);
+  doc["ram_used_mb"] = (snap.info.memoryTotal - snap.info.memoryFree) / 1024 / 1024;
+  doc["ram_total_mb"] = snap.info.memoryTotal / 1024 / 1024;
+  int last = (iface.pos + HISTORY_SIZE - 1) % HISTORY_SIZE;
+  doc["rx_kbps"] = snap.iface_valid ? iface.hist_rx[last] : 0;
+  doc["tx_kbps"] = snap.iface_valid ? iface.hist_tx[last] : 0;
+  doc["samples"] = snap.iface_valid ? iface.samples : 0;
+  JsonArray rx = doc.createNestedArray("rx");
+  JsonArray tx = doc.createNestedArray("tx");
+  for (uint32_t k = n; k > 0; k--) {
+    int idx = (iface.pos + HISTORY_SIZE - k) % HISTORY_SIZE;
+    rx.add(iface.hist_rx[idx]);
+    tx.add(iface.hist_tx[idx]);
+  }
+  
+  size_t len = serializeJson(doc, frame, sizeof(frame));
+  events.send(frame, "stats", seq);
+  last_samples = iface.samples;
+  
+  events_frames++;
+  events_bytes += len;
+  perfRecord(events_frame_hist, start_us);
+}
+
+// ==================== PERFORMANCE STATISTICS ====================
+
+// O(PERF_BUCKETS) and allocation free, so it can sit on any hot path
+void perfObserve(perf_hist_t& h, uint32_t us) {
+  int b = 0;
+  while (b < PERF_BUCKETS - 1 && us > PERF_BUCKET_US[b]) b++;
+  h.buckets[b]++;
+  h.total_us += us;
+  if (us > h.max_us) h.max_us = us;
+  h.runs++;
+}
+
+void perfRecord(perf_hist_t& h, unsigned long start_us) {
+  perfObserve(h, micros() - start_us);
+}
+
+// Cost of one timed observation (two micros() reads and the bucket update)
+void perfCalibrate() {
+  const int N = 1000;
+  perf_hist_t scratch;
+  memset(&scratch, 0, sizeof(scratch));
+  unsigned long start = micros();
+  for (int i = 0; i < N; i++) {
+    perfRecord(scratch, micros());
+  }
+  perf_overhead_ns = (uint32_t)((uint64_t)(micros() - start) * 1000 / N);
+  Serial.printf("✓ Perf timer overhead: %u ns per observation\n", perf_overhead_ns);
+}
+
+void metricsHeader(Print& out, const char* name, const char* type, const char* help) {
+  out.printf("# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+}
+
+// One histogram series; label may be empty
+void metricsHistogram(Print& out, const char* name, const char* label, const perf_hist_t& h) {
+  const char* sep = label[0] ? "," : "";
+  uint32_t cumulative = 0;
+  for (int b = 0; b < PERF_BUCKETS; b++) {
+    cumulative += h.buckets[b];
+    out.printf("%s_bucket{%s%sle=\"%s\"} %u\n", name, label, sep, PERF_BUCKET_LE[b], cumulative);
+  }
+  const char* open = label[0] ? "{" : "";
+  const char* close = label[0] ? "}" : "";
+  out.printf("%s_sum%s%s%s %.6f\n", name, open, label, close, h.total_us / 1e6);
+  out.printf("%s_count%s%s%s %u\n", name, open, label, close, h.runs);
+}
+
+void writeMetrics(Print& out) {
+  unsigned long start_us = micros();
+  char label[48];
+  
+  metricsHeader(out, "mtdisplay_frame_seconds", "histogram", "Render time of one display frame");
+  metricsHistogram(out, "mtdisplay_frame_seconds", "", render_frame);
+  
+  metricsHeader(out, "mtdisplay_render_stage_seconds", "histogram", "Render time per loop() stage");
+  for (int i = 0; i < RENDER_STAGE_COUNT; i++) {
+    snprintf(label, sizeof(label), "stage=\"%s\"", RENDER_STAGE_NAMES[i]);
+    metricsHistogram(out, "mtdisplay_render_stage_seconds", label, render_stages[i]);
+  }
+  
+  metricsHeader(out, "mtdisplay_router_request_seconds", "histogram", "Router HTTP round trip until response headers");
+  for (int i = 0; i < ROUTER_EP_COUNT; i++) {
+    snprintf(label, sizeof(label), "endpoint=\"%s\"", ROUTER_EP_NAMES[i]);
+    metricsHistogram(out, "mtdisplay_router_request_seconds", label, router_http_hist[i]);
+  }
+  
+  metricsHeader(out, "mtdisplay_router_parse_seconds", "histogram", "Router reply body read and JSON parse");
+  for (int i = 0; i < ROUTER_EP_COUNT; i++) {
+    snprintf(label, sizeof(label), "endpoint=\"%s\"", ROUTER_EP_NAMES[i]);
+    metricsHistogram(out, "mtdisplay_router_parse_seconds", label, router_parse_hist[i]);
+  }
+  
+  metricsHeader(out, "mtdisplay_flash_write_seconds", "histogram", "Time to append or compact a totals journal record");
+  metricsHistogram(out, "mtdisplay_flash_write_seconds", "", flash_write_hist);
+  metricsHeader(out, "mtdisplay_totals_compactions_total", "counter", "Totals journal compactions");
+  out.printf("mtdisplay_totals_compactions_total %u\n", totals_compactions);
+  
+  metricsHeader(out, "mtdisplay_archive_flush_seconds", "histogram", "Time to write queued traffic archive slots");
+  metricsHistogram(out, "mtdisplay_archive_flush_seconds", "", rrd_flush_hist);
+  metricsHeader(out, "mtdisplay_archive_slots_written_total", "counter", "Traffic archive slots written to flash");
+  out.printf("mtdisplay_archive_slots_written_total %u\n", rrd_slots_written);
+  
+  metricsHeader(out, "mtdisplay_web_page_requests_total", "counter", "Main page requests by how they were answered");
+  for (int i = 0; i < 3; i++) {
+    out.printf("mtdisplay_web_page_requests_total{result=\"%s\"} %u\n", WEB_PAGE_RESULTS[i], web_page_sends[i]);
+  }
+  
+  metricsHeader(out, "mtdisplay_exports_total", "counter", "History exports started");
+  out.printf("mtdisplay_exports_total %u\n", exports_total);
+  metricsHeader(out, "mtdisplay_export_bytes_total", "counter", "History export bytes streamed");
+  out.printf("mtdisplay_export_bytes_total %llu\n", (unsigned long long)export_bytes_total);
+  metricsHeader(out, "mtdisplay_export_last_seconds", "gauge", "Duration of the last finished export");
+  out.printf("mtdisplay_export_last_seconds %.3f\n", export_last_ms / 1000.0);
+  metricsHeader(out, "mtdisplay_export_last_bytes", "gauge", "Size of the last finished export");
+  out.printf("mtdisplay_export_last_bytes %llu\n", (unsigned long long)export_last_bytes);
+  metricsHeader(out, "mtdisplay_export_last_min_heap_bytes", "gauge", "Lowest free heap during the last finished export");
+  out.printf("mtdisplay_export_last_min_heap_bytes %u\n", export_last_min_heap);
+  
+  metricsHeader(out, "mtdisplay_events_clients", "gauge", "Web UI pages subscribed to /api/events");
+  out.printf("mtdisplay_events_clients %u\n", (uint32_t)events.count());
+  metricsHeader(out, "mtdisplay_events_frames_total", "counter", "Stats frames pushed to /api/events");
+  out.printf("mtdisplay_events_frames_total %u\n", events_frames);
+  metricsHeader(out, "mtdisplay_events_bytes_total", "counter", "Stats frame bytes serialized, once per frame");
+  out.printf("mtdisplay_events_bytes_total %llu\n", (unsigned long long)events_bytes);
+  metricsHeader(out, "mtdisplay_events_frame_seconds", "histogram", "Time to build and queue one stats frame");
+  metricsHistogram(out, "mtdisplay_events_frame_seconds", "", events_frame_hist);
+  
+  metricsHeader(out, "mtdisplay_router_requests_total", "counter", "Router requests sent");
+  for (int i = 0; i < ROUTER_EP_COUNT; i++) {
+    out.printf("mtdisplay_router_requests_total{endpoint=\"%s\"} %u\n", ROUTER_EP_NAMES[i], router_stats[i].requests);
+  }
+  metricsHeader(out, "mtdisplay_router_failures_total", "counter", "Router requests without a 200 reply");
+  for (int i = 0; i < ROUTER_EP_COUNT; i++) {
+    out.printf("mtdisplay_router_failures_total{endpoint=\"%s\"} %u\n", ROUTER_EP_NAMES[i], router_stats[i].failures);
+  }
+  
+  if (router_transport == ROUTER_TRANSPORT_REST) {
+    metricsHeader(out, "mtdisplay_poll_interval_seconds", "gauge", "Current poll interval per router endpoint");
+    for (int i = 0; i < ROUTER_EP_COUNT; i++) {
+      uint32_t ms = poll_attended ? poll_sched[i].interval_ms : POLL_SCHED_DEFS[i].unattended_ms;
+      out.printf("mtdisplay_poll_interval_seconds{endpoint=\"%s\"} %.3f\n", ROUTER_EP_NAMES[i], ms / 1000.0);
+    }
+    metricsHeader(out, "mtdisplay_poll_deadline_misses_total", "counter", "Polls started after their deadline");
+    for (int i = 0; i < ROUTER_EP_COUNT; i++) {
+      out.printf("mtdisplay_poll_deadline_misses_total{endpoint=\"%s\"} %u\n", ROUTER_EP_NAMES[i], poll_sched[i].misses);
+    }
+    
+    uint32_t requests = 0;
+    for (int i = 0; i < ROUTER_EP_COUNT; i++) {
+      requests += router_stats[i].requests;
+    }
+    uint32_t elapsed_ms = millis() - sched_started_ms;
+    metricsHeader(out, "mtdisplay_router_requests_per_hour", "gauge", "Router requests per hour since the poller started");
+    out.printf("mtdisplay_router_requests_per_hour %.0f\n", elapsed_ms > 0 ? requests * 3600000.0 / elapsed_ms : 0.0);
+  }
+  metricsHeader(out, "mtdisplay_poll_attended", "gauge", "1 while the backlight is on or a web client is connected");
+  out.printf("mtdisplay_poll_attended %d\n", poll_attended ? 1 : 0);
+  
+  metricsHeader(out, "mtdisplay_display_age_seconds", "gauge", "Age of the shown counters in the last frame");
+  out.printf("mtdisplay_display_age_seconds %.3f\n", display_age_last_ms / 1000.0);
+  metricsHeader(out, "mtdisplay_display_age_max_seconds", "gauge", "Oldest counters shown since boot or /api/perf/reset");
+  out.printf("mtdisplay_display_age_max_seconds %.3f\n", display_age_max_ms / 1000.0);
+  metricsHeader(out, "mtdisplay_display_age_avg_seconds", "gauge", "Average age of the shown counters since boot or /api/perf/reset");
+  out.printf("mtdisplay_display_age_avg_seconds %.3f\n",
+             display_age_frames > 0 ? display_age_sum_ms / 1000.0 / display_age_frames : 0.0);
+  
+  if (fleet_count > 0) {
+    metricsHeader(out, "mtdisplay_fleet_up", "gauge", "Whether the fleet router answered its last poll");
+    for (int i = 0; i < fleet_count; i++) {
+      out.printf("mtdisplay_fleet_up{router=\"%s\"} %d\n", fleet[i].name, fleet[i].online ? 1 : 0);
+    }
+    metricsHeader(out, "mtdisplay_fleet_requests_total", "counter", "Polls sent to each fleet router");
+    for (int i = 0; i < fleet_count; i++) {
+      out.printf("mtdisplay_fleet_requests_total{router=\"%s\"} %u\n", fleet[i].name, fleet[i].requests);
+    }
+    metricsHeader(out, "mtdisplay_fleet_failures_total", "counter", "Fleet polls without a usable reply");
+    for (int i = 0; i < fleet_count; i++) {
+      out.printf("mtdisplay_fleet_failures_total{router=\"%s\"} %u\n", fleet[i].name, fleet[i].failures);
+    }
+  }
+  
+  metricsHeader(out, "mtdisplay_spi_bytes_total", "counter", "Sprite bytes pushed to the panel");
+  out.printf("mtdisplay_spi_bytes_total %llu\n", (unsigned long long)spi_bytes_pushed);
+  metricsHeader(out, "mtdisplay_spi_blocked_seconds_total", "counter", "Time the renderer waited on SPI");
+  out.printf("mtdisplay_spi_blocked_seconds_total %.6f\n", spi_blocked_us / 1e6);
+  
+  metricsHeader(out, "mtdisplay_heap_free_bytes", "gauge", "Free heap");
+  out.printf("mtdisplay_heap_free_bytes %u\n", ESP.getFreeHeap());
+  metricsHeader(out, "mtdisplay_heap_min_free_bytes", "gauge", "Lowest free heap since boot");
+  out.printf("mtdisplay_heap_min_free_bytes %u\n", ESP.getMinFreeHeap());
+  metricsHeader(out, "mtdisplay_heap_largest_block_bytes", "gauge", "Largest allocatable heap block");
+  out.printf("mtdisplay_heap_largest_block_bytes %u\n", ESP.getMaxAllocHeap());
+  metricsHeader(out, "mtdisplay_uptime_seconds", "gauge", "Seconds since boot");
+  out.printf("mtdisplay_uptime_seconds %lu\n", millis() / 1000);
+  
+  metricsHeader(out, "mtdisplay_perf_observation_overhead_ns", "gauge", "Measured cost of one timer observation");
+  out.printf("mtdisplay_perf_observation_overhead_ns %u\n", perf_overhead_ns);
+  metricsHeader(out, "mtdisplay_metrics_render_seconds", "gauge", "Time taken to render the previous /metrics reply");
+  out.printf("mtdisplay_metrics_render_seconds %.6f\n", metrics_render_us / 1e6);
+  
+  metrics_render_us = micros() - start_us;
+}
+
+// ==================== RENDER STATISTICS ====================
+
+void resetRenderStats() {
+  memset(render_stages, 0, sizeof(render_stages));
+  display_age_max_ms = 0;
+  display_age_sum_ms = 0;
+  display_age_frames = 0;
+  memset(&render_frame, 0, sizeof(render_frame));
+  render_frames = 0;
+  spi_pushes = 0;
+  spi_bytes_pushed = 0;
+  spi_blocked_us = 0;
+  text_px_painted = 0;
+  graph_frames = 0;
+  graph_full_redraws = 0;
+  graph_bytes_pushed = 0;
+  graph_render_us = 0;
+  dash_tiles_drawn = 0;
+  dash_frames_deferred = 0;
+  gauge_full_draws = 0;
+  gauge_delta_draws = 0;
+  gauge_draw_us = 0;
+  font_fs_loads = 0;
+}
+
+void reportRenderStats() {
+  if (render_frames == 0) return;
+  
+  Serial.printf("Frame: %u frames, avg %u us, max %u us, heap free %u (min %u, largest block %u)\n",
+                render_frames, (uint32_t)(render_frame.total_us / render_frames), render_frame.max_us,
+                ESP.getFreeHeap(), ESP.getMinFreeHeap(), ESP.getMaxAllocHeap());
+  for (int i = 0; i < RENDER_STAGE_COUNT; i++) {
+    const perf_hist_t& st = render_stages[i];
+    if (st.runs == 0) continue;
+    Serial.printf("  %-7s %u runs, avg %u us, max %u us\n",
+                  RENDER_STAGE_NAMES[i], st.runs, (uint32_t)(st.total_us / st.runs), st.max_us);
+  }
+  if (graph_frames > 0) {
+    Serial.printf("Graph: %u frames (%u full), avg %u us, avg %u bytes pushed\n",
+                  graph_frames, graph_full_redraws,
+                  (uint32_t)(graph_render_us / graph_frames), (uint32_t)(graph_bytes_pushed / graph_frames));
+  }
+  if (display_layout != LAYOUT_SINGLE) {
+    Serial.printf("Tiles: %u drawn, %u frames hit the push budget\n", dash_tiles_drawn, dash_frames_deferred);
+  }
+  Serial.printf("SPI: %u pushes, avg %u bytes/frame, avg %u us/frame blocked (%s, %d graph buffers)\n",
+                spi_pushes, (uint32_t)(spi_bytes_pushed / render_frames),
+                (uint32_t)(spi_blocked_us / render_frames),
+                dma_ready ? "DMA" : "blocking", graph_buf_count);
+  uint32_t gauge_draws = gauge_full_draws + gauge_delta_draws;
+  if (gauge_draws > 0) {
+    Serial.printf("Gauges: %u redraws (%u delta), avg %u us\n",
+                  gauge_draws, gauge_delta_draws, (uint32_t)(gauge_draw_us / gauge_draws));
+  }
+  Serial.printf("Text: avg %u px/frame repainted, %u font loads from LittleFS (font %s)\n",
+                (uint32_t)(text_px_painted / render_frames), font_fs_loads,
+                small_font_data ? "cached in RAM" : "read from flash");
 }
 
 // ==================== SETUP ====================
@@ -1118,16 +6017,24 @@ void setup() {
     Serial.println("✓ LittleFS mounted");
   }
 
-  loadRxTotals();
+  perfCalibrate();
+  initFonts();
+  loadUsageTotals();
+  loadBilling();
   loadPreferences();
+  loadFleet();
+  routerSessionInit();
 
   tft.begin();
   tft.setRotation(1);
   tft.fillScreen(TFT_BLACK);
   Serial.println("✓ TFT initialized");
 
-  initGraphSprite();
+  initDisplayDMA();
+  if (display_layout != LAYOUT_SINGLE) initDashSprite();
+  if (display_layout == LAYOUT_SINGLE) initGraphSprite();
   initGaugeSprite();
+  initIfaceTable();
 
 #ifdef TFT_BL
   pinMode(TFT_BL, OUTPUT);
@@ -1146,6 +6053,12 @@ void setup() {
   }
   
   setupWebServer();
+  
+  if (!hotspot_mode) {
+    startRouterPoller();
+    startFleet();
+  }
+  
   showSplashScreen();
   tft.fillScreen(TFT_BLACK);
   
@@ -1175,16 +6088,14 @@ void loop() {
     if (millis() - last_update > 5000) {
       tft.fillScreen(TFT_BLACK);
       tft.setTextColor(TFT_ORANGE);
-      tft.loadFont(LARGE_FONT, LittleFS);
+      loadDisplayFont(tft, LARGE_FONT);
       tft.drawCentreString("Config Mode", SCREEN_WIDTH / 2, 100, 0);
-      tft.unloadFont();
       
-      tft.loadFont(SMALL_FONT, LittleFS);
+      loadDisplayFont(tft, SMALL_FONT);
       tft.setTextColor(TFT_WHITE);
       tft.drawCentreString("Connect to: " + hotspot_ssid, SCREEN_WIDTH / 2, 160, 0);
       tft.drawCentreString("Password: " + String(hotspot_password), SCREEN_WIDTH / 2, 185, 0);
       tft.drawCentreString("Browse to: http://192.168.4.1", SCREEN_WIDTH / 2, 220, 0);
-      tft.unloadFont();
       
       last_update = millis();
     }
@@ -1199,262 +6110,168 @@ void loop() {
     return;
   }
   
-  unsigned long current_time = millis();
-  bool api_data_fresh = false;
-
-  {
-    String url = router_address + "/rest/interface/ethernet/print";
-    String q = "{\".proplist\": \".id,name,rx-bytes,tx-bytes,running\"}";
-    HTTPClient http;
-    http.setTimeout(5000);
-    http.begin(url);
-    http.setAuthorization(router_login.c_str(), router_password.c_str());
-    http.addHeader("Content-Type", "application/json");
-    int code = http.POST(q);
-    
-    if (code == 200) {
-      String resp = http.getString();
-      DynamicJsonDocument doc(2048);
-      DeserializationError error = deserializeJson(doc, resp);
-      
-      if (error) {
-        Serial.println("Interface data parse error: " + String(error.c_str()));
-      } else if (doc.is<JsonArray>()) {
-        api_data_fresh = true;
-        uint64_t nowMs = millis();
-        
-        for (JsonVariant item : doc.as<JsonArray>()) {
-          const char* sid = item[".id"] | "";
-          if (!sid || sid[0] == '\0') continue;
-          
-          int id = id2int(sid);
-          if (id == 0) continue;
-
-          uint64_t rx = (uint64_t)atoll(item["rx-bytes"] | "0");
-          uint64_t tx = (uint64_t)atoll(item["tx-bytes"] | "0");
-          
-          mt_data_t* iface;
-          if (!ifaces.count(id)) {
-            iface = (mt_data_t*)malloc(sizeof(mt_data_t));
-            if (!iface) {
-              Serial.println("ERROR: Failed to allocate interface memory");
-              continue;
-            }
-            memset(iface, 0, sizeof(mt_data_t));
-            iface->rx = rx;
-            iface->tx = tx;
-            iface->time = nowMs;
-            ifaces[id] = iface;
-            Serial.printf("Initialized interface %d\n", id);
-          } else {
-            iface = ifaces[id];
-            
-            uint64_t elapsed_ms;
-            if (nowMs >= iface->time) {
-              elapsed_ms = nowMs - iface->time;
-            } else {
-              elapsed_ms = (0xFFFFFFFFUL - iface->time) + nowMs + 1;
-            }
-            
-            if (elapsed_ms < 100) {
-              continue;
-            }
-            
-            double dt = elapsed_ms / 1000.0;
-            
-            uint64_t drx = (rx >= iface->rx) ? (rx - iface->rx) : rx;
-            uint64_t dtx = (tx >= iface->tx) ? (tx - iface->tx) : tx;
-            
-            uint64_t rx_bps = (uint64_t)((drx / dt) * 8.0);
-            uint64_t tx_bps = (uint64_t)((dtx / dt) * 8.0);
-            
-            const uint64_t MAX_REASONABLE_BPS = 10ULL * 1024 * 1024 * 1024;
-            
-            if (rx_bps > MAX_REASONABLE_BPS) {
-              Serial.printf("Interface %d: Rejected unrealistic RX: %llu bps\n", id, rx_bps);
-              rx_bps = 0;
-            }
-            
-            if (tx_bps > MAX_REASONABLE_BPS) {
-              Serial.printf("Interface %d: Rejected unrealistic TX: %llu bps\n", id, tx_bps);
-              tx_bps = 0;
-            }
-            
-            int prevIdx = (iface->pos == 0) ? HISTORY_SIZE - 1 : iface->pos - 1;
-            uint64_t prev_rx = iface->hist_rx[prevIdx];
-            uint64_t prev_tx = iface->hist_tx[prevIdx];
-            
-            rx_bps = (rx_bps * 7 + prev_rx * 3) / 10;
-            tx_bps = (tx_bps * 7 + prev_tx * 3) / 10;
-            
-            iface->hist_rx[iface->pos] = rx_bps;
-            iface->hist_tx[iface->pos] = tx_bps;
-            
-            if (++iface->pos >= HISTORY_SIZE) {
-              iface->pos = 0;
-            }
-            
-            iface->rx = rx;
-            iface->tx = tx;
-            iface->time = nowMs;
-          }
-        }
-      }
-    } else if (code > 0) {
-      Serial.printf("Interface fetch HTTP error: %d\n", code);
-    }
-    http.end();
+  static TickType_t last_frame_tick = xTaskGetTickCount();
+  static uint32_t last_snapshot_seq = 0;
+  static router_snapshot_t snap;
+  
+  uint32_t snapshot_seq = readSnapshot(snap);
+  bool snapshot_changed = (snapshot_seq != last_snapshot_seq);
+  last_snapshot_seq = snapshot_seq;
+  
+  poll_attended = backlight_brightness > 0 || events.count() > 0 ||
+                  millis() - web_demand_ms < SCHED_WEB_IDLE_MS;
+  if (poll_attended && snap.counters_ms != 0) {
+    display_age_last_ms = millis() - snap.counters_ms;
+    display_age_max_ms = max(display_age_max_ms, display_age_last_ms);
+    display_age_sum_ms += display_age_last_ms;
+    display_age_frames++;
   }
-
-  fetchRouterInfo();
+  mt_data_t* graph_iface = snap.iface_valid ? &snap.iface : nullptr;
+  
+  if (render_stats_reset) {
+    resetRenderStats();
+    render_stats_reset = false;
+  }
+  unsigned long frame_start_us = micros();
+  
+  // Text is drawn straight to the panel, so last frame's DMA must be done
+  spiFlush();
   
+  unsigned long stage_start_us = micros();
   {
-    const int TOP_TEXT_CLEAR_WIDTH = 338;
-
-    if (routerCurrentMinute == -1 || routerCurrentMinute != last_minute) {
-      fetchTimeFromRouter();
-      last_minute = routerCurrentMinute;
-
-      char timeDisplayBuf[48];
-      snprintf(timeDisplayBuf, sizeof(timeDisplayBuf), "%s %s", routerDateStr, routerTimeStr);
-
-      tft.loadFont(SMALL_FONT, LittleFS);
-      tft.setTextColor(TFT_YELLOW, TFT_BLACK); 
-      tft.setTextPadding(TOP_TEXT_CLEAR_WIDTH);
-      tft.drawString(timeDisplayBuf, 10, 8, 0);
-      tft.unloadFont();
-    }
+    char timeDisplayBuf[48];
+    snprintf(timeDisplayBuf, sizeof(timeDisplayBuf), "%s %s", snap.dateStr, snap.timeStr);
+    drawTextField(time_field, timeDisplayBuf);
 
     {
       uint32_t usedMB = 0;
       uint32_t totalMB = 0;
-      if (routerInfo.memoryTotal > 0) {
-        usedMB = (routerInfo.memoryTotal - routerInfo.memoryFree) / 1024 / 1024;
-        totalMB = routerInfo.memoryTotal / 1024 / 1024;
+      if (snap.info.memoryTotal > 0) {
+        usedMB = (snap.info.memoryTotal - snap.info.memoryFree) / 1024 / 1024;
+        totalMB = snap.info.memoryTotal / 1024 / 1024;
       }
       
       char upBuf[32];
-      formatUptime(routerInfo.uptime, upBuf, sizeof(upBuf));
+      formatUptime(snap.info.uptime, upBuf, sizeof(upBuf));
       char sysBuf[128];
       snprintf(sysBuf, sizeof(sysBuf), "CPU: %.0f%% | RAM: %u/%u MB | Up: %s",
-                routerInfo.cpuLoad, usedMB, totalMB, upBuf);
-
-      tft.loadFont(SMALL_FONT, LittleFS);
-      tft.setTextColor(TFT_YELLOW, TFT_BLACK);
-      tft.setTextPadding(TOP_TEXT_CLEAR_WIDTH);
-      tft.drawString(sysBuf, 10, 30, 0);
-      tft.unloadFont();
+                snap.info.cpuLoad, usedMB, totalMB, upBuf);
+      drawTextField(sys_field, sysBuf);
     }
 
     {
-      mt_data_t* iface = ifaces.count(graph_interface_id) ? ifaces[graph_interface_id] : nullptr;
+      mt_data_t* iface = graph_iface;
       int lastIdx = iface ? ((iface->pos == 0) ? HISTORY_SIZE - 1 : iface->pos - 1) : 0; 
-      double rx_mbps = iface ? iface->hist_rx[lastIdx] / 1024.0 / 1024.0 : 0.0;
-      double tx_mbps = iface ? iface->hist_tx[lastIdx] / 1024.0 / 1024.0 : 0.0;
+      double rx_mbps = iface ? iface->hist_rx[lastIdx] / 1024.0 : 0.0;
+      double tx_mbps = iface ? iface->hist_tx[lastIdx] / 1024.0 : 0.0;
       char speedBuf[64];
       snprintf(speedBuf, sizeof(speedBuf), "TX: %.2f Mbps | RX: %.2f Mbps", tx_mbps, rx_mbps);
-
-      tft.loadFont(SMALL_FONT, LittleFS);
-      tft.setTextColor(TFT_WHITE, TFT_BLACK);
-      tft.setTextPadding(TOP_TEXT_CLEAR_WIDTH);
-      tft.drawString(speedBuf, 10, 52, 0);
-      
-      tft.setTextPadding(0); 
-      tft.unloadFont();
+      drawTextField(speed_field, speedBuf);
     }
   }
+  perfRecord(render_stages[RENDER_STAGE_TEXT], stage_start_us);
 
+  stage_start_us = micros();
   {
-    const int GAUGE_RADIUS = 30;
-    const int GAUGE_THICKNESS = 8;
-    const int GAUGE_Y = 35;
-    const int RAM_GAUGE_X = 380;
-    const int RX_GAUGE_X = 446;
-
     float ramUsagePercent = 0.0;
-    if (routerInfo.memoryTotal > 0) {
-      ramUsagePercent = (float)(routerInfo.memoryTotal - routerInfo.memoryFree) / routerInfo.memoryTotal * 100.0;
+    if (snap.info.memoryTotal > 0) {
+      ramUsagePercent = (float)(snap.info.memoryTotal - snap.info.memoryFree) / snap.info.memoryTotal * 100.0;
     }
 
     float rxUsagePercent = 0.0;
     if (FIXED_MAX_MBPS > FIXED_MIN_MBPS) {
-      mt_data_t* iface = ifaces.count(graph_interface_id) ? ifaces[graph_interface_id] : nullptr;
+      mt_data_t* iface = graph_iface;
       int lastIdx = iface ? ((iface->pos == 0) ? HISTORY_SIZE - 1 : iface->pos - 1) : 0;
-      double rx_mbps = iface ? iface->hist_rx[lastIdx] / 1024.0 / 1024.0 : 0.0;
+      double rx_mbps = iface ? iface->hist_rx[lastIdx] / 1024.0 : 0.0;
       
       rxUsagePercent = (float)((rx_mbps - FIXED_MIN_MBPS) / (FIXED_MAX_MBPS - FIXED_MIN_MBPS)) * 100.0;
       rxUsagePercent = constrain(rxUsagePercent, 0.0, 100.0);
     }
 
-    if (abs(ramUsagePercent - last_ram_percent) > 0.1f) {
-      drawGauge(RAM_GAUGE_X, GAUGE_Y, GAUGE_RADIUS, GAUGE_THICKNESS, ramUsagePercent, "RAM");
-      last_ram_percent = ramUsagePercent;
+    if (abs(ramUsagePercent - ram_gauge.percent) > 0.1f) {
+      drawGauge(ram_gauge, ramUsagePercent);
     }
 
-    if (abs(rxUsagePercent - last_rx_percent) > 0.1f) {
-      drawGauge(RX_GAUGE_X, GAUGE_Y, GAUGE_RADIUS, GAUGE_THICKNESS, rxUsagePercent, "RX%");
-      last_rx_percent = rxUsagePercent;
+    if (abs(rxUsagePercent - rx_gauge.percent) > 0.1f) {
+      drawGauge(rx_gauge, rxUsagePercent);
     }
   }
+  perfRecord(render_stages[RENDER_STAGE_GAUGES], stage_start_us);
 
   {
-    mt_data_t* iface = ifaces.count(graph_interface_id) ? ifaces[graph_interface_id] : nullptr;
-    if (iface && api_data_fresh) {
-      updateRxTotals(iface->rx);
-    }
-
     static uint64_t last_displayed_hour = UINT64_MAX;
     static uint64_t last_displayed_day = UINT64_MAX;
     static uint64_t last_displayed_week = UINT64_MAX;
     static uint64_t last_displayed_month = UINT64_MAX;
 
-    bool totals_changed = (last_displayed_hour != rx_totals.rx_hour) ||
-                          (last_displayed_day != rx_totals.rx_day) ||
-                          (last_displayed_week != rx_totals.rx_week) ||
-                          (last_displayed_month != rx_totals.rx_month);
+    const usage_entry_t* totals = snap.totals.period;
+    bool totals_changed = (last_displayed_hour != totals[USAGE_HOUR].rx) ||
+                          (last_displayed_day != totals[USAGE_DAY].rx) ||
+                          (last_displayed_week != totals[USAGE_WEEK].rx) ||
+                          (last_displayed_month != totals[USAGE_MONTH].rx);
 
-    if (totals_changed) {
-      tft.loadFont(SMALL_FONT, LittleFS);
+    if (totals_changed && display_layout == LAYOUT_SINGLE) {
+      unsigned long totals_start_us = micros();
 
       char totalsStr[100];
       snprintf(totalsStr, sizeof(totalsStr), "1H: %.2f | Day: %.2f | Wk: %.2f | Mo: %.2f - GB",
-                rx_totals.rx_hour / 1024.0 / 1024.0 / 1024.0,
-                rx_totals.rx_day / 1024.0 / 1024.0 / 1024.0,
-                rx_totals.rx_week / 1024.0 / 1024.0 / 1024.0,
-                rx_totals.rx_month / 1024.0 / 1024.0 / 1024.0);
-      
-      tft.setTextColor(TFT_CYAN, TFT_BLACK);
-      tft.setTextPadding(465);
-      tft.drawString(totalsStr, 10, 285, 0);
-      
-      tft.setTextPadding(0);
-      tft.unloadFont();
-
-      last_displayed_hour = rx_totals.rx_hour;
-      last_displayed_day = rx_totals.rx_day;
-      last_displayed_week = rx_totals.rx_week;
-      last_displayed_month = rx_totals.rx_month;
-
-      static unsigned long last_save_time = 0;
-      if (current_time - last_save_time >= 60000) { 
-        saveRxTotals();
-        last_save_time = current_time;
+                totals[USAGE_HOUR].rx / 1024.0 / 1024.0 / 1024.0,
+                totals[USAGE_DAY].rx / 1024.0 / 1024.0 / 1024.0,
+                totals[USAGE_WEEK].rx / 1024.0 / 1024.0 / 1024.0,
+                totals[USAGE_MONTH].rx / 1024.0 / 1024.0 / 1024.0);
+      drawTextField(totals_field, totalsStr);
+
+      last_displayed_hour = totals[USAGE_HOUR].rx;
+      last_displayed_day = totals[USAGE_DAY].rx;
+      last_displayed_week = totals[USAGE_WEEK].rx;
+      last_displayed_month = totals[USAGE_MONTH].rx;
+      perfRecord(render_stages[RENDER_STAGE_TOTALS], totals_start_us);
+    }
+  }
+
+  {
+    static uint32_t last_billing_samples = UINT32_MAX;
+    static uint32_t last_billing_month = UINT32_MAX;
+    const billing_view_t& billing = snap.billing;
+
+    if (display_layout == LAYOUT_SINGLE &&
+        (billing.samples != last_billing_samples || billing.month != last_billing_month)) {
+      unsigned long billing_start_us = micros();
+
+      // This month's 5-minute averages, RX/TX in Mbps
+      char billingStr[80];
+      if (billing.samples == 0) {
+        snprintf(billingStr, sizeof(billingStr), "P95: waiting for the first 5 min sample");
+      } else {
+        snprintf(billingStr, sizeof(billingStr), "P95 %.1f/%.1f | P99 %.1f/%.1f | Max %.1f/%.1f",
+                  billing.rx_p95 / 1024.0, billing.tx_p95 / 1024.0,
+                  billing.rx_p99 / 1024.0, billing.tx_p99 / 1024.0,
+                  billing.rx_max / 1024.0, billing.tx_max / 1024.0);
       }
+      drawTextField(billing_field, billingStr);
+
+      last_billing_samples = billing.samples;
+      last_billing_month = billing.month;
+      perfRecord(render_stages[RENDER_STAGE_TOTALS], billing_start_us);
     }
   }
 
-  if (ifaces.count(graph_interface_id)) {
+  // Tiles stand in for the graph, so they are timed as that stage. Runs every
+  // frame so tiles held back by the push budget don't wait for a new poll.
+  if (display_layout != LAYOUT_SINGLE) {
+    unsigned long tiles_start_us = micros();
+    drawDashboard(snap.dash);
+    perfRecord(render_stages[RENDER_STAGE_GRAPH], tiles_start_us);
+  }
+
+  // The graph only changes when the poller publishes a new sample
+  if (display_layout == LAYOUT_SINGLE && graph_iface && (snapshot_changed || !graph_static_elements_drawn)) {
+    unsigned long graph_start_us = micros();
     const int graph_left = GRAPH_X;
     const int graph_top = GRAPH_Y;
     const int graph_width = GRAPH_W;
     const int graph_height = GRAPH_H;
     const int graph_bottom = GRAPH_BOTTOM;
-    const int graph_inner_height = GRAPH_INNER_H;
-
-    mt_data_t* iface = ifaces[graph_interface_id];
-
-    uint64_t range_bps = FIXED_MAX_BPS - FIXED_MIN_BPS;
-    if (range_bps == 0) range_bps = 1;
 
     if (!sprite_created && !graph_static_elements_drawn) {
       initGraphSprite();
@@ -1465,10 +6282,10 @@ void loop() {
     }
 
     if (!graph_static_elements_drawn) {
+      spiFlush();
       tft.drawRect(graph_left, graph_top, graph_width, graph_height, TFT_WHITE);
       
       tft.setTextColor(TFT_WHITE);
-      tft.loadFont(SMALL_FONT, LittleFS);
 
       double step = (FIXED_MAX_MBPS - FIXED_MIN_MBPS) / 4.0;
       char ybuf[12];
@@ -1491,75 +6308,19 @@ void loop() {
       }
       tft.drawString("Mbps", graph_left - 55, graph_top - 25, 0);
 
-      char xbuf[8];
-      for (int i = 0; i <= HISTORY_SIZE; i += 10) {
-        int x = graph_left + i * graph_width / HISTORY_SIZE;
-        snprintf(xbuf, sizeof(xbuf), "%ds", HISTORY_SIZE - i);
-        tft.drawCentreString(xbuf, x, graph_bottom + 5, 0);
-      }
-
-      tft.unloadFont();
       graph_static_elements_drawn = true;
     }
+    
+    if (graph_axis_window != snap.graph.window) {
+      spiFlush();
+      drawGraphTimeAxis(snap.graph);
+    }
 
     if (sprite_created) {
-      graphSprite.fillSprite(TFT_BLACK);
-
-      for (int i = 1; i < 4; i++) {
-        int y = i * (graph_height / 4);
-        graphSprite.drawFastHLine(0, y, graph_width, TFT_DARKGREY);
-      }
-      graphSprite.drawFastHLine(0, graph_height - 1, graph_width, TFT_DARKGREY);
-
-      int p = iface->pos;
-      int prev_x = -1, prev_rx_y = -1, prev_tx_y = -1;
-      bool first_point = true;
-
-      for (int i = 0; i < HISTORY_SIZE; i++) {
-        if (p >= HISTORY_SIZE) p = 0; 
-        uint64_t bits_rx = iface->hist_rx[p];
-        uint64_t bits_tx = iface->hist_tx[p];
-
-        int rx_h, tx_h;
-        
-        if (bits_rx <= FIXED_MIN_BPS) {
-          rx_h = 0;
-        } else if (bits_rx >= FIXED_MAX_BPS) {
-          rx_h = graph_inner_height;
-        } else {
-          rx_h = (int)(((bits_rx - FIXED_MIN_BPS) * (uint64_t)graph_inner_height) / range_bps);
-        }
-        
-        if (bits_tx <= FIXED_MIN_BPS) {
-          tx_h = 0;
-        } else if (bits_tx >= FIXED_MAX_BPS) {
-          tx_h = graph_inner_height;
-        } else {
-          tx_h = (int)(((bits_tx - FIXED_MIN_BPS) * (uint64_t)graph_inner_height) / range_bps);
-        }
-
-        rx_h = constrain(rx_h, 0, graph_inner_height);
-        tx_h = constrain(tx_h, 0, graph_inner_height);
-
-        int current_x = (i * graph_width) / (HISTORY_SIZE - 1);
-        int current_rx_y = (graph_height - 1) - rx_h; 
-        int current_tx_y = (graph_height - 1) - tx_h;
-
-        if (prev_x != -1 && !first_point) {
-          draw_thick_line_sprite(graphSprite, prev_x, prev_tx_y, current_x, current_tx_y, GRAPH_COLOR_TX, LINE_THICKNESS);
-          draw_thick_line_sprite(graphSprite, prev_x, prev_rx_y, current_x, current_rx_y, GRAPH_COLOR_RX, LINE_THICKNESS);
-        }
-
-        prev_x = current_x;
-        prev_rx_y = current_rx_y;
-        prev_tx_y = current_tx_y;
-        first_point = false;
-        p++;
-      }
-
-      graphSprite.pushSprite(graph_left + 1, graph_top + 1);
+      drawGraphSprite(&snap.graph);
       
     } else {
+      spiFlush();
       tft.fillRect(graph_left + 1, graph_top + 1, graph_width - 2, graph_height - 2, TFT_BLACK);
 
       for (int i = 1; i < 4; i++) {
@@ -1568,53 +6329,42 @@ void loop() {
       }
       tft.drawFastHLine(graph_left + 1, graph_bottom - 1, graph_width - 2, TFT_DARKGREY);
       
-      int p = iface->pos;
-      int prev_x = -1, prev_rx_y = -1, prev_tx_y = -1;
-      bool first_point = true;
-
-      for (int i = 0; i < HISTORY_SIZE; i++) {
-        if (p >= HISTORY_SIZE) p = 0;
-        uint64_t bits_rx = iface->hist_rx[p];
-        uint64_t bits_tx = iface->hist_tx[p];
-
-        int rx_h, tx_h;
-        
-        if (bits_rx <= FIXED_MIN_BPS) {
-          rx_h = 0;
-        } else if (bits_rx >= FIXED_MAX_BPS) {
-          rx_h = graph_inner_height;
-        } else {
-          rx_h = (int)(((bits_rx - FIXED_MIN_BPS) * (uint64_t)graph_inner_height) / range_bps);
-        }
+      const graph_view_t& view = snap.graph;
+      for (int i = 0; i < view.points; i++) {
+        const graph_column_t* c = graphColumn(view, i);
+        if (!c) continue;
+        int x = graph_left + graphColumnX(view, i);
+        int prev;
+        const graph_column_t* p = graphPrevColumn(view, i, prev);
         
-        if (bits_tx <= FIXED_MIN_BPS) {
-          tx_h = 0;
-        } else if (bits_tx >= FIXED_MAX_BPS) {
-          tx_h = graph_inner_height;
-        } else {
-          tx_h = (int)(((bits_tx - FIXED_MIN_BPS) * (uint64_t)graph_inner_height) / range_bps);
-        }
-
-        rx_h = constrain(rx_h, 0, graph_inner_height);
-        tx_h = constrain(tx_h, 0, graph_inner_height);
-
-        int current_x = graph_left + (i * graph_width) / (HISTORY_SIZE - 1);
-        int current_rx_y = (graph_bottom - 1) - rx_h;
-        int current_tx_y = (graph_bottom - 1) - tx_h;
-
-        if (prev_x != -1 && !first_point) {
-          tft.drawLine(prev_x, prev_tx_y, current_x, current_tx_y, GRAPH_COLOR_TX);
-          tft.drawLine(prev_x, prev_rx_y, current_x, current_rx_y, GRAPH_COLOR_RX);
+        if (p) {
+          int prev_x = graph_left + graphColumnX(view, prev);
+          tft.drawLine(prev_x, (graph_bottom - 1) - p->tx_hi, x, (graph_bottom - 1) - c->tx_hi, GRAPH_COLOR_TX);
+          tft.drawLine(prev_x, (graph_bottom - 1) - p->rx_hi, x, (graph_bottom - 1) - c->rx_hi, GRAPH_COLOR_RX);
         }
-
-        prev_x = current_x;
-        prev_rx_y = current_rx_y;
-        prev_tx_y = current_tx_y;
-        first_point = false;
-        p++;
+        tft.drawFastVLine(x, (graph_bottom - 1) - c->tx_hi, c->tx_hi - c->tx_lo + 1, GRAPH_COLOR_TX);
+        tft.drawFastVLine(x, (graph_bottom - 1) - c->rx_hi, c->rx_hi - c->rx_lo + 1, GRAPH_COLOR_RX);
       }
     }
+    perfRecord(render_stages[RENDER_STAGE_GRAPH], graph_start_us);
   }
   
-  delay(500);
-}
\ No newline at end of file
+  perfRecord(render_frame, frame_start_us);
+  render_frames++;
+  
+  if (snapshot_changed) {
+    pushStatsFrame(snap, snapshot_seq);
+  }
+  
+  static unsigned long last_graph_report = 0;
+  if (millis() - last_graph_report >= 60000) {
+    reportRenderStats();
+    last_graph_report = millis();
+  }
+  
+  // Fixed cadence independent of how long the router takes to answer
+  if (xTaskGetTickCount() - last_frame_tick > pdMS_TO_TICKS(FRAME_INTERVAL_MS)) {
+    last_frame_tick = xTaskGetTickCount();
+  }
+  vTaskDelayUntil(&last_frame_tick, pdMS_TO_TICKS(FRAME_INTERVAL_MS));
+}
@@ -0,0 +1,133 @@
+// Gauge microbenchmark. Boots the sketch, then redraws the RAM and RX%
+// gauges through value sequences (steady, rising, falling, swinging) and
+// reports per redraw the host CPU time, the pixels drawn into the sprite,
+// the SPI bytes pushed and how many redraws took the full or the delta path.
+// Every delta redraw is also compared with a full redraw of the same value;
+// the exit code is non-zero if any differ.
+//
+//   bench_gauge [--draws N]
+#include "sketch.h"
+
+#include <cmath>
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace {
+
+double threadCpuUs() {
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+struct Result {
+  uint32_t draws = 0;
+  double cpu_us = 0;
+  uint64_t sprite_pixels = 0;
+  uint64_t spi_bytes = 0;
+  uint32_t full = 0;
+  uint32_t delta = 0;
+  uint32_t mismatches = 0;
+};
+
+void drawMeasured(gauge_t& g, float pct, Result& r) {
+  mock::TftStats before = mock::tft_stats;
+  uint32_t full_before = gauge_full_draws, delta_before = gauge_delta_draws;
+  double start = threadCpuUs();
+  drawGauge(g, pct);
+  spiFlush();
+  r.cpu_us += threadCpuUs() - start;
+  r.draws++;
+  r.sprite_pixels += mock::tft_stats.sprite_pixels - before.sprite_pixels;
+  r.spi_bytes += mock::tft_stats.spi_bytes - before.spi_bytes;
+  r.full += gauge_full_draws - full_before;
+  r.delta += gauge_delta_draws - delta_before;
+}
+
+// The sprite after this redraw against a full redraw of the same value
+bool matchesFullDraw(gauge_t& g, float pct) {
+  const size_t n = GAUGE_SIZE * GAUGE_SIZE;
+  std::vector<uint16_t> drawn;
+  {
+    mock::HeapPause pause;
+    drawn.assign((uint16_t*)g.spr->getPointer(), (uint16_t*)g.spr->getPointer() + n);
+  }
+  g.valid = false;
+  drawGauge(g, pct);
+  return memcmp(drawn.data(), g.spr->getPointer(), n * 2) == 0;
+}
+
+Result run(gauge_t& g, const std::vector<float>& values, bool invalidate) {
+  Result r;
+  g.valid = false;
+  drawGauge(g, values[0]);
+  for (size_t i = 1; i < values.size(); i++) {
+    if (invalidate) g.valid = false;
+    drawMeasured(g, values[i], r);
+  }
+  // Second pass for exactness, outside the timing
+  g.valid = false;
+  drawGauge(g, values[0]);
+  for (size_t i = 1; i < values.size(); i++) {
+    uint32_t delta_before = gauge_delta_draws;
+    drawGauge(g, values[i]);
+    if (gauge_delta_draws != delta_before && !matchesFullDraw(g, values[i])) r.mismatches++;
+  }
+  return r;
+}
+
+void report(const char* gauge, const char* name, const Result& r) {
+  double n = r.draws ? r.draws : 1;
+  printf("%-5s %-9s %6u %9.1f %10.0f %10.0f %6u %6u %6u\n", gauge, name, r.draws, r.cpu_us / n, r.sprite_pixels / n,
+         r.spi_bytes / n, r.full, r.delta, r.mismatches);
+}
+
+int argInt(int argc, char** argv, const char* name, int def) {
+  for (int i = 1; i + 1 < argc; i++) {
+    if (strcmp(argv[i], name) == 0) return atoi(argv[i + 1]);
+  }
+  return def;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int draws = argInt(argc, argv, "--draws", 400);
+
+  mock::RouterModel model(8);
+  mock::RestRouter rest(model);
+  host::boot();
+  host::frames(10);
+
+  std::vector<float> steady, rising, falling, swing;
+  {
+    mock::HeapPause pause;
+    for (int i = 0; i <= draws; i++) {
+      steady.push_back(41.0f + 0.1f * (i % 3));            // RAM use moving in the last digit
+      rising.push_back(5.0f + 90.0f * i / draws);           // traffic ramping up
+      falling.push_back(95.0f - 90.0f * i / draws);
+      swing.push_back(50.0f + 45.0f * sinf(i * 0.7f));      // bursty RX
+    }
+  }
+
+  uint32_t mismatches = 0;
+  printf("%-5s %-9s %6s %9s %10s %10s %6s %6s %6s\n", "gauge", "values", "draws", "cpu_us", "sprite_px", "spi_bytes",
+         "full", "delta", "diff");
+  gauge_t* gauges[] = { &ram_gauge, &rx_gauge };
+  for (gauge_t* g : gauges) {
+    struct {
+      const char* name;
+      const std::vector<float>* values;
+      bool invalidate;
+    } series[] = { { "steady", &steady, false }, { "rising", &rising, false }, { "falling", &falling, false },
+                   { "swing", &swing, false }, { "full", &swing, true } };
+    for (const auto& s : series) {
+      Result r = run(*g, *s.values, s.invalidate);
+      report(g->label, s.name, r);
+      mismatches += r.mismatches;
+    }
+  }
+  printf("\ngauge redraws: %u full, %u delta\n", gauge_full_draws, gauge_delta_draws);
+  return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,208 @@
+// Render benchmark. Boots the sketch against the fake router, runs loop()
+// for a number of frames and reports, per frame and per drawing stage, the
+// host CPU time, pixels and SPI bytes sent to the panel and the heap
+// high-water above the level before the call.
+//
+//   bench_render [--frames N] [--ifaces N] [--transport rest|api]
+//                [--window 1m|10m|1h|24h|7d]
+//
+// CPU time is the main thread's own (CLOCK_THREAD_CPUTIME_ID), so the
+// poller running during the frame wait is not charged to loop(); it is
+// reported separately. Absolute times are host times, useful for comparing
+// changes rather than as ESP32 numbers; pixels, bytes and heap are exact.
+#include "sketch.h"
+
+#include <algorithm>
+#include <ctime>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Sample {
+  double cpu_us;
+  uint64_t pixels;
+  uint64_t spi_bytes;
+  uint64_t windows;
+  int64_t heap_peak;
+};
+
+struct Series {
+  const char* name;
+  std::vector<Sample> samples;
+
+  // The bench's own bookkeeping stays out of the sketch's heap figures
+  void add(const Sample& s) {
+    mock::HeapPause pause;
+    samples.push_back(s);
+  }
+};
+
+double threadCpuUs() {
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+Sample measure(const std::function<void()>& fn) {
+  mock::TftStats before = mock::tft_stats;
+  int64_t live = mock::heap_live();
+  mock::heap_mark();
+  double start = threadCpuUs();
+  fn();
+  Sample s;
+  s.cpu_us = threadCpuUs() - start;
+  s.pixels = mock::tft_stats.panel_pixels - before.panel_pixels;
+  s.spi_bytes = mock::tft_stats.spi_bytes - before.spi_bytes;
+  s.windows = mock::tft_stats.transactions - before.transactions;
+  s.heap_peak = std::max<int64_t>(0, mock::heap_peak_since_mark() - live);
+  return s;
+}
+
+template <typename T>
+T percentile(std::vector<T> v, double p) {
+  if (v.empty()) return T();
+  std::sort(v.begin(), v.end());
+  return v[std::min(v.size() - 1, (size_t)(p * (v.size() - 1) + 0.5))];
+}
+
+void report(const Series& s) {
+  std::vector<double> cpu;
+  std::vector<uint64_t> px, bytes, win;
+  std::vector<int64_t> heap;
+  for (const auto& x : s.samples) {
+    cpu.push_back(x.cpu_us);
+    px.push_back(x.pixels);
+    bytes.push_back(x.spi_bytes);
+    win.push_back(x.windows);
+    heap.push_back(x.heap_peak);
+  }
+  double cpu_sum = 0;
+  uint64_t px_sum = 0, bytes_sum = 0;
+  for (size_t i = 0; i < cpu.size(); i++) cpu_sum += cpu[i], px_sum += px[i], bytes_sum += bytes[i];
+  size_t n = std::max<size_t>(1, s.samples.size());
+  printf("%-14s %6zu %9.1f %9.1f %9.1f %10.0f %10llu %11.0f %10llu %8.1f %9lld\n", s.name, s.samples.size(),
+         cpu_sum / n, percentile(cpu, 0.95), percentile(cpu, 1.0), (double)px_sum / n,
+         (unsigned long long)percentile(px, 1.0), (double)bytes_sum / n, (unsigned long long)percentile(bytes, 1.0),
+         (double)std::accumulate(win.begin(), win.end(), 0ULL) / n, (long long)percentile(heap, 1.0));
+}
+
+int argInt(int argc, char** argv, const char* name, int def) {
+  for (int i = 1; i + 1 < argc; i++) {
+    if (strcmp(argv[i], name) == 0) return atoi(argv[i + 1]);
+  }
+  return def;
+}
+
+const char* argStr(int argc, char** argv, const char* name, const char* def) {
+  for (int i = 1; i + 1 < argc; i++) {
+    if (strcmp(argv[i], name) == 0) return argv[i + 1];
+  }
+  return def;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int frames = argInt(argc, argv, "--frames", 600);
+  const int ifaces = argInt(argc, argv, "--ifaces", 8);
+  const std::string transport = argStr(argc, argv, "--transport", "rest");
+  const std::string window = argStr(argc, argv, "--window", "1m");
+  const std::string layout = argStr(argc, argv, "--layout", "single");
+
+  host::BootOptions opts;
+  opts.transport = transport == "api" ? ROUTER_TRANSPORT_API : ROUTER_TRANSPORT_REST;
+  for (int w = 0; w < GRAPH_WINDOW_COUNT; w++) {
+    if (window == GRAPH_WINDOWS[w].name) opts.window = w;
+  }
+  for (int l = 0; l < LAYOUT_COUNT; l++) {
+    if (layout == LAYOUT_NAMES[l]) opts.layout = l;
+  }
+
+  mock::RouterModel model(ifaces);
+  mock::RestRouter rest(model);
+  mock::ApiRouter api(model);
+  api.password = "secret";
+
+  {
+    // stdout's buffer is the bench's, not the sketch's
+    mock::HeapPause pause;
+    printf("%d interfaces, %s, %s layout, window %s, %d frames\n", ifaces, transport.c_str(),
+           LAYOUT_NAMES[opts.layout], window.c_str(), frames);
+    fflush(stdout);
+  }
+  mock::clock_realtime(true);
+  host::boot(opts);
+  // Let the splash clear and the graph fill before measuring
+  host::frames(30);
+
+  Series frame = { "loop()", {} };
+  for (int i = 0; i < frames; i++) frame.add(measure([] { loop(); }));
+
+  // Each stage on its own, with the data the last frame drew
+  router_snapshot_t snap;
+  readSnapshot(snap);
+  Series text = { "text", {} }, gauges = { "gauges", {} }, graph = { "graph", {} },
+         graph_full = { "graph (full)", {} }, tiles = { "tiles", {} };
+  const int stage_runs = std::max(20, frames / 5);
+  char buf[128];
+  for (int i = 0; i < stage_runs; i++) {
+    snprintf(buf, sizeof(buf), "TX: %.2f Mbps | RX: %.2f Mbps", 12.0 + i * 0.37, 80.0 + i * 1.13);
+    text.add(measure([&] { drawTextField(speed_field, buf); }));
+    float pct = 20.0f + (i * 7) % 60;
+    gauges.add(measure([&] {
+      drawGauge(ram_gauge, pct);
+      drawGauge(rx_gauge, 100.0f - pct);
+    }));
+    if (sprite_created) {
+      // One new sample scrolls the view by one column, as after a poll
+      snap.graph.newest++;
+      graph.add(measure([&] {
+        drawGraphSprite(&snap.graph);
+        spiFlush();
+      }));
+    }
+  }
+  for (int i = 0; i < stage_runs && dash_buf_count > 0; i++) {
+    // Every tile has a new sample, as after a poll; the push credit decides
+    // how many of them this frame draws
+    memset(dash_drawn_samples, 0xFF, sizeof(dash_drawn_samples));
+    tiles.add(measure([&] {
+      drawDashboard(snap.dash);
+      spiFlush();
+    }));
+  }
+  for (int i = 0; i < stage_runs && sprite_created; i++) {
+    // A window or scale change redraws the whole plot
+    snap.graph.generation++;
+    graph_full.add(measure([&] {
+      drawGraphSprite(&snap.graph);
+      spiFlush();
+    }));
+  }
+  mock::clock_realtime(false);
+  uint32_t free_heap = ESP.getFreeHeap(), min_heap = ESP.getMinFreeHeap(), max_alloc = ESP.getMaxAllocHeap();
+
+  printf("%-14s %6s %9s %9s %9s %10s %10s %11s %10s %8s %9s\n", "stage", "runs", "cpu_us", "p95_us", "max_us",
+         "pixels", "max_px", "spi_bytes", "max_bytes", "windows", "heap_hw");
+  report(frame);
+  report(text);
+  report(gauges);
+  if (!graph.samples.empty()) report(graph);
+  if (!graph_full.samples.empty()) report(graph_full);
+  if (!tiles.samples.empty()) report(tiles);
+
+  printf("\nsketch histograms (host us): frame avg %llu max %u over %u frames\n",
+         render_frame.runs ? (unsigned long long)(render_frame.total_us / render_frame.runs) : 0ULL,
+         render_frame.max_us, render_frame.runs);
+  for (int i = 0; i < RENDER_STAGE_COUNT; i++) {
+    const perf_hist_t& st = render_stages[i];
+    printf("  %-8s runs %6u avg %6llu max %6u\n", RENDER_STAGE_NAMES[i], st.runs,
+           st.runs ? (unsigned long long)(st.total_us / st.runs) : 0ULL, st.max_us);
+  }
+  printf("poller cpu %.1f ms, heap free %u (min %u, largest %u)\n", mock::task_cpu_us("router_poll") / 1000.0,
+         free_heap, min_heap, max_alloc);
+  return frame.samples.size() == (size_t)frames ? 0 : 1;
+}
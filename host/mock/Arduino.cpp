@@ -0,0 +1,245 @@
+#include "Arduino.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+HardwareSerial Serial;
+EspClass ESP;
+
+// ==================== STRING ====================
+static std::string toBase(unsigned long long v, unsigned char base, bool negative) {
+  if (base < 2 || base > 36) base = 10;
+  char buf[72];
+  int i = sizeof(buf) - 1;
+  buf[i] = 0;
+  do {
+    int d = v % base;
+    buf[--i] = d < 10 ? '0' + d : 'a' + d - 10;
+    v /= base;
+  } while (v);
+  if (negative) buf[--i] = '-';
+  return std::string(buf + i);
+}
+
+String::String(long v, unsigned char base) : s_(toBase(v < 0 ? -(unsigned long long)v : v, base, v < 0)) {}
+String::String(unsigned long v, unsigned char base) : s_(toBase(v, base, false)) {}
+String::String(long long v, unsigned char base) : s_(toBase(v < 0 ? -(unsigned long long)v : v, base, v < 0)) {}
+String::String(unsigned long long v, unsigned char base) : s_(toBase(v, base, false)) {}
+
+String::String(double v, unsigned int decimals) {
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.*f", (int)decimals, v);
+  s_ = buf;
+}
+
+bool String::equalsIgnoreCase(const String& o) const {
+  if (s_.size() != o.s_.size()) return false;
+  for (size_t i = 0; i < s_.size(); i++)
+    if (tolower((unsigned char)s_[i]) != tolower((unsigned char)o.s_[i])) return false;
+  return true;
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+  if (from > to) std::swap(from, to);
+  if (from >= s_.size()) return String();
+  if (to > s_.size()) to = s_.size();
+  return String(s_.substr(from, to - from));
+}
+
+void String::replace(const String& from, const String& to) {
+  if (from.s_.empty()) return;
+  size_t p = 0;
+  while ((p = s_.find(from.s_, p)) != std::string::npos) {
+    s_.replace(p, from.s_.size(), to.s_);
+    p += to.s_.size();
+  }
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+  if (index >= s_.size()) return;
+  s_.erase(index, count);
+}
+
+void String::trim() {
+  size_t b = 0, e = s_.size();
+  while (b < e && isspace((unsigned char)s_[b])) b++;
+  while (e > b && isspace((unsigned char)s_[e - 1])) e--;
+  s_ = s_.substr(b, e - b);
+}
+
+void String::toLowerCase() {
+  for (auto& c : s_) c = tolower((unsigned char)c);
+}
+
+void String::toUpperCase() {
+  for (auto& c : s_) c = toupper((unsigned char)c);
+}
+
+// ==================== PRINT ====================
+size_t Print::write(const uint8_t* buf, size_t n) {
+  size_t done = 0;
+  while (done < n && write(buf[done])) done++;
+  return done;
+}
+
+size_t Print::print(long v, int base) { return print(String(v, (unsigned char)base)); }
+size_t Print::print(unsigned long v, int base) { return print(String(v, (unsigned char)base)); }
+size_t Print::print(long long v, int base) { return print(String(v, (unsigned char)base)); }
+size_t Print::print(unsigned long long v, int base) { return print(String(v, (unsigned char)base)); }
+size_t Print::print(double v, int digits) { return print(String(v, digits)); }
+
+size_t Print::printf(const char* fmt, ...) {
+  char small[256];
+  va_list ap;
+  va_start(ap, fmt);
+  int n = vsnprintf(small, sizeof(small), fmt, ap);
+  va_end(ap);
+  if (n < 0) return 0;
+  if ((size_t)n < sizeof(small)) return write((const uint8_t*)small, n);
+  std::string big(n + 1, '\0');
+  va_start(ap, fmt);
+  vsnprintf(&big[0], big.size(), fmt, ap);
+  va_end(ap);
+  return write((const uint8_t*)big.data(), n);
+}
+
+// ==================== STREAM ====================
+// Same contract as the core: wait up to the stream timeout for each byte.
+int Stream::timedRead() {
+  unsigned long start = millis();
+  do {
+    int c = read();
+    if (c >= 0) return c;
+    delay(1);
+  } while (millis() - start < timeout_ms_);
+  return -1;
+}
+
+int Stream::timedPeek() {
+  unsigned long start = millis();
+  do {
+    int c = peek();
+    if (c >= 0) return c;
+    delay(1);
+  } while (millis() - start < timeout_ms_);
+  return -1;
+}
+
+bool Stream::find(const char* target) { return findUntil(target, nullptr); }
+
+bool Stream::find(const char* target, size_t len) {
+  std::string t(target, len);
+  return findUntil(t.c_str(), nullptr);
+}
+
+bool Stream::findUntil(const char* target, const char* terminator) {
+  size_t tlen = strlen(target), termlen = terminator ? strlen(terminator) : 0;
+  if (tlen == 0) return true;
+  size_t matched = 0, term_matched = 0;
+  for (;;) {
+    int c = timedRead();
+    if (c < 0) return false;
+    if (c == target[matched]) {
+      if (++matched == tlen) return true;
+    } else {
+      matched = (c == target[0]) ? 1 : 0;
+    }
+    if (termlen) {
+      if (c == terminator[term_matched]) {
+        if (++term_matched == termlen) return false;
+      } else {
+        term_matched = (c == terminator[0]) ? 1 : 0;
+      }
+    }
+  }
+}
+
+size_t Stream::readBytes(char* buf, size_t n) {
+  size_t count = 0;
+  while (count < n) {
+    int c = timedRead();
+    if (c < 0) break;
+    buf[count++] = (char)c;
+  }
+  return count;
+}
+
+String Stream::readString() {
+  String out;
+  int c;
+  while ((c = timedRead()) >= 0) out += (char)c;
+  return out;
+}
+
+String Stream::readStringUntil(char terminator) {
+  String out;
+  int c;
+  while ((c = timedRead()) >= 0 && c != terminator) out += (char)c;
+  return out;
+}
+
+// ==================== SERIAL ====================
+namespace {
+std::string& serialBuffer() {
+  static std::string* log = [] {
+    mock::HeapPause pause;
+    return new std::string();
+  }();
+  return *log;
+}
+const bool serial_echo = getenv("MOCK_VERBOSE") != nullptr;
+uint32_t restart_count = 0;
+}  // namespace
+
+size_t HardwareSerial::write(uint8_t c) { return write(&c, 1); }
+
+size_t HardwareSerial::write(const uint8_t* buf, size_t n) {
+  mock::HeapPause pause;
+  std::string& log = serialBuffer();
+  if (log.size() > (1u << 20)) log.erase(0, log.size() / 2);
+  log.append((const char*)buf, n);
+  if (serial_echo) fwrite(buf, 1, n, stdout);
+  return n;
+}
+
+const std::string& mock::serial_log() { return serialBuffer(); }
+
+void mock::serial_clear() {
+  mock::HeapPause pause;
+  serialBuffer().clear();
+}
+
+uint32_t mock::restarts() { return restart_count; }
+
+void EspClass::restart() {
+  restart_count++;
+  Serial.println("[mock] ESP.restart() requested");
+}
+
+// ==================== NETWORK ADDRESS ====================
+bool IPAddress::fromString(const String& s) {
+  unsigned a, b, c, d;
+  if (sscanf(s.c_str(), "%u.%u.%u.%u", &a, &b, &c, &d) != 4 || a > 255 || b > 255 || c > 255 || d > 255)
+    return false;
+  b_[0] = a;
+  b_[1] = b;
+  b_[2] = c;
+  b_[3] = d;
+  return true;
+}
+
+String IPAddress::toString() const {
+  char buf[16];
+  snprintf(buf, sizeof(buf), "%u.%u.%u.%u", b_[0], b_[1], b_[2], b_[3]);
+  return String(buf);
+}
+
+// ==================== MISC ====================
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  if (in_max == in_min) return out_min;
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+void pinMode(int, int) {}
+void analogWrite(int, int) {}
+void digitalWrite(int, int) {}
@@ -0,0 +1,238 @@
+// Host stand-in for the ESP32 Arduino core: String, Print/Stream, Serial,
+// ESP and the clock. Time is virtual and driven by the task simulator in
+// mock_rtos.cpp, so delay() and vTaskDelayUntil() cost nothing on the host.
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdarg>
+#include <cmath>
+#include <cctype>
+#include <string>
+#include <functional>
+#include <algorithm>
+#include <atomic>
+
+#include "freertos_mock.h"
+
+typedef uint8_t byte;
+typedef bool boolean;
+using std::min;
+using std::max;
+using std::abs;
+
+#define PI 3.1415926535897932384626433832795
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+#define PROGMEM
+#define F(x) x
+#define PSTR(x) x
+#define IRAM_ATTR
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define pgm_read_byte(p) (*(const uint8_t*)(p))
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+#define OUTPUT 0x03
+#define INPUT 0x01
+#define HIGH 1
+#define LOW 0
+
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void yield();
+int64_t esp_timer_get_time();
+void pinMode(int pin, int mode);
+void analogWrite(int pin, int value);
+void digitalWrite(int pin, int value);
+
+// ==================== STRING ====================
+class String {
+ public:
+  String() {}
+  String(const char* c) : s_(c ? c : "") {}
+  String(const std::string& s) : s_(s) {}
+  String(const String&) = default;
+  String(String&&) = default;
+  explicit String(char c) : s_(1, c) {}
+  explicit String(unsigned char v, unsigned char base = 10) : String((unsigned long)v, base) {}
+  explicit String(int v, unsigned char base = 10) : String((long)v, base) {}
+  explicit String(unsigned int v, unsigned char base = 10) : String((unsigned long)v, base) {}
+  explicit String(long v, unsigned char base = 10);
+  explicit String(unsigned long v, unsigned char base = 10);
+  explicit String(long long v, unsigned char base = 10);
+  explicit String(unsigned long long v, unsigned char base = 10);
+  explicit String(float v, unsigned int decimals = 2) : String((double)v, decimals) {}
+  explicit String(double v, unsigned int decimals = 2);
+
+  String& operator=(const String&) = default;
+  String& operator=(String&&) = default;
+  String& operator=(const char* c) { s_ = c ? c : ""; return *this; }
+
+  const char* c_str() const { return s_.c_str(); }
+  unsigned int length() const { return s_.size(); }
+  bool isEmpty() const { return s_.empty(); }
+  bool reserve(unsigned int n) { s_.reserve(n); return true; }
+  const std::string& str() const { return s_; }
+  std::string& str() { return s_; }
+
+  bool concat(const String& o) { s_ += o.s_; return true; }
+  bool concat(const char* c) { if (c) s_ += c; return true; }
+  bool concat(const char* c, unsigned int n) { s_.append(c, n); return true; }
+  bool concat(char c) { s_ += c; return true; }
+  String& operator+=(const String& o) { s_ += o.s_; return *this; }
+  String& operator+=(const char* c) { if (c) s_ += c; return *this; }
+  String& operator+=(char c) { s_ += c; return *this; }
+  String& operator+=(int v) { s_ += std::to_string(v); return *this; }
+  String& operator+=(unsigned int v) { s_ += std::to_string(v); return *this; }
+  String& operator+=(long v) { s_ += std::to_string(v); return *this; }
+  String& operator+=(unsigned long v) { s_ += std::to_string(v); return *this; }
+  String& operator+=(long long v) { s_ += std::to_string(v); return *this; }
+  String& operator+=(unsigned long long v) { s_ += std::to_string(v); return *this; }
+  String& operator+=(double v) { *this += String(v); return *this; }
+
+  friend String operator+(const String& a, const String& b) { return String(a.s_ + b.s_); }
+  friend String operator+(const String& a, const char* b) { return String(a.s_ + (b ? b : "")); }
+  friend String operator+(const char* a, const String& b) { return String((a ? a : "") + b.s_); }
+  friend String operator+(const String& a, char c) { return String(a.s_ + c); }
+  friend String operator+(const String& a, int v) { return String(a.s_ + std::to_string(v)); }
+  friend String operator+(const String& a, unsigned int v) { return String(a.s_ + std::to_string(v)); }
+  friend String operator+(const String& a, long v) { return String(a.s_ + std::to_string(v)); }
+  friend String operator+(const String& a, unsigned long v) { return String(a.s_ + std::to_string(v)); }
+  friend String operator+(const String& a, unsigned long long v) { return String(a.s_ + std::to_string(v)); }
+  friend String operator+(const String& a, double v) { return a + String(v); }
+
+  bool operator==(const String& o) const { return s_ == o.s_; }
+  bool operator!=(const String& o) const { return s_ != o.s_; }
+  bool operator==(const char* c) const { return s_ == (c ? c : ""); }
+  bool operator!=(const char* c) const { return !(*this == c); }
+  bool operator<(const String& o) const { return s_ < o.s_; }
+  bool equals(const String& o) const { return s_ == o.s_; }
+  bool equalsIgnoreCase(const String& o) const;
+  char operator[](unsigned int i) const { return i < s_.size() ? s_[i] : 0; }
+  char& operator[](unsigned int i) { return s_[i]; }
+  char charAt(unsigned int i) const { return (*this)[i]; }
+
+  bool startsWith(const String& p) const { return s_.compare(0, p.s_.size(), p.s_) == 0; }
+  bool endsWith(const String& p) const {
+    return s_.size() >= p.s_.size() && s_.compare(s_.size() - p.s_.size(), p.s_.size(), p.s_) == 0;
+  }
+  int indexOf(char c, unsigned int from = 0) const { return pos(s_.find(c, from)); }
+  int indexOf(const char* c, unsigned int from = 0) const { return pos(s_.find(c, from)); }
+  int indexOf(const String& c, unsigned int from = 0) const { return pos(s_.find(c.s_, from)); }
+  int lastIndexOf(char c) const { return pos(s_.rfind(c)); }
+  int lastIndexOf(const String& c) const { return pos(s_.rfind(c.s_)); }
+  String substring(unsigned int from) const { return from >= s_.size() ? String() : String(s_.substr(from)); }
+  String substring(unsigned int from, unsigned int to) const;
+  void replace(const String& from, const String& to);
+  void remove(unsigned int index, unsigned int count = (unsigned int)-1);
+  void trim();
+  void toLowerCase();
+  void toUpperCase();
+  long toInt() const { return strtol(s_.c_str(), nullptr, 10); }
+  float toFloat() const { return (float)atof(s_.c_str()); }
+  double toDouble() const { return atof(s_.c_str()); }
+
+ protected:
+  static int pos(size_t p) { return p == std::string::npos ? -1 : (int)p; }
+  std::string s_;
+};
+
+// ==================== PRINT / STREAM ====================
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buf, size_t n);
+  size_t write(const char* s) { return s ? write((const uint8_t*)s, strlen(s)) : 0; }
+  size_t write(const char* s, size_t n) { return write((const uint8_t*)s, n); }
+  virtual void flush() {}
+
+  size_t print(const String& s) { return write((const uint8_t*)s.c_str(), s.length()); }
+  size_t print(const char* s) { return write(s); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int v, int base = 10) { return print((long)v, base); }
+  size_t print(unsigned int v, int base = 10) { return print((unsigned long)v, base); }
+  size_t print(long v, int base = 10);
+  size_t print(unsigned long v, int base = 10);
+  size_t print(long long v, int base = 10);
+  size_t print(unsigned long long v, int base = 10);
+  size_t print(double v, int digits = 2);
+
+  template <typename T>
+  size_t println(const T& v) { size_t n = print(v); return n + println(); }
+  template <typename T>
+  size_t println(const T& v, int fmt) { size_t n = print(v, fmt); return n + println(); }
+  size_t println() { return write((const uint8_t*)"\r\n", 2); }
+  size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+};
+
+class Stream : public Print {
+ public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+
+  void setTimeout(unsigned long ms) { timeout_ms_ = ms; }
+  unsigned long getTimeout() const { return timeout_ms_; }
+  bool find(const char* target);
+  bool find(const char* target, size_t len);
+  bool findUntil(const char* target, const char* terminator);
+  size_t readBytes(char* buf, size_t n);
+  size_t readBytes(uint8_t* buf, size_t n) { return readBytes((char*)buf, n); }
+  String readString();
+  String readStringUntil(char terminator);
+
+ protected:
+  int timedRead();
+  int timedPeek();
+  unsigned long timeout_ms_ = 1000;
+};
+
+class HardwareSerial : public Stream {
+ public:
+  void begin(unsigned long) {}
+  void end() {}
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t* buf, size_t n) override;
+  using Print::write;
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+  operator bool() const { return true; }
+};
+extern HardwareSerial Serial;
+
+// ==================== NETWORK ADDRESS ====================
+class IPAddress {
+ public:
+  IPAddress() {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : b_{ a, b, c, d } {}
+  uint8_t operator[](int i) const { return b_[i]; }
+  uint8_t& operator[](int i) { return b_[i]; }
+  bool operator==(const IPAddress& o) const { return memcmp(b_, o.b_, 4) == 0; }
+  bool fromString(const String& s);
+  String toString() const;
+
+ private:
+  uint8_t b_[4] = { 0, 0, 0, 0 };
+};
+
+// ==================== ESP ====================
+class EspClass {
+ public:
+  uint32_t getFreeHeap();
+  uint32_t getMinFreeHeap();
+  uint32_t getMaxAllocHeap();
+  uint32_t getHeapSize();
+  uint32_t getCpuFreqMHz() { return 240; }
+  void restart();
+};
+extern EspClass ESP;
+
+#include "mock_control.h"
@@ -0,0 +1,733 @@
+#include "ArduinoJson.h"
+
+#include <algorithm>
+#include <cerrno>
+
+namespace {
+
+// Slot size of a value in the library's pool on a 32-bit target.
+const size_t SLOT_BYTES = 16;
+
+void resetNode(JsonNode* n) {
+  n->type = JsonNode::Null;
+  n->s.clear();
+  n->keys.clear();
+  n->items.clear();
+}
+
+int findKey(const JsonNode* n, const char* key) {
+  if (!n || n->type != JsonNode::Object) return -1;
+  for (size_t i = 0; i < n->keys.size(); i++)
+    if (n->keys[i] == key) return (int)i;
+  return -1;
+}
+
+}  // namespace
+
+// ==================== DOCUMENT ====================
+JsonDocument::JsonDocument(size_t capacity, bool on_heap) : capacity_(capacity) {
+  {
+    mock::HeapPause pause;
+    root_ = new JsonNode();
+  }
+  doc_ = this;
+  node_ = root_;
+  // What the device actually spends on a DynamicJsonDocument.
+  if (on_heap) device_buffer_ = malloc(capacity);
+}
+
+JsonDocument::~JsonDocument() {
+  for (JsonNode* n : pool_) delete n;
+  delete root_;
+  free(device_buffer_);
+}
+
+void JsonDocument::clear() {
+  mock::HeapPause pause;
+  for (JsonNode* n : pool_) delete n;
+  pool_.clear();
+  strings_.clear();
+  resetNode(root_);
+  used_ = 0;
+  overflowed_ = false;
+}
+
+JsonNode* JsonDocument::newNode() {
+  if (!reserve(SLOT_BYTES)) return nullptr;
+  mock::HeapPause pause;
+  JsonNode* n = new JsonNode();
+  pool_.push_back(n);
+  return n;
+}
+
+bool JsonDocument::reserve(size_t bytes) {
+  if (used_ + bytes > capacity_) {
+    overflowed_ = true;
+    return false;
+  }
+  used_ += bytes;
+  return true;
+}
+
+bool JsonDocument::reserveString(const std::string& s) {
+  if (std::find(strings_.begin(), strings_.end(), s) != strings_.end()) return true;
+  if (!reserve(s.size() + 1)) return false;
+  mock::HeapPause pause;
+  strings_.push_back(s);
+  return true;
+}
+
+// ==================== VARIANT ====================
+JsonVariant JsonVariant::operator[](const char* key) const {
+  mock::HeapPause pause;
+  JsonVariant r;
+  r.doc_ = doc_;
+  JsonNode* n = node_;
+  int i = findKey(n, key);
+  if (i >= 0) {
+    r.node_ = n->items[i];
+    return r;
+  }
+  r.key_ = key;
+  if (n) {
+    if (n->type == JsonNode::Null || n->type == JsonNode::Object) r.parent_ = n;
+  } else if (parent_ || parent_ref_) {
+    r.parent_ref_ = std::make_shared<JsonVariant>(*this);
+  }
+  return r;
+}
+
+JsonVariant JsonVariant::operator[](const String& key) const {
+  JsonVariant r = (*this)[key.c_str()];
+  r.key_copied_ = true;
+  return r;
+}
+
+JsonVariant JsonVariant::operator[](int index) const {
+  if (node_ && node_->type == JsonNode::Array && index >= 0 && (size_t)index < node_->items.size())
+    return JsonVariant(doc_, node_->items[index]);
+  return JsonVariant(doc_, nullptr);
+}
+
+JsonNode* JsonVariant::resolve(bool create) const {
+  if (node_ || !create || !doc_) return node_;
+  JsonNode* parent = parent_;
+  if (!parent && parent_ref_) parent = parent_ref_->resolve(true);
+  if (!parent) return nullptr;
+  if (parent->type == JsonNode::Null) parent->type = JsonNode::Object;
+  if (parent->type != JsonNode::Object) return nullptr;
+  int i = findKey(parent, key_.c_str());
+  if (i >= 0) return node_ = parent->items[i];
+  if (key_copied_ && !doc_->reserveString(key_)) return nullptr;
+  JsonNode* n = doc_->newNode();
+  if (!n) return nullptr;
+  mock::HeapPause pause;
+  parent->keys.push_back(key_);
+  parent->items.push_back(n);
+  return node_ = n;
+}
+
+bool JsonVariant::set(const char* value) const {
+  JsonNode* n = resolve(true);
+  if (!n) return false;
+  mock::HeapPause pause;
+  resetNode(n);
+  if (value) {
+    n->type = JsonNode::Str;
+    n->s = value;
+  }
+  return true;
+}
+
+bool JsonVariant::set(const String& value) const {
+  JsonNode* n = resolve(true);
+  if (!n) return false;
+  mock::HeapPause pause;
+  resetNode(n);
+  if (!doc_->reserveString(value.str())) return false;
+  n->type = JsonNode::Str;
+  n->s = value.str();
+  return true;
+}
+
+bool JsonVariant::set(bool value) const {
+  JsonNode* n = resolve(true);
+  if (!n) return false;
+  resetNode(n);
+  n->type = JsonNode::Bool;
+  n->b = value;
+  return true;
+}
+
+bool JsonVariant::set(double value) const {
+  JsonNode* n = resolve(true);
+  if (!n) return false;
+  resetNode(n);
+  n->type = JsonNode::Float;
+  n->d = value;
+  return true;
+}
+
+bool JsonVariant::setInt(int64_t value) const {
+  if (value >= 0) return setUInt((uint64_t)value);
+  JsonNode* n = resolve(true);
+  if (!n) return false;
+  resetNode(n);
+  n->type = JsonNode::Int;
+  n->i = value;
+  return true;
+}
+
+bool JsonVariant::setUInt(uint64_t value) const {
+  JsonNode* n = resolve(true);
+  if (!n) return false;
+  resetNode(n);
+  n->type = JsonNode::UInt;
+  n->u = value;
+  return true;
+}
+
+static bool copyNode(JsonDocument* doc, JsonNode* dst, const JsonNode* src) {
+  mock::HeapPause pause;
+  resetNode(dst);
+  if (!src) return true;
+  dst->type = src->type;
+  dst->b = src->b;
+  dst->i = src->i;
+  dst->u = src->u;
+  dst->d = src->d;
+  if (src->type == JsonNode::Str) {
+    if (!doc->reserveString(src->s)) return false;
+    dst->s = src->s;
+  }
+  for (size_t i = 0; i < src->items.size(); i++) {
+    if (src->type == JsonNode::Object) {
+      if (!doc->reserveString(src->keys[i])) return false;
+      dst->keys.push_back(src->keys[i]);
+    }
+    JsonNode* child = doc->newNode();
+    if (!child) return false;
+    dst->items.push_back(child);
+    if (!copyNode(doc, child, src->items[i])) return false;
+  }
+  return true;
+}
+
+bool JsonVariant::set(const JsonVariant& value) const {
+  JsonNode* n = resolve(true);
+  if (!n || n == value.node_) return n != nullptr;
+  return copyNode(doc_, n, value.node_);
+}
+
+const char* JsonVariant::operator|(const char* fallback) const {
+  return node_ && node_->type == JsonNode::Str ? node_->s.c_str() : fallback;
+}
+
+size_t JsonVariant::size() const {
+  if (!node_ || (node_->type != JsonNode::Array && node_->type != JsonNode::Object)) return 0;
+  return node_->items.size();
+}
+
+bool JsonVariant::containsKey(const char* key) const { return findKey(node_, key) >= 0; }
+
+void JsonVariant::remove(const char* key) const {
+  int i = findKey(node_, key);
+  if (i < 0) return;
+  node_->keys.erase(node_->keys.begin() + i);
+  node_->items.erase(node_->items.begin() + i);
+}
+
+JsonVariant JsonVariant::add() const {
+  JsonNode* n = resolve(true);
+  if (!n) return JsonVariant();
+  if (n->type == JsonNode::Null) n->type = JsonNode::Array;
+  if (n->type != JsonNode::Array) return JsonVariant();
+  JsonNode* child = doc_->newNode();
+  if (!child) return JsonVariant();
+  mock::HeapPause pause;
+  n->items.push_back(child);
+  return JsonVariant(doc_, child);
+}
+
+static JsonVariant makeContainer(const JsonVariant& slot, JsonNode::Type type) {
+  JsonNode* n = slot.node();
+  if (!n) return JsonVariant();
+  resetNode(n);
+  n->type = type;
+  return JsonVariant(slot.document(), n);
+}
+
+JsonArray JsonVariant::createNestedArray(const char* key) const {
+  JsonVariant member = (*this)[key];
+  member.resolve(true);
+  return JsonArray(makeContainer(member, JsonNode::Array));
+}
+
+JsonArray JsonVariant::createNestedArray(const String& key) const {
+  JsonVariant member = (*this)[key];
+  member.resolve(true);
+  return JsonArray(makeContainer(member, JsonNode::Array));
+}
+
+JsonObject JsonVariant::createNestedObject(const char* key) const {
+  JsonVariant member = (*this)[key];
+  member.resolve(true);
+  return JsonObject(makeContainer(member, JsonNode::Object));
+}
+
+JsonObject JsonVariant::createNestedObject(const String& key) const {
+  JsonVariant member = (*this)[key];
+  member.resolve(true);
+  return JsonObject(makeContainer(member, JsonNode::Object));
+}
+
+JsonArray JsonVariant::createNestedArray() const { return JsonArray(makeContainer(add(), JsonNode::Array)); }
+
+JsonObject JsonVariant::createNestedObject() const { return JsonObject(makeContainer(add(), JsonNode::Object)); }
+
+JsonVariant::iterator JsonVariant::begin() const { return iterator(doc_, node_, 0); }
+
+JsonVariant::iterator JsonVariant::end() const {
+  return iterator(doc_, node_, node_ && node_->type == JsonNode::Array ? node_->items.size() : 0);
+}
+
+// ==================== SERIALIZATION ====================
+namespace {
+
+void writeString(std::string& out, const std::string& s) {
+  out += '"';
+  for (unsigned char c : s) {
+    switch (c) {
+      case '"': out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\b': out += "\\b"; break;
+      case '\f': out += "\\f"; break;
+      case '\n': out += "\\n"; break;
+      case '\r': out += "\\r"; break;
+      case '\t': out += "\\t"; break;
+      default:
+        if (c < 0x20) {
+          char buf[8];
+          snprintf(buf, sizeof(buf), "\\u%04x", c);
+          out += buf;
+        } else {
+          out += (char)c;
+        }
+    }
+  }
+  out += '"';
+}
+
+void writeNode(std::string& out, const JsonNode* n) {
+  if (!n) {
+    out += "null";
+    return;
+  }
+  char buf[40];
+  switch (n->type) {
+    case JsonNode::Null: out += "null"; break;
+    case JsonNode::Bool: out += n->b ? "true" : "false"; break;
+    case JsonNode::Int: out += std::to_string(n->i); break;
+    case JsonNode::UInt: out += std::to_string(n->u); break;
+    case JsonNode::Float:
+      if (!std::isfinite(n->d)) {
+        out += "null";
+      } else {
+        snprintf(buf, sizeof(buf), "%.9g", n->d);
+        out += buf;
+      }
+      break;
+    case JsonNode::Str: writeString(out, n->s); break;
+    case JsonNode::Array:
+      out += '[';
+      for (size_t i = 0; i < n->items.size(); i++) {
+        if (i) out += ',';
+        writeNode(out, n->items[i]);
+      }
+      out += ']';
+      break;
+    case JsonNode::Object:
+      out += '{';
+      for (size_t i = 0; i < n->items.size(); i++) {
+        if (i) out += ',';
+        writeString(out, n->keys[i]);
+        out += ':';
+        writeNode(out, n->items[i]);
+      }
+      out += '}';
+      break;
+  }
+}
+
+std::string render(const JsonVariant& v) {
+  mock::HeapPause pause;
+  std::string out;
+  writeNode(out, v.node());
+  return out;
+}
+
+}  // namespace
+
+String ajmock::Conv<String>::get(const JsonNode* n) {
+  if (n && n->type == JsonNode::Str) return String(n->s);
+  std::string text;
+  {
+    mock::HeapPause pause;
+    writeNode(text, n);
+  }
+  return String(text.c_str());
+}
+
+size_t serializeJson(const JsonVariant& src, String& out) {
+  std::string text = render(src);
+  out = text.c_str();
+  return text.size();
+}
+
+size_t serializeJson(const JsonVariant& src, Print& out) {
+  std::string text = render(src);
+  return out.write((const uint8_t*)text.data(), text.size());
+}
+
+size_t serializeJson(const JsonVariant& src, char* buf, size_t size) {
+  if (!buf || size == 0) return 0;
+  std::string text = render(src);
+  size_t n = std::min(text.size(), size - 1);
+  memcpy(buf, text.data(), n);
+  buf[n] = 0;
+  return n;
+}
+
+size_t measureJson(const JsonVariant& src) { return render(src).size(); }
+
+// ==================== DESERIALIZATION ====================
+const char* DeserializationError::c_str() const {
+  static const char* names[] = { "Ok", "EmptyInput", "IncompleteInput", "InvalidInput", "NoMemory", "TooDeep" };
+  return names[code_];
+}
+
+namespace {
+
+struct BufferReader : ajmock::Reader {
+  BufferReader(const char* d, size_t n) : data(d), len(n) {}
+  int read() override {
+    if (pos >= len || data[pos] == 0) return -1;
+    return (unsigned char)data[pos++];
+  }
+  const char* data;
+  size_t len;
+  size_t pos = 0;
+};
+
+struct StreamReader : ajmock::Reader {
+  explicit StreamReader(Stream& s) : stream(s) {}
+  int read() override {
+    char c;
+    return stream.readBytes(&c, 1) == 1 ? (unsigned char)c : -1;
+  }
+  Stream& stream;
+};
+
+// Filter decision for one value, mirroring the library's Filter class.
+enum FilterMode { KEEP_ALL, KEEP_FILTERED, SKIP };
+
+FilterMode filterMode(const JsonNode* f) {
+  if (!f) return KEEP_ALL;
+  if (f->type == JsonNode::Bool) return f->b ? KEEP_ALL : SKIP;
+  if (f->type == JsonNode::Object || f->type == JsonNode::Array) return KEEP_FILTERED;
+  return SKIP;
+}
+
+class Parser {
+ public:
+  Parser(JsonDocument& doc, ajmock::Reader& in) : doc_(doc), in_(in) {}
+
+  DeserializationError run(const JsonNode* filter, int nesting) {
+    skipSpace();
+    if (peek() < 0) return DeserializationError::EmptyInput;
+    JsonNode* root = doc_.root().node();
+    FilterMode mode = filterMode(filter);
+    parseValue(mode == SKIP ? nullptr : root, mode == KEEP_FILTERED ? filter : nullptr, nesting);
+    return err_;
+  }
+
+ private:
+  int peek() {
+    if (cur_ == -2) cur_ = in_.read();
+    return cur_;
+  }
+  void move() { cur_ = -2; }
+  bool fail(DeserializationError::Code code) {
+    if (!err_) err_ = code;
+    return false;
+  }
+
+  void skipSpace() {
+    while (peek() == ' ' || peek() == '\t' || peek() == '\n' || peek() == '\r') move();
+  }
+
+  bool expect(char c) {
+    skipSpace();
+    int p = peek();
+    if (p < 0) return fail(DeserializationError::IncompleteInput);
+    if (p != c) return fail(DeserializationError::InvalidInput);
+    move();
+    return true;
+  }
+
+  // out == nullptr parses and discards. filter == nullptr keeps everything.
+  bool parseValue(JsonNode* out, const JsonNode* filter, int nesting) {
+    skipSpace();
+    int c = peek();
+    if (c < 0) return fail(DeserializationError::IncompleteInput);
+    if (c == '{') return parseObject(out, filter, nesting);
+    if (c == '[') return parseArray(out, filter, nesting);
+    if (filter && out) out = nullptr;   // a container filter rejects scalars
+    if (c == '"' || c == '\'') {
+      std::string s;
+      if (!parseString(s)) return false;
+      if (out) {
+        if (!doc_.reserveString(s)) return fail(DeserializationError::NoMemory);
+        mock::HeapPause pause;
+        out->type = JsonNode::Str;
+        out->s = s;
+      }
+      return true;
+    }
+    return parseLiteral(out);
+  }
+
+  bool parseObject(JsonNode* out, const JsonNode* filter, int nesting) {
+    if (nesting <= 0) return fail(DeserializationError::TooDeep);
+    if (filter && filter->type != JsonNode::Object) out = nullptr;
+    move();
+    if (out) out->type = JsonNode::Object;
+    skipSpace();
+    if (peek() == '}') {
+      move();
+      return true;
+    }
+    for (;;) {
+      skipSpace();
+      if (peek() < 0) return fail(DeserializationError::IncompleteInput);
+      if (peek() != '"' && peek() != '\'') return fail(DeserializationError::InvalidInput);
+      std::string key;
+      if (!parseString(key)) return false;
+      if (!expect(':')) return false;
+
+      const JsonNode* member_filter = nullptr;
+      FilterMode mode = KEEP_ALL;
+      if (filter) {
+        int i = findKey(filter, key.c_str());
+        if (i < 0) i = findKey(filter, "*");
+        mode = i >= 0 ? filterMode(filter->items[i]) : SKIP;
+        if (mode == KEEP_FILTERED) member_filter = filter->items[i];
+      }
+      JsonNode* child = nullptr;
+      if (out && mode != SKIP) {
+        if (!doc_.reserveString(key)) return fail(DeserializationError::NoMemory);
+        child = doc_.newNode();
+        if (!child) return fail(DeserializationError::NoMemory);
+        mock::HeapPause pause;
+        out->keys.push_back(key);
+        out->items.push_back(child);
+      }
+      if (!parseValue(child, member_filter, nesting - 1)) return false;
+
+      skipSpace();
+      int c = peek();
+      if (c < 0) return fail(DeserializationError::IncompleteInput);
+      move();
+      if (c == '}') return true;
+      if (c != ',') return fail(DeserializationError::InvalidInput);
+    }
+  }
+
+  bool parseArray(JsonNode* out, const JsonNode* filter, int nesting) {
+    if (nesting <= 0) return fail(DeserializationError::TooDeep);
+    const JsonNode* element_filter = nullptr;
+    FilterMode mode = KEEP_ALL;
+    if (filter) {
+      if (filter->type != JsonNode::Array) {
+        out = nullptr;
+      } else {
+        mode = filter->items.empty() ? SKIP : filterMode(filter->items[0]);
+        if (mode == KEEP_FILTERED) element_filter = filter->items[0];
+      }
+    }
+    move();
+    if (out) out->type = JsonNode::Array;
+    skipSpace();
+    if (peek() == ']') {
+      move();
+      return true;
+    }
+    for (;;) {
+      JsonNode* child = nullptr;
+      if (out && mode != SKIP) {
+        child = doc_.newNode();
+        if (!child) return fail(DeserializationError::NoMemory);
+        mock::HeapPause pause;
+        out->items.push_back(child);
+      }
+      if (!parseValue(child, element_filter, nesting - 1)) return false;
+      skipSpace();
+      int c = peek();
+      if (c < 0) return fail(DeserializationError::IncompleteInput);
+      move();
+      if (c == ']') return true;
+      if (c != ',') return fail(DeserializationError::InvalidInput);
+    }
+  }
+
+  static void appendUtf8(std::string& s, uint32_t cp) {
+    if (cp < 0x80) {
+      s += (char)cp;
+    } else if (cp < 0x800) {
+      s += (char)(0xC0 | (cp >> 6));
+      s += (char)(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+      s += (char)(0xE0 | (cp >> 12));
+      s += (char)(0x80 | ((cp >> 6) & 0x3F));
+      s += (char)(0x80 | (cp & 0x3F));
+    } else {
+      s += (char)(0xF0 | (cp >> 18));
+      s += (char)(0x80 | ((cp >> 12) & 0x3F));
+      s += (char)(0x80 | ((cp >> 6) & 0x3F));
+      s += (char)(0x80 | (cp & 0x3F));
+    }
+  }
+
+  bool parseHex4(uint32_t& v) {
+    v = 0;
+    for (int i = 0; i < 4; i++) {
+      int c = peek();
+      if (c < 0) return fail(DeserializationError::IncompleteInput);
+      move();
+      v <<= 4;
+      if (c >= '0' && c <= '9') v |= c - '0';
+      else if (c >= 'a' && c <= 'f') v |= c - 'a' + 10;
+      else if (c >= 'A' && c <= 'F') v |= c - 'A' + 10;
+      else return fail(DeserializationError::InvalidInput);
+    }
+    return true;
+  }
+
+  bool parseString(std::string& s) {
+    mock::HeapPause pause;
+    int quote = peek();
+    move();
+    for (;;) {
+      int c = peek();
+      if (c < 0) return fail(DeserializationError::IncompleteInput);
+      move();
+      if (c == quote) return true;
+      if (c != '\\') {
+        s += (char)c;
+        continue;
+      }
+      c = peek();
+      if (c < 0) return fail(DeserializationError::IncompleteInput);
+      move();
+      switch (c) {
+        case 'b': s += '\b'; break;
+        case 'f': s += '\f'; break;
+        case 'n': s += '\n'; break;
+        case 'r': s += '\r'; break;
+        case 't': s += '\t'; break;
+        case 'u': {
+          uint32_t cp;
+          if (!parseHex4(cp)) return false;
+          if (cp >= 0xD800 && cp < 0xDC00 && peek() == '\\') {
+            move();
+            if (peek() != 'u') return fail(DeserializationError::InvalidInput);
+            move();
+            uint32_t low;
+            if (!parseHex4(low)) return false;
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+          }
+          appendUtf8(s, cp);
+          break;
+        }
+        default: s += (char)c;
+      }
+    }
+  }
+
+  bool parseLiteral(JsonNode* out) {
+    char buf[64];
+    size_t n = 0;
+    for (;;) {
+      int c = peek();
+      if (c < 0 || !(isalnum(c) || c == '+' || c == '-' || c == '.')) break;
+      if (n + 1 >= sizeof(buf)) return fail(DeserializationError::InvalidInput);
+      buf[n++] = (char)c;
+      move();
+    }
+    buf[n] = 0;
+    if (n == 0) return fail(peek() < 0 ? DeserializationError::IncompleteInput : DeserializationError::InvalidInput);
+    if (!strcmp(buf, "true") || !strcmp(buf, "false")) {
+      if (out) {
+        out->type = JsonNode::Bool;
+        out->b = buf[0] == 't';
+      }
+      return true;
+    }
+    if (!strcmp(buf, "null")) return true;
+    char* end;
+    bool is_float = strpbrk(buf, ".eE") != nullptr;
+    if (!is_float) {
+      errno = 0;
+      if (buf[0] == '-') {
+        long long v = strtoll(buf, &end, 10);
+        if (*end == 0 && errno == 0) {
+          if (out) {
+            out->type = JsonNode::Int;
+            out->i = v;
+          }
+          return true;
+        }
+      } else {
+        unsigned long long v = strtoull(buf, &end, 10);
+        if (*end == 0 && errno == 0) {
+          if (out) {
+            out->type = JsonNode::UInt;
+            out->u = v;
+          }
+          return true;
+        }
+      }
+    }
+    double d = strtod(buf, &end);
+    if (*end != 0) return fail(DeserializationError::InvalidInput);
+    if (out) {
+      out->type = JsonNode::Float;
+      out->d = d;
+    }
+    return true;
+  }
+
+  JsonDocument& doc_;
+  ajmock::Reader& in_;
+  int cur_ = -2;
+  DeserializationError err_;
+};
+
+}  // namespace
+
+DeserializationError ajmock::parse(JsonDocument& doc, Reader& in, const JsonNode* filter, int nesting) {
+  doc.clear();
+  Parser p(doc, in);
+  return p.run(filter, nesting);
+}
+
+DeserializationError ajmock::parseStream(JsonDocument& doc, Stream& in, const JsonNode* filter, int nesting) {
+  StreamReader reader(in);
+  return parse(doc, reader, filter, nesting);
+}
+
+DeserializationError ajmock::parseBuffer(JsonDocument& doc, const char* data, size_t len, const JsonNode* filter,
+                                         int nesting) {
+  BufferReader reader(data, len);
+  return parse(doc, reader, filter, nesting);
+}
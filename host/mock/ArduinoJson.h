@@ -0,0 +1,381 @@
+// The subset of the ArduinoJson 6 API the sketch uses, over a simple node
+// tree. Capacity is enforced the way the library does on a 32-bit target:
+// 16 bytes per value slot plus copied strings, so a document that overflows
+// on the device overflows here too.
+#pragma once
+
+#include "Arduino.h"
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+class JsonDocument;
+class JsonArray;
+class JsonObject;
+
+struct JsonNode {
+  enum Type : uint8_t { Null, Bool, Int, UInt, Float, Str, Array, Object };
+  Type type = Null;
+  bool b = false;
+  int64_t i = 0;
+  uint64_t u = 0;
+  double d = 0;
+  std::string s;
+  std::vector<std::string> keys;     // Object member names
+  std::vector<JsonNode*> items;      // Array elements or Object member values
+};
+
+// A reference into a document. Like the library's MemberProxy it may point
+// at a member that does not exist yet; the first write creates it.
+class JsonVariant {
+ public:
+  JsonVariant() {}
+  JsonVariant(JsonDocument* doc, JsonNode* node) : doc_(doc), node_(node) {}
+
+  JsonVariant operator[](const char* key) const;
+  JsonVariant operator[](const String& key) const;
+  JsonVariant operator[](int index) const;
+  JsonVariant operator[](size_t index) const { return (*this)[(int)index]; }
+
+  template <typename T>
+  const JsonVariant& operator=(const T& value) const {
+    set(value);
+    return *this;
+  }
+
+  bool set(const JsonVariant& value) const;
+  bool set(const char* value) const;
+  bool set(char* value) const { return set((const char*)value); }
+  bool set(const String& value) const;
+  bool set(bool value) const;
+  bool set(double value) const;
+  bool set(float value) const { return set((double)value); }
+  template <typename T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, int>::type = 0>
+  bool set(T value) const {
+    return std::is_signed<T>::value ? setInt((int64_t)value) : setUInt((uint64_t)value);
+  }
+  template <size_t N>
+  bool set(const char (&value)[N]) const { return set((const char*)value); }
+  template <size_t N>
+  bool set(char (&value)[N]) const { return set((const char*)value); }
+
+  template <typename T>
+  T as() const;
+  template <typename T>
+  bool is() const;
+  // Only to the types as<T>() knows, so option structs taking a variant
+  // don't see a competing conversion
+  template <typename T, typename std::enable_if<!std::is_class<T>::value || std::is_same<T, String>::value ||
+                                                    std::is_same<T, JsonArray>::value ||
+                                                    std::is_same<T, JsonObject>::value,
+                                                int>::type = 0>
+  operator T() const { return as<T>(); }
+
+  const char* operator|(const char* fallback) const;
+  template <typename T, typename std::enable_if<!std::is_array<T>::value && !std::is_pointer<T>::value, int>::type = 0>
+  T operator|(const T& fallback) const {
+    return is<T>() ? as<T>() : fallback;
+  }
+
+  bool isNull() const { return !node_ || node_->type == JsonNode::Null; }
+  size_t size() const;
+  bool containsKey(const char* key) const;
+  bool containsKey(const String& key) const { return containsKey(key.c_str()); }
+  void remove(const char* key) const;
+
+  JsonArray createNestedArray(const char* key) const;
+  JsonArray createNestedArray(const String& key) const;
+  JsonObject createNestedObject(const char* key) const;
+  JsonObject createNestedObject(const String& key) const;
+  JsonArray createNestedArray() const;
+  JsonObject createNestedObject() const;
+  JsonVariant add() const;
+  template <typename T>
+  bool add(const T& value) const {
+    JsonVariant slot = add();
+    return slot.node_ ? slot.set(value) : false;
+  }
+
+  class iterator {
+   public:
+    iterator(JsonDocument* doc, JsonNode* parent, size_t i) : doc_(doc), parent_(parent), i_(i) {}
+    JsonVariant operator*() const { return JsonVariant(doc_, parent_->items[i_]); }
+    iterator& operator++() {
+      ++i_;
+      return *this;
+    }
+    bool operator!=(const iterator& o) const { return i_ != o.i_; }
+
+   private:
+    JsonDocument* doc_;
+    JsonNode* parent_;
+    size_t i_;
+  };
+  iterator begin() const;
+  iterator end() const;
+
+  JsonNode* node() const { return node_; }
+  JsonDocument* document() const { return doc_; }
+
+ protected:
+  JsonNode* resolve(bool create) const;
+  bool setInt(int64_t v) const;
+  bool setUInt(uint64_t v) const;
+
+  JsonDocument* doc_ = nullptr;
+  mutable JsonNode* node_ = nullptr;
+  // Pending member: created in parent_ (or the resolved parent_ref_) on write.
+  JsonNode* parent_ = nullptr;
+  std::shared_ptr<JsonVariant> parent_ref_;
+  std::string key_;
+  bool key_copied_ = false;   // String keys are copied into the pool, literals are not
+};
+
+class JsonArray : public JsonVariant {
+ public:
+  JsonArray() {}
+  JsonArray(const JsonVariant& v) : JsonVariant(v) {}
+};
+
+class JsonObject : public JsonVariant {
+ public:
+  JsonObject() {}
+  JsonObject(const JsonVariant& v) : JsonVariant(v) {}
+};
+
+class JsonDocument : public JsonVariant {
+ public:
+  JsonDocument(size_t capacity, bool on_heap);
+  virtual ~JsonDocument();
+  JsonDocument(const JsonDocument&) = delete;
+  JsonDocument& operator=(const JsonDocument&) = delete;
+
+  void clear();
+  size_t capacity() const { return capacity_; }
+  size_t memoryUsage() const { return used_; }
+  bool overflowed() const { return overflowed_; }
+  void garbageCollect() {}
+  void shrinkToFit() {}
+
+  template <typename T>
+  T to();
+  JsonVariant root() const { return JsonVariant(const_cast<JsonDocument*>(this), root_); }
+
+  // Allocation bookkeeping used by the variants and the parser.
+  JsonNode* newNode();
+  bool reserve(size_t bytes);
+  bool reserveString(const std::string& s);
+  void setOverflowed() { overflowed_ = true; }
+
+ private:
+  JsonNode* root_;
+  std::vector<JsonNode*> pool_;
+  size_t capacity_;
+  size_t used_ = 0;
+  bool overflowed_ = false;
+  void* device_buffer_ = nullptr;
+  std::vector<std::string> strings_;   // copied strings, deduplicated like the library
+};
+
+template <>
+inline JsonArray JsonDocument::to<JsonArray>() {
+  clear();
+  root_->type = JsonNode::Array;
+  return JsonArray(root());
+}
+
+template <>
+inline JsonObject JsonDocument::to<JsonObject>() {
+  clear();
+  root_->type = JsonNode::Object;
+  return JsonObject(root());
+}
+
+// The pool lives on the heap like the library's; the device-side footprint
+// is modelled by a tracked block of the document's capacity.
+class DynamicJsonDocument : public JsonDocument {
+ public:
+  explicit DynamicJsonDocument(size_t capacity) : JsonDocument(capacity, true) {}
+};
+
+template <size_t N>
+class StaticJsonDocument : public JsonDocument {
+ public:
+  StaticJsonDocument() : JsonDocument(N, false) {}
+};
+
+// ==================== CONVERSIONS ====================
+namespace ajmock {
+
+template <typename T, typename Enable = void>
+struct Conv;
+
+template <typename T>
+struct Conv<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type> {
+  static T get(const JsonNode* n) {
+    if (!n) return 0;
+    switch (n->type) {
+      case JsonNode::Int: return (T)n->i;
+      case JsonNode::UInt: return (T)n->u;
+      case JsonNode::Float: return (T)n->d;
+      case JsonNode::Bool: return (T)n->b;
+      default: return 0;
+    }
+  }
+  static bool is(const JsonNode* n) {
+    if (!n) return false;
+    if (n->type == JsonNode::Int) {
+      if (std::is_signed<T>::value) return n->i >= (int64_t)std::numeric_limits<T>::min() && n->i <= (int64_t)std::numeric_limits<T>::max();
+      return n->i >= 0 && (uint64_t)n->i <= (uint64_t)std::numeric_limits<T>::max();
+    }
+    if (n->type == JsonNode::UInt) return n->u <= (uint64_t)std::numeric_limits<T>::max();
+    return false;
+  }
+};
+
+template <typename T>
+struct Conv<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+  static T get(const JsonNode* n) {
+    if (!n) return 0;
+    switch (n->type) {
+      case JsonNode::Int: return (T)n->i;
+      case JsonNode::UInt: return (T)n->u;
+      case JsonNode::Float: return (T)n->d;
+      case JsonNode::Bool: return (T)n->b;
+      default: return 0;
+    }
+  }
+  static bool is(const JsonNode* n) {
+    return n && (n->type == JsonNode::Int || n->type == JsonNode::UInt || n->type == JsonNode::Float);
+  }
+};
+
+template <>
+struct Conv<bool> {
+  static bool get(const JsonNode* n) {
+    if (!n) return false;
+    switch (n->type) {
+      case JsonNode::Bool: return n->b;
+      case JsonNode::Int: return n->i != 0;
+      case JsonNode::UInt: return n->u != 0;
+      case JsonNode::Float: return n->d != 0;
+      default: return false;
+    }
+  }
+  static bool is(const JsonNode* n) { return n && n->type == JsonNode::Bool; }
+};
+
+template <>
+struct Conv<const char*> {
+  static const char* get(const JsonNode* n) { return n && n->type == JsonNode::Str ? n->s.c_str() : nullptr; }
+  static bool is(const JsonNode* n) { return n && n->type == JsonNode::Str; }
+};
+
+template <>
+struct Conv<String> {
+  static String get(const JsonNode* n);
+  static bool is(const JsonNode* n) { return n && n->type == JsonNode::Str; }
+};
+
+}  // namespace ajmock
+
+template <typename T>
+T JsonVariant::as() const {
+  if constexpr (std::is_same<T, JsonArray>::value) {
+    return (node_ && node_->type == JsonNode::Array) ? JsonArray(JsonVariant(doc_, node_)) : JsonArray();
+  } else if constexpr (std::is_same<T, JsonObject>::value) {
+    return (node_ && node_->type == JsonNode::Object) ? JsonObject(JsonVariant(doc_, node_)) : JsonObject();
+  } else if constexpr (std::is_same<T, JsonVariant>::value) {
+    return *this;
+  } else {
+    return ajmock::Conv<typename std::decay<T>::type>::get(node_);
+  }
+}
+
+template <typename T>
+bool JsonVariant::is() const {
+  if constexpr (std::is_same<T, JsonArray>::value) {
+    return node_ && node_->type == JsonNode::Array;
+  } else if constexpr (std::is_same<T, JsonObject>::value) {
+    return node_ && node_->type == JsonNode::Object;
+  } else if constexpr (std::is_same<T, JsonVariant>::value) {
+    return true;
+  } else {
+    return ajmock::Conv<typename std::decay<T>::type>::is(node_);
+  }
+}
+
+// ==================== (DE)SERIALIZATION ====================
+class DeserializationError {
+ public:
+  enum Code { Ok, EmptyInput, IncompleteInput, InvalidInput, NoMemory, TooDeep };
+  DeserializationError(Code c = Ok) : code_(c) {}
+  explicit operator bool() const { return code_ != Ok; }
+  bool operator==(Code c) const { return code_ == c; }
+  bool operator!=(Code c) const { return code_ != c; }
+  Code code() const { return code_; }
+  const char* c_str() const;
+
+ private:
+  Code code_;
+};
+
+namespace DeserializationOption {
+struct Filter {
+  explicit Filter(const JsonVariant& v) : node(v.node()) {}
+  const JsonNode* node;
+};
+struct NestingLimit {
+  explicit NestingLimit(int n) : limit(n) {}
+  int limit;
+};
+}  // namespace DeserializationOption
+
+namespace ajmock {
+// Byte source for the parser; Stream sources are read one byte at a time
+// with the stream timeout, exactly like the library's StreamReader.
+struct Reader {
+  virtual ~Reader() {}
+  virtual int read() = 0;
+};
+DeserializationError parse(JsonDocument& doc, Reader& in, const JsonNode* filter, int nesting);
+DeserializationError parseStream(JsonDocument& doc, Stream& in, const JsonNode* filter, int nesting);
+DeserializationError parseBuffer(JsonDocument& doc, const char* data, size_t len, const JsonNode* filter, int nesting);
+}  // namespace ajmock
+
+inline DeserializationError deserializeJson(JsonDocument& doc, const char* json) {
+  return ajmock::parseBuffer(doc, json, json ? strlen(json) : 0, nullptr, 10);
+}
+inline DeserializationError deserializeJson(JsonDocument& doc, const char* json, size_t len) {
+  return ajmock::parseBuffer(doc, json, len, nullptr, 10);
+}
+inline DeserializationError deserializeJson(JsonDocument& doc, const uint8_t* json, size_t len) {
+  return ajmock::parseBuffer(doc, (const char*)json, len, nullptr, 10);
+}
+inline DeserializationError deserializeJson(JsonDocument& doc, const String& json) {
+  return ajmock::parseBuffer(doc, json.c_str(), json.length(), nullptr, 10);
+}
+inline DeserializationError deserializeJson(JsonDocument& doc, Stream& in) {
+  return ajmock::parseStream(doc, in, nullptr, 10);
+}
+inline DeserializationError deserializeJson(JsonDocument& doc, Stream& in, DeserializationOption::Filter filter) {
+  return ajmock::parseStream(doc, in, filter.node, 10);
+}
+inline DeserializationError deserializeJson(JsonDocument& doc, Stream& in, DeserializationOption::Filter filter,
+                                            DeserializationOption::NestingLimit limit) {
+  return ajmock::parseStream(doc, in, filter.node, limit.limit);
+}
+inline DeserializationError deserializeJson(JsonDocument& doc, const char* json, DeserializationOption::Filter filter) {
+  return ajmock::parseBuffer(doc, json, json ? strlen(json) : 0, filter.node, 10);
+}
+inline DeserializationError deserializeJson(JsonDocument& doc, const String& json, DeserializationOption::Filter filter) {
+  return ajmock::parseBuffer(doc, json.c_str(), json.length(), filter.node, 10);
+}
+
+size_t serializeJson(const JsonVariant& src, String& out);
+size_t serializeJson(const JsonVariant& src, Print& out);
+size_t serializeJson(const JsonVariant& src, char* buf, size_t size);
+size_t measureJson(const JsonVariant& src);
@@ -0,0 +1,270 @@
+#include "ESPAsyncWebServer.h"
+
+#include <strings.h>
+
+namespace {
+
+std::string urlDecode(const std::string& s) {
+  std::string out;
+  for (size_t i = 0; i < s.size(); i++) {
+    if (s[i] == '+') {
+      out += ' ';
+    } else if (s[i] == '%' && i + 2 < s.size()) {
+      out += (char)strtol(s.substr(i + 1, 2).c_str(), nullptr, 16);
+      i += 2;
+    } else {
+      out += s[i];
+    }
+  }
+  return out;
+}
+
+size_t copyOut(const char* data, size_t len, uint8_t* buf, size_t max_len, size_t index) {
+  if (index >= len) return 0;
+  size_t n = std::min(max_len, len - index);
+  memcpy(buf, data + index, n);
+  return n;
+}
+
+}  // namespace
+
+// ==================== RESPONSES ====================
+size_t AsyncBasicResponse::fill(uint8_t* buf, size_t max_len, size_t index) {
+  return copyOut(content_.c_str(), content_.length(), buf, max_len, index);
+}
+
+size_t AsyncProgmemResponse::fill(uint8_t* buf, size_t max_len, size_t index) {
+  return copyOut((const char*)data_, len_, buf, max_len, index);
+}
+
+size_t AsyncResponseStream::write(const uint8_t* buf, size_t n) {
+  for (size_t i = 0; i < n; i++) content_ += (char)buf[i];
+  return n;
+}
+
+size_t AsyncResponseStream::fill(uint8_t* buf, size_t max_len, size_t index) {
+  return copyOut(content_.c_str(), content_.length(), buf, max_len, index);
+}
+
+// ==================== REQUESTS ====================
+bool AsyncWebServerRequest::hasParam(const String& name, bool, bool) const {
+  for (const auto& p : params_) {
+    if (p.name() == name) return true;
+  }
+  return false;
+}
+
+AsyncWebParameter* AsyncWebServerRequest::getParam(const String& name, bool, bool) {
+  for (auto& p : params_) {
+    if (p.name() == name) return &p;
+  }
+  return nullptr;
+}
+
+bool AsyncWebServerRequest::hasHeader(const String& name) const {
+  for (const auto& h : headers_) {
+    if (strcasecmp(h.name().c_str(), name.c_str()) == 0) return true;
+  }
+  return false;
+}
+
+AsyncWebHeader* AsyncWebServerRequest::getHeader(const String& name) {
+  for (auto& h : headers_) {
+    if (strcasecmp(h.name().c_str(), name.c_str()) == 0) return &h;
+  }
+  return nullptr;
+}
+
+void AsyncWebServerRequest::send(int code, const String& type, const String& content) {
+  send(beginResponse(code, type, content));
+}
+
+void AsyncWebServerRequest::send(AsyncWebServerResponse* response) {
+  if (response_) {
+    delete response;   // the library ignores a second send()
+    return;
+  }
+  response_ = response;
+}
+
+void AsyncWebServerRequest::send(fs::FS& fs, const String& path, const String& type, bool download) {
+  fs::File f = fs.open(path, "r");
+  if (!f) {
+    send(404);
+    return;
+  }
+  String content;
+  uint8_t buf[256];
+  int n;
+  while ((n = f.read(buf, sizeof(buf))) > 0) {
+    for (int i = 0; i < n; i++) content += (char)buf[i];
+  }
+  f.close();
+  AsyncWebServerResponse* r = beginResponse(200, type, content);
+  if (download) {
+    String name = path.substring(path.lastIndexOf("/") + 1);
+    r->addHeader("Content-Disposition", "attachment; filename=\"" + name + "\"");
+  }
+  send(r);
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse(int code, const String& type, const String& content) {
+  return new AsyncBasicResponse(code, type, content);
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse_P(int code, const String& type, const uint8_t* data,
+                                                               size_t len) {
+  return new AsyncProgmemResponse(code, type, data, len);
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginChunkedResponse(const String& type, AwsResponseFiller filler) {
+  return new AsyncChunkedResponse(type, filler);
+}
+
+AsyncResponseStream* AsyncWebServerRequest::beginResponseStream(const String& type, size_t) {
+  return new AsyncResponseStream(type);
+}
+
+// ==================== SERVER ====================
+void AsyncWebServer::on(const char* uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest) {
+  on(uri, method, onRequest, nullptr, nullptr);
+}
+
+void AsyncWebServer::on(const char* uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest,
+                        ArUploadHandlerFunction, ArBodyHandlerFunction onBody) {
+  mock::HeapPause pause;
+  routes_.push_back(Route{ uri, method, onRequest, onBody });
+}
+
+mock::WebResponse AsyncWebServer::mockRequest(int method, const std::string& url, const std::string& body,
+                                              const std::map<std::string, std::string>& headers) {
+  mock::WebResponse out;
+  std::string path = url, query;
+  size_t q = url.find('?');
+  if (q != std::string::npos) {
+    path = url.substr(0, q);
+    query = url.substr(q + 1);
+  }
+
+  const Route* route = nullptr;
+  for (const auto& r : routes_) {
+    if (r.uri == path && (r.method & method)) {
+      route = &r;
+      break;
+    }
+  }
+  if (!route) {
+    out.code = 404;
+    return out;
+  }
+
+  AsyncWebServerRequest* req = new AsyncWebServerRequest(method, String(path.c_str()));
+  size_t start = 0;
+  while (start < query.size()) {
+    size_t end = query.find('&', start);
+    if (end == std::string::npos) end = query.size();
+    std::string kv = query.substr(start, end - start);
+    size_t eq = kv.find('=');
+    std::string k = urlDecode(kv.substr(0, eq));
+    std::string v = eq == std::string::npos ? std::string() : urlDecode(kv.substr(eq + 1));
+    req->params_.push_back(AsyncWebParameter(String(k.c_str()), String(v.c_str())));
+    start = end + 1;
+  }
+  for (const auto& h : headers) req->headers_.push_back(AsyncWebHeader(String(h.first.c_str()), String(h.second.c_str())));
+
+  if (route->onBody && !body.empty()) {
+    // The library hands over its receive buffer; keep a terminator after it
+    std::vector<uint8_t> data(body.begin(), body.end());
+    data.push_back(0);
+    route->onBody(req, data.data(), body.size(), 0, body.size());
+  }
+  route->onRequest(req);
+
+  if (req->response_) {
+    AsyncWebServerResponse* r = req->response_;
+    out.code = r->code_;
+    out.type = r->type_.c_str();
+    for (const auto& h : r->headers_) out.headers[h.name().c_str()] = h.value().c_str();
+    uint8_t buf[1460];
+    size_t index = 0;
+    for (;;) {
+      size_t n = r->fill(buf, sizeof(buf), index);
+      if (n == 0) break;
+      out.fills++;
+      mock::HeapPause pause;
+      out.body.append((const char*)buf, n);
+      index += n;
+    }
+  }
+  delete req;
+  return out;
+}
+
+// ==================== EVENTS ====================
+AsyncEventSource::~AsyncEventSource() {
+  for (auto* c : clients_) {
+    for (char* m : c->queue_) free(m);
+    delete c;
+  }
+}
+
+size_t AsyncEventSource::count() const {
+  size_t n = 0;
+  for (const auto* c : clients_) n += c->connected_;
+  return n;
+}
+
+void AsyncEventSource::send(const char* message, const char* event, uint32_t id, uint32_t reconnect) {
+  String ev;
+  if (reconnect) ev += "retry: " + String(reconnect) + "\r\n";
+  if (id) ev += "id: " + String(id) + "\r\n";
+  if (event) ev += "event: " + String(event) + "\r\n";
+  if (message) ev += "data: " + String(message) + "\r\n";
+  ev += "\r\n";
+  for (auto* c : clients_) {
+    if (!c->connected_) continue;
+    if (c->queue_.size() >= SSE_MAX_QUEUED_MESSAGES) {
+      c->dropped_++;
+      continue;
+    }
+    char* copy = (char*)malloc(ev.length() + 1);
+    memcpy(copy, ev.c_str(), ev.length() + 1);
+    mock::HeapPause pause;
+    c->queue_.push_back(copy);
+  }
+}
+
+AsyncEventSourceClient* AsyncEventSource::mockConnect() {
+  AsyncEventSourceClient* c;
+  {
+    mock::HeapPause pause;
+    c = new AsyncEventSourceClient();
+    c->id_ = next_id_++;
+    clients_.push_back(c);
+  }
+  if (on_connect_) on_connect_(c);
+  return c;
+}
+
+void AsyncEventSource::mockDisconnect(AsyncEventSourceClient* client) {
+  client->connected_ = false;
+  for (char* m : client->queue_) free(m);
+  mock::HeapPause pause;
+  client->queue_.clear();
+}
+
+size_t AsyncEventSource::mockDrain(AsyncEventSourceClient* client, size_t max_events) {
+  size_t n = 0;
+  while (n < max_events && !client->queue_.empty()) {
+    char* m = client->queue_.front();
+    {
+      mock::HeapPause pause;
+      client->last_ = m;
+      client->queue_.erase(client->queue_.begin());
+    }
+    free(m);
+    client->delivered_++;
+    n++;
+  }
+  return n;
+}
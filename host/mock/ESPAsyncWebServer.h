@@ -0,0 +1,221 @@
+// ESPAsyncWebServer stand-in. Routes are kept in a table and driven by
+// server.mockRequest(), which runs the body handler and then the request
+// handler in the calling thread (as async_tcp would) and drains whatever
+// response was sent, chunked fillers included, in TCP-sized pieces.
+//
+// AsyncEventSource keeps simulated clients. Like the library, send() copies
+// the formatted event into every client's queue (so the copies show up in
+// the heap accounting) and drops it for a client whose queue is full; tests
+// drain the queues to model the network.
+#pragma once
+
+#include "Arduino.h"
+#include "LittleFS.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define HTTP_GET 0b00000001
+#define HTTP_POST 0b00000010
+#define HTTP_ANY 0b01111111
+typedef uint8_t WebRequestMethodComposite;
+
+#define SSE_MAX_QUEUED_MESSAGES 32
+
+class AsyncWebServerRequest;
+
+typedef std::function<void(AsyncWebServerRequest*)> ArRequestHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest*, const String&, size_t, uint8_t*, size_t, bool)>
+    ArUploadHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest*, uint8_t*, size_t, size_t, size_t)> ArBodyHandlerFunction;
+typedef std::function<size_t(uint8_t*, size_t, size_t)> AwsResponseFiller;
+
+class AsyncWebParameter {
+ public:
+  AsyncWebParameter(const String& name, const String& value) : name_(name), value_(value) {}
+  const String& name() const { return name_; }
+  const String& value() const { return value_; }
+
+ private:
+  String name_;
+  String value_;
+};
+
+typedef AsyncWebParameter AsyncWebHeader;
+
+class AsyncWebServerResponse {
+ public:
+  AsyncWebServerResponse(int code, const String& type) : code_(code), type_(type) {}
+  virtual ~AsyncWebServerResponse() {}
+  void addHeader(const String& name, const String& value) { headers_.push_back(AsyncWebHeader(name, value)); }
+  void setCode(int code) { code_ = code; }
+  // Next piece of the body, 0 at the end.
+  virtual size_t fill(uint8_t* buf, size_t max_len, size_t index) = 0;
+
+  int code_;
+  String type_;
+  std::vector<AsyncWebHeader> headers_;
+};
+
+class AsyncBasicResponse : public AsyncWebServerResponse {
+ public:
+  AsyncBasicResponse(int code, const String& type, const String& content)
+      : AsyncWebServerResponse(code, type), content_(content) {}
+  size_t fill(uint8_t* buf, size_t max_len, size_t index) override;
+
+ private:
+  String content_;
+};
+
+class AsyncProgmemResponse : public AsyncWebServerResponse {
+ public:
+  AsyncProgmemResponse(int code, const String& type, const uint8_t* data, size_t len)
+      : AsyncWebServerResponse(code, type), data_(data), len_(len) {}
+  size_t fill(uint8_t* buf, size_t max_len, size_t index) override;
+
+ private:
+  const uint8_t* data_;
+  size_t len_;
+};
+
+class AsyncChunkedResponse : public AsyncWebServerResponse {
+ public:
+  AsyncChunkedResponse(const String& type, AwsResponseFiller filler)
+      : AsyncWebServerResponse(200, type), filler_(filler) {}
+  size_t fill(uint8_t* buf, size_t max_len, size_t index) override { return filler_(buf, max_len, index); }
+
+ private:
+  AwsResponseFiller filler_;
+};
+
+class AsyncResponseStream : public AsyncWebServerResponse, public Print {
+ public:
+  AsyncResponseStream(const String& type) : AsyncWebServerResponse(200, type) {}
+  size_t write(uint8_t c) override {
+    content_ += (char)c;
+    return 1;
+  }
+  size_t write(const uint8_t* buf, size_t n) override;
+  using Print::write;
+  size_t fill(uint8_t* buf, size_t max_len, size_t index) override;
+
+ private:
+  String content_;
+};
+
+class AsyncWebServerRequest {
+ public:
+  AsyncWebServerRequest(int method, const String& url) : method_(method), url_(url) {}
+  ~AsyncWebServerRequest() { delete response_; }
+
+  int method() const { return method_; }
+  const String& url() const { return url_; }
+  bool hasParam(const String& name, bool post = false, bool file = false) const;
+  AsyncWebParameter* getParam(const String& name, bool post = false, bool file = false);
+  bool hasHeader(const String& name) const;
+  AsyncWebHeader* getHeader(const String& name);
+
+  void send(int code, const String& type = String(), const String& content = String());
+  void send(AsyncWebServerResponse* response);
+  void send(fs::FS& fs, const String& path, const String& type = String(), bool download = false);
+  AsyncWebServerResponse* beginResponse(int code, const String& type = String(), const String& content = String());
+  AsyncWebServerResponse* beginResponse_P(int code, const String& type, const uint8_t* data, size_t len);
+  AsyncWebServerResponse* beginChunkedResponse(const String& type, AwsResponseFiller filler);
+  AsyncResponseStream* beginResponseStream(const String& type, size_t buffer_size = 1460);
+
+  std::vector<AsyncWebParameter> params_;
+  std::vector<AsyncWebHeader> headers_;
+  AsyncWebServerResponse* response_ = nullptr;
+
+ private:
+  int method_;
+  String url_;
+};
+
+class AsyncWebHandler {
+ public:
+  virtual ~AsyncWebHandler() {}
+};
+
+class AsyncEventSourceClient {
+ public:
+  uint32_t id() const { return id_; }
+  bool connected() const { return connected_; }
+  size_t packetsWaiting() const { return queue_.size(); }
+  void close() { connected_ = false; }
+
+ private:
+  friend class AsyncEventSource;
+  uint32_t id_ = 0;
+  bool connected_ = true;
+  std::vector<char*> queue_;     // formatted events, one heap copy each
+  uint32_t dropped_ = 0;
+  uint32_t delivered_ = 0;
+  std::string last_;
+};
+
+class AsyncEventSource : public AsyncWebHandler {
+ public:
+  explicit AsyncEventSource(const String& url) : url_(url) {}
+  ~AsyncEventSource() override;
+  void onConnect(std::function<void(AsyncEventSourceClient*)> cb) { on_connect_ = cb; }
+  size_t count() const;
+  void send(const char* message, const char* event = nullptr, uint32_t id = 0, uint32_t reconnect = 0);
+
+  // Test controls
+  AsyncEventSourceClient* mockConnect();
+  void mockDisconnect(AsyncEventSourceClient* client);
+  // Hand up to max_events queued events to the network; returns how many.
+  size_t mockDrain(AsyncEventSourceClient* client, size_t max_events = (size_t)-1);
+  uint32_t mockDropped(AsyncEventSourceClient* client) const { return client->dropped_; }
+  uint32_t mockDelivered(AsyncEventSourceClient* client) const { return client->delivered_; }
+  const std::string& mockLast(AsyncEventSourceClient* client) const { return client->last_; }
+
+ private:
+  String url_;
+  std::function<void(AsyncEventSourceClient*)> on_connect_;
+  std::vector<AsyncEventSourceClient*> clients_;
+  uint32_t next_id_ = 1;
+};
+
+namespace mock {
+
+struct WebResponse {
+  int code = 0;                  // 0 when the handler sent nothing
+  std::string type;
+  std::map<std::string, std::string> headers;
+  std::string body;
+  uint32_t fills = 0;            // filler/stream callbacks used to produce the body
+};
+
+}  // namespace mock
+
+class AsyncWebServer {
+ public:
+  explicit AsyncWebServer(uint16_t port) : port_(port) {}
+  void on(const char* uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest);
+  void on(const char* uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest,
+          ArUploadHandlerFunction onUpload, ArBodyHandlerFunction onBody = nullptr);
+  void addHandler(AsyncWebHandler* handler) { handlers_.push_back(handler); }
+  void begin() { begun_ = true; }
+  bool begun() const { return begun_; }
+
+  // Runs one request through the route table, like async_tcp would.
+  mock::WebResponse mockRequest(int method, const std::string& url, const std::string& body = std::string(),
+                                const std::map<std::string, std::string>& headers = {});
+
+ private:
+  struct Route {
+    std::string uri;
+    WebRequestMethodComposite method;
+    ArRequestHandlerFunction onRequest;
+    ArBodyHandlerFunction onBody;
+  };
+  uint16_t port_;
+  bool begun_ = false;
+  std::vector<Route> routes_;
+  std::vector<AsyncWebHandler*> handlers_;
+};
@@ -0,0 +1,3 @@
+#include "ElegantOTA.h"
+
+ElegantOTAClass ElegantOTA;
@@ -0,0 +1,11 @@
+// OTA updates are out of scope for the host build.
+#pragma once
+
+#include "ESPAsyncWebServer.h"
+
+class ElegantOTAClass {
+ public:
+  void begin(AsyncWebServer*, const char* = "", const char* = "") {}
+  void loop() {}
+};
+extern ElegantOTAClass ElegantOTA;
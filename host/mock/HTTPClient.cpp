@@ -0,0 +1,221 @@
+#include "HTTPClient.h"
+
+#include "StreamString.h"
+
+namespace {
+
+std::map<std::string, mock::HttpPeer*>& peers() {
+  static std::map<std::string, mock::HttpPeer*>* m = [] {
+    mock::HeapPause pause;
+    return new std::map<std::string, mock::HttpPeer*>();
+  }();
+  return *m;
+}
+
+std::string endpointKey(const std::string& host, uint16_t port) { return host + ":" + std::to_string(port); }
+
+std::string frameChunked(const std::string& body) {
+  std::string out;
+  const size_t CHUNK = 512;
+  for (size_t i = 0; i < body.size(); i += CHUNK) {
+    size_t n = std::min(CHUNK, body.size() - i);
+    char head[16];
+    snprintf(head, sizeof(head), "%zx\r\n", n);
+    out += head;
+    out.append(body, i, n);
+    out += "\r\n";
+  }
+  out += "0\r\n\r\n";
+  return out;
+}
+
+}  // namespace
+
+void mock::http_listen(const std::string& host, uint16_t port, HttpPeer* peer) {
+  mock::HeapPause pause;
+  peers()[endpointKey(host, port)] = peer;
+}
+
+void mock::http_unlisten(const std::string& host, uint16_t port) {
+  mock::HeapPause pause;
+  peers().erase(endpointKey(host, port));
+}
+
+bool HTTPClient::begin(WiFiClient& client, const String& url) {
+  mock::HeapPause pause;
+  client_ = &client;
+  headers_.clear();
+  size_ = -1;
+  chunked_ = false;
+  std::string u = url.c_str();
+  size_t scheme = u.find("://");
+  if (scheme != std::string::npos) u = u.substr(scheme + 3);
+  size_t slash = u.find('/');
+  std::string hostport = u.substr(0, slash);
+  path_ = slash == std::string::npos ? "/" : u.substr(slash);
+  size_t colon = hostport.find(':');
+  host_ = hostport.substr(0, colon);
+  port_ = colon == std::string::npos ? 80 : (uint16_t)atoi(hostport.c_str() + colon + 1);
+  return true;
+}
+
+void HTTPClient::addHeader(const String& name, const String& value) {
+  mock::HeapPause pause;
+  headers_[name.c_str()] = value.c_str();
+}
+
+bool HTTPClient::connected() { return client_ && client_->connected(); }
+
+int HTTPClient::GET() { return sendRequest("GET", nullptr, 0); }
+
+int HTTPClient::POST(const String& payload) {
+  return sendRequest("POST", (const uint8_t*)payload.c_str(), payload.length());
+}
+
+int HTTPClient::POST(const uint8_t* payload, size_t size) { return sendRequest("POST", payload, size); }
+
+int HTTPClient::sendRequest(const char* method, const uint8_t* payload, size_t size) {
+  if (!client_) return HTTPC_ERROR_NOT_CONNECTED;
+  if (WiFi.status() != WL_CONNECTED) return HTTPC_ERROR_CONNECTION_REFUSED;
+  auto it = peers().find(endpointKey(host_, port_));
+  mock::HttpPeer* peer = it == peers().end() ? nullptr : it->second;
+  std::shared_ptr<mock::Conn>& conn = client_->conn;
+
+  if (conn && conn->open && conn->http_peer == peer && peer) {
+    // Reuse: what has already arrived is flushed, as HTTPClient::connect() does
+    conn->rx.clear();
+    if (!conn->in_flight.empty()) {
+      // The rest of an unread body arrives as this request's status line
+      peer->stats.desyncs++;
+      peer->stats.requests++;
+      conn->send(std::string(), (size_t)-1);
+      conn->rx.clear();
+      can_reuse_ = false;
+      delay(timeout_);
+      return HTTPC_ERROR_READ_TIMEOUT;
+    }
+  } else {
+    client_->stop();
+    if (!peer) {
+      delay(20);
+      return HTTPC_ERROR_CONNECTION_REFUSED;
+    }
+    if ((int32_t)peer->connect_ms > connect_timeout_) {
+      delay(connect_timeout_);
+      return HTTPC_ERROR_CONNECTION_REFUSED;
+    }
+    delay(peer->connect_ms);
+    mock::HeapPause pause;
+    conn = std::make_shared<mock::Conn>();
+    conn->http_peer = peer;
+    conn->host = host_;
+    conn->port = port_;
+    peer->stats.connects++;
+  }
+  client_->setTimeout(timeout_);
+
+  mock::HttpReply reply;
+  {
+    mock::HeapPause pause;
+    mock::HttpRequest req;
+    req.method = method;
+    req.path = path_;
+    if (payload) req.body.assign((const char*)payload, size);
+    req.headers = headers_;
+    peer->stats.requests++;
+    reply = peer->serve(req);
+  }
+
+  if (reply.drop) {
+    delay(reply.latency_ms);
+    conn->open = false;
+    return HTTPC_ERROR_CONNECTION_LOST;
+  }
+  {
+    mock::HeapPause pause;
+    // Queued even when late, so a caller that keeps the socket sees it later
+    conn->send(reply.chunked ? frameChunked(reply.body) : reply.body, 0);
+  }
+  if (reply.latency_ms > timeout_) {
+    delay(timeout_);
+    return HTTPC_ERROR_READ_TIMEOUT;
+  }
+  delay(reply.latency_ms);
+  conn->arrive();
+  can_reuse_ = reply.keep_alive;
+  chunked_ = reply.chunked;
+  size_ = reply.chunked ? -1 : (int)reply.body.size();
+  return reply.code;
+}
+
+int HTTPClient::readChunkSize() {
+  String line = client_->readStringUntil('\n');
+  line.trim();
+  if (line.length() == 0) return -1;
+  return (int)strtol(line.c_str(), nullptr, 16);
+}
+
+int HTTPClient::writeToStream(Stream* stream) {
+  if (!client_ || !client_->conn) return HTTPC_ERROR_NOT_CONNECTED;
+  uint8_t buf[512];
+  int total = 0;
+  if (!chunked_) {
+    int left = size_;
+    while (left > 0) {
+      int n = client_->readBytes(buf, std::min(left, (int)sizeof(buf)));
+      if (n <= 0) return HTTPC_ERROR_READ_TIMEOUT;
+      stream->write(buf, n);
+      left -= n;
+      total += n;
+    }
+    return total;
+  }
+  for (;;) {
+    int len = readChunkSize();
+    if (len < 0) return HTTPC_ERROR_READ_TIMEOUT;
+    if (len == 0) {
+      client_->readStringUntil('\n');   // empty line after the last chunk
+      break;
+    }
+    while (len > 0) {
+      int n = client_->readBytes(buf, std::min(len, (int)sizeof(buf)));
+      if (n <= 0) return HTTPC_ERROR_READ_TIMEOUT;
+      stream->write(buf, n);
+      len -= n;
+      total += n;
+    }
+    char crlf[2];
+    if (client_->readBytes(crlf, 2) != 2 || crlf[0] != '\r') return HTTPC_ERROR_ENCODING;
+  }
+  return total;
+}
+
+String HTTPClient::getString() {
+  StreamString s;
+  writeToStream(&s);
+  return s;
+}
+
+void HTTPClient::end() {
+  if (!client_) return;
+  if (client_->conn) client_->conn->rx.clear();
+  if (!reuse_ || !can_reuse_) client_->stop();
+  client_ = nullptr;
+}
+
+String HTTPClient::errorToString(int error) {
+  switch (error) {
+    case HTTPC_ERROR_CONNECTION_REFUSED: return String("connection refused");
+    case HTTPC_ERROR_SEND_HEADER_FAILED: return String("send header failed");
+    case HTTPC_ERROR_SEND_PAYLOAD_FAILED: return String("send payload failed");
+    case HTTPC_ERROR_NOT_CONNECTED: return String("not connected");
+    case HTTPC_ERROR_CONNECTION_LOST: return String("connection lost");
+    case HTTPC_ERROR_NO_STREAM: return String("no stream");
+    case HTTPC_ERROR_NO_HTTP_SERVER: return String("no HTTP server");
+    case HTTPC_ERROR_TOO_LESS_RAM: return String("too less ram");
+    case HTTPC_ERROR_ENCODING: return String("Transfer-Encoding not supported");
+    case HTTPC_ERROR_STREAM_WRITE: return String("Stream write error");
+    case HTTPC_ERROR_READ_TIMEOUT: return String("read Timeout");
+    default: return String();
+  }
+}
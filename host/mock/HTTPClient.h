@@ -0,0 +1,102 @@
+// HTTPClient over the mock WiFiClient. A test registers an HttpPeer (the
+// fake RouterOS REST server) for host:port; POST() runs the peer, waits its
+// latency in virtual time and queues the reply on the connection. Only the
+// first TCP segment is readable at once, the rest arrives as the body is
+// read, so a caller that abandons a body leaves bytes on a kept-alive socket
+// exactly like the real client does. The next request on that socket then
+// reads the stale bytes as its status line (counted as a desync).
+#pragma once
+
+#include "WiFi.h"
+
+#include <map>
+#include <string>
+
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED (-2)
+#define HTTPC_ERROR_SEND_PAYLOAD_FAILED (-3)
+#define HTTPC_ERROR_NOT_CONNECTED (-4)
+#define HTTPC_ERROR_CONNECTION_LOST (-5)
+#define HTTPC_ERROR_NO_STREAM (-6)
+#define HTTPC_ERROR_NO_HTTP_SERVER (-7)
+#define HTTPC_ERROR_TOO_LESS_RAM (-8)
+#define HTTPC_ERROR_ENCODING (-9)
+#define HTTPC_ERROR_STREAM_WRITE (-10)
+#define HTTPC_ERROR_READ_TIMEOUT (-11)
+
+#define HTTP_CODE_OK 200
+
+namespace mock {
+
+struct HttpRequest {
+  std::string method;
+  std::string path;
+  std::string body;
+  std::map<std::string, std::string> headers;
+};
+
+struct HttpReply {
+  int code = 200;
+  std::string body;
+  bool chunked = false;        // Transfer-Encoding: chunked, no Content-Length
+  uint32_t latency_ms = 20;    // time to first byte
+  bool keep_alive = true;
+  bool drop = false;           // close the connection instead of answering
+};
+
+class HttpPeer {
+ public:
+  virtual ~HttpPeer() {}
+  virtual HttpReply serve(const HttpRequest& req) = 0;
+
+  struct Stats {
+    uint32_t connects;
+    uint32_t requests;
+    uint32_t desyncs;          // requests sent while an old body was still in flight
+  } stats = {};
+  uint32_t connect_ms = 5;
+};
+
+void http_listen(const std::string& host, uint16_t port, HttpPeer* peer);
+void http_unlisten(const std::string& host, uint16_t port);
+
+}  // namespace mock
+
+class HTTPClient {
+ public:
+  HTTPClient() {}
+  ~HTTPClient() { end(); }
+
+  bool begin(WiFiClient& client, const String& url);
+  void end();
+  void setReuse(bool reuse) { reuse_ = reuse; }
+  void setTimeout(uint16_t ms) { timeout_ = ms; }
+  void setConnectTimeout(int32_t ms) { connect_timeout_ = ms; }
+  void addHeader(const String& name, const String& value);
+  int GET();
+  int POST(const String& payload);
+  int POST(const uint8_t* payload, size_t size);
+  int sendRequest(const char* method, const uint8_t* payload, size_t size);
+  int getSize() const { return size_; }
+  bool connected();
+  WiFiClient& getStream() { return *client_; }
+  WiFiClient* getStreamPtr() { return client_; }
+  int writeToStream(Stream* stream);
+  String getString();
+  static String errorToString(int error);
+
+ private:
+  int readChunkSize();
+
+  WiFiClient* client_ = nullptr;
+  std::string host_;
+  uint16_t port_ = 80;
+  std::string path_;
+  std::map<std::string, std::string> headers_;
+  bool reuse_ = true;
+  bool can_reuse_ = true;
+  bool chunked_ = false;
+  uint16_t timeout_ = 5000;
+  int32_t connect_timeout_ = 5000;
+  int size_ = -1;
+};
@@ -0,0 +1,323 @@
+#include "LittleFS.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <fstream>
+#include <map>
+#include <sstream>
+
+LittleFSFS LittleFS;
+mock::FsStats mock::fs_stats;
+
+namespace {
+
+struct Entry {
+  std::vector<uint8_t> data;
+};
+
+struct Volume {
+  std::map<std::string, std::shared_ptr<Entry>> files;
+  size_t total_bytes = 0x160000;
+  bool mounted = false;
+  bool flash_timing = false;
+  int64_t power_budget = -1;
+};
+
+Volume& volume() {
+  static Volume* v = [] {
+    mock::HeapPause pause;
+    return new Volume();
+  }();
+  return *v;
+}
+
+std::string normalize(const char* path) {
+  std::string p = path ? path : "";
+  if (p.empty() || p[0] != '/') p = "/" + p;
+  return p;
+}
+
+size_t blocksFor(size_t bytes) { return (bytes + mock::FS_BLOCK - 1) / mock::FS_BLOCK; }
+
+// Root directory metadata pair plus one block per started 4 KB of data.
+size_t usedBlocks(const Volume& v) {
+  size_t blocks = 2;
+  for (const auto& f : v.files) blocks += std::max<size_t>(1, blocksFor(f.second->data.size()));
+  return blocks;
+}
+
+}  // namespace
+
+namespace fs {
+
+struct FileImpl {
+  std::shared_ptr<Entry> entry;
+  std::string path;
+  std::string name;
+  size_t pos = 0;
+  bool can_read = false;
+  bool can_write = false;
+  bool append = false;
+  bool open = true;
+  bool dir = false;
+  std::vector<std::string> children;   // directory: entry paths when opened
+  size_t next_child = 0;
+  size_t committed_size = 0;        // file size at the last commit
+  size_t dirty_from = SIZE_MAX;     // lowest overwritten offset since the last commit
+
+  // Dropping the last handle closes the file, as on the device.
+  ~FileImpl() {
+    if (open) commit();
+  }
+
+  void commit() {
+    if (!can_write) return;
+    size_t size = entry->data.size();
+    size_t prog = 0;
+    if (dirty_from != SIZE_MAX) {
+      prog = size - std::min(size, dirty_from / mock::FS_BLOCK * mock::FS_BLOCK);
+    } else if (size > committed_size) {
+      prog = size - committed_size;
+    }
+    committed_size = size;
+    dirty_from = SIZE_MAX;
+    if (!prog) return;
+    uint64_t erased = blocksFor(prog);
+    mock::fs_stats.prog_bytes += prog;
+    mock::fs_stats.erased_blocks += erased;
+    mock::fs_stats.commits++;
+    if (volume().flash_timing) mock::delay_us(erased * 20000 + (prog + 255) / 256 * 100);
+  }
+};
+
+File::operator bool() const { return impl_ && impl_->open; }
+
+size_t File::write(const uint8_t* buf, size_t n) {
+  if (!*this || !impl_->can_write) return 0;
+  Volume& v = volume();
+  std::vector<uint8_t>& data = impl_->entry->data;
+  if (impl_->append) impl_->pos = data.size();
+  size_t end = impl_->pos + n;
+  if (end > data.size()) {
+    size_t extra = blocksFor(end) - blocksFor(data.size());
+    if (usedBlocks(v) + extra > v.total_bytes / mock::FS_BLOCK) return 0;
+  }
+  if (v.power_budget >= 0) n = std::min<size_t>(n, v.power_budget), v.power_budget -= n;
+  if (!n) return 0;
+  mock::HeapPause pause;
+  if (impl_->pos < impl_->committed_size) impl_->dirty_from = std::min(impl_->dirty_from, impl_->pos);
+  if (impl_->pos + n > data.size()) data.resize(impl_->pos + n, 0);
+  memcpy(&data[impl_->pos], buf, n);
+  impl_->pos += n;
+  mock::fs_stats.bytes_written += n;
+  return n;
+}
+
+int File::available() {
+  if (!*this || !impl_->can_read) return 0;
+  size_t size = impl_->entry->data.size();
+  return impl_->pos < size ? (int)(size - impl_->pos) : 0;
+}
+
+int File::read() {
+  if (available() <= 0) return -1;
+  return impl_->entry->data[impl_->pos++];
+}
+
+int File::peek() {
+  if (available() <= 0) return -1;
+  return impl_->entry->data[impl_->pos];
+}
+
+size_t File::read(uint8_t* buf, size_t n) {
+  size_t avail = available();
+  if (n > avail) n = avail;
+  if (n) memcpy(buf, &impl_->entry->data[impl_->pos], n);
+  if (impl_) impl_->pos += n;
+  return n;
+}
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+  if (!*this) return false;
+  size_t size = impl_->entry->data.size();
+  size_t target = mode == SeekSet ? pos : mode == SeekCur ? impl_->pos + pos : size + pos;
+  // Like lfs_file_seek, seeking past the end is allowed; a later write
+  // zero-fills the gap.
+  impl_->pos = target;
+  return true;
+}
+
+size_t File::position() const { return impl_ ? impl_->pos : 0; }
+
+size_t File::size() const { return impl_ ? impl_->entry->data.size() : 0; }
+
+void File::flush() {
+  if (*this) impl_->commit();
+}
+
+void File::close() {
+  if (!*this) return;
+  impl_->commit();
+  impl_->open = false;
+}
+
+const char* File::name() const { return impl_ ? impl_->name.c_str() : ""; }
+
+const char* File::path() const { return impl_ ? impl_->path.c_str() : ""; }
+
+bool File::isDirectory() const { return impl_ && impl_->dir; }
+
+File File::openNextFile(const char* mode) {
+  if (!isDirectory() || impl_->next_child >= impl_->children.size()) return File();
+  return LittleFS.open(impl_->children[impl_->next_child++].c_str(), mode);
+}
+
+File FS::open(const char* path, const char* mode, bool) {
+  mock::HeapPause pause;
+  Volume& v = volume();
+  if (!v.mounted) return File();
+  std::string p = normalize(path);
+  std::string m = mode ? mode : "r";
+  auto it = v.files.find(p);
+  bool plus = m.find('+') != std::string::npos;
+  auto impl = std::make_shared<FileImpl>();
+  if (m[0] == 'r' && it == v.files.end()) {
+    // Directories exist implicitly, as the parents of the files
+    std::string prefix = p == "/" ? p : p + "/";
+    for (const auto& f : v.files) {
+      if (f.first.compare(0, prefix.size(), prefix) != 0) continue;
+      size_t slash = f.first.find('/', prefix.size());
+      std::string child = slash == std::string::npos ? f.first : f.first.substr(0, slash);
+      if (impl->children.empty() || impl->children.back() != child) impl->children.push_back(child);
+    }
+    if (impl->children.empty() && p != "/") return File();
+    impl->dir = true;
+    impl->path = p;
+    impl->name = p.substr(p.rfind('/') + 1);
+    return File(impl);
+  }
+  if (m[0] == 'r') {
+    impl->entry = it->second;
+    impl->can_read = true;
+    impl->can_write = plus;
+  } else if (m[0] == 'w') {
+    if (it == v.files.end()) it = v.files.emplace(p, std::make_shared<Entry>()).first;
+    it->second->data.clear();
+    impl->entry = it->second;
+    impl->can_write = true;
+    impl->can_read = plus;
+  } else if (m[0] == 'a') {
+    if (it == v.files.end()) it = v.files.emplace(p, std::make_shared<Entry>()).first;
+    impl->entry = it->second;
+    impl->can_write = true;
+    impl->can_read = plus;
+    impl->append = true;
+    impl->pos = impl->entry->data.size();
+  } else {
+    return File();
+  }
+  impl->path = p;
+  impl->name = p.substr(p.rfind('/') + 1);
+  impl->committed_size = impl->entry->data.size();
+  mock::fs_stats.opens++;
+  return File(impl);
+}
+
+bool FS::exists(const char* path) { return volume().mounted && volume().files.count(normalize(path)) > 0; }
+
+bool FS::remove(const char* path) {
+  mock::HeapPause pause;
+  return volume().mounted && volume().files.erase(normalize(path)) > 0;
+}
+
+bool FS::rename(const char* from, const char* to) {
+  mock::HeapPause pause;
+  Volume& v = volume();
+  auto it = v.files.find(normalize(from));
+  if (!v.mounted || it == v.files.end()) return false;
+  std::shared_ptr<Entry> e = it->second;
+  v.files.erase(it);
+  v.files[normalize(to)] = e;
+  return true;
+}
+
+}  // namespace fs
+
+bool LittleFSFS::begin(bool, const char*, uint8_t, const char*) {
+  volume().mounted = true;
+  return true;
+}
+
+bool LittleFSFS::format() {
+  mock::HeapPause pause;
+  volume().files.clear();
+  return true;
+}
+
+size_t LittleFSFS::totalBytes() { return volume().total_bytes / mock::FS_BLOCK * mock::FS_BLOCK; }
+
+size_t LittleFSFS::usedBytes() { return usedBlocks(volume()) * mock::FS_BLOCK; }
+
+void mock::fs_reset(size_t total_bytes) {
+  mock::HeapPause pause;
+  Volume& v = volume();
+  v.files.clear();
+  v.total_bytes = total_bytes;
+  v.power_budget = -1;
+  fs_stats = FsStats();
+}
+
+bool mock::fs_put(const char* path, const std::string& bytes) {
+  mock::HeapPause pause;
+  auto e = std::make_shared<Entry>();
+  e->data.assign(bytes.begin(), bytes.end());
+  volume().files[normalize(path)] = e;
+  return true;
+}
+
+bool mock::fs_get(const char* path, std::string& bytes) {
+  mock::HeapPause pause;
+  auto it = volume().files.find(normalize(path));
+  if (it == volume().files.end()) return false;
+  bytes.assign(it->second->data.begin(), it->second->data.end());
+  return true;
+}
+
+std::vector<std::string> mock::fs_list() {
+  mock::HeapPause pause;
+  std::vector<std::string> out;
+  for (const auto& f : volume().files) out.push_back(f.first);
+  return out;
+}
+
+static bool loadDir(const std::string& host, const std::string& prefix) {
+  DIR* d = opendir(host.c_str());
+  if (!d) return false;
+  while (dirent* ent = readdir(d)) {
+    std::string name = ent->d_name;
+    if (name == "." || name == "..") continue;
+    std::string full = host + "/" + name;
+    struct stat st;
+    if (stat(full.c_str(), &st) != 0) continue;
+    if (S_ISDIR(st.st_mode)) {
+      loadDir(full, prefix + "/" + name);
+    } else {
+      std::ifstream in(full, std::ios::binary);
+      std::stringstream ss;
+      ss << in.rdbuf();
+      mock::fs_put((prefix + "/" + name).c_str(), ss.str());
+    }
+  }
+  closedir(d);
+  return true;
+}
+
+bool mock::fs_load_dir(const char* host_dir) {
+  mock::HeapPause pause;
+  return loadDir(host_dir, "");
+}
+
+void mock::fs_flash_timing(bool on) { volume().flash_timing = on; }
+
+void mock::fs_power_cut_after(int64_t bytes) { volume().power_budget = bytes; }
@@ -0,0 +1,116 @@
+// In-memory LittleFS. Besides holding the files it models what the flash
+// pays for each write: LittleFS is copy-on-write, so overwriting bytes in
+// the middle of a file rewrites everything from the block holding the first
+// changed byte to the end of the file, while appends only program the new
+// bytes. Those costs are counted and, optionally, charged to the clock.
+#pragma once
+
+#include "Arduino.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+struct FileImpl;
+
+class File : public Stream {
+ public:
+  File() {}
+  explicit File(std::shared_ptr<FileImpl> impl) : impl_(std::move(impl)) {}
+
+  explicit operator bool() const;
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* buf, size_t n) override;
+  using Print::write;
+  int available() override;
+  int read() override;
+  int peek() override;
+  size_t read(uint8_t* buf, size_t n);
+  bool seek(uint32_t pos, SeekMode mode = SeekSet);
+  size_t position() const;
+  size_t size() const;
+  void flush() override;
+  void close();
+  const char* name() const;
+  const char* path() const;
+  bool isDirectory() const;
+  // Directory handles: the next entry (file or subdirectory), or an invalid
+  // File at the end.
+  File openNextFile(const char* mode = FILE_READ);
+
+ private:
+  std::shared_ptr<FileImpl> impl_;
+};
+
+class FS {
+ public:
+  File open(const char* path, const char* mode = FILE_READ, bool create = false);
+  File open(const String& path, const char* mode = FILE_READ, bool create = false) {
+    return open(path.c_str(), mode, create);
+  }
+  bool exists(const char* path);
+  bool exists(const String& path) { return exists(path.c_str()); }
+  bool remove(const char* path);
+  bool remove(const String& path) { return remove(path.c_str()); }
+  bool rename(const char* from, const char* to);
+  bool rename(const String& from, const String& to) { return rename(from.c_str(), to.c_str()); }
+  bool mkdir(const char*) { return true; }
+};
+
+}  // namespace fs
+
+using fs::File;
+using fs::FS;
+using fs::SeekCur;
+using fs::SeekEnd;
+using fs::SeekSet;
+
+class LittleFSFS : public fs::FS {
+ public:
+  bool begin(bool format_on_fail = false, const char* base_path = "/littlefs", uint8_t max_open = 10,
+             const char* label = "spiffs");
+  bool format();
+  size_t totalBytes();
+  size_t usedBytes();
+  void end() {}
+};
+extern LittleFSFS LittleFS;
+
+namespace mock {
+
+struct FsStats {
+  uint64_t bytes_written;     // bytes handed to File::write
+  uint64_t prog_bytes;        // bytes the flash had to program, copy-on-write included
+  uint64_t erased_blocks;     // 4 KB blocks erased for those programs
+  uint32_t commits;           // closes/flushes that wrote something
+  uint32_t opens;
+};
+
+extern FsStats fs_stats;
+
+const uint32_t FS_BLOCK = 4096;
+
+// Drop every file and set the partition size (the sketch's default table
+// gives LittleFS 0x160000 bytes).
+void fs_reset(size_t total_bytes = 0x160000);
+// Copy a host directory into the root, e.g. the sketch's data/ folder.
+bool fs_load_dir(const char* host_dir);
+bool fs_put(const char* path, const std::string& bytes);
+bool fs_get(const char* path, std::string& bytes);
+std::vector<std::string> fs_list();
+// Charge erase/program time to the clock: 20 ms per erased block and
+// 0.1 ms per 256-byte page, roughly what the ESP32's SPI flash takes.
+void fs_flash_timing(bool on);
+// Power cut: after this many more bytes reach the flash, writes fail
+// silently and the partial data stays. Pass -1 to restore power.
+void fs_power_cut_after(int64_t bytes);
+
+}  // namespace mock
@@ -0,0 +1,94 @@
+#include "Preferences.h"
+
+#include <map>
+
+namespace {
+
+std::map<std::string, std::string>& nvs() {
+  static std::map<std::string, std::string>* m = [] {
+    mock::HeapPause pause;
+    return new std::map<std::string, std::string>();
+  }();
+  return *m;
+}
+
+}  // namespace
+
+void mock::prefs_reset() {
+  mock::HeapPause pause;
+  nvs().clear();
+}
+
+void mock::prefs_put(const std::string& ns, const std::string& key, const std::string& value) {
+  mock::HeapPause pause;
+  nvs()[ns + "/" + key] = value;
+}
+
+bool Preferences::begin(const char* name, bool read_only, const char*) {
+  mock::HeapPause pause;
+  ns_ = name;
+  read_only_ = read_only;
+  return true;
+}
+
+bool Preferences::clear() {
+  if (ns_.empty() || read_only_) return false;
+  mock::HeapPause pause;
+  std::string prefix = ns_ + "/";
+  for (auto it = nvs().begin(); it != nvs().end();) {
+    it = it->first.compare(0, prefix.size(), prefix) == 0 ? nvs().erase(it) : std::next(it);
+  }
+  return true;
+}
+
+bool Preferences::remove(const char* key) {
+  if (ns_.empty() || read_only_) return false;
+  mock::HeapPause pause;
+  return nvs().erase(ns_ + "/" + key) > 0;
+}
+
+bool Preferences::isKey(const char* key) {
+  std::string v;
+  return lookup(key, v);
+}
+
+bool Preferences::lookup(const char* key, std::string& out) {
+  if (ns_.empty()) return false;
+  mock::HeapPause pause;
+  auto it = nvs().find(ns_ + "/" + key);
+  if (it == nvs().end()) return false;
+  out = it->second;
+  return true;
+}
+
+size_t Preferences::store(const char* key, const std::string& value) {
+  if (ns_.empty() || read_only_) return 0;
+  mock::HeapPause pause;
+  nvs()[ns_ + "/" + key] = value;
+  return value.size() ? value.size() : 1;
+}
+
+size_t Preferences::putString(const char* key, const String& value) { return store(key, value.c_str()); }
+size_t Preferences::putInt(const char* key, int32_t value) { return store(key, std::to_string(value)) ? 4 : 0; }
+size_t Preferences::putUInt(const char* key, uint32_t value) { return store(key, std::to_string(value)) ? 4 : 0; }
+size_t Preferences::putUChar(const char* key, uint8_t value) { return store(key, std::to_string(value)) ? 1 : 0; }
+
+String Preferences::getString(const char* key, const String& def) {
+  std::string v;
+  return lookup(key, v) ? String(v.c_str()) : def;
+}
+
+int32_t Preferences::getInt(const char* key, int32_t def) {
+  std::string v;
+  return lookup(key, v) ? (int32_t)strtol(v.c_str(), nullptr, 10) : def;
+}
+
+uint32_t Preferences::getUInt(const char* key, uint32_t def) {
+  std::string v;
+  return lookup(key, v) ? (uint32_t)strtoul(v.c_str(), nullptr, 10) : def;
+}
+
+uint8_t Preferences::getUChar(const char* key, uint8_t def) {
+  std::string v;
+  return lookup(key, v) ? (uint8_t)strtoul(v.c_str(), nullptr, 10) : def;
+}
@@ -0,0 +1,41 @@
+// NVS preferences kept in memory for the life of the process; tests seed
+// or wipe them with mock::prefs_put() / mock::prefs_reset().
+#pragma once
+
+#include "Arduino.h"
+
+#include <string>
+
+class Preferences {
+ public:
+  bool begin(const char* name, bool read_only = false, const char* partition = nullptr);
+  void end() { ns_.clear(); }
+  bool clear();
+  bool remove(const char* key);
+  bool isKey(const char* key);
+
+  size_t putString(const char* key, const String& value);
+  size_t putInt(const char* key, int32_t value);
+  size_t putUInt(const char* key, uint32_t value);
+  size_t putUChar(const char* key, uint8_t value);
+  size_t putBool(const char* key, bool value) { return putUChar(key, value); }
+  String getString(const char* key, const String& def = String());
+  int32_t getInt(const char* key, int32_t def = 0);
+  uint32_t getUInt(const char* key, uint32_t def = 0);
+  uint8_t getUChar(const char* key, uint8_t def = 0);
+  bool getBool(const char* key, bool def = false) { return getUChar(key, def); }
+
+ private:
+  bool lookup(const char* key, std::string& out);
+  size_t store(const char* key, const std::string& value);
+
+  std::string ns_;
+  bool read_only_ = false;
+};
+
+namespace mock {
+
+void prefs_reset();
+void prefs_put(const std::string& ns, const std::string& key, const std::string& value);
+
+}  // namespace mock
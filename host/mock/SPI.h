@@ -0,0 +1,4 @@
+// TFT_eSPI owns the bus; nothing in the sketch touches SPI directly.
+#pragma once
+
+#include "Arduino.h"
@@ -0,0 +1,31 @@
+// String that is also a Stream: writes append, reads consume from the front.
+#pragma once
+
+#include "Arduino.h"
+
+class StreamString : public Stream, public String {
+ public:
+  size_t write(uint8_t c) override {
+    String::operator+=((char)c);
+    return 1;
+  }
+  size_t write(const uint8_t* buf, size_t n) override {
+    for (size_t i = 0; i < n; i++) String::operator+=((char)buf[i]);
+    return n;
+  }
+  using Print::write;
+  int available() override { return (int)(length() - pos_); }
+  int read() override {
+    if (pos_ >= length()) return -1;
+    int c = (uint8_t)c_str()[pos_++];
+    if (pos_ >= length()) {
+      *(String*)this = String();
+      pos_ = 0;
+    }
+    return c;
+  }
+  int peek() override { return pos_ < length() ? (uint8_t)c_str()[pos_] : -1; }
+
+ private:
+  size_t pos_ = 0;
+};
@@ -0,0 +1,531 @@
+#include "TFT_eSPI.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+mock::TftStats mock::tft_stats;
+mock::TftConfig mock::tft_config;
+
+// ==================== VLW FONTS ====================
+struct mock::VlwFont {
+  struct Glyph {
+    int16_t width, height, advance, dy, dx;
+    std::vector<uint8_t> alpha;
+  };
+  std::map<uint32_t, Glyph> glyphs;
+  int16_t max_ascent = 0;
+  int16_t y_advance = 0;
+  int16_t space_width = 0;
+};
+
+namespace {
+
+// Panel contents in logical RGB565, landscape.
+uint16_t* panelBuffer() {
+  static uint16_t* fb = [] {
+    mock::HeapPause pause;
+    return new uint16_t[mock::PANEL_W * mock::PANEL_H]();
+  }();
+  return fb;
+}
+
+// Every address window costs CASET, RASET and RAMWR with their arguments.
+const uint32_t WINDOW_BYTES = 11;
+
+void countPanel(uint64_t pixels, uint32_t windows) {
+  mock::tft_stats.panel_pixels += pixels;
+  mock::tft_stats.spi_bytes += pixels * 2 + (uint64_t)windows * WINDOW_BYTES;
+  mock::tft_stats.transactions += windows;
+}
+
+inline uint16_t swap16(uint16_t v) { return (v >> 8) | (v << 8); }
+
+// Copy pixels to the panel. Without swap the data is already in panel
+// (big-endian) byte order, as sprite buffers are.
+void panelBlit(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data, int32_t stride, bool swapped,
+               uint32_t windows) {
+  uint16_t* fb = panelBuffer();
+  uint64_t n = 0;
+  for (int32_t r = 0; r < h; r++) {
+    int32_t py = y + r;
+    if (py < 0 || py >= mock::PANEL_H) continue;
+    for (int32_t c = 0; c < w; c++) {
+      int32_t px = x + c;
+      if (px < 0 || px >= mock::PANEL_W) continue;
+      uint16_t v = data[(size_t)r * stride + c];
+      fb[py * mock::PANEL_W + px] = swapped ? v : swap16(v);
+      n++;
+    }
+  }
+  countPanel(n, windows);
+}
+
+uint32_t readBE32(const uint8_t*& p) {
+  uint32_t v = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+  p += 4;
+  return v;
+}
+
+// Same metrics as TFT_eSPI's loadMetrics(): ascent and descent come from the
+// printable glyphs, the space width from the header.
+std::shared_ptr<const mock::VlwFont> parseVlw(const uint8_t* data, size_t size) {
+  mock::HeapPause pause;
+  if (!data || size < 24) return nullptr;
+  const uint8_t* p = data;
+  const uint8_t* end = data + size;
+  uint32_t count = readBE32(p);
+  readBE32(p);
+  readBE32(p);
+  readBE32(p);
+  int32_t ascent = readBE32(p);
+  int32_t descent = readBE32(p);
+  if (count > 10000 || (size_t)(end - p) < count * 28) return nullptr;
+
+  auto font = std::make_shared<mock::VlwFont>();
+  int32_t max_ascent = ascent, max_descent = descent;
+  std::vector<std::pair<uint32_t, mock::VlwFont::Glyph>> list;
+  for (uint32_t i = 0; i < count; i++) {
+    mock::VlwFont::Glyph g;
+    uint32_t code = readBE32(p);
+    g.height = readBE32(p);
+    g.width = readBE32(p);
+    g.advance = readBE32(p);
+    g.dy = (int32_t)readBE32(p);
+    g.dx = (int8_t)readBE32(p);
+    readBE32(p);
+    if ((code > 0x20 && code < 0xA0 && code != 0x7F) || code > 0xFF) {
+      max_ascent = std::max<int32_t>(max_ascent, g.dy);
+      max_descent = std::max<int32_t>(max_descent, g.height - g.dy);
+    }
+    list.push_back({ code, g });
+  }
+  for (auto& e : list) {
+    size_t n = (size_t)e.second.width * e.second.height;
+    if ((size_t)(end - p) < n) return nullptr;
+    e.second.alpha.assign(p, p + n);
+    p += n;
+    font->glyphs[e.first] = std::move(e.second);
+  }
+  font->max_ascent = max_ascent;
+  font->y_advance = max_ascent + max_descent;
+  font->space_width = (ascent + descent) * 2 / 7;
+  return font;
+}
+
+uint16_t alphaBlend(uint8_t alpha, uint16_t fg, uint16_t bg) {
+  uint16_t fr = ((fg >> 10) & 0x3E) + 1, fgG = ((fg >> 4) & 0x7E) + 1, fb = ((fg << 1) & 0x3E) + 1;
+  uint16_t br = ((bg >> 10) & 0x3E) + 1, bgG = ((bg >> 4) & 0x7E) + 1, bb = ((bg << 1) & 0x3E) + 1;
+  uint16_t r = ((fr * alpha) + (br * (255 - alpha))) >> 9;
+  uint16_t g = ((fgG * alpha) + (bgG * (255 - alpha))) >> 9;
+  uint16_t b = ((fb * alpha) + (bb * (255 - alpha))) >> 9;
+  return (r << 11) | (g << 5) | b;
+}
+
+// Stand-in for the 5x7 GLCD font: a fixed pseudo-random pattern per
+// character so changed text changes pixels.
+bool glcdBit(uint32_t ch, int col, int row) {
+  if (ch == ' ' || col >= 5 || row >= 7) return false;
+  uint32_t h = ch * 2654435761u;
+  h ^= h >> 13;
+  return (h >> ((col * 7 + row) % 31)) & 1;
+}
+
+uint32_t nextCodepoint(const char*& s) {
+  uint8_t c = *s++;
+  if (c < 0x80) return c;
+  int extra = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : c >= 0xC0 ? 1 : 0;
+  uint32_t cp = c & (0x3F >> extra);
+  while (extra-- && (*s & 0xC0) == 0x80) cp = (cp << 6) | (*s++ & 0x3F);
+  return cp;
+}
+
+}  // namespace
+
+const uint16_t* mock::panel() { return panelBuffer(); }
+
+uint16_t mock::panel_pixel(int x, int y) {
+  if (x < 0 || y < 0 || x >= PANEL_W || y >= PANEL_H) return 0;
+  return panelBuffer()[y * PANEL_W + x];
+}
+
+void mock::panel_clear() { memset(panelBuffer(), 0, PANEL_W * PANEL_H * sizeof(uint16_t)); }
+
+// ==================== PANEL ====================
+TFT_eSPI::TFT_eSPI(int16_t w, int16_t h) : width_(w), height_(h) {
+  // The panel is always used in landscape by the sketch.
+  if (w == TFT_WIDTH && h == TFT_HEIGHT) {
+    width_ = mock::PANEL_W;
+    height_ = mock::PANEL_H;
+  }
+}
+
+TFT_eSPI::~TFT_eSPI() { free(font_metrics_); }
+
+void TFT_eSPI::begin() {}
+
+void TFT_eSPI::setRotation(uint8_t) {}
+
+uint16_t* TFT_eSPI::target() const { return panelBuffer(); }
+
+void TFT_eSPI::countPixels(uint64_t n, uint32_t windows) {
+  if (onPanel()) countPanel(n, windows);
+  else mock::tft_stats.sprite_pixels += n;
+}
+
+void TFT_eSPI::fillSpan(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) {
+  uint16_t* buf = target();
+  if (!buf) return;
+  int32_t left = 0, top = 0, right = width_, bottom = height_;
+  if (vp_w_ >= 0) {
+    if (vp_datum_) x += vp_x_, y += vp_y_;
+    left = std::max(left, vp_x_);
+    top = std::max(top, vp_y_);
+    right = std::min(right, vp_x_ + vp_w_);
+    bottom = std::min(bottom, vp_y_ + vp_h_);
+  }
+  if (x < left) w -= left - x, x = left;
+  if (y < top) h -= top - y, y = top;
+  if (x + w > right) w = right - x;
+  if (y + h > bottom) h = bottom - y;
+  if (w <= 0 || h <= 0) return;
+  uint16_t v = onPanel() ? color : swap16(color);
+  for (int32_t r = 0; r < h; r++) {
+    uint16_t* row = buf + (size_t)(y + r) * width_ + x;
+    for (int32_t c = 0; c < w; c++) row[c] = v;
+  }
+  countPixels((uint64_t)w * h, 1);
+}
+
+void TFT_eSPI::setViewport(int32_t x, int32_t y, int32_t w, int32_t h, bool vpDatum) {
+  vp_x_ = x;
+  vp_y_ = y;
+  vp_w_ = std::max(w, 0);
+  vp_h_ = std::max(h, 0);
+  vp_datum_ = vpDatum;
+}
+
+void TFT_eSPI::resetViewport() {
+  vp_x_ = vp_y_ = 0;
+  vp_w_ = vp_h_ = -1;
+  vp_datum_ = false;
+}
+
+uint16_t TFT_eSPI::readPixel(int32_t x, int32_t y) {
+  if (x < 0 || y < 0 || x >= width_ || y >= height_) return 0;
+  return panelBuffer()[y * mock::PANEL_W + x];
+}
+
+size_t TFT_eSPI::write(uint8_t c) {
+  if (c == '\n') {
+    cursor_x_ = 0;
+    cursor_y_ += fontHeight();
+    return 1;
+  }
+  char s[2] = { (char)c, 0 };
+  cursor_x_ += drawString(s, cursor_x_, cursor_y_, textfont_);
+  return 1;
+}
+
+void TFT_eSPI::fillScreen(uint32_t color) { fillSpan(0, 0, width_, height_, color); }
+
+void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color) { fillSpan(x, y, 1, 1, color); }
+
+void TFT_eSPI::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) { fillSpan(x, y, w, 1, color); }
+
+void TFT_eSPI::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) { fillSpan(x, y, 1, h, color); }
+
+// Bresenham with runs, exactly as TFT_eSPI::drawLine, so lines cover the
+// same pixels and cost the same number of address windows.
+void TFT_eSPI::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color) {
+  bool steep = std::abs(y1 - y0) > std::abs(x1 - x0);
+  if (steep) {
+    std::swap(x0, y0);
+    std::swap(x1, y1);
+  }
+  if (x0 > x1) {
+    std::swap(x0, x1);
+    std::swap(y0, y1);
+  }
+  int32_t dx = x1 - x0, dy = std::abs(y1 - y0);
+  int32_t err = dx >> 1, ystep = -1, xs = x0, dlen = 0;
+  if (y0 < y1) ystep = 1;
+  for (; x0 <= x1; x0++) {
+    dlen++;
+    err -= dy;
+    if (err < 0) {
+      if (steep) drawFastVLine(y0, xs, dlen, color);
+      else drawFastHLine(xs, y0, dlen, color);
+      err += dx;
+      dlen = 0;
+      y0 += ystep;
+      xs = x0 + 1;
+    }
+  }
+  if (dlen) {
+    if (steep) drawFastVLine(y0, xs, dlen, color);
+    else drawFastHLine(xs, y0, dlen, color);
+  }
+}
+
+void TFT_eSPI::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) { fillSpan(x, y, w, h, color); }
+
+void TFT_eSPI::drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+  drawFastHLine(x, y, w, color);
+  drawFastHLine(x, y + h - 1, w, color);
+  drawFastVLine(x, y + 1, h - 2, color);
+  drawFastVLine(x + w - 1, y + 1, h - 2, color);
+}
+
+// ==================== TEXT ====================
+void TFT_eSPI::loadFont(const uint8_t* array) {
+  unloadFont();
+  // The array is a whole .vlw file; its size is in the glyph table.
+  const uint8_t* p = array;
+  uint32_t count = readBE32(p);
+  size_t size = 24 + (size_t)count * 28;
+  p = array + 24;
+  for (uint32_t i = 0; i < count; i++) {
+    const uint8_t* g = p + i * 28;
+    uint32_t h = ((uint32_t)g[4] << 24) | (g[5] << 16) | (g[6] << 8) | g[7];
+    uint32_t w = ((uint32_t)g[8] << 24) | (g[9] << 16) | (g[10] << 8) | g[11];
+    size += (size_t)w * h;
+  }
+  font_ = parseVlw(array, size);
+  if (font_) font_metrics_ = malloc(font_->glyphs.size() * 18);
+  mock::tft_stats.font_loads++;
+}
+
+void TFT_eSPI::loadFont(const String& name, fs::FS& fs) {
+  unloadFont();
+  std::string bytes;
+  {
+    String path = "/" + name + ".vlw";
+    File f = fs.open(path, "r");
+    if (!f) {
+      Serial.println("[mock] font missing: " + path);
+      return;
+    }
+    mock::HeapPause pause;
+    bytes.resize(f.size());
+    f.read((uint8_t*)&bytes[0], bytes.size());
+  }
+  font_ = parseVlw((const uint8_t*)bytes.data(), bytes.size());
+  if (font_) font_metrics_ = malloc(font_->glyphs.size() * 18);
+  mock::tft_stats.font_loads++;
+}
+
+void TFT_eSPI::loadFont(const String& name, bool) { loadFont(name, LittleFS); }
+
+void TFT_eSPI::unloadFont() {
+  font_.reset();
+  free(font_metrics_);
+  font_metrics_ = nullptr;
+}
+
+int16_t TFT_eSPI::fontHeight(int16_t font) {
+  if (font_) return font_->y_advance;
+  switch (font) {
+    case 2: return 16;
+    case 4: return 26;
+    default: return 8;
+  }
+}
+
+int16_t TFT_eSPI::glyphWidth(uint32_t ch, uint8_t) const {
+  if (!font_) return 6;
+  auto it = font_->glyphs.find(ch);
+  if (it != font_->glyphs.end()) return it->second.advance;
+  return ch == ' ' ? font_->space_width : font_->space_width + 1;
+}
+
+int16_t TFT_eSPI::textWidth(const char* s, uint8_t font) {
+  int16_t w = 0;
+  while (s && *s) w += glyphWidth(nextCodepoint(s), font);
+  return w;
+}
+
+void TFT_eSPI::drawGlyph(uint32_t ch, int32_t x, int32_t y, uint8_t font) {
+  uint16_t* buf = target();
+  if (!buf) return;
+  if (!font_) {
+    // 6x8 cell; with a background colour the whole cell is one window
+    bool fill = textcolor != textbgcolor;
+    uint64_t n = 0;
+    uint32_t windows = fill ? 1 : 0;
+    for (int row = 0; row < 8; row++) {
+      for (int col = 0; col < 6; col++) {
+        bool on = glcdBit(ch, col, row);
+        if (!on && !fill) continue;
+        int32_t px = x + col, py = y + row;
+        if (px < 0 || py < 0 || px >= width_ || py >= height_) continue;
+        uint16_t c = on ? textcolor : textbgcolor;
+        buf[py * width_ + px] = onPanel() ? c : swap16(c);
+        n++;
+        if (!fill) windows++;
+      }
+    }
+    countPixels(n, windows);
+    (void)font;
+    return;
+  }
+  auto it = font_->glyphs.find(ch);
+  if (it == font_->glyphs.end()) {
+    if (ch != ' ') drawRect(x, y + 1, font_->space_width, font_->y_advance - 2, textcolor);
+    return;
+  }
+  const mock::VlwFont::Glyph& g = it->second;
+  int32_t top = y + font_->max_ascent - g.dy;
+  uint64_t n = 0;
+  uint32_t windows = 0;
+  for (int row = 0; row < g.height; row++) {
+    int32_t py = top + row;
+    if (py < 0 || py >= height_) continue;
+    bool in_run = false;
+    for (int col = 0; col < g.width; col++) {
+      uint8_t a = g.alpha[row * g.width + col];
+      int32_t px = x + g.dx + col;
+      if (!a || px < 0 || px >= width_) {
+        in_run = false;
+        continue;
+      }
+      uint16_t* dst = &buf[py * width_ + px];
+      uint16_t bg = textbgcolor;
+      if (textcolor == textbgcolor) bg = onPanel() ? *dst : swap16(*dst);
+      uint16_t c = a == 255 ? textcolor : alphaBlend(a, textcolor, bg);
+      *dst = onPanel() ? c : swap16(c);
+      n++;
+      // Solid runs go out as one line, edge pixels one by one
+      if (a == 255) {
+        if (!in_run) windows++;
+        in_run = true;
+      } else {
+        windows++;
+        in_run = false;
+      }
+    }
+  }
+  countPixels(n, windows);
+}
+
+int16_t TFT_eSPI::drawString(const char* s, int32_t x, int32_t y, uint8_t font) {
+  int16_t width = textWidth(s, font);
+  if (datum_ == TC_DATUM) x -= width / 2;
+  else if (datum_ == TR_DATUM) x -= width;
+  int32_t cx = x;
+  while (s && *s) {
+    uint32_t ch = nextCodepoint(s);
+    drawGlyph(ch, cx, y, font);
+    cx += glyphWidth(ch, font);
+  }
+  if (padding_ > width) fillSpan(x + width, y, padding_ - width, fontHeight(font), textbgcolor);
+  return width;
+}
+
+int16_t TFT_eSPI::drawCentreString(const char* s, int32_t x, int32_t y, uint8_t font) {
+  uint8_t saved = datum_;
+  datum_ = TC_DATUM;
+  int16_t w = drawString(s, x, y, font);
+  datum_ = saved;
+  return w;
+}
+
+int16_t TFT_eSPI::drawRightString(const char* s, int32_t x, int32_t y, uint8_t font) {
+  uint8_t saved = datum_;
+  datum_ = TR_DATUM;
+  int16_t w = drawString(s, x, y, font);
+  datum_ = saved;
+  return w;
+}
+
+// ==================== BULK TRANSFERS ====================
+void TFT_eSPI::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data) {
+  panelBlit(x, y, w, h, data, w, swap_bytes_, 1);
+}
+
+bool TFT_eSPI::initDMA(bool) { return dma_ = mock::tft_config.dma_available; }
+
+void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data, uint16_t*) {
+  panelBlit(x, y, w, h, data, w, swap_bytes_, 1);
+  mock::tft_stats.dma_pushes++;
+}
+
+// ==================== SPRITES ====================
+TFT_eSprite::~TFT_eSprite() { deleteSprite(); }
+
+void* TFT_eSprite::createSprite(int16_t w, int16_t h, uint8_t) {
+  if (buf_) return buf_;
+  size_t bytes = (size_t)w * h * 2;
+  if (psram_ && mock::tft_config.psram_bytes >= bytes) {
+    // PSRAM is outside the internal heap the sketch reports
+    mock::HeapPause pause;
+    buf_ = (uint16_t*)calloc((size_t)w * h, 2);
+    mock::tft_config.psram_bytes -= bytes;
+    in_psram_ = true;
+  } else {
+    if (bytes > mock::tft_config.sprite_ram_limit || bytes > ESP.getMaxAllocHeap()) return nullptr;
+    buf_ = (uint16_t*)calloc((size_t)w * h, 2);
+    in_psram_ = false;
+  }
+  if (!buf_) return nullptr;
+  width_ = w;
+  height_ = h;
+  setScrollRect(0, 0, w, h, TFT_BLACK);
+  return buf_;
+}
+
+void TFT_eSprite::deleteSprite() {
+  if (buf_ && in_psram_) mock::tft_config.psram_bytes += (size_t)width_ * height_ * 2;
+  free(buf_);
+  buf_ = nullptr;
+  width_ = height_ = 0;
+}
+
+uint16_t TFT_eSprite::readPixel(int32_t x, int32_t y) {
+  if (!buf_ || x < 0 || y < 0 || x >= width_ || y >= height_) return 0;
+  return swap16(buf_[y * width_ + x]);
+}
+
+void TFT_eSprite::setScrollRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) {
+  scroll_x_ = x;
+  scroll_y_ = y;
+  scroll_w_ = w;
+  scroll_h_ = h;
+  scroll_fill_ = color;
+}
+
+void TFT_eSprite::scroll(int16_t dx, int16_t dy) {
+  if (!buf_ || (!dx && !dy)) return;
+  std::vector<uint16_t> copy;
+  {
+    mock::HeapPause pause;
+    copy.assign(buf_, buf_ + (size_t)width_ * height_);
+  }
+  uint16_t fill = swap16(scroll_fill_);
+  for (int32_t r = 0; r < scroll_h_; r++) {
+    for (int32_t c = 0; c < scroll_w_; c++) {
+      int32_t sx = c - dx, sy = r - dy;
+      uint16_t v = (sx >= 0 && sy >= 0 && sx < scroll_w_ && sy < scroll_h_)
+                       ? copy[(size_t)(scroll_y_ + sy) * width_ + scroll_x_ + sx]
+                       : fill;
+      buf_[(size_t)(scroll_y_ + r) * width_ + scroll_x_ + c] = v;
+    }
+  }
+}
+
+void TFT_eSprite::pushSprite(int32_t x, int32_t y) {
+  if (buf_) panelBlit(x, y, width_, height_, buf_, width_, false, 1);
+}
+
+bool TFT_eSprite::pushSprite(int32_t tx, int32_t ty, int32_t sx, int32_t sy, int32_t sw, int32_t sh) {
+  if (!buf_) return false;
+  if (sx < 0) sw += sx, tx -= sx, sx = 0;
+  if (sy < 0) sh += sy, ty -= sy, sy = 0;
+  if (sx + sw > width_) sw = width_ - sx;
+  if (sy + sh > height_) sh = height_ - sy;
+  if (sw <= 0 || sh <= 0) return false;
+  // Full-width regions go out as one block, others line by line
+  uint32_t windows = (sx == 0 && sw == width_) ? 1 : sh;
+  panelBlit(tx, ty, sw, sh, buf_ + (size_t)sy * width_ + sx, width_, false, windows);
+  return true;
+}
@@ -0,0 +1,226 @@
+// TFT_eSPI and TFT_eSprite drawing into memory. The panel is a 480x320
+// RGB565 framebuffer; every primitive that reaches it is counted as pixels
+// and SPI bytes (2 per pixel plus an address window per transaction), which
+// is what the display loop pays for on the device. Sprites draw into their
+// own heap buffer and only cost SPI when pushed.
+//
+// Smooth fonts are the real .vlw files parsed from LittleFS, so text covers
+// the same pixels as on the panel. Advances are used for widths (no
+// end-of-string ink trimming), matching the sketch's per-glyph arithmetic.
+#pragma once
+
+#include "Arduino.h"
+#include "LittleFS.h"
+
+#include <memory>
+
+// Present in TFT_eSPI for ESP32 SPI panels that support DMA.
+#define ESP32_DMA
+
+#define TFT_WIDTH 320
+#define TFT_HEIGHT 480
+#define TFT_BL 27
+
+#define TFT_BLACK 0x0000
+#define TFT_NAVY 0x000F
+#define TFT_DARKGREEN 0x03E0
+#define TFT_DARKCYAN 0x03EF
+#define TFT_MAROON 0x7800
+#define TFT_PURPLE 0x780F
+#define TFT_OLIVE 0x7BE0
+#define TFT_LIGHTGREY 0xD69A
+#define TFT_DARKGREY 0x7BEF
+#define TFT_BLUE 0x001F
+#define TFT_GREEN 0x07E0
+#define TFT_CYAN 0x07FF
+#define TFT_RED 0xF800
+#define TFT_MAGENTA 0xF81F
+#define TFT_YELLOW 0xFFE0
+#define TFT_WHITE 0xFFFF
+#define TFT_ORANGE 0xFDA0
+#define TFT_GREENYELLOW 0xB7E0
+#define TFT_PINK 0xFE19
+#define TFT_BROWN 0x9A60
+#define TFT_GOLD 0xFEA0
+#define TFT_SILVER 0xC618
+#define TFT_SKYBLUE 0x867D
+#define TFT_VIOLET 0x915C
+
+#define TL_DATUM 0
+#define TC_DATUM 1
+#define TR_DATUM 2
+#define MC_DATUM 4
+
+#define PSRAM_ENABLE 3
+
+namespace mock {
+
+struct TftStats {
+  uint64_t panel_pixels;      // pixels written to the panel
+  uint64_t spi_bytes;         // bytes on the SPI bus, commands included
+  uint64_t transactions;      // address windows opened
+  uint64_t dma_pushes;        // pushImageDMA calls
+  uint64_t sprite_pixels;     // pixels drawn into sprites (CPU only)
+  uint32_t font_loads;        // loadFont calls
+};
+
+struct TftConfig {
+  bool dma_available = true;                 // what initDMA() returns
+  size_t sprite_ram_limit = (size_t)-1;      // cap on internal-RAM sprites, besides the largest free block
+  size_t psram_bytes = 0;                    // PSRAM left for sprites (a WROOM module has none)
+};
+
+extern TftStats tft_stats;
+extern TftConfig tft_config;
+
+const int PANEL_W = 480;
+const int PANEL_H = 320;
+const uint16_t* panel();
+uint16_t panel_pixel(int x, int y);
+void panel_clear();
+
+struct VlwFont;
+
+}  // namespace mock
+
+class TFT_eSPI : public Print {
+ public:
+  TFT_eSPI(int16_t w = TFT_WIDTH, int16_t h = TFT_HEIGHT);
+  virtual ~TFT_eSPI();
+
+  void init() { begin(); }
+  void begin();
+  void setRotation(uint8_t r);
+  int16_t width() const { return width_; }
+  int16_t height() const { return height_; }
+
+  size_t write(uint8_t c) override;
+  using Print::write;
+
+  // Shapes
+  void fillScreen(uint32_t color);
+  void drawPixel(int32_t x, int32_t y, uint32_t color);
+  void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color);
+  void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color);
+  void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color);
+  virtual void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+  void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+  // Clip rectangle for shapes (text ignores it); with vpDatum the origin
+  // moves to its corner as well.
+  void setViewport(int32_t x, int32_t y, int32_t w, int32_t h, bool vpDatum = true);
+  void resetViewport();
+  uint16_t color565(uint8_t r, uint8_t g, uint8_t b) const {
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+  }
+  virtual uint16_t readPixel(int32_t x, int32_t y);
+
+  // Text
+  void setTextColor(uint16_t fg) { textcolor = textbgcolor = fg; }
+  void setTextColor(uint16_t fg, uint16_t bg, bool bgfill = false) {
+    textcolor = fg;
+    textbgcolor = bg;
+    (void)bgfill;
+  }
+  void setTextDatum(uint8_t d) { datum_ = d; }
+  void setTextFont(uint8_t f) { textfont_ = f; }
+  void setTextSize(uint8_t) {}
+  void setTextPadding(uint16_t px) { padding_ = px; }
+  void setCursor(int16_t x, int16_t y) { cursor_x_ = x, cursor_y_ = y; }
+  void loadFont(const uint8_t* array);
+  void loadFont(const String& name, fs::FS& fs);
+  void loadFont(const String& name, bool flash = true);
+  void unloadFont();
+  int16_t fontHeight(int16_t font);
+  int16_t fontHeight() { return fontHeight(textfont_); }
+  int16_t textWidth(const char* s, uint8_t font);
+  int16_t textWidth(const char* s) { return textWidth(s, textfont_); }
+  int16_t textWidth(const String& s, uint8_t font) { return textWidth(s.c_str(), font); }
+  int16_t textWidth(const String& s) { return textWidth(s.c_str(), textfont_); }
+  int16_t drawString(const char* s, int32_t x, int32_t y, uint8_t font);
+  int16_t drawString(const char* s, int32_t x, int32_t y) { return drawString(s, x, y, textfont_); }
+  int16_t drawString(const String& s, int32_t x, int32_t y, uint8_t font) { return drawString(s.c_str(), x, y, font); }
+  int16_t drawString(const String& s, int32_t x, int32_t y) { return drawString(s.c_str(), x, y, textfont_); }
+  int16_t drawCentreString(const char* s, int32_t x, int32_t y, uint8_t font);
+  int16_t drawCentreString(const String& s, int32_t x, int32_t y, uint8_t font) {
+    return drawCentreString(s.c_str(), x, y, font);
+  }
+  int16_t drawRightString(const char* s, int32_t x, int32_t y, uint8_t font);
+  int16_t drawRightString(const String& s, int32_t x, int32_t y, uint8_t font) {
+    return drawRightString(s.c_str(), x, y, font);
+  }
+
+  // Bulk transfers
+  void startWrite() {}
+  void endWrite() {}
+  void setSwapBytes(bool swap) { swap_bytes_ = swap; }
+  bool getSwapBytes() const { return swap_bytes_; }
+  void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data);
+  bool initDMA(bool ctrl_cs = false);
+  void deInitDMA() { dma_ = false; }
+  void pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data, uint16_t* buffer = nullptr);
+  void dmaWait() {}
+  bool dmaBusy() { return false; }
+
+  uint16_t textcolor = TFT_WHITE;
+  uint16_t textbgcolor = TFT_BLACK;
+
+ protected:
+  // Draw target: the panel for TFT_eSPI, the sprite buffer for sprites.
+  virtual uint16_t* target() const;
+  virtual bool onPanel() const { return true; }
+  void fillSpan(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color);   // clipped, counted
+  void countPixels(uint64_t n, uint32_t windows);
+  int16_t glyphWidth(uint32_t ch, uint8_t font) const;
+  void drawGlyph(uint32_t ch, int32_t x, int32_t y, uint8_t font);
+
+  int16_t width_;
+  int16_t height_;
+  uint8_t textfont_ = 1;
+  uint8_t datum_ = TL_DATUM;
+  uint16_t padding_ = 0;
+  int16_t cursor_x_ = 0;
+  int16_t cursor_y_ = 0;
+  bool swap_bytes_ = false;
+  bool dma_ = false;
+  int32_t vp_x_ = 0, vp_y_ = 0, vp_w_ = -1, vp_h_ = -1;   // -1: the whole target
+  bool vp_datum_ = false;
+  std::shared_ptr<const mock::VlwFont> font_;
+  void* font_metrics_ = nullptr;   // what TFT_eSPI allocates per loadFont
+};
+
+class TFT_eSprite : public TFT_eSPI {
+ public:
+  explicit TFT_eSprite(TFT_eSPI* tft) : TFT_eSPI(0, 0), tft_(tft) {}
+  ~TFT_eSprite() override;
+  TFT_eSprite(const TFT_eSprite&) = delete;
+  TFT_eSprite& operator=(const TFT_eSprite&) = delete;
+
+  void* createSprite(int16_t w, int16_t h, uint8_t frames = 1);
+  void deleteSprite();
+  bool created() const { return buf_ != nullptr; }
+  void setColorDepth(int8_t bits) { depth_ = bits; }
+  int8_t getColorDepth() const { return depth_; }
+  void setAttribute(uint8_t id, uint8_t value) {
+    if (id == PSRAM_ENABLE) psram_ = value;
+  }
+  void fillSprite(uint32_t color) { fillRect(0, 0, width_, height_, color); }
+  void* getPointer() { return buf_; }
+  uint16_t readPixel(int32_t x, int32_t y) override;
+  void setScrollRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color = TFT_BLACK);
+  void scroll(int16_t dx, int16_t dy = 0);
+  void pushSprite(int32_t x, int32_t y);
+  bool pushSprite(int32_t tx, int32_t ty, int32_t sx, int32_t sy, int32_t sw, int32_t sh);
+
+ protected:
+  uint16_t* target() const override { return buf_; }
+  bool onPanel() const override { return false; }
+
+ private:
+  TFT_eSPI* tft_;
+  uint16_t* buf_ = nullptr;
+  int8_t depth_ = 16;
+  bool psram_ = false;
+  bool in_psram_ = false;
+  int32_t scroll_x_ = 0, scroll_y_ = 0, scroll_w_ = 0, scroll_h_ = 0;
+  uint16_t scroll_fill_ = TFT_BLACK;
+};
@@ -0,0 +1,206 @@
+#include "WiFi.h"
+
+#include <map>
+
+WiFiClass WiFi;
+mock::WifiConfig mock::wifi_config;
+
+namespace {
+
+std::map<std::string, mock::TcpPeer*>& listeners() {
+  static std::map<std::string, mock::TcpPeer*>* m = [] {
+    mock::HeapPause pause;
+    return new std::map<std::string, mock::TcpPeer*>();
+  }();
+  return *m;
+}
+
+std::string endpointKey(const std::string& host, uint16_t port) { return host + ":" + std::to_string(port); }
+
+bool link_up = true;
+bool joined = false;
+unsigned long join_at = 0;
+bool scan_started = false;
+unsigned long scan_done_at = 0;
+
+}  // namespace
+
+// ==================== CONNECTIONS ====================
+void mock::Conn::send(const std::string& bytes, size_t arrive_now) {
+  mock::HeapPause pause;
+  in_flight += bytes;
+  arrive(arrive_now);
+}
+
+bool mock::Conn::arrive(size_t max_bytes) {
+  if (in_flight.empty() || max_bytes == 0) return false;
+  mock::HeapPause pause;
+  size_t n = std::min(max_bytes, in_flight.size());
+  rx.insert(rx.end(), in_flight.begin(), in_flight.begin() + n);
+  in_flight.erase(0, n);
+  return true;
+}
+
+void mock::tcp_listen(const std::string& host, uint16_t port, TcpPeer* peer) {
+  mock::HeapPause pause;
+  listeners()[endpointKey(host, port)] = peer;
+}
+
+void mock::tcp_unlisten(const std::string& host, uint16_t port) {
+  mock::HeapPause pause;
+  listeners().erase(endpointKey(host, port));
+}
+
+int WiFiClient::connect(const char* host, uint16_t port) {
+  stop();
+  if (WiFi.status() != WL_CONNECTED) return 0;
+  auto it = listeners().find(endpointKey(host ? host : "", port));
+  if (it == listeners().end()) {
+    delay(20);   // RST from the router
+    return 0;
+  }
+  {
+    mock::HeapPause pause;
+    conn = std::make_shared<mock::Conn>();
+    conn->peer = it->second;
+    conn->host = host;
+    conn->port = port;
+    conn->tls = tls_;
+  }
+  delay(tls_ ? 400 : 5);   // handshake
+  conn->peer->onConnect(*conn);
+  if (!conn->open) {
+    conn.reset();
+    return 0;
+  }
+  return 1;
+}
+
+int WiFiClient::connect(IPAddress ip, uint16_t port) { return connect(ip.toString().c_str(), port); }
+
+uint8_t WiFiClient::connected() {
+  if (!conn) return 0;
+  pump();
+  return conn->open || !conn->rx.empty();
+}
+
+void WiFiClient::stop() {
+  if (!conn) return;
+  if (conn->open && conn->peer) conn->peer->onClose(*conn);
+  conn->open = false;
+  mock::HeapPause pause;
+  conn.reset();
+}
+
+size_t WiFiClient::write(const uint8_t* buf, size_t n) {
+  if (!conn || !conn->open) return 0;
+  if (conn->peer) conn->peer->onData(*conn, buf, n);
+  return n;
+}
+
+void WiFiClient::pump() {
+  if (conn && conn->open && conn->peer) conn->peer->pump(*conn);
+}
+
+int WiFiClient::available() {
+  if (!conn) return 0;
+  pump();
+  if (conn->rx.empty()) conn->arrive();
+  return (int)conn->rx.size();
+}
+
+int WiFiClient::read() {
+  if (!available()) return -1;
+  int c = conn->rx.front();
+  conn->rx.pop_front();
+  return c;
+}
+
+int WiFiClient::read(uint8_t* buf, size_t size) {
+  size_t n = 0;
+  while (n < size && available()) {
+    size_t chunk = std::min(size - n, conn->rx.size());
+    std::copy(conn->rx.begin(), conn->rx.begin() + chunk, buf + n);
+    conn->rx.erase(conn->rx.begin(), conn->rx.begin() + chunk);
+    n += chunk;
+  }
+  return n ? (int)n : -1;
+}
+
+int WiFiClient::peek() {
+  if (!available()) return -1;
+  return conn->rx.front();
+}
+
+// ==================== WIFI ====================
+int WiFiClass::status() {
+  if (mode_ != WIFI_STA && mode_ != WIFI_AP_STA) return WL_DISCONNECTED;
+  if (!joined || !link_up) return WL_DISCONNECTED;
+  return millis() >= join_at ? WL_CONNECTED : WL_DISCONNECTED;
+}
+
+int WiFiClass::begin(const char*, const char*) {
+  if (mode_ == WIFI_OFF) mode_ = WIFI_STA;
+  joined = mock::wifi_config.joinable;
+  join_at = millis() + mock::wifi_config.join_ms;
+  return WL_DISCONNECTED;
+}
+
+bool WiFiClass::reconnect() {
+  joined = mock::wifi_config.joinable;
+  join_at = millis() + mock::wifi_config.join_ms;
+  return true;
+}
+
+bool WiFiClass::disconnect(bool) {
+  joined = false;
+  return true;
+}
+
+bool WiFiClass::softAP(const char*, const char*) {
+  mode_ = mode_ == WIFI_STA ? WIFI_AP_STA : WIFI_AP;
+  return true;
+}
+
+uint8_t* WiFiClass::macAddress(uint8_t* mac) {
+  static const uint8_t fixed[6] = { 0x24, 0x6f, 0x28, 0xa1, 0xb2, 0xc3 };
+  memcpy(mac, fixed, 6);
+  return mac;
+}
+
+String WiFiClass::macAddress() { return String("24:6F:28:A1:B2:C3"); }
+
+String WiFiClass::SSID() { return String("HomeNet"); }
+
+int WiFiClass::scanNetworks(bool async, bool) {
+  scan_started = true;
+  scan_done_at = millis() + mock::wifi_config.scan_ms;
+  if (async) return WIFI_SCAN_RUNNING;
+  delay(mock::wifi_config.scan_ms);
+  return (int)mock::wifi_config.networks.size();
+}
+
+int WiFiClass::scanComplete() {
+  if (!scan_started) return WIFI_SCAN_FAILED;
+  if (millis() < scan_done_at) return WIFI_SCAN_RUNNING;
+  return (int)mock::wifi_config.networks.size();
+}
+
+void WiFiClass::scanDelete() { scan_started = false; }
+
+String WiFiClass::SSID(int i) {
+  const auto& n = mock::wifi_config.networks;
+  return i >= 0 && (size_t)i < n.size() ? String(n[i].ssid) : String();
+}
+
+int WiFiClass::RSSI(int i) {
+  const auto& n = mock::wifi_config.networks;
+  return i >= 0 && (size_t)i < n.size() ? n[i].rssi : 0;
+}
+
+int WiFiClass::encryptionType(int i) {
+  const auto& n = mock::wifi_config.networks;
+  return i >= 0 && (size_t)i < n.size() ? n[i].auth : 0;
+}
+
+void mock::wifi_set_connected(bool up) { link_up = up; }
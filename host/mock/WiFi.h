@@ -0,0 +1,144 @@
+// WiFi and TCP clients. A WiFiClient connects to whatever a test registered
+// on host:port with mock::tcp_listen() (the fake RouterOS API server);
+// HTTPClient uses the same connection object for its keep-alive model.
+#pragma once
+
+#include "Arduino.h"
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define WL_IDLE_STATUS 0
+#define WL_NO_SSID_AVAIL 1
+#define WL_CONNECTED 3
+#define WL_CONNECT_FAILED 4
+#define WL_DISCONNECTED 6
+
+#define WIFI_OFF 0
+#define WIFI_STA 1
+#define WIFI_AP 2
+#define WIFI_AP_STA 3
+
+#define WIFI_AUTH_OPEN 0
+#define WIFI_AUTH_WPA2_PSK 3
+
+#define WIFI_SCAN_RUNNING (-1)
+#define WIFI_SCAN_FAILED (-2)
+
+namespace mock {
+
+struct Conn;
+
+// Server side of a TCP connection.
+class TcpPeer {
+ public:
+  virtual ~TcpPeer() {}
+  virtual void onConnect(Conn&) {}
+  virtual void onData(Conn&, const uint8_t* data, size_t len) = 0;
+  // Queue whatever has become due by now (streamed replies).
+  virtual void pump(Conn&) {}
+  virtual void onClose(Conn&) {}
+};
+
+struct Conn {
+  TcpPeer* peer = nullptr;
+  void* http_peer = nullptr;     // set when HTTPClient owns the connection
+  std::string host;
+  uint16_t port = 0;
+  bool tls = false;
+  bool open = true;
+  std::deque<uint8_t> rx;        // arrived at the ESP32, readable now
+  std::string in_flight;         // sent by the server, not yet arrived
+
+  // Server writes: one TCP segment arrives at once, the rest as it is read.
+  void send(const std::string& bytes, size_t arrive_now = (size_t)-1);
+  // Move in-flight bytes into rx (the client is waiting for them).
+  bool arrive(size_t max_bytes = 1460);
+};
+
+void tcp_listen(const std::string& host, uint16_t port, TcpPeer* peer);
+void tcp_unlisten(const std::string& host, uint16_t port);
+
+struct ScanResult {
+  std::string ssid;
+  int rssi;
+  int auth;
+};
+
+struct WifiConfig {
+  bool joinable = true;              // begin() connects after join_ms
+  uint32_t join_ms = 1500;
+  uint32_t scan_ms = 2500;
+  std::vector<ScanResult> networks = { { "HomeNet", -52, WIFI_AUTH_WPA2_PSK }, { "Guest", -71, WIFI_AUTH_OPEN } };
+};
+extern WifiConfig wifi_config;
+// Drop or restore the station link (tests of reconnect paths).
+void wifi_set_connected(bool up);
+
+}  // namespace mock
+
+class Client : public Stream {
+ public:
+  virtual int connect(const char* host, uint16_t port) = 0;
+  virtual uint8_t connected() = 0;
+  virtual void stop() = 0;
+  virtual int read(uint8_t* buf, size_t size) = 0;
+  using Stream::read;
+};
+
+class WiFiClient : public Client {
+ public:
+  int connect(const char* host, uint16_t port) override;
+  int connect(IPAddress ip, uint16_t port);
+  int connect(const char* host, uint16_t port, int32_t) { return connect(host, port); }
+  uint8_t connected() override;
+  void stop() override;
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* buf, size_t n) override;
+  using Print::write;
+  int available() override;
+  int read() override;
+  int read(uint8_t* buf, size_t size) override;
+  int peek() override;
+  void setNoDelay(bool) {}
+  explicit operator bool() { return connected(); }
+
+  std::shared_ptr<mock::Conn> conn;
+
+ protected:
+  bool tls_ = false;
+  void pump();
+};
+
+class WiFiClass {
+ public:
+  int status();
+  bool mode(int m) {
+    mode_ = m;
+    return true;
+  }
+  int getMode() const { return mode_; }
+  bool softAP(const char* ssid, const char* password = nullptr);
+  IPAddress softAPIP() { return IPAddress(192, 168, 4, 1); }
+  IPAddress localIP() { return IPAddress(192, 168, 88, 40); }
+  int begin(const char* ssid, const char* password = nullptr);
+  bool reconnect();
+  bool disconnect(bool wifioff = false);
+  void setSleep(bool) {}
+  uint8_t* macAddress(uint8_t* mac);
+  String macAddress();
+  String SSID();
+  int RSSI() { return -55; }
+  int scanNetworks(bool async = false, bool show_hidden = false);
+  int scanComplete();
+  void scanDelete();
+  String SSID(int i);
+  int RSSI(int i);
+  int encryptionType(int i);
+
+ private:
+  int mode_ = WIFI_OFF;
+};
+extern WiFiClass WiFi;
@@ -0,0 +1,16 @@
+#include "base64.h"
+
+String base64::encode(const uint8_t* data, size_t length) {
+  static const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string out;
+  for (size_t i = 0; i < length; i += 3) {
+    uint32_t v = (uint32_t)data[i] << 16;
+    if (i + 1 < length) v |= (uint32_t)data[i + 1] << 8;
+    if (i + 2 < length) v |= data[i + 2];
+    out += alphabet[(v >> 18) & 63];
+    out += alphabet[(v >> 12) & 63];
+    out += i + 1 < length ? alphabet[(v >> 6) & 63] : '=';
+    out += i + 2 < length ? alphabet[v & 63] : '=';
+  }
+  return String(out.c_str());
+}
@@ -0,0 +1,59 @@
+// Test-side controls for the core mocks: virtual clock, task table, heap
+// accounting and the captured serial log. Device mocks (TFT, LittleFS,
+// router) declare their own controls next to the class they stand in for.
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace mock {
+
+// --- Clock ---
+uint64_t now_us();
+// Add the host time each task spends running to the virtual clock, so
+// micros() inside the sketch measures real CPU time (benchmarks). Off by
+// default: tests stay deterministic and only delays move the clock.
+void clock_realtime(bool on);
+// Let other tasks run until the virtual clock has advanced by ms.
+void run_for(uint32_t ms);
+// Block the calling task for a sub-millisecond span (device-side costs).
+void delay_us(uint64_t us);
+
+// --- Tasks ---
+struct TaskInfo {
+  std::string name;
+  unsigned priority;
+  int core;
+  uint32_t stack_bytes;
+  bool finished;
+};
+std::vector<TaskInfo> tasks();
+// Host CPU time spent inside the named task so far, in microseconds.
+uint64_t task_cpu_us(const char* name);
+
+// --- Heap ---
+// The sketch sees ESP.getFreeHeap() = device_free - (live bytes since
+// heap_rebase()). Allocations made by the mocks themselves are excluded
+// while a HeapPause is in scope.
+void heap_rebase(uint32_t device_free = 320 * 1024);
+int64_t heap_live();              // bytes allocated by the sketch since rebase
+void heap_mark();                 // restart the high-water mark at the current level
+int64_t heap_peak_since_mark();   // highest live level since heap_mark()
+uint64_t heap_allocs();           // malloc calls so far
+
+class HeapPause {
+ public:
+  HeapPause();
+  ~HeapPause();
+  HeapPause(const HeapPause&) = delete;
+  HeapPause& operator=(const HeapPause&) = delete;
+};
+
+// --- Serial ---
+const std::string& serial_log();
+void serial_clear();
+uint32_t restarts();
+
+}  // namespace mock
@@ -0,0 +1,188 @@
+// Heap accounting. malloc and friends are interposed so every allocation
+// the sketch makes (String growth, JSON documents, sprites, SSE copies) is
+// counted; blocks allocated under mock::HeapPause belong to the mocks and are
+// remembered so their frees are not counted either.
+#include "Arduino.h"
+
+#include <malloc.h>
+#include <mutex>
+#include <unordered_set>
+
+extern "C" {
+void* __libc_malloc(size_t);
+void* __libc_calloc(size_t, size_t);
+void* __libc_realloc(void*, size_t);
+void* __libc_memalign(size_t, size_t);
+void __libc_free(void*);
+}
+
+namespace {
+
+std::atomic<int64_t> live_bytes{ 0 };
+std::atomic<int64_t> peak_bytes{ 0 };
+std::atomic<uint64_t> alloc_calls{ 0 };
+int64_t base_bytes = 0;
+uint32_t device_free_bytes = 320 * 1024;
+int64_t min_free_seen = device_free_bytes;
+
+thread_local int pause_depth = 0;
+thread_local bool in_hook = false;
+
+// Plain new/delete here would recurse into the hooks; the set is only ever
+// touched with in_hook set, which makes its own allocations invisible.
+std::mutex& untrackedLock() {
+  static std::mutex* m = new (__libc_malloc(sizeof(std::mutex))) std::mutex();
+  return *m;
+}
+
+std::unordered_set<void*>& untracked() {
+  static std::unordered_set<void*>* s = new (__libc_malloc(sizeof(std::unordered_set<void*>))) std::unordered_set<void*>();
+  return *s;
+}
+
+void account(int64_t delta) {
+  int64_t now = live_bytes.fetch_add(delta) + delta;
+  int64_t peak = peak_bytes.load();
+  while (now > peak && !peak_bytes.compare_exchange_weak(peak, now)) {}
+  int64_t free_now = (int64_t)device_free_bytes - (now - base_bytes);
+  if (free_now < min_free_seen) min_free_seen = free_now;
+}
+
+void noteAlloc(void* p) {
+  if (!p || in_hook) return;
+  alloc_calls++;
+  if (pause_depth) {
+    in_hook = true;
+    {
+      std::lock_guard<std::mutex> lock(untrackedLock());
+      untracked().insert(p);
+    }
+    in_hook = false;
+  } else {
+    account((int64_t)malloc_usable_size(p));
+  }
+}
+
+void noteFree(void* p) {
+  if (!p || in_hook) return;
+  in_hook = true;
+  size_t erased;
+  {
+    std::lock_guard<std::mutex> lock(untrackedLock());
+    erased = untracked().erase(p);
+  }
+  in_hook = false;
+  if (!erased) account(-(int64_t)malloc_usable_size(p));
+}
+
+}  // namespace
+
+extern "C" {
+
+void* malloc(size_t n) {
+  void* p = __libc_malloc(n);
+  noteAlloc(p);
+  return p;
+}
+
+void* calloc(size_t n, size_t size) {
+  void* p = __libc_calloc(n, size);
+  noteAlloc(p);
+  return p;
+}
+
+void free(void* p) {
+  noteFree(p);
+  __libc_free(p);
+}
+
+void* realloc(void* p, size_t n) {
+  if (!p) return malloc(n);
+  if (n == 0) {
+    free(p);
+    return nullptr;
+  }
+  // Realloc keeps the block's ownership: a mock buffer stays a mock buffer.
+  bool was_untracked = false;
+  if (!in_hook) {
+    in_hook = true;
+    {
+      std::lock_guard<std::mutex> lock(untrackedLock());
+      was_untracked = untracked().erase(p) > 0;
+    }
+    in_hook = false;
+  }
+  size_t old_size = malloc_usable_size(p);
+  void* q = __libc_realloc(p, n);
+  if (!q) {
+    if (was_untracked) {
+      in_hook = true;
+      std::lock_guard<std::mutex> lock(untrackedLock());
+      untracked().insert(p);
+      in_hook = false;
+    }
+    return q;
+  }
+  if (in_hook) return q;
+  if (was_untracked) {
+    in_hook = true;
+    {
+      std::lock_guard<std::mutex> lock(untrackedLock());
+      untracked().insert(q);
+    }
+    in_hook = false;
+  } else {
+    account((int64_t)malloc_usable_size(q) - (int64_t)old_size);
+  }
+  return q;
+}
+
+void* memalign(size_t align, size_t n) {
+  void* p = __libc_memalign(align, n);
+  noteAlloc(p);
+  return p;
+}
+
+void* aligned_alloc(size_t align, size_t n) { return memalign(align, n); }
+
+int posix_memalign(void** out, size_t align, size_t n) {
+  void* p = memalign(align, n);
+  if (!p) return 12;  // ENOMEM
+  *out = p;
+  return 0;
+}
+
+void* valloc(size_t n) { return memalign(4096, n); }
+
+}  // extern "C"
+
+mock::HeapPause::HeapPause() { pause_depth++; }
+mock::HeapPause::~HeapPause() { pause_depth--; }
+
+void mock::heap_rebase(uint32_t device_free) {
+  device_free_bytes = device_free;
+  base_bytes = live_bytes.load();
+  peak_bytes = base_bytes;
+  min_free_seen = device_free;
+}
+
+int64_t mock::heap_live() { return live_bytes.load() - base_bytes; }
+
+void mock::heap_mark() { peak_bytes = live_bytes.load(); }
+
+int64_t mock::heap_peak_since_mark() { return peak_bytes.load() - base_bytes; }
+
+uint64_t mock::heap_allocs() { return alloc_calls.load(); }
+
+uint32_t EspClass::getFreeHeap() {
+  int64_t free_now = (int64_t)device_free_bytes - mock::heap_live();
+  return free_now > 0 ? (uint32_t)free_now : 0;
+}
+
+uint32_t EspClass::getMinFreeHeap() { return min_free_seen > 0 ? (uint32_t)min_free_seen : 0; }
+
+// The device heap is fragmented into regions; the largest block is
+// typically a bit over half of what is free.
+uint32_t EspClass::getMaxAllocHeap() { return getFreeHeap() * 6 / 10; }
+
+uint32_t EspClass::getHeapSize() { return 320 * 1024; }
@@ -0,0 +1,543 @@
+#include "mock_router.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+#ifndef MOCK_FIXTURE_DIR
+#define MOCK_FIXTURE_DIR "host/fixtures"
+#endif
+
+namespace mock {
+
+namespace {
+
+uint64_t nowMs() { return now_us() / 1000; }
+
+std::vector<std::string> split(const std::string& s, char sep) {
+  std::vector<std::string> out;
+  size_t start = 0;
+  while (start <= s.size()) {
+    size_t end = s.find(sep, start);
+    if (end == std::string::npos) end = s.size();
+    if (end > start) out.push_back(s.substr(start, end - start));
+    start = end + 1;
+  }
+  return out;
+}
+
+// .proplist from a REST query body: "a,b,c" or ["a","b","c"]
+std::vector<std::string> proplistOf(const std::string& body) {
+  std::vector<std::string> out;
+  size_t k = body.find("\".proplist\"");
+  if (k == std::string::npos) return out;
+  size_t p = body.find(':', k);
+  if (p == std::string::npos) return out;
+  p = body.find_first_not_of(" \t\r\n", p + 1);
+  if (p == std::string::npos) return out;
+  if (body[p] == '"') {
+    size_t e = body.find('"', p + 1);
+    return split(body.substr(p + 1, e - p - 1), ',');
+  }
+  if (body[p] == '[') {
+    size_t e = body.find(']', p);
+    std::string inner = body.substr(p + 1, e - p - 1);
+    for (size_t q = inner.find('"'); q != std::string::npos; q = inner.find('"', q)) {
+      size_t qe = inner.find('"', q + 1);
+      out.push_back(inner.substr(q + 1, qe - q - 1));
+      q = qe + 1;
+    }
+  }
+  return out;
+}
+
+void setField(RestItem& item, const std::string& key, const std::string& value) {
+  for (auto& kv : item) {
+    if (kv.first == key) {
+      kv.second = value;
+      return;
+    }
+  }
+  item.emplace_back(key, value);
+}
+
+std::string jsonEscape(const std::string& s) {
+  std::string out;
+  for (char c : s) {
+    if (c == '"' || c == '\\') out += '\\';
+    out += c;
+  }
+  return out;
+}
+
+std::string hexId(int id) {
+  char buf[16];
+  snprintf(buf, sizeof(buf), "*%X", id);
+  return buf;
+}
+
+const char* MONTHS = "janfebmaraprmayjunjulaugsepoctnovdec";
+
+void civil(uint32_t epoch, int& y, int& m, int& d) {
+  int32_t days = epoch / 86400 + 719468;
+  int32_t era = days / 146097;
+  uint32_t doe = (uint32_t)(days - era * 146097);
+  uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  uint32_t mp = (5 * doy + 2) / 153;
+  d = doy - (153 * mp + 2) / 5 + 1;
+  m = mp < 10 ? mp + 3 : mp - 9;
+  y = (int)yoe + era * 400 + (m <= 2);
+}
+
+}  // namespace
+
+// ==================== MODEL ====================
+
+RouterModel::RouterModel(int n) {
+  rate = [](int i, uint64_t t_ms, double& rx, double& tx) {
+    double phase = t_ms / 7000.0 + i;
+    rx = 20e6 * (1.0 + 0.3 * sin(phase)) / (1 + i);
+    tx = 4e6 * (1.0 + 0.3 * cos(phase)) / (1 + i);
+  };
+  resize(n);
+  last_ms_ = nowMs();
+}
+
+void RouterModel::resize(int n) {
+  HeapPause pause;
+  int old = (int)ifaces.size();
+  ifaces.resize(n);
+  for (int i = old; i < n; i++) {
+    RouterIface& f = ifaces[i];
+    f.id = i + 1;
+    f.name = i == 0 ? "ether1" : (i < 10 ? "ether" + std::to_string(i + 1) : "sfp-sfpplus" + std::to_string(i - 9));
+    f.running = i % 5 != 4;
+    f.rx_bytes = 1000000000ULL * (i + 3);
+    f.tx_bytes = 250000000ULL * (i + 2);
+    f.rx_bps = f.tx_bps = 0;
+  }
+}
+
+void RouterModel::advance() {
+  uint64_t now = nowMs();
+  while (last_ms_ < now) {
+    uint64_t step = std::min<uint64_t>(100, now - last_ms_);
+    for (size_t i = 0; i < ifaces.size(); i++) {
+      RouterIface& f = ifaces[i];
+      double rx = 0, tx = 0;
+      if (f.running) rate((int)i, last_ms_, rx, tx);
+      f.rx_bps = rx;
+      f.tx_bps = tx;
+      f.rx_bytes += (uint64_t)llround(rx / 8.0 * step / 1000.0);
+      f.tx_bytes += (uint64_t)llround(tx / 8.0 * step / 1000.0);
+    }
+    last_ms_ += step;
+  }
+}
+
+uint32_t RouterModel::epoch() const { return epoch_at_zero + (uint32_t)(nowMs() / 1000); }
+
+// ==================== REST ====================
+
+std::string fixture(const std::string& name) {
+  std::ifstream in(std::string(MOCK_FIXTURE_DIR) + "/" + name, std::ios::binary);
+  if (!in) {
+    fprintf(stderr, "missing fixture %s\n", name.c_str());
+    abort();
+  }
+  std::stringstream ss;
+  ss << in.rdbuf();
+  return ss.str();
+}
+
+std::vector<RestItem> parseRestFixture(const std::string& json) {
+  HeapPause pause;
+  std::vector<RestItem> items;
+  size_t p = 0;
+  auto readString = [&](std::string& out) {
+    out.clear();
+    p = json.find('"', p) + 1;
+    while (json[p] != '"') {
+      if (json[p] == '\\') p++;
+      out += json[p++];
+    }
+    p++;
+  };
+  while ((p = json.find('{', p)) != std::string::npos) {
+    RestItem item;
+    for (;;) {
+      p = json.find_first_of("\"}", p);
+      if (json[p] == '}') break;
+      std::string key, value;
+      readString(key);
+      p = json.find(':', p) + 1;
+      readString(value);
+      item.emplace_back(key, value);
+    }
+    items.push_back(item);
+  }
+  return items;
+}
+
+std::string renderRest(const std::vector<RestItem>& items, const std::vector<std::string>& proplist) {
+  HeapPause pause;
+  std::string out = "[";
+  for (size_t i = 0; i < items.size(); i++) {
+    if (i) out += ',';
+    out += '{';
+    bool first = true;
+    for (const auto& kv : items[i]) {
+      if (!proplist.empty() && std::find(proplist.begin(), proplist.end(), kv.first) == proplist.end()) continue;
+      if (!first) out += ',';
+      first = false;
+      out += '"' + jsonEscape(kv.first) + "\":\"" + jsonEscape(kv.second) + '"';
+    }
+    out += '}';
+  }
+  out += ']';
+  return out;
+}
+
+std::string uptimeString(uint32_t s) {
+  std::string out;
+  uint32_t w = s / 604800, d = s / 86400 % 7, h = s / 3600 % 24, m = s / 60 % 60, sec = s % 60;
+  if (w) out += std::to_string(w) + "w";
+  if (d) out += std::to_string(d) + "d";
+  if (h) out += std::to_string(h) + "h";
+  if (m) out += std::to_string(m) + "m";
+  out += std::to_string(sec) + "s";
+  return out;
+}
+
+RestRouter::RestRouter(RouterModel& model, const std::string& host, uint16_t port)
+    : model_(model), host_(host), port_(port) {
+  HeapPause pause;
+  ether_tpl_ = parseRestFixture(fixture("rest_interface_ethernet_print.json"));
+  resource_tpl_ = parseRestFixture(fixture("rest_system_resource_print.json"));
+  clock_tpl_ = parseRestFixture(fixture("rest_system_clock_print.json"));
+  http_listen(host_, port_, this);
+}
+
+RestRouter::~RestRouter() { http_unlisten(host_, port_); }
+
+std::string RestRouter::ethernet(const std::vector<std::string>& proplist) {
+  std::vector<RestItem> items;
+  items.reserve(model_.ifaces.size());
+  for (size_t i = 0; i < model_.ifaces.size(); i++) {
+    const RouterIface& f = model_.ifaces[i];
+    RestItem item = ether_tpl_[i % ether_tpl_.size()];
+    char mac[24];
+    snprintf(mac, sizeof(mac), "48:A9:8A:5C:%02X:%02X", (f.id >> 8) & 0xFF, f.id & 0xFF);
+    setField(item, ".id", hexId(f.id));
+    setField(item, "name", f.name);
+    setField(item, "default-name", f.name);
+    setField(item, "mac-address", mac);
+    setField(item, "orig-mac-address", mac);
+    setField(item, "running", f.running ? "true" : "false");
+    setField(item, "rx-bytes", std::to_string(f.rx_bytes));
+    setField(item, "tx-bytes", std::to_string(f.tx_bytes));
+    items.push_back(std::move(item));
+  }
+  return renderRest(items, proplist);
+}
+
+std::string RestRouter::resource(const std::vector<std::string>& proplist) {
+  RestItem item = resource_tpl_.at(0);
+  setField(item, "uptime", uptimeString(model_.uptime_at_zero + (uint32_t)(nowMs() / 1000)));
+  setField(item, "cpu-load", std::to_string((int)model_.cpu_load));
+  setField(item, "free-memory", std::to_string(model_.free_memory));
+  setField(item, "total-memory", std::to_string(model_.total_memory));
+  return renderRest({ item }, proplist);
+}
+
+std::string RestRouter::clock(const std::vector<std::string>& proplist) {
+  RestItem item = clock_tpl_.at(0);
+  uint32_t e = model_.epoch();
+  int y, m, d;
+  civil(e, y, m, d);
+  char time[16], date[16];
+  snprintf(time, sizeof(time), "%02u:%02u:%02u", e / 3600 % 24, e / 60 % 60, e % 60);
+  bool legacy = false;
+  for (const auto& kv : item) {
+    if (kv.first == "date" && kv.second.find('/') != std::string::npos) legacy = true;
+  }
+  if (legacy) {
+    snprintf(date, sizeof(date), "%.3s/%02d/%04d", MONTHS + (m - 1) * 3, d, y);
+  } else {
+    snprintf(date, sizeof(date), "%04d-%02d-%02d", y, m, d);
+  }
+  setField(item, "time", time);
+  setField(item, "date", date);
+  return renderRest({ item }, proplist);
+}
+
+HttpReply RestRouter::serve(const HttpRequest& req) {
+  HttpReply r;
+  model_.advance();
+  path_counts[req.path]++;
+  log.push_back(req.path);
+  r.latency_ms = latency_ms(req.path);
+  r.chunked = chunked;
+
+  if (fail_next > 0) {
+    fail_next--;
+    if (fail_code == 0) {
+      r.drop = true;
+    } else {
+      r.code = fail_code;
+      r.body = "{\"detail\":\"busy\",\"error\":" + std::to_string(fail_code) + ",\"message\":\"Service Unavailable\"}";
+    }
+    return r;
+  }
+
+  std::vector<std::string> proplist = proplistOf(req.body);
+  if (req.path == "/rest/interface/ethernet/print") {
+    r.body = ethernet(proplist);
+  } else if (req.path == "/rest/system/resource/print") {
+    r.body = resource(proplist);
+  } else if (req.path == "/rest/system/clock/print") {
+    r.body = clock(proplist);
+  } else {
+    r.code = 400;
+    r.body = "{\"detail\":\"no such command\",\"error\":400,\"message\":\"Bad Request\"}";
+  }
+  if (!corrupt_path.empty() && req.path == corrupt_path && corrupt_at < r.body.size()) {
+    r.body[corrupt_at] = '@';
+  }
+  return r;
+}
+
+// ==================== API ====================
+
+std::string apiWord(const std::string& w) {
+  std::string out;
+  size_t len = w.size();
+  if (len < 0x80) {
+    out += (char)len;
+  } else if (len < 0x4000) {
+    out += (char)((len >> 8) | 0x80);
+    out += (char)(len & 0xFF);
+  } else if (len < 0x200000) {
+    out += (char)((len >> 16) | 0xC0);
+    out += (char)((len >> 8) & 0xFF);
+    out += (char)(len & 0xFF);
+  } else {
+    out += (char)((len >> 24) | 0xE0);
+    out += (char)((len >> 16) & 0xFF);
+    out += (char)((len >> 8) & 0xFF);
+    out += (char)(len & 0xFF);
+  }
+  return out + w;
+}
+
+ApiRouter::ApiRouter(RouterModel& model, const std::string& host, uint16_t port)
+    : model_(model), host_(host), port_(port) {
+  tcp_listen(host_, port_, this);
+}
+
+ApiRouter::~ApiRouter() { tcp_unlisten(host_, port_); }
+
+void ApiRouter::onConnect(Conn& c) {
+  if (require_tls && !c.tls) {
+    c.open = false;
+    return;
+  }
+  HeapPause pause;
+  connects++;
+  authed_ = false;
+  subs_.clear();
+  inbox_.clear();
+}
+
+void ApiRouter::onClose(Conn&) {
+  HeapPause pause;
+  subs_.clear();
+  inbox_.clear();
+}
+
+void ApiRouter::sendSentence(Conn& c, const std::vector<std::string>& words) {
+  HeapPause pause;
+  std::string bytes;
+  for (const auto& w : words) bytes += apiWord(w);
+  bytes += '\0';
+  c.send(bytes);
+}
+
+void ApiRouter::onData(Conn& c, const uint8_t* data, size_t len) {
+  std::vector<std::vector<std::string>> sentences;
+  {
+    HeapPause pause;
+    inbox_.append((const char*)data, len);
+    for (;;) {
+      std::vector<std::string> words;
+      size_t p = 0;
+      bool complete = false;
+      while (p < inbox_.size()) {
+        uint8_t b = inbox_[p];
+        size_t n, hdr;
+        if (b < 0x80) {
+          n = b, hdr = 1;
+        } else if ((b & 0xC0) == 0x80) {
+          if (p + 1 >= inbox_.size()) break;
+          n = ((b & 0x3F) << 8) | (uint8_t)inbox_[p + 1], hdr = 2;
+        } else {
+          if (p + 2 >= inbox_.size()) break;
+          n = ((b & 0x1F) << 16) | ((uint8_t)inbox_[p + 1] << 8) | (uint8_t)inbox_[p + 2], hdr = 3;
+        }
+        if (n == 0) {
+          p += 1;
+          complete = true;
+          break;
+        }
+        if (p + hdr + n > inbox_.size()) break;
+        words.push_back(inbox_.substr(p + hdr, n));
+        p += hdr + n;
+      }
+      if (!complete) break;
+      inbox_.erase(0, p);
+      if (!words.empty()) sentences.push_back(words);
+    }
+  }
+  for (const auto& words : sentences) handle(c, words);
+}
+
+void ApiRouter::handle(Conn& c, const std::vector<std::string>& words) {
+  HeapPause pause;
+  std::string cmd = words[0];
+  commands.push_back(cmd);
+  std::map<std::string, std::string> attrs;
+  std::string tag;
+  for (size_t i = 1; i < words.size(); i++) {
+    const std::string& w = words[i];
+    if (w.compare(0, 5, ".tag=") == 0) {
+      tag = w.substr(5);
+    } else if (w.size() > 1 && w[0] == '=') {
+      size_t eq = w.find('=', 1);
+      if (eq != std::string::npos) attrs[w.substr(1, eq - 1)] = w.substr(eq + 1);
+    }
+  }
+  auto tagged = [&](std::vector<std::string> s) {
+    if (!tag.empty()) s.push_back(".tag=" + tag);
+    return s;
+  };
+  auto trap = [&](const std::string& msg) {
+    sendSentence(c, tagged({ "!trap", "=message=" + msg }));
+    sendSentence(c, tagged({ "!done" }));
+  };
+
+  if (cmd == "/login") {
+    if (attrs["name"] == login && attrs["password"] == password) {
+      authed_ = true;
+      logins++;
+      sendSentence(c, tagged({ "!done" }));
+    } else {
+      trap("invalid user name or password (6)");
+    }
+    return;
+  }
+  if (!authed_) {
+    trap("not logged in");
+    return;
+  }
+  if (cmd == "/cancel") {
+    const std::string victim = attrs["tag"];
+    subs_.erase(std::remove_if(subs_.begin(), subs_.end(), [&](const Sub& s) { return s.tag == victim; }), subs_.end());
+    sendSentence(c, tagged({ "!done" }));
+    return;
+  }
+
+  Sub s;
+  s.tag = tag;
+  s.cmd = cmd;
+  s.proplist = split(attrs[".proplist"], ',');
+  s.interval_ms = 0;
+  if (attrs.count("interval")) s.interval_ms = (uint32_t)(atof(attrs["interval"].c_str()) * 1000);
+
+  if (cmd == "/interface/monitor-traffic") {
+    s.names = split(attrs["interface"], ',');
+    monitored = s.names;
+    s.interval_ms = 1000;
+  } else if (cmd != "/interface/ethernet/print" && cmd != "/system/resource/print" && cmd != "/system/clock/print") {
+    trap("no such command prefix");
+    return;
+  }
+
+  model_.advance();
+  emit(c, s);
+  if (s.interval_ms == 0) {
+    sendSentence(c, tagged({ "!done" }));
+    return;
+  }
+  s.next_ms = nowMs() + s.interval_ms;
+  subs_.push_back(s);
+}
+
+void ApiRouter::emit(Conn& c, const Sub& s) {
+  auto want = [&](const std::string& k) {
+    return s.proplist.empty() || std::find(s.proplist.begin(), s.proplist.end(), k) != s.proplist.end();
+  };
+  auto finish = [&](std::vector<std::string>& w) {
+    if (!s.tag.empty()) w.push_back(".tag=" + s.tag);
+    sendSentence(c, w);
+  };
+
+  if (s.cmd == "/interface/monitor-traffic") {
+    for (const auto& name : s.names) {
+      for (const auto& f : model_.ifaces) {
+        if (f.name != name) continue;
+        std::vector<std::string> w = { "!re" };
+        if (want("name")) w.push_back("=name=" + f.name);
+        if (want("rx-bits-per-second")) w.push_back("=rx-bits-per-second=" + std::to_string((uint64_t)f.rx_bps));
+        if (want("tx-bits-per-second")) w.push_back("=tx-bits-per-second=" + std::to_string((uint64_t)f.tx_bps));
+        finish(w);
+      }
+    }
+  } else if (s.cmd == "/interface/ethernet/print") {
+    for (const auto& f : model_.ifaces) {
+      std::vector<std::string> w = { "!re" };
+      if (want(".id")) w.push_back("=.id=" + hexId(f.id));
+      if (want("name")) w.push_back("=name=" + f.name);
+      if (want("rx-bytes")) w.push_back("=rx-bytes=" + std::to_string(f.rx_bytes));
+      if (want("tx-bytes")) w.push_back("=tx-bytes=" + std::to_string(f.tx_bytes));
+      if (want("running")) w.push_back(std::string("=running=") + (f.running ? "true" : "false"));
+      finish(w);
+    }
+  } else if (s.cmd == "/system/resource/print") {
+    std::vector<std::string> w = { "!re" };
+    if (want("uptime")) w.push_back("=uptime=" + uptimeString(model_.uptime_at_zero + (uint32_t)(nowMs() / 1000)));
+    if (want("cpu-load")) w.push_back("=cpu-load=" + std::to_string((int)model_.cpu_load));
+    if (want("free-memory")) w.push_back("=free-memory=" + std::to_string(model_.free_memory));
+    if (want("total-memory")) w.push_back("=total-memory=" + std::to_string(model_.total_memory));
+    finish(w);
+  } else if (s.cmd == "/system/clock/print") {
+    uint32_t e = model_.epoch();
+    int y, m, d;
+    civil(e, y, m, d);
+    char time[16], date[16];
+    snprintf(time, sizeof(time), "%02u:%02u:%02u", e / 3600 % 24, e / 60 % 60, e % 60);
+    snprintf(date, sizeof(date), "%04d-%02d-%02d", y, m, d);
+    std::vector<std::string> w = { "!re" };
+    if (want("time")) w.push_back(std::string("=time=") + time);
+    if (want("date")) w.push_back(std::string("=date=") + date);
+    finish(w);
+  }
+}
+
+void ApiRouter::pump(Conn& c) {
+  if (subs_.empty()) return;
+  uint64_t now = nowMs();
+  bool any = false;
+  for (const auto& s : subs_) any |= s.next_ms <= now;
+  if (!any) return;
+  model_.advance();
+  for (auto& s : subs_) {
+    if (s.next_ms > now) continue;
+    emit(c, s);
+    s.next_ms += s.interval_ms;
+    if (s.next_ms <= now) s.next_ms = now + s.interval_ms;
+  }
+}
+
+}  // namespace mock
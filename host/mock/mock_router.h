@@ -0,0 +1,135 @@
+// Fake RouterOS for the host tests. RouterModel keeps N ethernet interfaces
+// whose byte counters advance with virtual time at a rate the test chooses,
+// plus the resource and clock values. RestRouter serves it over the mock
+// HTTPClient as /rest/... replies built from the recorded replies in
+// host/fixtures (same fields, same string encoding, .proplist honoured);
+// ApiRouter speaks the binary API sentence protocol over a mock WiFiClient,
+// including tagged =interval= and monitor-traffic subscriptions.
+#pragma once
+
+#include "HTTPClient.h"
+#include "WiFi.h"
+
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mock {
+
+struct RouterIface {
+  int id;
+  std::string name;
+  bool running;
+  uint64_t rx_bytes;
+  uint64_t tx_bytes;
+  double rx_bps;     // rates used for the last step (monitor-traffic reports them)
+  double tx_bps;
+};
+
+class RouterModel {
+ public:
+  explicit RouterModel(int ifaces = 8);
+
+  // Traffic in bits per second for interface index i at virtual time t_ms.
+  std::function<void(int i, uint64_t t_ms, double& rx_bps, double& tx_bps)> rate;
+
+  std::vector<RouterIface> ifaces;
+  uint32_t epoch_at_zero = 1767268800;   // router clock at millis() == 0 (2026-01-01 12:00:00)
+  uint32_t uptime_at_zero = 3 * 86400 + 4 * 3600;
+  float cpu_load = 7;
+  uint64_t free_memory = 912 * 1024 * 1024ULL;
+  uint64_t total_memory = 1024 * 1024 * 1024ULL;
+
+  void resize(int n);
+  // Integrate the counters up to now.
+  void advance();
+  uint32_t epoch() const;
+
+ private:
+  uint64_t last_ms_ = 0;
+};
+
+// Flat RouterOS REST object: every value is a JSON string.
+typedef std::vector<std::pair<std::string, std::string>> RestItem;
+
+std::string fixture(const std::string& name);
+std::vector<RestItem> parseRestFixture(const std::string& json);
+std::string renderRest(const std::vector<RestItem>& items, const std::vector<std::string>& proplist);
+
+class RestRouter : public HttpPeer {
+ public:
+  explicit RestRouter(RouterModel& model, const std::string& host = "192.168.88.1", uint16_t port = 80);
+  ~RestRouter() override;
+
+  HttpReply serve(const HttpRequest& req) override;
+
+  // Per-request knobs: latency of every reply, forced failures.
+  std::function<uint32_t(const std::string& path)> latency_ms = [](const std::string&) { return 15u; };
+  int fail_next = 0;           // that many replies fail with fail_code (or drop when 0)
+  int fail_code = 503;
+  bool chunked = false;
+  std::string corrupt_path;    // replies on this path get a stray byte at corrupt_at
+  size_t corrupt_at = 0;
+
+  std::map<std::string, uint32_t> path_counts;
+  std::vector<std::string> log;     // "path" per request, in order
+
+ private:
+  std::string ethernet(const std::vector<std::string>& proplist);
+  std::string resource(const std::vector<std::string>& proplist);
+  std::string clock(const std::vector<std::string>& proplist);
+
+  RouterModel& model_;
+  std::string host_;
+  uint16_t port_;
+  std::vector<RestItem> ether_tpl_;
+  std::vector<RestItem> resource_tpl_;
+  std::vector<RestItem> clock_tpl_;
+};
+
+class ApiRouter : public TcpPeer {
+ public:
+  explicit ApiRouter(RouterModel& model, const std::string& host = "192.168.88.1", uint16_t port = 8728);
+  ~ApiRouter() override;
+
+  void onConnect(Conn& c) override;
+  void onData(Conn& c, const uint8_t* data, size_t len) override;
+  void pump(Conn& c) override;
+  void onClose(Conn& c) override;
+
+  bool require_tls = false;
+  std::string login = "admin";
+  std::string password;
+  uint32_t connects = 0;
+  uint32_t logins = 0;
+  std::vector<std::string> monitored;      // names in the last monitor-traffic subscription
+  std::vector<std::string> commands;       // first word of every sentence received
+
+ private:
+  struct Sub {
+    std::string tag;
+    std::string cmd;
+    std::vector<std::string> proplist;
+    std::vector<std::string> names;
+    uint32_t interval_ms;
+    uint64_t next_ms;
+  };
+  void handle(Conn& c, const std::vector<std::string>& words);
+  void emit(Conn& c, const Sub& s);
+  void sendSentence(Conn& c, const std::vector<std::string>& words);
+
+  RouterModel& model_;
+  std::string host_;
+  uint16_t port_;
+  std::string inbox_;
+  std::vector<Sub> subs_;
+  bool authed_ = false;
+};
+
+// RouterOS API length prefix.
+std::string apiWord(const std::string& w);
+std::string uptimeString(uint32_t s);
+
+}  // namespace mock
@@ -0,0 +1,308 @@
+// Cooperative FreeRTOS simulator. Each task is a host thread, but a single
+// token decides which one runs: the running task keeps it until it delays,
+// yields or blocks on a semaphore. The dispatcher then hands it to the
+// highest-priority task whose wake time has come (round-robin among equals)
+// and, when none is ready, jumps virtual time to the next wake-up.
+#include "Arduino.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using SteadyClock = std::chrono::steady_clock;
+
+struct Sem {
+  UBaseType_t count;
+  UBaseType_t max;
+};
+
+struct Task {
+  std::string name;
+  unsigned priority;
+  int core;
+  uint32_t stack_bytes;
+  TaskFunction_t fn;
+  void* arg;
+  uint64_t wake_us;
+  uint64_t turn;       // last dispatch, for round-robin among equals
+  Sem* waiting_on;
+  bool finished;
+  uint64_t cpu_us;
+  std::condition_variable cv;
+};
+
+struct TaskExit {};
+
+struct Sim {
+  std::mutex mu;
+  std::vector<Task*> tasks;
+  Task* running = nullptr;
+  uint64_t now_us = 0;
+  uint64_t turns = 0;
+  bool realtime = false;
+  SteadyClock::time_point slice_start = SteadyClock::now();
+};
+
+// Leaked on purpose: detached task threads are still parked on it at exit.
+Sim& sim() {
+  static Sim* s = [] {
+    mock::HeapPause pause;
+    return new Sim();
+  }();
+  return *s;
+}
+
+thread_local Task* self_task = nullptr;
+bool loop_task_claimed = false;
+
+uint64_t sliceElapsedUs(Sim& s) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(SteadyClock::now() - s.slice_start).count();
+}
+
+// The thread that first touches the simulator is the Arduino loopTask.
+// Threads a test starts by hand (to hammer the seqlock, say) are foreign:
+// they read the clock but never take the token.
+Task* self(Sim& s) {
+  if (self_task || loop_task_claimed) return self_task;
+  loop_task_claimed = true;
+  mock::HeapPause pause;
+  Task* t = new Task();
+  t->name = "loopTask";
+  t->priority = 1;
+  t->core = 1;
+  t->stack_bytes = 8192;
+  t->fn = nullptr;
+  t->arg = nullptr;
+  t->wake_us = 0;
+  t->turn = 0;
+  t->waiting_on = nullptr;
+  t->finished = false;
+  t->cpu_us = 0;
+  s.tasks.push_back(t);
+  s.running = t;
+  s.slice_start = SteadyClock::now();
+  self_task = t;
+  return t;
+}
+
+void chargeSlice(Sim& s) {
+  uint64_t used = sliceElapsedUs(s);
+  if (s.running) s.running->cpu_us += used;
+  if (s.realtime) s.now_us += used;
+  s.slice_start = SteadyClock::now();
+}
+
+// Pick the next task to run and hand it the token. Caller holds the lock.
+void dispatch(Sim& s) {
+  chargeSlice(s);
+  for (;;) {
+    Task* best = nullptr;
+    uint64_t next_wake = UINT64_MAX;
+    for (Task* t : s.tasks) {
+      if (t->finished) continue;
+      if (t->wake_us <= s.now_us) {
+        if (!best || t->priority > best->priority || (t->priority == best->priority && t->turn < best->turn))
+          best = t;
+      } else if (t->wake_us < next_wake) {
+        next_wake = t->wake_us;
+      }
+    }
+    if (best) {
+      best->turn = ++s.turns;
+      s.running = best;
+      s.slice_start = SteadyClock::now();
+      best->cv.notify_one();
+      return;
+    }
+    if (next_wake == UINT64_MAX) {
+      fprintf(stderr, "[mock] every task is blocked forever\n");
+      abort();
+    }
+    s.now_us = next_wake;
+  }
+}
+
+// Give up the token until the dispatcher hands it back.
+void block(Sim& s, std::unique_lock<std::mutex>& lock, Task* t) {
+  dispatch(s);
+  t->cv.wait(lock, [&] { return s.running == t; });
+}
+
+void sleepUntil(uint64_t wake_us) {
+  Sim& s = sim();
+  std::unique_lock<std::mutex> lock(s.mu);
+  Task* t = self(s);
+  if (!t) {
+    lock.unlock();
+    std::this_thread::yield();
+    return;
+  }
+  chargeSlice(s);
+  t->wake_us = wake_us > s.now_us ? wake_us : s.now_us;
+  block(s, lock, t);
+}
+
+void taskEntry(Task* t) {
+  Sim& s = sim();
+  self_task = t;
+  {
+    std::unique_lock<std::mutex> lock(s.mu);
+    t->cv.wait(lock, [&] { return s.running == t; });
+  }
+  try {
+    t->fn(t->arg);
+  } catch (const TaskExit&) {
+  }
+  std::unique_lock<std::mutex> lock(s.mu);
+  t->finished = true;
+  dispatch(s);
+}
+
+}  // namespace
+
+// ==================== CLOCK ====================
+uint64_t mock::now_us() {
+  Sim& s = sim();
+  std::lock_guard<std::mutex> lock(s.mu);
+  Task* t = self(s);
+  return s.realtime && t ? s.now_us + sliceElapsedUs(s) : s.now_us;
+}
+
+void mock::clock_realtime(bool on) {
+  Sim& s = sim();
+  std::lock_guard<std::mutex> lock(s.mu);
+  self(s);
+  chargeSlice(s);
+  s.realtime = on;
+}
+
+void mock::run_for(uint32_t ms) { sleepUntil(mock::now_us() + (uint64_t)ms * 1000); }
+
+void mock::delay_us(uint64_t us) { sleepUntil(mock::now_us() + us); }
+
+unsigned long millis() { return mock::now_us() / 1000; }
+unsigned long micros() { return mock::now_us(); }
+int64_t esp_timer_get_time() { return mock::now_us(); }
+
+void delay(unsigned long ms) { sleepUntil(mock::now_us() + (uint64_t)ms * 1000); }
+
+void yield() { sleepUntil(0); }
+
+// ==================== TASKS ====================
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stack_bytes, void* arg,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t core) {
+  Sim& s = sim();
+  Task* t;
+  {
+    mock::HeapPause pause;
+    std::lock_guard<std::mutex> lock(s.mu);
+    self(s);
+    t = new Task();
+    t->name = name ? name : "";
+    t->priority = priority;
+    t->core = core;
+    t->stack_bytes = stack_bytes;
+    t->fn = fn;
+    t->arg = arg;
+    t->wake_us = s.now_us;
+    t->turn = ++s.turns;
+    t->waiting_on = nullptr;
+    t->finished = false;
+    t->cpu_us = 0;
+    s.tasks.push_back(t);
+    std::thread(taskEntry, t).detach();
+  }
+  if (handle) *handle = t;
+  return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task) {
+  if (task == nullptr || task == self_task) throw TaskExit();
+  Sim& s = sim();
+  std::lock_guard<std::mutex> lock(s.mu);
+  static_cast<Task*>(task)->finished = true;
+}
+
+void vTaskDelay(TickType_t ticks) { delay(ticks); }
+
+void vTaskDelayUntil(TickType_t* previous_wake, TickType_t increment) {
+  *previous_wake += increment;
+  sleepUntil((uint64_t)*previous_wake * 1000);
+}
+
+TickType_t xTaskGetTickCount() { return (TickType_t)millis(); }
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t) { return 2048; }
+
+BaseType_t xPortGetCoreID() {
+  Sim& s = sim();
+  std::lock_guard<std::mutex> lock(s.mu);
+  Task* t = self(s);
+  return t ? t->core : 0;
+}
+
+std::vector<mock::TaskInfo> mock::tasks() {
+  Sim& s = sim();
+  std::lock_guard<std::mutex> lock(s.mu);
+  std::vector<TaskInfo> out;
+  for (Task* t : s.tasks) out.push_back({ t->name, t->priority, t->core, t->stack_bytes, t->finished });
+  return out;
+}
+
+uint64_t mock::task_cpu_us(const char* name) {
+  Sim& s = sim();
+  std::lock_guard<std::mutex> lock(s.mu);
+  chargeSlice(s);
+  uint64_t total = 0;
+  for (Task* t : s.tasks)
+    if (t->name == name) total += t->cpu_us;
+  return total;
+}
+
+// ==================== SEMAPHORES ====================
+SemaphoreHandle_t xSemaphoreCreateMutex() { return xSemaphoreCreateCounting(1, 1); }
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max_count, UBaseType_t initial) {
+  mock::HeapPause pause;
+  return new Sem{ initial, max_count };
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t handle, TickType_t ticks) {
+  Sim& s = sim();
+  Sem* sem = static_cast<Sem*>(handle);
+  std::unique_lock<std::mutex> lock(s.mu);
+  Task* t = self(s);
+  if (!t) {
+    if (sem->count == 0) return pdFALSE;
+    sem->count--;
+    return pdTRUE;
+  }
+  chargeSlice(s);
+  uint64_t deadline = ticks == portMAX_DELAY ? UINT64_MAX : s.now_us + (uint64_t)ticks * 1000;
+  for (;;) {
+    if (sem->count > 0) {
+      sem->count--;
+      return pdTRUE;
+    }
+    if (s.now_us >= deadline) return pdFALSE;
+    t->wake_us = deadline;
+    t->waiting_on = sem;
+    block(s, lock, t);
+    t->waiting_on = nullptr;
+  }
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t handle) {
+  Sim& s = sim();
+  Sem* sem = static_cast<Sem*>(handle);
+  std::lock_guard<std::mutex> lock(s.mu);
+  if (sem->count >= sem->max) return pdFALSE;
+  sem->count++;
+  for (Task* t : s.tasks)
+    if (t->waiting_on == sem && t->wake_us > s.now_us) t->wake_us = s.now_us;
+  return pdTRUE;
+}
@@ -0,0 +1,56 @@
+// The sketch compiled for the host. Each test or benchmark is one
+// executable that includes this header once, so the sketch's static
+// globals and helpers are directly visible to it.
+#pragma once
+
+#include <Arduino.h>
+
+#include "../ESP32_3_5Inch_Mikrotik_v19.ino"
+
+#include "mock_router.h"
+
+#ifndef MOCK_DATA_DIR
+#define MOCK_DATA_DIR "data"
+#endif
+
+namespace host {
+
+struct BootOptions {
+  int transport = ROUTER_TRANSPORT_REST;
+  int layout = LAYOUT_SINGLE;
+  int graph_iface = 2;
+  int window = 0;
+  int backlight = 100;
+  std::string router = "http://192.168.88.1";
+};
+
+// NVS as left by the config page: station credentials and a router.
+inline void seedConfig(const BootOptions& o = BootOptions()) {
+  mock::prefs_reset();
+  mock::prefs_put("wifi-config", "ssid", "HomeNet");
+  mock::prefs_put("wifi-config", "password", "hunter22");
+  mock::prefs_put("wifi-config", "router_addr", o.router);
+  mock::prefs_put("wifi-config", "router_user", "admin");
+  mock::prefs_put("wifi-config", "router_pass", "secret");
+  mock::prefs_put("wifi-config", "router_proto", std::to_string(o.transport));
+  mock::prefs_put("wifi-config", "interface_id", std::to_string(o.graph_iface));
+  mock::prefs_put("wifi-config", "backlight", std::to_string(o.backlight));
+  mock::prefs_put("wifi-config", "graph_window", std::to_string(o.window));
+  mock::prefs_put("wifi-config", "layout", std::to_string(o.layout));
+}
+
+// Fresh flash with the data/ image (fonts), configured NVS, then setup().
+inline void boot(const BootOptions& o = BootOptions()) {
+  mock::fs_reset();
+  mock::fs_load_dir(MOCK_DATA_DIR);
+  seedConfig(o);
+  mock::heap_rebase();
+  setup();
+}
+
+// Runs loop() for n frames; the poller task runs in between.
+inline void frames(int n) {
+  for (int i = 0; i < n; i++) loop();
+}
+
+}  // namespace host
@@ -0,0 +1,93 @@
+// Minimal test runner: TEST() registers a case, CHECK*() record failures
+// and keep going, main() runs every case (or those named on the command
+// line) and returns non-zero if any failed.
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+namespace check {
+
+struct Case {
+  const char* name;
+  void (*fn)();
+};
+
+inline std::vector<Case>& cases() {
+  static std::vector<Case> v;
+  return v;
+}
+
+inline int& failures() {
+  static int n = 0;
+  return n;
+}
+
+struct Register {
+  Register(const char* name, void (*fn)()) { cases().push_back(Case{ name, fn }); }
+};
+
+inline void fail(const char* file, int line, const char* expr, const char* detail = "") {
+  failures()++;
+  fprintf(stderr, "%s:%d: CHECK failed: %s %s\n", file, line, expr, detail);
+}
+
+}  // namespace check
+
+#define TEST(name)                                       \
+  static void name();                                    \
+  static check::Register name##_registration(#name, name); \
+  static void name()
+
+#define CHECK(cond)                                   \
+  do {                                                \
+    if (!(cond)) check::fail(__FILE__, __LINE__, #cond); \
+  } while (0)
+
+#define CHECK_EQ(a, b)                                                               \
+  do {                                                                               \
+    double check_a_ = (double)(a), check_b_ = (double)(b);                           \
+    if (!(check_a_ == check_b_)) {                                                   \
+      char check_buf_[96];                                                           \
+      snprintf(check_buf_, sizeof(check_buf_), "(%.6g vs %.6g)", check_a_, check_b_); \
+      check::fail(__FILE__, __LINE__, #a " == " #b, check_buf_);                     \
+    }                                                                                \
+  } while (0)
+
+#define CHECK_NEAR(a, b, tol)                                                        \
+  do {                                                                               \
+    double check_a_ = (double)(a), check_b_ = (double)(b);                           \
+    if (!(std::fabs(check_a_ - check_b_) <= (double)(tol))) {                        \
+      char check_buf_[96];                                                           \
+      snprintf(check_buf_, sizeof(check_buf_), "(%.6g vs %.6g)", check_a_, check_b_); \
+      check::fail(__FILE__, __LINE__, #a " ~= " #b, check_buf_);                     \
+    }                                                                                \
+  } while (0)
+
+#define CHECK_LE(a, b)                                                               \
+  do {                                                                               \
+    double check_a_ = (double)(a), check_b_ = (double)(b);                           \
+    if (!(check_a_ <= check_b_)) {                                                   \
+      char check_buf_[96];                                                           \
+      snprintf(check_buf_, sizeof(check_buf_), "(%.6g vs %.6g)", check_a_, check_b_); \
+      check::fail(__FILE__, __LINE__, #a " <= " #b, check_buf_);                     \
+    }                                                                                \
+  } while (0)
+
+int main(int argc, char** argv) {
+  int ran = 0;
+  for (const auto& c : check::cases()) {
+    bool selected = argc < 2;
+    for (int i = 1; i < argc; i++) selected |= strcmp(argv[i], c.name) == 0;
+    if (!selected) continue;
+    int before = check::failures();
+    c.fn();
+    printf("%s %s\n", check::failures() == before ? "PASS" : "FAIL", c.name);
+    ran++;
+  }
+  printf("%d cases, %d failed checks\n", ran, check::failures());
+  return check::failures() ? 1 : 0;
+}
@@ -0,0 +1,90 @@
+// The RouterOS API transport against the fake API server: login, the
+// =interval= and monitor-traffic subscriptions, pushed values reaching the
+// display, the interface cap and reconnecting after a failed login.
+#include "sketch.h"
+#include "check.h"
+
+#include <algorithm>
+
+// More interfaces than API_MAX_IFACES, graphing one near the end
+static mock::RouterModel model(40);
+static mock::RestRouter rest(model);
+static mock::ApiRouter api(model);
+
+static int countOf(const std::vector<std::string>& v, const std::string& s) {
+  return (int)std::count(v.begin(), v.end(), s);
+}
+
+TEST(logs_in_and_subscribes) {
+  api.password = "secret";
+  model.rate = [](int i, uint64_t, double& rx, double& tx) {
+    rx = 40e6 + i * 1e6;
+    tx = 4e6;
+  };
+  host::BootOptions opts;
+  opts.transport = ROUTER_TRANSPORT_API;
+  opts.graph_iface = 38;
+  host::boot(opts);
+  host::frames(10);
+
+  CHECK_EQ(api.connects, 1);
+  CHECK_EQ(api.logins, 1);
+  CHECK_EQ(countOf(api.commands, "/login"), 1);
+  CHECK_EQ(countOf(api.commands, "/interface/ethernet/print"), 2);   // names, then the counter subscription
+  CHECK_EQ(countOf(api.commands, "/system/resource/print"), 1);
+  CHECK_EQ(countOf(api.commands, "/system/clock/print"), 1);
+  CHECK_EQ(countOf(api.commands, "/interface/monitor-traffic"), 1);
+  // Nothing is polled over REST
+  CHECK_EQ(rest.stats.requests, 0);
+}
+
+TEST(graphed_interface_is_monitored_first) {
+  CHECK_EQ(api.monitored.size(), API_MAX_IFACES);
+  CHECK(!api.monitored.empty() && api.monitored[0] == model.ifaces[37].name);
+  CHECK_EQ(countOf(api.monitored, model.ifaces[37].name), 1);
+  CHECK(mock::serial_log().find("monitor-traffic limited to 32 of 40 interfaces") != std::string::npos);
+}
+
+TEST(pushed_values_reach_the_display) {
+  // No polling: subscriptions keep pushing for as long as the display runs
+  size_t sent = api.commands.size();
+  host::frames(40);
+  CHECK_EQ(api.commands.size(), sent);
+
+  router_snapshot_t snap;
+  readSnapshot(snap);
+  CHECK(snap.iface_valid);
+  CHECK(snap.iface.samples >= 15);
+  iface_entry_t* iface = findIface(38);
+  CHECK(iface != nullptr);
+  if (iface) {
+    // monitor-traffic rates in bits/s, kept as kbps of 1024 bit/s
+    CHECK_NEAR(iface->last_rx_kbps, (40e6 + 37e6) / 1024, 2);
+    CHECK_NEAR(iface->last_tx_kbps, 4e6 / 1024, 2);
+    // Counters come every API_COUNTER_INTERVAL_S, so at most that far behind
+    CHECK(iface->rx <= model.ifaces[37].rx_bytes);
+    CHECK_NEAR(iface->rx, model.ifaces[37].rx_bytes, (40e6 + 37e6) / 8 * API_COUNTER_INTERVAL_S);
+  }
+  CHECK_EQ(snap.info.cpuLoad, model.cpu_load);
+  CHECK(snap.info.memoryTotal > 0);
+  CHECK_NEAR(routerNow(), model.epoch(), API_CLOCK_INTERVAL_S + 1);
+}
+
+TEST(reconnects_after_failed_login) {
+  api.password = "changed";
+  apiDisconnect();
+  host::frames(20);
+  CHECK(api.connects >= 2);
+  CHECK_EQ(api.logins, 1);
+  CHECK(!api_ready);
+  CHECK(mock::serial_log().find("RouterOS API login failed") != std::string::npos);
+  // Retries back off instead of hammering the router
+  CHECK(api_backoff_ms >= ROUTER_BACKOFF_MIN_MS);
+  CHECK_LE(api.connects, 6);
+
+  api.password = "secret";
+  host::frames(2 * ROUTER_BACKOFF_MAX_MS / FRAME_INTERVAL_MS);
+  CHECK(api_ready);
+  CHECK_EQ(api.logins, 2);
+  CHECK(!api.monitored.empty() && api.monitored[0] == model.ifaces[37].name);
+}
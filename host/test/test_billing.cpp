@@ -0,0 +1,219 @@
+// 95th-percentile billing. A month of polls replayed through billingAdd()
+// must give sketch quantiles within the log buckets' error of an exact
+// nearest-rank computation over the same 5-minute samples, and the same
+// exact values as /api/billing?exact=1 once the poller has answered its
+// 202. Also covers the split of a poll that straddles a slot boundary, a
+// gap leaving a slot unbilled and the reset at the start of a month.
+#include "sketch.h"
+#include "check.h"
+
+#include <algorithm>
+#include <ctime>
+
+static mock::RouterModel model(4);
+static mock::RestRouter router(model);
+
+static uint32_t at(int y, int m, int d) { return (uint32_t)daysFromCivil(y, m, d) * 86400UL; }
+
+// Restart the slot state, as after a boot with an unknown clock
+static void freshStart() {
+  billing_slot = 0;
+  billing_slot_rx = 0;
+  billing_slot_tx = 0;
+  billing_slot_complete = false;
+}
+
+static uint32_t slotKbps(uint64_t bytes) { return (uint32_t)(bytes * 8 / 1024 / BILLING_SLOT_S); }
+
+static uint32_t nearestRank(std::vector<uint32_t> v, double q) {
+  mock::HeapPause pause;
+  std::sort(v.begin(), v.end());
+  return v.empty() ? 0 : v[(size_t)ceil(q * v.size()) - 1];
+}
+
+// Half a bucket either way, plus rounding to whole kbps
+static double bucketError(uint32_t exact) { return exact * (sqrt(BILLING_GAMMA) - 1) + 1; }
+
+// Office traffic: a daily curve, noise and now and then a burst, constant
+// within each 5-minute slot so the exact samples are known
+static uint64_t rng = 0x9E3779B97F4A7C15ULL;
+static double uniform() {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return (rng >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static void slotRates(uint32_t slot, uint64_t& rx_bps, uint64_t& tx_bps) {
+  double hour = (slot * BILLING_SLOT_S % 86400) / 3600.0;
+  double day = 0.5 - 0.5 * cos((hour - 3) / 24 * 2 * M_PI);
+  double mbps = 20 + 180 * day * (0.7 + 0.6 * uniform());
+  if (uniform() < 0.03) mbps += 300 + 500 * uniform();
+  rx_bps = (uint64_t)(mbps * 1e6 / 8);
+  tx_bps = rx_bps / 8 + (uint64_t)(uniform() * 1e5);
+}
+
+struct Replay {
+  std::vector<uint32_t> rx, tx;   // exact samples of the slots billed so far
+  uint64_t slot_rx = 0, slot_tx = 0;
+  uint32_t slot = 0;
+  uint32_t first = 0;             // began with an unknown previous poll, unbilled
+  uint32_t last = 0;              // time of the last poll
+};
+
+// Polls every 30 s from `from` up to `to`, slot-aligned so no poll
+// straddles a boundary
+static void replay(Replay& r, uint32_t from, uint32_t to) {
+  if (r.last == 0) {
+    billingAdd(0, from, 0, 0);
+    r.last = from;
+    r.slot = r.first = from / BILLING_SLOT_S;
+  }
+  uint64_t rx_bps = 0, tx_bps = 0;
+  slotRates(r.slot, rx_bps, tx_bps);
+  for (uint32_t t = r.last + 30; t <= to; t += 30) {
+    uint32_t slot = (t - 30) / BILLING_SLOT_S;
+    if (slot != r.slot) {
+      if (r.slot != r.first) {
+        mock::HeapPause pause;
+        r.rx.push_back(slotKbps(r.slot_rx));
+        r.tx.push_back(slotKbps(r.slot_tx));
+      }
+      r.slot = slot;
+      r.slot_rx = r.slot_tx = 0;
+      slotRates(slot, rx_bps, tx_bps);
+    }
+    r.slot_rx += rx_bps * 30;
+    r.slot_tx += tx_bps * 30;
+    billingAdd(t - 30, t, rx_bps * 30, tx_bps * 30);
+    r.last = t;
+  }
+}
+
+static double threadCpuMs() {
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static Replay march;
+
+TEST(straddling_poll_is_split_by_time) {
+  host::boot();
+  const uint32_t T = at(2026, 2, 10);
+  freshStart();
+  billingAdd(0, T - 10, 0, 0);
+  // Ends exactly on the boundary: all of it belongs to the unbilled slot
+  billingAdd(T - 10, T, 1000000, 100000);
+  CHECK_EQ(billing_view.month, usagePeriodKey(USAGE_MONTH, T));
+  CHECK_EQ(billing_slot_rx, 0u);
+  for (uint32_t t = T + 10; t < T + BILLING_SLOT_S; t += 10) billingAdd(t - 10, t, 1000000, 100000);
+  // 20 s across the boundary, 10 s on each side
+  billingAdd(T + 290, T + 310, 4000000, 400000);
+  CHECK_EQ(billing_view.samples, 1u);
+  CHECK_EQ(billing_view.missed, 1u);
+  CHECK_EQ(billing_view.rx_max, slotKbps(29 * 1000000ULL + 2000000));
+  CHECK_EQ(billing_view.tx_max, slotKbps(29 * 100000ULL + 200000));
+  CHECK_EQ(billing_slot_rx, 2000000u);
+  CHECK_EQ(billing_slot_tx, 200000u);
+
+  // A 90 s gap leaves the slot it falls in unbilled
+  billingAdd(T + 310, T + 400, 9000000, 900000);
+  for (uint32_t t = T + 410; t <= T + 610; t += 10) billingAdd(t - 10, t, 1000000, 100000);
+  CHECK_EQ(billing_view.samples, 1u);
+  CHECK_EQ(billing_view.missed, 2u);
+}
+
+TEST(month_replay_matches_exact_quantiles) {
+  freshStart();
+  double start = threadCpuMs();
+  replay(march, at(2026, 3, 1), at(2026, 4, 1) - 30);
+  double cpu_ms = threadCpuMs() - start;
+
+  const uint32_t n = march.rx.size();
+  CHECK_EQ(n, 31u * 288 - 2);
+  CHECK_EQ(billing_view.samples, n);
+  CHECK_EQ(billing_view.month, usagePeriodKey(USAGE_MONTH, at(2026, 3, 1)));
+
+  uint32_t rx95 = nearestRank(march.rx, 0.95), rx99 = nearestRank(march.rx, 0.99);
+  uint32_t tx95 = nearestRank(march.tx, 0.95), tx99 = nearestRank(march.tx, 0.99);
+  printf("%u samples in %.1f ms host CPU; rx p95 %u/%u p99 %u/%u, tx p95 %u/%u p99 %u/%u (sketch/exact kbps)\n", n,
+         cpu_ms, billing_view.rx_p95, rx95, billing_view.rx_p99, rx99, billing_view.tx_p95, tx95, billing_view.tx_p99,
+         tx99);
+  CHECK_NEAR(billing_view.rx_p95, rx95, bucketError(rx95));
+  CHECK_NEAR(billing_view.rx_p99, rx99, bucketError(rx99));
+  CHECK_NEAR(billing_view.tx_p95, tx95, bucketError(tx95));
+  CHECK_NEAR(billing_view.tx_p99, tx99, bucketError(tx99));
+  CHECK_EQ(billing_view.rx_max, nearestRank(march.rx, 1.0));
+  CHECK_EQ(billing_view.tx_max, nearestRank(march.tx, 1.0));
+  // The bursts must actually be above the 95th percentile for this to mean much
+  CHECK(rx99 > rx95 * 1.2);
+
+  // The stored samples give the exact values, and a reboot rebuilds the sketch
+  uint32_t p95, p99, stored;
+  CHECK(billingExact(false, p95, p99, stored));
+  CHECK_EQ(stored, n);
+  CHECK_EQ(p95, rx95);
+  CHECK_EQ(p99, rx99);
+  billing_view_t live = billing_view;
+  loadBilling();
+  CHECK_EQ(billing_view.samples, live.samples);
+  CHECK_EQ(billing_view.rx_p95, live.rx_p95);
+  CHECK_EQ(billing_view.tx_p99, live.tx_p99);
+  CHECK_EQ(billing_view.rx_max, live.rx_max);
+  billing_view.missed = live.missed;
+}
+
+TEST(exact_endpoint_answers_202_then_200) {
+  publishSnapshot();
+  mock::WebResponse r = server.mockRequest(HTTP_GET, "/api/billing?exact=1");
+  CHECK_EQ(r.code, 202);
+  CHECK(r.body.find("\"computing\"") != std::string::npos);
+  // Asking again before the poller has run doesn't queue a second job
+  uint32_t job = billing_exact_job;
+  CHECK_EQ(server.mockRequest(HTTP_GET, "/api/billing?exact=1").code, 202);
+  CHECK_EQ(billing_exact_job, job);
+
+  // The poller's turn, with the router away so no live poll moves the month on
+  mock::wifi_set_connected(false);
+  for (int i = 0; i < 4 && billing_exact_done != job; i++) host::frames(1);
+  mock::wifi_set_connected(true);
+  CHECK_EQ(billing_exact_done, job);
+
+  r = server.mockRequest(HTTP_GET, "/api/billing?exact=1");
+  CHECK_EQ(r.code, 200);
+  DynamicJsonDocument doc(1024);
+  {
+    mock::HeapPause pause;
+    CHECK(!deserializeJson(doc, r.body.c_str()));
+  }
+  CHECK(r.body.find("\"month\":\"2026-03\"") != std::string::npos);
+  CHECK_EQ(doc["samples"].as<uint32_t>(), (uint32_t)march.rx.size());
+  CHECK_EQ(doc["rx"]["exact"]["samples"].as<uint32_t>(), (uint32_t)march.rx.size());
+  CHECK_EQ(doc["rx"]["exact"]["p95_kbps"].as<uint32_t>(), nearestRank(march.rx, 0.95));
+  CHECK_EQ(doc["tx"]["exact"]["p99_kbps"].as<uint32_t>(), nearestRank(march.tx, 0.99));
+  CHECK_EQ(doc["rx"]["p95_kbps"].as<uint32_t>(), billing_view.rx_p95);
+  CHECK_EQ(doc["rx"]["max_kbps"].as<uint32_t>(), billing_view.rx_max);
+}
+
+TEST(new_month_starts_empty) {
+  const uint32_t april = at(2026, 4, 1);
+  uint32_t march_samples = march.rx.size();
+  replay(march, march.last, april + 2 * 3600 - 30);
+  CHECK_EQ(billing_view.month, usagePeriodKey(USAGE_MONTH, april));
+  // The last March slot closed into March, then two hours of April
+  CHECK(mock::serial_log().find(">>> Billing month 2026-04 started") != std::string::npos);
+  char line[64];
+  snprintf(line, sizeof(line), "(%u samples last month)", march_samples + 1);
+  CHECK(mock::serial_log().find(line) != std::string::npos);
+  CHECK_EQ(billing_view.samples, 2u * 12 - 1);
+  CHECK_EQ(billing_view.missed, 0u);
+
+  std::vector<uint32_t> april_rx(march.rx.end() - billing_view.samples, march.rx.end());
+  uint32_t p95, p99, stored;
+  CHECK(billingExact(false, p95, p99, stored));
+  CHECK_EQ(stored, billing_view.samples);
+  CHECK_EQ(p95, nearestRank(april_rx, 0.95));
+  CHECK_NEAR(billing_view.rx_p95, p95, bucketError(p95));
+  CHECK_EQ(billing_view.rx_max, nearestRank(april_rx, 1.0));
+}
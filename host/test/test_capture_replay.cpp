@@ -0,0 +1,233 @@
+// Record and replay of raw REST replies. A capture recorded from the fake
+// router must download in the documented format and replay to the same
+// byte totals; a synthetic three-hour capture with a counter reset, a
+// burst over MAX_REASONABLE_BPS and a router reboot must replay in a few
+// seconds of host time with exact totals and one rejected rate, leaving
+// the live state as it was.
+#include "sketch.h"
+#include "check.h"
+
+#include <chrono>
+
+static mock::RouterModel model(4);
+static mock::RestRouter router(model);
+
+struct CapturedReply {
+  capture_record_t rec;
+  std::string body;
+};
+
+static std::vector<CapturedReply> parseCapture(const std::string& bytes) {
+  mock::HeapPause pause;
+  std::vector<CapturedReply> out;
+  if (bytes.compare(0, sizeof(CAPTURE_MAGIC), std::string(CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC))) != 0) return out;
+  size_t pos = sizeof(CAPTURE_MAGIC);
+  while (pos + sizeof(capture_record_t) <= bytes.size()) {
+    CapturedReply r;
+    memcpy(&r.rec, bytes.data() + pos, sizeof(r.rec));
+    pos += sizeof(r.rec);
+    r.body = bytes.substr(pos, r.rec.len);
+    pos += r.rec.len;
+    out.push_back(r);
+  }
+  return out;
+}
+
+// rx-bytes of interface *id in an interface reply
+static uint64_t rxBytes(const std::string& body, int id) {
+  char key[24];
+  snprintf(key, sizeof(key), "\".id\":\"*%X\"", id);
+  size_t at = body.find(key);
+  if (at == std::string::npos) return 0;
+  at = body.find("\"rx-bytes\":\"", at);
+  return strtoull(body.c_str() + at + 12, nullptr, 10);
+}
+
+static void postCapture(const char* action) {
+  std::string body = std::string("{\"action\":\"") + action + "\"}";
+  CHECK_EQ(server.mockRequest(HTTP_POST, "/api/capture", body).code, 202);
+}
+
+static bool runReplay() {
+  replay_result.valid = false;
+  postCapture("replay");
+  for (int i = 0; i < 20 && !replay_result.valid; i++) host::frames(1);
+  return replay_result.valid;
+}
+
+TEST(live_capture_downloads_and_replays) {
+  model.rate = [](int i, uint64_t t, double& rx, double& tx) {
+    rx = 30e6 + (t / 1000 % 10) * 2e6 + i * 1e6;
+    tx = 3e6;
+  };
+  host::boot();
+  host::frames(10);
+  postCapture("start");
+  host::frames(120);
+  postCapture("stop");
+  host::frames(2);
+  CHECK(!capture_active);
+
+  mock::WebResponse dl = server.mockRequest(HTTP_GET, "/capture.bin");
+  CHECK_EQ(dl.code, 200);
+  std::vector<CapturedReply> replies = parseCapture(dl.body);
+  CHECK_EQ(replies.size(), capture_records);
+  CHECK_EQ(dl.body.size(), capture_bytes);
+  int per_ep[ROUTER_EP_COUNT] = { 0 };
+  const CapturedReply* first = nullptr;
+  const CapturedReply* last = nullptr;
+  for (const auto& r : replies) {
+    CHECK(r.rec.ep < ROUTER_EP_COUNT);
+    if (r.rec.ep >= ROUTER_EP_COUNT) continue;
+    per_ep[r.rec.ep]++;
+    if (r.rec.ep == ROUTER_EP_INTERFACES) {
+      if (!first) first = &r;
+      last = &r;
+    }
+  }
+  CHECK(per_ep[ROUTER_EP_INTERFACES] > 40);
+  CHECK(per_ep[ROUTER_EP_RESOURCE] > 0);
+
+  CHECK(runReplay());
+  CHECK_EQ(replay_result.records, replies.size());
+  CHECK_EQ(replay_result.errors, 0);
+  CHECK_EQ(replay_result.rejections, 0);
+  if (first && last) {
+    // The first counter reply is the baseline
+    uint64_t want = rxBytes(last->body, graph_interface_id) - rxBytes(first->body, graph_interface_id);
+    CHECK(want > 0);
+    CHECK_EQ(replay_result.totals.period[USAGE_DAY].rx, want);
+  }
+  mock::WebResponse st = server.mockRequest(HTTP_GET, "/api/capture");
+  CHECK(st.body.find("\"replay\"") != std::string::npos);
+}
+
+// ---- Synthetic multi-hour capture ----
+
+struct SynthIface {
+  uint64_t rx, tx;
+};
+
+static std::string ifaceReply(const std::vector<SynthIface>& ifs) {
+  std::string s = "[";
+  char item[200];
+  for (size_t i = 0; i < ifs.size(); i++) {
+    snprintf(item, sizeof(item),
+             "%s{\".id\":\"*%X\",\"name\":\"ether%zu\",\"running\":\"true\",\"rx-bytes\":\"%llu\",\"tx-bytes\":\"%llu\"}",
+             i ? "," : "", (unsigned)(i + 1), i + 1, (unsigned long long)ifs[i].rx, (unsigned long long)ifs[i].tx);
+    s += item;
+  }
+  return s + "]";
+}
+
+static void appendRecord(std::string& file, uint32_t ms, router_endpoint_t ep, const std::string& body) {
+  capture_record_t rec = { ms, (uint8_t)ep, 0, (uint16_t)body.size() };
+  file.append((const char*)&rec, sizeof(rec));
+  file += body;
+}
+
+TEST(three_hour_capture_replays_in_seconds) {
+  const uint32_t HOURS = 3, STEP_MS = 1000;
+  const uint32_t start_epoch = (uint32_t)daysFromCivil(2026, 3, 10) * 86400UL + 10 * 3600;
+  const int graphed = graph_interface_id;
+  std::string file(CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC));
+  std::vector<SynthIface> ifs(4);
+  for (size_t i = 0; i < ifs.size(); i++) ifs[i] = { 40000000000ULL * (i + 1), 5000000000ULL * (i + 1) };
+  uint64_t expect_rx = 0, expect_tx = 0;
+  uint32_t records = 0;
+  {
+    mock::HeapPause pause;
+    file.reserve(HOURS * 3600 * 420);
+    for (uint32_t t = 0; t <= HOURS * 3600; t++) {
+      uint32_t ms = 5000000 + t * STEP_MS;
+      if (t % 60 == 0) {
+        uint32_t e = start_epoch + t;
+        char body[96];
+        snprintf(body, sizeof(body), "[{\"date\":\"2026-03-10\",\"time\":\"%02u:%02u:%02u\"}]", e / 3600 % 24,
+                 e / 60 % 60, e % 60);
+        appendRecord(file, ms, ROUTER_EP_CLOCK, body);
+        records++;
+      }
+      if (t % 10 == 0) {
+        appendRecord(file, ms, ROUTER_EP_RESOURCE,
+                     "[{\"uptime\":\"1d2h\",\"cpu-load\":\"9\",\"free-memory\":\"900000000\",\"total-memory\":\"1073741824\"}]");
+        records++;
+      }
+      if (t > 0) {
+        for (size_t i = 0; i < ifs.size(); i++) {
+          uint64_t drx = (uint64_t)(25e6 / 8) + (t % 17) * 10000 + i * 1000, dtx = (uint64_t)(2e6 / 8);
+          if (t == 5400 && (int)i + 1 == graphed) drx = 12000000000ULL / 8;    // 12 Gbps for a second
+          ifs[i].rx += drx;
+          ifs[i].tx += dtx;
+          if ((int)i + 1 == graphed) expect_rx += drx, expect_tx += dtx;
+        }
+        if (t == 3600) ifs[graphed - 1] = { 4000, 400 };     // /interface reset-counters
+        if (t == 7200) {
+          // Reboot: every counter starts over
+          for (auto& f : ifs) f = { 1000, 100 };
+        }
+        if (t == 3600 || t == 7200) {
+          // What came after the reset is all the router still counts
+          expect_rx -= (uint64_t)(25e6 / 8) + (t % 17) * 10000 + (graphed - 1) * 1000;
+          expect_tx -= (uint64_t)(2e6 / 8);
+          expect_rx += ifs[graphed - 1].rx;
+          expect_tx += ifs[graphed - 1].tx;
+        }
+      }
+      appendRecord(file, ms, ROUTER_EP_INTERFACES, ifaceReply(ifs));
+      records++;
+    }
+  }
+  CHECK(mock::fs_put(CAPTURE_PATH, file));
+  printf("synthetic capture: %u replies, %zu bytes, %u h\n", records, file.size(), HOURS);
+
+  // With the link down the poller only runs the replay, so the live state
+  // cannot move and anything published meanwhile came from the replay
+  mock::wifi_set_connected(false);
+  host::frames(2);
+  router_snapshot_t before;
+  uint32_t seq = readSnapshot(before);
+  iface_entry_t* live = findIface(graphed);
+  CHECK(live != nullptr);
+  if (!live) return;
+  iface_entry_t live_entry = *live;
+  mt_data_t live_view;
+  CHECK(copyIfaceView(live, live_view));
+  int live_count = iface_count;
+  std::string live_date = routerDateStr;
+
+  auto t0 = std::chrono::steady_clock::now();
+  CHECK(runReplay());
+  double host_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  printf("replayed in %.2f s host time (%.0fx real time)\n", host_s, HOURS * 3600 / host_s);
+
+  CHECK_EQ(replay_result.records, records);
+  CHECK_EQ(replay_result.errors, 0);
+  CHECK_EQ(replay_result.span_ms, HOURS * 3600 * STEP_MS);
+  // Only the burst is over MAX_REASONABLE_BPS
+  CHECK_EQ(replay_result.rejections, 1);
+  CHECK_EQ(replay_result.totals.period[USAGE_DAY].rx, expect_rx);
+  CHECK_EQ(replay_result.totals.period[USAGE_DAY].tx, expect_tx);
+  CHECK_EQ(replay_result.totals.period[USAGE_MONTH].rx, expect_rx);
+  CHECK(replay_result.samples >= HOURS * 3600 - 1);
+  CHECK_LE(host_s, 5.0);
+
+  // The live table, its history and the clock are untouched, and nothing
+  // from the replay was published to the display
+  router_snapshot_t after;
+  CHECK_EQ(readSnapshot(after), seq);
+  CHECK_EQ(iface_count, live_count);
+  CHECK(findIface(graphed) == live);
+  CHECK(memcmp(live, &live_entry, sizeof(live_entry)) == 0);
+  mt_data_t view;
+  CHECK(copyIfaceView(live, view));
+  CHECK(memcmp(view.hist_rx, live_view.hist_rx, sizeof(view.hist_rx)) == 0);
+  CHECK(live_date == routerDateStr);
+
+  // Polling carries on from the live counters
+  mock::wifi_set_connected(true);
+  uint32_t samples = live->samples;
+  host::frames(4);
+  CHECK(findIface(graphed)->samples > samples);
+  CHECK_EQ(router.stats.desyncs, 0);
+}
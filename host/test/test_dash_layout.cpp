@@ -0,0 +1,89 @@
+// Frame cost of the tile layouts against the single graph. Over the same
+// run of polls, 8 and 16 tiles must not put more bytes on the SPI bus or
+// burn more CPU per frame than the single layout does, on average or in
+// the worst frame. Pixel counts are printed alongside for comparison.
+#include "sketch.h"
+#include "check.h"
+
+#include <ctime>
+
+static mock::RouterModel model(16);
+static mock::RestRouter router(model);
+
+static double threadCpuUs() {
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+struct FrameCost {
+  uint32_t frames = 0;
+  uint64_t panel_pixels = 0;
+  uint64_t spi_bytes = 0;
+  uint64_t sprite_pixels = 0;
+  uint64_t max_spi_bytes = 0;
+  int stale_tiles = 0;        // tiles not redrawn during the run
+  double cpu_us = 0;
+};
+
+// Boots a layout, lets the splash clear and the history fill, then
+// measures loop() frame by frame
+static FrameCost measureLayout(int layout, int frames) {
+  model.rate = [](int i, uint64_t t, double& rx, double& tx) {
+    rx = 20e6 + i * 3e6 + (t * 7919 % 5000) * 1000.0;
+    tx = 2e6 + i * 1e5 + (t * 104729 % 3000) * 100.0;
+  };
+  // setup() runs once on the device; state it assumes fresh is reset here
+  iface_count = 0;
+  iface_rings_used = 0;
+  dash_buf_count = 0;
+  dash_tile_next = 0;
+  memset(dash_drawn_id, 0, sizeof(dash_drawn_id));
+  memset(dash_drawn_samples, 0, sizeof(dash_drawn_samples));
+  host::BootOptions o;
+  o.layout = layout;
+  host::boot(o);
+  CHECK_EQ(display_layout, layout);
+  host::frames(60);
+
+  uint32_t samples_before[DASH_MAX_TILES];
+  memcpy(samples_before, dash_drawn_samples, sizeof(samples_before));
+  FrameCost cost;
+  for (int i = 0; i < frames; i++) {
+    mock::TftStats before = mock::tft_stats;
+    double start = threadCpuUs();
+    loop();
+    spiFlush();
+    cost.cpu_us += threadCpuUs() - start;
+    uint64_t spi = mock::tft_stats.spi_bytes - before.spi_bytes;
+    cost.frames++;
+    cost.panel_pixels += mock::tft_stats.panel_pixels - before.panel_pixels;
+    cost.spi_bytes += spi;
+    cost.sprite_pixels += mock::tft_stats.sprite_pixels - before.sprite_pixels;
+    if (spi > cost.max_spi_bytes) cost.max_spi_bytes = spi;
+  }
+  for (int slot = 0; slot < dashTileCount(); slot++) {
+    if (dash_drawn_id[slot] == 0 || dash_drawn_samples[slot] == samples_before[slot]) cost.stale_tiles++;
+  }
+  mock::HeapPause pause;
+  printf("  %-8s %4u frames: %8.0f px %8.0f spi bytes %8.0f sprite px %7.1f us per frame, max %llu bytes\n",
+         LAYOUT_NAMES[layout], cost.frames, (double)cost.panel_pixels / cost.frames,
+         (double)cost.spi_bytes / cost.frames, (double)cost.sprite_pixels / cost.frames, cost.cpu_us / cost.frames,
+         (unsigned long long)cost.max_spi_bytes);
+  return cost;
+}
+
+TEST(tiles_cost_no_more_than_the_single_graph) {
+  const int frames = 600;
+  FrameCost single = measureLayout(LAYOUT_SINGLE, frames);
+  CHECK(single.spi_bytes > 0);
+
+  for (int layout : { LAYOUT_MULTI_8, LAYOUT_MULTI_16 }) {
+    FrameCost tiles = measureLayout(layout, frames);
+    // The credit still gets every tile redrawn within the run
+    CHECK_EQ(tiles.stale_tiles, 0);
+    CHECK_LE(tiles.spi_bytes, single.spi_bytes);
+    CHECK_LE(tiles.max_spi_bytes, single.max_spi_bytes);
+    CHECK_LE(tiles.cpu_us, single.cpu_us);
+  }
+}
@@ -0,0 +1,325 @@
+// /api/export over a month of history. The traffic archive, usage periods
+// and billing samples are fed through the same calls the poller makes;
+// every series must then come out with the same rows in CSV, NDJSON and
+// binary (the delta format decoded here), match what was fed, and stream
+// in constant RAM: a month costs no more heap than a day. Bytes, host CPU
+// time and the heap peak of each export are printed.
+#include "sketch.h"
+#include "check.h"
+
+#include <ctime>
+#include <map>
+
+static mock::RouterModel model(4);
+static mock::RestRouter router(model);
+
+static uint32_t at(int y, int m, int d) { return (uint32_t)daysFromCivil(y, m, d) * 86400UL; }
+
+static double threadCpuMs() {
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+// Rates in kbps: a daily curve plus a per-minute wobble, so min, avg and max
+// of a 15-minute slot differ
+static uint32_t rxKbps(uint32_t t) { return 20000 + (t % 86400) / 10 + (t / 60 * 7919) % 3000; }
+static uint32_t txKbps(uint32_t t) { return 2000 + (t / 60 * 104729) % 500; }
+
+struct SlotRef {
+  uint32_t n = 0;
+  uint64_t rx_sum = 0, tx_sum = 0;
+  uint32_t rx_min = UINT32_MAX, rx_max = 0, tx_min = UINT32_MAX, tx_max = 0;
+};
+
+static const uint32_t MONTH_START = at(2026, 3, 1);
+static const uint32_t MONTH_END = at(2026, 4, 1) - 30;   // last poll of March
+static std::map<uint32_t, SlotRef> slots_15m;            // closed 15-minute slots fed
+static uint64_t usage_rx_fed = 0, usage_tx_fed = 0;
+
+// A month of 30-second polls straight into the accounting and the archive,
+// with the link down so the poller leaves them alone
+static void feedMonth() {
+  mock::wifi_set_connected(false);
+  host::frames(2);
+  memset(&usage_totals, 0, sizeof(usage_totals));
+  usage_iface = 0;
+  usage_pending_rx = usage_pending_tx = 0;
+  billing_slot = 0;
+  billing_slot_rx = billing_slot_tx = 0;
+  billing_slot_complete = false;
+  rrd_pending_count = 0;
+  memset(rrd_accum, 0, sizeof(rrd_accum));
+  rrdRemove(graph_interface_id);
+  CHECK(rrdOpen(graph_interface_id));
+  rrd_iface_id = graph_interface_id;
+
+  uint64_t rx = 1000000, tx = 100000;
+  updateUsage(rx, tx, MONTH_START - 30);
+  for (uint32_t t = MONTH_START; t <= MONTH_END; t += 30) {
+    uint64_t drx = (uint64_t)rxKbps(t) * 1024 / 8 * 30, dtx = (uint64_t)txKbps(t) * 1024 / 8 * 30;
+    rx += drx;
+    tx += dtx;
+    usage_rx_fed += drx;
+    usage_tx_fed += dtx;
+    updateUsage(rx, tx, t);
+    if (t % 60 != 0) continue;
+    rrdAddSample(t, rxKbps(t), txKbps(t));
+    mock::HeapPause pause;
+    SlotRef& s = slots_15m[t - t % 900];
+    s.n++;
+    s.rx_sum += rxKbps(t);
+    s.tx_sum += txKbps(t);
+    s.rx_min = std::min(s.rx_min, rxKbps(t));
+    s.rx_max = std::max(s.rx_max, rxKbps(t));
+    s.tx_min = std::min(s.tx_min, txKbps(t));
+    s.tx_max = std::max(s.tx_max, txKbps(t));
+  }
+  rrdFlush();
+  // The last slot is still open in the accumulator
+  slots_15m.erase(MONTH_END - MONTH_END % 900);
+
+  router_epoch = MONTH_END;
+  router_epoch_ms = millis();
+  publishSnapshot();
+}
+
+struct Row {
+  std::string label;          // time, or the period for usage
+  std::vector<long long> v;
+  bool operator==(const Row& o) const { return label == o.label && v == o.v; }
+};
+
+struct Export {
+  int code = 0;
+  std::string body;
+  double cpu_ms = 0;
+  int64_t heap_peak = 0;      // above the level before the request
+};
+
+static Export fetch(const std::string& url) {
+  Export e;
+  int64_t base = mock::heap_live();
+  mock::heap_mark();
+  double start = threadCpuMs();
+  mock::WebResponse r = server.mockRequest(HTTP_GET, url);
+  e.cpu_ms = threadCpuMs() - start;
+  e.heap_peak = mock::heap_peak_since_mark() - base;
+  mock::HeapPause pause;
+  e.code = r.code;
+  e.body = r.body;
+  return e;
+}
+
+static std::vector<Row> parseCsv(const std::string& body, std::string& header) {
+  mock::HeapPause pause;
+  std::vector<Row> rows;
+  size_t pos = body.find('\n');
+  header = body.substr(0, pos);
+  while (pos != std::string::npos && pos + 1 < body.size()) {
+    size_t end = body.find('\n', pos + 1);
+    std::string line = body.substr(pos + 1, end - pos - 1);
+    Row row;
+    size_t comma = line.find(',');
+    row.label = line.substr(0, comma);
+    while (comma != std::string::npos) {
+      row.v.push_back(strtoll(line.c_str() + comma + 1, nullptr, 10));
+      comma = line.find(',', comma + 1);
+    }
+    rows.push_back(row);
+    pos = end;
+  }
+  return rows;
+}
+
+// Takes the first member as the label and the rest as numbers, in order
+static std::vector<Row> parseNdjson(const std::string& body) {
+  mock::HeapPause pause;
+  std::vector<Row> rows;
+  for (size_t pos = 0; pos < body.size();) {
+    size_t end = body.find('\n', pos);
+    std::string line = body.substr(pos, end - pos);
+    Row row;
+    bool first = true;
+    for (size_t c = line.find("\":"); c != std::string::npos; c = line.find("\":", c + 2)) {
+      const char* p = line.c_str() + c + 2;
+      if (first && *p == '"') {
+        row.label = std::string(p + 1, strchr(p + 1, '"'));
+      } else if (first) {
+        row.label = std::to_string(strtoll(p, nullptr, 10));
+      } else {
+        row.v.push_back(strtoll(p, nullptr, 10));
+      }
+      first = false;
+    }
+    rows.push_back(row);
+    pos = end + 1;
+  }
+  return rows;
+}
+
+static uint64_t readVarint(const std::string& b, size_t& pos) {
+  uint64_t v = 0;
+  for (int shift = 0; pos < b.size(); shift += 7) {
+    uint8_t byte = (uint8_t)b[pos++];
+    v |= (uint64_t)(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) break;
+  }
+  return v;
+}
+
+// MTX1: 12-byte header, then per row the key and each field as zigzag
+// LEB128 deltas from the previous row
+static std::vector<Row> decodeBinary(const std::string& body, int series, int period) {
+  mock::HeapPause pause;
+  std::vector<Row> rows;
+  CHECK(body.size() >= 12);
+  CHECK(body.compare(0, 4, "MTX1") == 0);
+  CHECK_EQ((int)(uint8_t)body[4], series);
+  const int fields = (uint8_t)body[5];
+  CHECK_EQ(fields, EXPORT_FIELD_COUNT[series]);
+  uint32_t step;
+  memcpy(&step, body.data() + 8, sizeof(step));
+  CHECK_EQ(step, series == EXPORT_TRAFFIC ? 900u : series == EXPORT_BILLING ? (uint32_t)BILLING_SLOT_S : 0u);
+
+  std::vector<long long> prev(fields + 1, 0);
+  size_t pos = 12;
+  while (pos < body.size()) {
+    Row row;
+    for (int i = 0; i <= fields; i++) {
+      uint64_t z = readVarint(body, pos);
+      prev[i] += (long long)(z >> 1) ^ -(long long)(z & 1);
+      if (i > 0) row.v.push_back(prev[i]);
+    }
+    if (series == EXPORT_USAGE) {
+      char label[24];
+      formatUsagePeriod(period, (uint32_t)prev[0], label, sizeof(label));
+      row.label = label;
+    } else {
+      row.label = std::to_string(prev[0] * step);
+    }
+    rows.push_back(row);
+  }
+  return rows;
+}
+
+// Exports one series in every format; the rows must agree
+static std::vector<Row> exportAll(const char* query, int series, int period = USAGE_DAY) {
+  std::vector<Row> csv, ndjson, bin;
+  for (int f = 0; f < 3; f++) {
+    std::string url = std::string("/api/export?") + query + "&format=" + EXPORT_FORMAT_NAMES[f];
+    Export e = fetch(url);
+    CHECK_EQ(e.code, 200);
+    if (f == EXPORT_CSV) {
+      std::string header;
+      csv = parseCsv(e.body, header);
+      std::string want = series == EXPORT_USAGE ? "period" : "time";
+      for (int i = 0; i < EXPORT_FIELD_COUNT[series]; i++) want += std::string(",") + EXPORT_FIELDS[series][i];
+      CHECK(header == want);
+    } else if (f == EXPORT_NDJSON) {
+      ndjson = parseNdjson(e.body);
+    } else {
+      bin = decodeBinary(e.body, series, period);
+    }
+    size_t rows = f == EXPORT_CSV ? csv.size() : f == EXPORT_NDJSON ? ndjson.size() : bin.size();
+    printf("  %-8s %-6s %5zu rows %8zu bytes %6.1f bytes/row %7.2f ms host CPU, heap peak %lld bytes\n",
+           EXPORT_SERIES_NAMES[series], EXPORT_FORMAT_NAMES[f], rows, e.body.size(),
+           rows ? (double)e.body.size() / rows : 0.0, e.cpu_ms, (long long)e.heap_peak);
+    CHECK(e.heap_peak > 0);
+    CHECK_LE(e.heap_peak, (int64_t)(sizeof(export_ctx_t) + 2048));
+    CHECK_EQ(export_last_bytes, (uint64_t)e.body.size());
+  }
+  CHECK_EQ(ndjson.size(), csv.size());
+  CHECK_EQ(bin.size(), csv.size());
+  CHECK(ndjson == csv);
+  CHECK(bin == csv);
+  return csv;
+}
+
+TEST(traffic_month_in_every_format) {
+  host::boot();
+  feedMonth();
+  char query[64];
+  snprintf(query, sizeof(query), "series=traffic&tier=15m&iface=%d", graph_interface_id);
+  std::vector<Row> rows = exportAll(query, EXPORT_TRAFFIC);
+
+  // Everything closed within the tier's 30 days, oldest first
+  const uint32_t span = 900 * (RRD_TIER_DEFS[2].slots - 1);
+  const uint32_t first = (MONTH_END - span) - (MONTH_END - span) % 900;
+  std::vector<Row> want;
+  {
+    mock::HeapPause pause;
+    for (const auto& kv : slots_15m) {
+      if (kv.first < first) continue;
+      const SlotRef& s = kv.second;
+      want.push_back(Row{ std::to_string(kv.first),
+                          { s.rx_min, (long long)(s.rx_sum / s.n), s.rx_max, s.tx_min,
+                            (long long)(s.tx_sum / s.n), s.tx_max } });
+    }
+  }
+  CHECK_EQ(rows.size(), want.size());
+  CHECK(rows.size() > 2800);
+  CHECK(rows == want);
+}
+
+TEST(usage_days_in_every_format) {
+  std::vector<Row> rows = exportAll("series=usage&period=day", EXPORT_USAGE, USAGE_DAY);
+  // 30 closed days and today, which together hold every byte counted
+  CHECK_EQ(rows.size(), 31u);
+  CHECK(rows.front().label == "2026-03-01");
+  CHECK(rows.back().label == "2026-03-31");
+  long long rx = 0, tx = 0;
+  for (const Row& r : rows) {
+    rx += r.v[0];
+    tx += r.v[1];
+  }
+  CHECK_EQ((uint64_t)rx, usage_rx_fed);
+  CHECK_EQ((uint64_t)tx, usage_tx_fed);
+
+  // A range picks whole periods
+  char query[96];
+  snprintf(query, sizeof(query), "series=usage&period=day&from=%u&to=%u", at(2026, 3, 10) + 3600,
+           at(2026, 3, 12));
+  std::vector<Row> some = exportAll(query, EXPORT_USAGE, USAGE_DAY);
+  CHECK_EQ(some.size(), 3u);
+  CHECK(some.front().label == "2026-03-10");
+}
+
+TEST(billing_month_in_every_format) {
+  std::vector<Row> rows = exportAll("series=billing", EXPORT_BILLING);
+  CHECK_EQ(rows.size(), (size_t)billing_view.samples);
+  // Every slot of March but the last, still open
+  CHECK_EQ(rows.size(), 31u * 288 - 1);
+  CHECK(rows.front().label == std::to_string(MONTH_START));
+  // Each sample is the mean rate of the polls that ended in its slot
+  uint32_t slot = MONTH_START / BILLING_SLOT_S;
+  uint64_t rx_bytes = 0;
+  for (uint32_t t = slot * BILLING_SLOT_S + 30; t <= (slot + 1) * BILLING_SLOT_S; t += 30) {
+    rx_bytes += (uint64_t)rxKbps(t) * 1024 / 8 * 30;
+  }
+  CHECK_EQ(rows.front().v[0], (long long)(rx_bytes * 8 / 1024 / BILLING_SLOT_S));
+}
+
+TEST(a_month_costs_the_heap_of_a_day) {
+  char month[64], day[96];
+  snprintf(month, sizeof(month), "/api/export?series=traffic&tier=15m&iface=%d", graph_interface_id);
+  snprintf(day, sizeof(day), "/api/export?series=traffic&tier=15m&iface=%d&from=%u", graph_interface_id,
+           MONTH_END - 86400);
+  Export m = fetch(month), d = fetch(day);
+  CHECK(m.body.size() > d.body.size() * 25);
+  printf("  month %zu bytes, heap peak %lld; day %zu bytes, heap peak %lld\n", m.body.size(),
+         (long long)m.heap_peak, d.body.size(), (long long)d.heap_peak);
+  CHECK_LE(m.heap_peak, d.heap_peak + 64);
+
+  mock::WebResponse r = server.mockRequest(HTTP_GET, "/metrics");
+  CHECK(r.body.find("mtdisplay_export_last_bytes " + std::to_string(d.body.size())) != std::string::npos);
+  CHECK(r.body.find("mtdisplay_export_last_min_heap_bytes") != std::string::npos);
+}
+
+TEST(bad_requests) {
+  CHECK_EQ(fetch("/api/export?series=nope").code, 400);
+  CHECK_EQ(fetch("/api/export?series=traffic&iface=99").code, 404);
+  router_epoch = 0;
+  CHECK_EQ(fetch("/api/export?series=usage").code, 503);
+  router_epoch = MONTH_END;
+}
@@ -0,0 +1,195 @@
+// Fleet polling against three local mock routers besides the main one: two
+// switches that answer in 400 ms and one that never answers. The single
+// layout must not poll them, and saving a list there must warn. After a
+// reboot into a multi layout each gets its own task at the poller's
+// priority, no more than FLEET_MAX_INFLIGHT requests are ever in flight,
+// the dead member only costs itself its polls, and the live members' rates
+// reach /api/fleet and the tiles.
+#include "sketch.h"
+#include "check.h"
+
+#include <algorithm>
+
+static mock::RouterModel model(4);
+static mock::RestRouter router(model);
+
+// Records when each request was being answered, for the in-flight check
+struct Span {
+  uint64_t start, end;
+};
+static std::vector<Span> spans;
+
+class TimedRouter : public mock::RestRouter {
+ public:
+  using mock::RestRouter::RestRouter;
+  mock::HttpReply serve(const mock::HttpRequest& req) override {
+    mock::HttpReply reply = mock::RestRouter::serve(req);
+    mock::HeapPause pause;
+    auto it = req.headers.find("Authorization");
+    if (it != req.headers.end()) auth = it->second;
+    spans.push_back(Span{ millis(), millis() + std::min<uint64_t>(reply.latency_ms, FLEET_TIMEOUT_MS) });
+    return reply;
+  }
+  std::string auth;
+};
+
+static mock::RouterModel sw1_model(8), sw2_model(8), dead_model(8);
+static TimedRouter sw1(sw1_model, "10.0.0.2"), sw2(sw2_model, "10.0.0.3"), dead(dead_model, "10.0.0.4");
+
+static const char* FLEET_JSON =
+    "[{\"name\":\"crs-a\",\"address\":\"http://10.0.0.2\",\"login\":\"mon\",\"password\":\"a\",\"interface_id\":1},"
+    "{\"name\":\"crs-b\",\"address\":\"http://10.0.0.3\",\"login\":\"mon\",\"password\":\"b\",\"interface_id\":2},"
+    "{\"name\":\"dead\",\"address\":\"http://10.0.0.4\",\"login\":\"mon\",\"password\":\"c\",\"interface_id\":1}]";
+
+static uint32_t fleetRequests(const mock::RestRouter& r) {
+  uint32_t n = 0;
+  for (const auto& p : r.path_counts) n += p.second;
+  return n;
+}
+
+static int maxInFlight() {
+  mock::HeapPause pause;
+  std::vector<std::pair<uint64_t, int>> edges;
+  for (const Span& s : spans) {
+    edges.push_back({ s.start, 1 });
+    edges.push_back({ s.end, -1 });
+  }
+  // An answer that ends as another starts frees its slot first
+  std::sort(edges.begin(), edges.end());
+  int now = 0, most = 0;
+  for (const auto& e : edges) most = std::max(most, now += e.second);
+  return most;
+}
+
+static std::string fleetTaskNames() {
+  std::string names;
+  for (const mock::TaskInfo& t : mock::tasks()) {
+    if (t.name.compare(0, 6, "fleet_") == 0) names += t.name + " ";
+  }
+  return names;
+}
+
+TEST(single_layout_does_not_poll) {
+  sw1_model.rate = [](int i, uint64_t, double& rx, double& tx) {
+    rx = i == 0 ? 50e6 : 1e6;
+    tx = i == 0 ? 5e6 : 1e6;
+  };
+  sw2_model.rate = [](int i, uint64_t, double& rx, double& tx) {
+    rx = i == 1 ? 200e6 : 1e6;
+    tx = i == 1 ? 20e6 : 1e6;
+  };
+  sw1.latency_ms = sw2.latency_ms = [](const std::string&) { return 400u; };
+  dead.latency_ms = [](const std::string&) { return 60000u; };
+
+  mock::fs_reset();
+  mock::fs_load_dir(MOCK_DATA_DIR);
+  host::seedConfig();
+  mock::prefs_put("wifi-config", "fleet", FLEET_JSON);
+  mock::heap_rebase();
+  setup();
+  CHECK_EQ(fleet_count, 3);
+  CHECK(mock::serial_log().find("Fleet: 3 routers configured, shown only in the multi layouts; not polling") !=
+        std::string::npos);
+
+  host::frames(40);
+  CHECK(fleet_slots == nullptr);
+  CHECK(fleetTaskNames().empty());
+  CHECK_EQ(fleetRequests(sw1) + fleetRequests(sw2) + fleetRequests(dead), 0u);
+  mock::WebResponse r = server.mockRequest(HTTP_GET, "/api/fleet");
+  CHECK_EQ(r.code, 200);
+  CHECK(r.body.find("\"polling\":false") != std::string::npos);
+  CHECK(r.body.find("\"name\":\"crs-b\"") != std::string::npos);
+  // Passwords stay on the device
+  CHECK(r.body.find("password") == std::string::npos);
+
+  // Saving a list here says it won't be polled until a multi layout is picked
+  uint32_t restarts = mock::restarts();
+  std::string body = std::string("{\"routers\":") + FLEET_JSON + "}";
+  r = server.mockRequest(HTTP_POST, "/api/fleet", body);
+  CHECK_EQ(r.code, 200);
+  CHECK(r.body.find("\"polling\":false") != std::string::npos);
+  CHECK(r.body.find("\"warning\"") != std::string::npos);
+  CHECK(mock::serial_log().find("⚠ Fleet routers are not polled in the single layout") != std::string::npos);
+  CHECK_EQ(mock::restarts(), restarts + 1);
+  // An empty list has nothing to warn about
+  r = server.mockRequest(HTTP_POST, "/api/fleet", "{\"routers\":[]}");
+  CHECK_EQ(r.code, 200);
+  CHECK(r.body.find("warning") == std::string::npos);
+}
+
+TEST(multi_layout_polls_concurrently) {
+  // The layout is applied at boot: restart as the config page does
+  host::BootOptions opts;
+  opts.layout = LAYOUT_MULTI_8;
+  host::seedConfig(opts);
+  mock::prefs_put("wifi-config", "fleet", FLEET_JSON);
+  // What the first boot allocated is gone after a restart
+  mock::heap_rebase();
+  setup();
+  CHECK(fleet_slots != nullptr);
+  CHECK(fleetTaskNames() == "fleet_0 fleet_1 fleet_2 ");
+  unsigned poller_priority = 0;
+  for (const mock::TaskInfo& t : mock::tasks()) {
+    if (t.name == "router_poll") poller_priority = t.priority;
+  }
+  for (const mock::TaskInfo& t : mock::tasks()) {
+    if (t.name.compare(0, 6, "fleet_") != 0) continue;
+    CHECK_EQ(t.priority, poller_priority);
+    CHECK_EQ(t.priority, 1u);
+    CHECK_EQ(t.core, POLLER_CORE);
+    CHECK_EQ(t.stack_bytes, FLEET_STACK_SIZE);
+  }
+  // Bounded state per member, whatever the router has
+  CHECK_LE(sizeof(fleet_router_t), 600);
+
+  uint32_t main_before = fleetRequests(router);
+  unsigned long start = millis();
+  while (millis() - start < 60000) host::frames(1);
+
+  uint32_t a = fleetRequests(sw1), b = fleetRequests(sw2), d = fleetRequests(dead);
+  printf("60 s: crs-a %u, crs-b %u, dead %u requests, main %u; at most %d in flight\n", a, b, d,
+         fleetRequests(router) - main_before, maxInFlight());
+  // One poll a second each, the dead member notwithstanding
+  CHECK_LE(55, a);
+  CHECK_LE(55, b);
+  // Timeouts and back-off keep the dead member to a few attempts
+  CHECK_LE(d, 20u);
+  CHECK_LE(1u, d);
+  CHECK_EQ(maxInFlight(), FLEET_MAX_INFLIGHT);
+  CHECK_LE(50u, fleetRequests(router) - main_before);
+  CHECK(mock::serial_log().find("Fleet dead failed (read Timeout)") != std::string::npos);
+
+  // Each member sends its own credentials
+  CHECK(sw1.auth == std::string("Basic ") + base64::encode(String("mon:a")).c_str());
+  CHECK(dead.auth == std::string("Basic ") + base64::encode(String("mon:c")).c_str());
+
+  CHECK_EQ(fleet[0].online, true);
+  CHECK_EQ(fleet[2].online, false);
+  CHECK(fleet[2].last_code < 0);
+  CHECK_EQ(fleet[2].failures, fleet[2].requests);
+  CHECK_NEAR(fleet[0].last_rx_kbps, 50e6 / 1024, 50e6 / 1024 * 0.02);
+  CHECK_NEAR(fleet[1].last_rx_kbps, 200e6 / 1024, 200e6 / 1024 * 0.02);
+  CHECK_NEAR(fleet[1].last_tx_kbps, 20e6 / 1024, 20e6 / 1024 * 0.02);
+  CHECK_LE(400, fleet[0].last_latency_ms);
+
+  mock::WebResponse r = server.mockRequest(HTTP_GET, "/api/fleet");
+  CHECK(r.body.find("\"polling\":true") != std::string::npos);
+  CHECK(r.body.find("\"online\":false") != std::string::npos);
+}
+
+TEST(members_get_their_own_tiles) {
+  static dash_view_t view;
+  dashViewFill(view);
+  CHECK_EQ(view.count, 8);
+  // Five local interfaces, then the fleet in its configured order
+  const char* names[3] = { "crs-a", "crs-b", "dead" };
+  for (int i = 0; i < 3; i++) {
+    const dash_tile_t& t = view.tile[5 + i];
+    CHECK_EQ(t.id, -(i + 1));
+    CHECK(strcmp(t.name, names[i]) == 0);
+    CHECK_EQ(t.online, i < 2 ? 1 : 0);
+  }
+  CHECK_EQ(view.tile[6].rx_kbps, fleet[1].last_rx_kbps);
+  CHECK(view.tile[5].points > 30);
+  CHECK_EQ(view.tile[7].points, 0);
+}
@@ -0,0 +1,123 @@
+// Framebuffer diff harness for the scrolling graph: after any run of
+// incremental frames the panel must match a full redraw of the same view
+// pixel for pixel, while each incremental frame costs a fraction of the
+// SPI bytes and sprite work of a full one.
+#include "sketch.h"
+#include "check.h"
+
+#include <ctime>
+#include <vector>
+
+static mock::RouterModel model(8);
+static mock::RestRouter router(model);
+
+static std::vector<uint16_t> graphPixels() {
+  spiFlush();
+  mock::HeapPause pause;
+  std::vector<uint16_t> px;
+  for (int y = GRAPH_Y + 1; y < GRAPH_Y + 1 + GRAPH_H; y++) {
+    for (int x = GRAPH_X + 1; x < GRAPH_X + 1 + GRAPH_W; x++) px.push_back(mock::panel_pixel(x, y));
+  }
+  return px;
+}
+
+static double threadCpuUs() {
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+struct DrawCost {
+  uint32_t frames = 0;
+  uint64_t spi_bytes = 0;
+  uint64_t sprite_pixels = 0;
+  double cpu_us = 0;
+};
+
+static DrawCost incremental, full;
+
+static void draw(const graph_view_t& view, DrawCost& cost) {
+  mock::TftStats before = mock::tft_stats;
+  double start = threadCpuUs();
+  drawGraphSprite(&view);
+  spiFlush();
+  cost.cpu_us += threadCpuUs() - start;
+  cost.frames++;
+  cost.spi_bytes += mock::tft_stats.spi_bytes - before.spi_bytes;
+  cost.sprite_pixels += mock::tft_stats.sprite_pixels - before.sprite_pixels;
+}
+
+// Brings the panel up to the newest published view incrementally, then
+// redraws that view from scratch and compares
+static int diffAgainstFullRedraw() {
+  router_snapshot_t snap;
+  readSnapshot(snap);
+  uint32_t redraws = graph_full_redraws;
+  draw(snap.graph, incremental);
+  CHECK_EQ(graph_full_redraws, redraws);
+  std::vector<uint16_t> scrolled = graphPixels();
+
+  snap.graph.generation++;
+  draw(snap.graph, full);
+  std::vector<uint16_t> redrawn = graphPixels();
+  int differ = 0;
+  for (size_t i = 0; i < scrolled.size(); i++) differ += scrolled[i] != redrawn[i];
+  return differ;
+}
+
+TEST(scrolled_graph_matches_full_redraw) {
+  // Steady traffic with some noise, a burst now and then
+  model.rate = [](int, uint64_t t, double& rx, double& tx) {
+    rx = 50e6 + (t * 7919 % 5000) * 1000.0 + ((t / 10000) % 3 == 0 ? 30e6 : 0);
+    tx = 5e6 + (t * 104729 % 3000) * 100.0;
+  };
+  host::boot();
+  host::frames(30);
+  CHECK(sprite_created);
+  for (int round = 0; round < 8; round++) {
+    host::frames(5 + round * 3);
+    int differ = diffAgainstFullRedraw();
+    CHECK_EQ(differ, 0);
+    // The loop's next frame is a full one (the test bumped the generation)
+    host::frames(1);
+  }
+}
+
+TEST(incremental_frame_is_cheaper) {
+  // The first 1m window scrolls one column per bucket; measure plain frames
+  router_snapshot_t snap;
+  DrawCost inc, ful;
+  for (int i = 0; i < 40; i++) {
+    host::frames(1);
+    readSnapshot(snap);
+    if (snap.graph.newest == graph_newest_drawn && snap.graph.generation == graph_generation_drawn) continue;
+    draw(snap.graph, inc);
+  }
+  readSnapshot(snap);
+  for (int i = 0; i < 10; i++) {
+    snap.graph.generation++;
+    draw(snap.graph, ful);
+  }
+  CHECK(inc.frames >= 10);
+  double inc_bytes = (double)inc.spi_bytes / inc.frames, full_bytes = (double)ful.spi_bytes / ful.frames;
+  double inc_px = (double)inc.sprite_pixels / inc.frames, full_px = (double)ful.sprite_pixels / ful.frames;
+  // Host CPU includes the mock's sprite scroll, a plain copy of the buffer;
+  // sprite_pixels is the drawing work the ESP32 does
+  printf("graph frame   %6s %10s %14s %9s\n", "frames", "spi_bytes", "sprite_pixels", "cpu_us");
+  printf("incremental   %6u %10.0f %14.0f %9.1f\n", inc.frames, inc_bytes, inc_px, inc.cpu_us / inc.frames);
+  printf("full          %6u %10.0f %14.0f %9.1f\n", ful.frames, full_bytes, full_px, ful.cpu_us / ful.frames);
+
+  // A full frame pushes the whole plot
+  CHECK_NEAR(full_bytes, GRAPH_W * GRAPH_H * 2, 64);
+  CHECK_LE(inc_bytes * 3, full_bytes);
+  CHECK_LE(inc_px * 5, full_px);
+}
+
+TEST(window_change_redraws_whole_plot) {
+  uint32_t redraws = graph_full_redraws;
+  graph_window = 1;
+  host::frames(6);
+  CHECK(graph_full_redraws > redraws);
+  CHECK_EQ(diffAgainstFullRedraw(), 0);
+  graph_window = 0;
+}
@@ -0,0 +1,96 @@
+// Stress test for the flat interface table: 500 interfaces polled over
+// REST, the graphed one late in the list, with the memory budget checked
+// and no heap growth once the table is filled.
+#include "sketch.h"
+#include "check.h"
+
+static mock::RouterModel model(500);
+static mock::RestRouter router(model);
+
+TEST(tracks_500_interfaces) {
+  model.rate = [](int i, uint64_t, double& rx, double& tx) {
+    rx = 1e6 * (i + 1);
+    tx = 1e5 * (i + 1);
+  };
+  host::BootOptions opts;
+  opts.graph_iface = 481;
+  host::boot(opts);
+  host::frames(20);
+
+  CHECK_EQ(iface_count, 500);
+  int missing = 0, wrong = 0;
+  for (const auto& f : model.ifaces) {
+    iface_entry_t* e = findIface(f.id);
+    if (!e) {
+      missing++;
+      continue;
+    }
+    // Interfaces that aren't running carry no traffic
+    double rx_kbps = f.running ? 1e6 * f.id / 1024 : 0;
+    if (std::fabs(e->last_rx_kbps - rx_kbps) > rx_kbps * 0.05) wrong++;
+  }
+  CHECK_EQ(missing, 0);
+  CHECK_EQ(wrong, 0);
+  CHECK(findIface(501) == nullptr);
+}
+
+TEST(graphed_interface_keeps_its_history) {
+  // All but the reserved ring went to the first interfaces seen
+  CHECK_EQ(iface_rings_used, HISTORY_RINGS);
+  iface_entry_t* graphed = findIface(481);
+  CHECK(graphed != nullptr);
+  if (graphed) CHECK(graphed->ring >= 0);
+  CHECK(findIface(HISTORY_RINGS + 1)->ring < 0);
+  router_snapshot_t snap;
+  readSnapshot(snap);
+  CHECK(snap.iface_valid);
+  CHECK(snap.iface.samples > 5);
+  CHECK_NEAR(snap.iface.hist_rx[(snap.iface.pos + HISTORY_SIZE - 1) % HISTORY_SIZE], 481e6 / 1024, 481e6 / 1024 * 0.05);
+}
+
+TEST(memory_budget) {
+  // The budget documented next to MAX_IFACES
+  CHECK_LE(sizeof(iface_entry_t), 40);
+  CHECK_EQ(sizeof(iface_ring_t), HISTORY_SIZE * 2 * sizeof(uint32_t));
+  size_t total = MAX_IFACES * sizeof(iface_entry_t) + IFACE_INDEX_SIZE * sizeof(int16_t) +
+                 HISTORY_RINGS * sizeof(iface_ring_t);
+  CHECK_LE(total, 32 * 1024);
+  CHECK(mock::serial_log().find("✓ Interface table: 512 entries") != std::string::npos);
+
+  // Polling 500 interfaces allocates nothing that stays behind
+  int64_t live = mock::heap_live();
+  host::frames(40);
+  CHECK_LE(mock::heap_live(), live);
+}
+
+TEST(full_table_ignores_new_interfaces) {
+  model.resize(MAX_IFACES + 20);
+  host::frames(10);
+  CHECK_EQ(iface_count, MAX_IFACES);
+  CHECK(findIface(MAX_IFACES) != nullptr);
+  CHECK(findIface(MAX_IFACES + 1) == nullptr);
+  CHECK(mock::serial_log().find("Interface table full (512)") != std::string::npos);
+  // The interfaces already tracked keep updating
+  uint32_t samples = findIface(481)->samples;
+  host::frames(10);
+  CHECK(findIface(481)->samples > samples);
+}
+
+TEST(sparse_ids_probe_past_collisions) {
+  // Start from an empty table, as after boot
+  memset(iface_index, 0xFF, IFACE_INDEX_SIZE * sizeof(int16_t));
+  iface_count = 0;
+  iface_rings_used = 0;
+  // Ids that hash to the same slot, as VLANs and bridges created over
+  // time end up with
+  const int ids[] = { 1, 1 + IFACE_INDEX_SIZE, 1 + 2 * IFACE_INDEX_SIZE, 0x7FFF, 0x10000, 5 };
+  for (int id : ids) CHECK(addIface(id, id * 10, id, millis()) != nullptr);
+  for (int id : ids) {
+    iface_entry_t* e = findIface(id);
+    CHECK(e != nullptr);
+    if (e) CHECK_EQ(e->rx, id * 10);
+  }
+  CHECK(findIface(2) == nullptr);
+  CHECK(findIface(0) == nullptr);
+  CHECK(findIface(-1) == nullptr);
+}
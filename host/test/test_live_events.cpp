@@ -0,0 +1,202 @@
+// /api/events under load. With 20 subscribers each published snapshot must
+// be serialized once (same bytes per frame as with one subscriber), cost
+// far less device CPU than 20 pages polling /api/stats, and keep the heap
+// to one queued copy per subscriber; the rx/tx deltas must rebuild the
+// graph ring, a subscriber that joins late must get the whole ring, and one
+// that stops reading must be capped at SSE_MAX_QUEUED_MESSAGES without
+// holding up the rest.
+#include "sketch.h"
+#include "check.h"
+
+#include <ctime>
+
+static mock::RouterModel model(4);
+static mock::RestRouter router(model);
+
+static const int CLIENTS = 20;
+static AsyncEventSourceClient* clients[CLIENTS];
+
+static double threadCpuUs() {
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+// The JSON after "data: " in a formatted event
+static bool parseFrame(const std::string& event, DynamicJsonDocument& doc) {
+  mock::HeapPause pause;
+  size_t at = event.find("data: ");
+  if (at == std::string::npos) return false;
+  size_t end = event.find("\r\n", at);
+  return !deserializeJson(doc, event.substr(at + 6, end - at - 6).c_str());
+}
+
+static void drainAll() {
+  for (int i = 0; i < CLIENTS; i++) {
+    if (clients[i]) events.mockDrain(clients[i]);
+  }
+}
+
+TEST(no_subscribers_no_frames) {
+  model.rate = [](int i, uint64_t t, double& rx, double& tx) {
+    rx = 40e6 + (t / 1000 % 7) * 3e6 + i * 1e6;
+    tx = 4e6 + (t / 1000 % 3) * 1e6;
+  };
+  host::boot();
+  host::frames(40);
+  CHECK_EQ(events_frames, 0u);
+}
+
+TEST(twenty_subscribers_share_one_frame) {
+  // Bytes per frame with a single subscriber first
+  clients[0] = events.mockConnect();
+  // Past the first frame, which carries the whole ring
+  host::frames(2);
+  events.mockDrain(clients[0]);
+  uint32_t frames0 = events_frames;
+  uint64_t bytes0 = events_bytes;
+  for (int f = 0; f < 40; f++) {
+    host::frames(1);
+    events.mockDrain(clients[0]);
+  }
+  uint32_t one_frames = events_frames - frames0;
+  double one_bytes = (double)(events_bytes - bytes0) / std::max(1u, one_frames);
+
+  for (int i = 1; i < CLIENTS; i++) clients[i] = events.mockConnect();
+  CHECK_EQ(events.count(), (size_t)CLIENTS);
+  host::frames(2);
+  drainAll();
+
+  // A minute of frames, the network keeping up with every subscriber
+  frames0 = events_frames;
+  bytes0 = events_bytes;
+  uint32_t delivered0 = events.mockDelivered(clients[CLIENTS - 1]);
+  int64_t live = mock::heap_live();
+  mock::heap_mark();
+  unsigned long start = millis();
+  while (millis() - start < 60000) {
+    host::frames(1);
+    drainAll();
+  }
+  int64_t peak = mock::heap_peak_since_mark() - live;
+  uint32_t frames = events_frames - frames0;
+  double bytes = (double)(events_bytes - bytes0) / std::max(1u, frames);
+  printf("%u frames in 60 s, %.0f bytes each (%.0f with one subscriber), heap peak +%lld bytes\n", frames, bytes,
+         one_bytes, (long long)peak);
+
+  // One frame per published snapshot, whatever the subscriber count
+  CHECK_LE(40u, frames);
+  CHECK_LE(frames, 121u);
+  CHECK_NEAR(bytes, one_bytes, one_bytes * 0.1);
+  for (int i = 0; i < CLIENTS; i++) {
+    CHECK_EQ(events.mockDropped(clients[i]), 0u);
+  }
+  CHECK_EQ(events.mockDelivered(clients[CLIENTS - 1]) - delivered0, frames);
+  // The queued copies of one frame, plus the sketch's own frame work
+  CHECK_LE(peak, CLIENTS * (bytes + 64) + 4096);
+  CHECK_LE(mock::heap_live() - live, 0);
+}
+
+TEST(push_costs_less_than_polling) {
+  router_snapshot_t snap;
+  readSnapshot(snap);
+  const int RUNS = 200;
+
+  // One push to 20 subscribers
+  double cpu = 0;
+  int64_t live = mock::heap_live();
+  mock::heap_mark();
+  for (int r = 0; r < RUNS; r++) {
+    double t0 = threadCpuUs();
+    pushStatsFrame(snap, 1000 + r);
+    cpu += threadCpuUs() - t0;
+    drainAll();
+  }
+  double push_us = cpu / RUNS;
+  int64_t push_heap = mock::heap_peak_since_mark() - live;
+
+  // 20 pages each fetching /api/stats once
+  cpu = 0;
+  mock::heap_mark();
+  for (int r = 0; r < RUNS; r++) {
+    double t0 = threadCpuUs();
+    for (int i = 0; i < CLIENTS; i++) server.mockRequest(HTTP_GET, "/api/stats");
+    cpu += threadCpuUs() - t0;
+  }
+  double poll_us = cpu / RUNS;
+  int64_t poll_heap = mock::heap_peak_since_mark() - live;
+  printf("20 subscribers: push %.1f us, heap +%lld; 20 x /api/stats %.1f us, heap +%lld (host CPU)\n", push_us,
+         (long long)push_heap, poll_us, (long long)poll_heap);
+  CHECK_LE(push_us * 2, poll_us);
+  CHECK_LE(mock::heap_live() - live, 0);
+}
+
+TEST(deltas_rebuild_the_ring) {
+  // A page that joins late gets the whole ring in its first frame
+  AsyncEventSourceClient* page = events.mockConnect();
+  DynamicJsonDocument doc(4096);
+  uint32_t seen = 0;
+  std::vector<uint32_t> rx;
+  auto readPage = [&] {
+    while (events.mockDrain(page, 1) == 1) {
+      CHECK(parseFrame(events.mockLast(page), doc));
+      uint32_t samples = doc["samples"];
+      JsonArray arr = doc["rx"];
+      if (seen == 0) {
+        CHECK_EQ(arr.size(), std::min<uint32_t>(samples, HISTORY_SIZE));
+      } else {
+        CHECK_EQ(arr.size(), std::min<uint32_t>(samples - seen, HISTORY_SIZE));
+      }
+      mock::HeapPause pause;
+      for (JsonVariant v : arr) rx.push_back(v.as<uint32_t>());
+      if (arr.size() > 0) CHECK_EQ(doc["rx_kbps"].as<uint32_t>(), arr[arr.size() - 1].as<uint32_t>());
+      seen = samples;
+    }
+  };
+  for (int f = 0; f < 60; f++) {
+    host::frames(1);
+    drainAll();
+    readPage();
+  }
+  CHECK(seen > HISTORY_SIZE);
+
+  // The poller may have published again since the last frame; frame the
+  // snapshot compared against, then the page's copy ends with its ring
+  router_snapshot_t snap;
+  uint32_t seq = readSnapshot(snap);
+  pushStatsFrame(snap, seq);
+  drainAll();
+  readPage();
+  CHECK_EQ(snap.iface.samples, seen);
+  for (int k = 1; k <= HISTORY_SIZE; k++) {
+    CHECK_EQ(rx[rx.size() - k], snap.iface.hist_rx[(snap.iface.pos + HISTORY_SIZE - k) % HISTORY_SIZE]);
+  }
+  events.mockDisconnect(page);
+}
+
+TEST(stalled_subscriber_is_capped) {
+  AsyncEventSourceClient* stalled = clients[CLIENTS - 1];
+  clients[CLIENTS - 1] = nullptr;
+  int64_t live = mock::heap_live();
+  uint32_t frames0 = events_frames;
+  uint32_t delivered0 = events.mockDelivered(clients[0]);
+  for (int f = 0; f < 200; f++) {
+    host::frames(1);
+    drainAll();
+  }
+  uint32_t frames = events_frames - frames0;
+  CHECK(frames > SSE_MAX_QUEUED_MESSAGES + 10);
+  CHECK_EQ(stalled->packetsWaiting(), (size_t)SSE_MAX_QUEUED_MESSAGES);
+  CHECK_EQ(events.mockDropped(stalled), frames - SSE_MAX_QUEUED_MESSAGES);
+  CHECK_EQ(events.mockDelivered(clients[0]) - delivered0, frames);
+  // Only the stalled queue is held
+  CHECK_LE(mock::heap_live() - live, SSE_MAX_QUEUED_MESSAGES * ((double)events_bytes / events_frames + 64));
+
+  events.mockDisconnect(stalled);
+  for (int i = 0; i < CLIENTS - 1; i++) events.mockDisconnect(clients[i]);
+  CHECK_EQ(events.count(), (size_t)0);
+  CHECK_LE(mock::heap_live() - live, 0);
+  uint32_t idle = events_frames;
+  host::frames(20);
+  CHECK_EQ(events_frames, idle);
+}
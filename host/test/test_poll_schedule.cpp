@@ -0,0 +1,142 @@
+// Per-endpoint REST poll scheduler. Counters must follow the graph's
+// bucket width while traffic flows, drop to the burst interval when the
+// rate jumps and back off only on an idle link; resource, clock and names
+// keep their own slow intervals. With nobody watching every endpoint falls
+// back to its unattended interval, and a returning viewer gets everything
+// at once. /metrics must report the request rate the router really saw.
+#include "sketch.h"
+#include "check.h"
+
+static mock::RouterModel model(4);
+static mock::RestRouter router(model);
+
+static double rx_bps = 50e6;
+
+static uint32_t runs(int ep) { return poll_sched[ep].runs; }
+
+struct Runs {
+  uint32_t n[ROUTER_EP_COUNT];
+  Runs() {
+    for (int i = 0; i < ROUTER_EP_COUNT; i++) n[i] = runs(i);
+  }
+  uint32_t since(int ep) const { return runs(ep) - n[ep]; }
+};
+
+static uint32_t routerRequests() {
+  uint32_t n = 0;
+  for (const auto& kv : router.path_counts) n += kv.second;
+  return n;
+}
+
+static double metric(const std::string& body, const std::string& name) {
+  size_t at = body.find("\n" + name + " ");
+  return at == std::string::npos ? -1 : atof(body.c_str() + at + name.size() + 2);
+}
+
+TEST(steady_traffic_polls_at_the_bucket_width) {
+  model.rate = [](int, uint64_t, double& rx, double& tx) {
+    rx = rx_bps;
+    tx = rx_bps / 10;
+  };
+  host::boot();
+  CHECK_EQ(GRAPH_WINDOWS[graph_window].bucket_s, 1u);
+  host::frames(60);
+  CHECK_EQ(poll_sched[ROUTER_EP_INTERFACES].interval_ms, 1000u);
+
+  Runs before;
+  host::frames(240);          // two minutes
+  printf("  steady 120 s: interfaces %u, resource %u, clock %u, iface_list %u polls\n",
+         before.since(ROUTER_EP_INTERFACES), before.since(ROUTER_EP_RESOURCE), before.since(ROUTER_EP_CLOCK),
+         before.since(ROUTER_EP_IFACE_LIST));
+  CHECK_NEAR(before.since(ROUTER_EP_INTERFACES), 120, 2);
+  CHECK_NEAR(before.since(ROUTER_EP_RESOURCE), 12, 1);
+  CHECK_NEAR(before.since(ROUTER_EP_CLOCK), 2, 1);
+  CHECK_NEAR(before.since(ROUTER_EP_IFACE_LIST), 2, 1);
+  CHECK_EQ(poll_sched[ROUTER_EP_INTERFACES].misses, 0u);
+
+  // One sample per bucket: the last minute of the 1 s archive tier is full
+  rrdFlush();
+  const uint32_t end = routerNow() - 5;
+  int filled = 0;
+  for (uint32_t t = end - 60; t < end; t++) {
+    rrd_slot_t slot;
+    rrdReadSlots(rrd_iface_id, 0, rrdSlotIndex(0, t), &slot, 1);
+    filled += slot.t == t;
+  }
+  CHECK_EQ(filled, 60);
+}
+
+TEST(a_burst_drops_to_the_burst_interval) {
+  rx_bps = 200e6;
+  Runs before;
+  uint32_t shortest = UINT32_MAX;
+  for (int i = 0; i < 8; i++) {
+    mock::run_for(250);
+    shortest = min(shortest, poll_sched[ROUTER_EP_INTERFACES].interval_ms);
+  }
+  CHECK_EQ(shortest, POLL_SCHED_DEFS[ROUTER_EP_INTERFACES].min_ms);
+  // 250, 375, 562, 843 ms and back at the bucket width
+  CHECK(before.since(ROUTER_EP_INTERFACES) >= 4);
+  host::frames(10);
+  CHECK_EQ(poll_sched[ROUTER_EP_INTERFACES].interval_ms, 1000u);
+}
+
+TEST(an_idle_link_backs_off_to_the_idle_interval) {
+  rx_bps = 100e3;             // well under SCHED_BURST_FLOOR_KBPS with tx
+  host::frames(40);
+  CHECK_EQ(poll_sched[ROUTER_EP_INTERFACES].interval_ms, POLL_SCHED_DEFS[ROUTER_EP_INTERFACES].max_ms);
+  Runs before;
+  host::frames(240);
+  CHECK_NEAR(before.since(ROUTER_EP_INTERFACES), 120000 / POLL_SCHED_DEFS[ROUTER_EP_INTERFACES].max_ms, 1);
+}
+
+TEST(unattended_falls_back_and_a_viewer_refreshes_everything) {
+  rx_bps = 50e6;
+  host::frames(20);
+  backlight_brightness = 0;
+  host::frames(2);
+  CHECK(!poll_attended);
+  mock::WebResponse m = server.mockRequest(HTTP_GET, "/metrics");
+  CHECK_EQ(metric(m.body, "mtdisplay_poll_attended"), 0);
+
+  // Ten minutes with the screen off; loop() keeps the scheduler unattended
+  Runs before;
+  host::frames(1200);
+  printf("  unattended 600 s: interfaces %u, resource %u, clock %u, iface_list %u polls\n",
+         before.since(ROUTER_EP_INTERFACES), before.since(ROUTER_EP_RESOURCE), before.since(ROUTER_EP_CLOCK),
+         before.since(ROUTER_EP_IFACE_LIST));
+  CHECK_NEAR(before.since(ROUTER_EP_INTERFACES), 600000 / POLL_SCHED_DEFS[ROUTER_EP_INTERFACES].unattended_ms, 1);
+  CHECK_NEAR(before.since(ROUTER_EP_RESOURCE), 600000 / POLL_SCHED_DEFS[ROUTER_EP_RESOURCE].unattended_ms, 1);
+  CHECK_LE(before.since(ROUTER_EP_CLOCK), 1u);
+  CHECK_LE(before.since(ROUTER_EP_IFACE_LIST), 1u);
+  m = server.mockRequest(HTTP_GET, "/metrics");
+  CHECK(m.body.find("mtdisplay_poll_interval_seconds{endpoint=\"interfaces\"} 15.000") != std::string::npos);
+
+  // A page asking for stats counts as a viewer: every endpoint goes at once
+  Runs back;
+  CHECK_EQ(server.mockRequest(HTTP_GET, "/api/stats").code, 200);
+  host::frames(2);
+  CHECK(poll_attended);
+  for (int i = 0; i < ROUTER_EP_COUNT; i++) CHECK(back.since(i) >= 1);
+  CHECK_LE(poll_sched[ROUTER_EP_INTERFACES].interval_ms, 1000u);
+  backlight_brightness = 100;
+}
+
+TEST(requests_per_hour_match_the_router) {
+  const uint32_t start_ms = millis(), start_requests = routerRequests();
+  host::frames(7200);          // an hour
+  const double hour = (routerRequests() - start_requests) * 3600000.0 / (millis() - start_ms);
+  // The old fixed cycle sent interfaces, resource and clock every 500 ms
+  const double fixed_cycle = 3 * 3600000.0 / POLL_INTERVAL_MS;
+
+  // The gauge averages over the poller's whole run, the unattended part included
+  mock::WebResponse m = server.mockRequest(HTTP_GET, "/metrics");
+  const double reported = metric(m.body, "mtdisplay_router_requests_per_hour");
+  const double seen = routerRequests() * 3600000.0 / (millis() - sched_started_ms);
+  printf("  last hour %.0f requests, since boot %.0f/h reported and %.0f/h seen by the router; "
+         "%.0f/h with the fixed 500 ms cycle\n", hour, reported, seen, fixed_cycle);
+  CHECK_NEAR(reported, seen, seen * 0.01);
+  // Counters every second, resource every 10 s, clock and names every minute
+  CHECK_NEAR(hour, 3600 + 360 + 60 + 60, 60);
+  CHECK(hour < fixed_cycle / 5);
+}
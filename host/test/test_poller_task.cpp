@@ -0,0 +1,118 @@
+// The router poller runs in its own task and hands the renderer a snapshot
+// through a seqlock. A slow or dead router must not change the frame
+// cadence, and the renderer must only ever see whole snapshots.
+#include "sketch.h"
+#include "check.h"
+
+#include <algorithm>
+#include <vector>
+
+static mock::RouterModel model(8);
+static mock::RestRouter router(model);
+
+// millis() between the starts of consecutive loop() calls
+static std::vector<uint32_t> frameGaps(int n) {
+  std::vector<uint32_t> gaps;
+  uint32_t last = millis();
+  for (int i = 0; i < n; i++) {
+    loop();
+    uint32_t now = millis();
+    gaps.push_back(now - last);
+    last = now;
+  }
+  return gaps;
+}
+
+static uint32_t maxGap(const std::vector<uint32_t>& gaps) { return *std::max_element(gaps.begin(), gaps.end()); }
+
+TEST(poller_runs_in_its_own_task) {
+  host::boot();
+  host::frames(10);
+  bool found = false;
+  for (const auto& t : mock::tasks()) {
+    if (t.name != "router_poll") continue;
+    found = true;
+    CHECK_EQ(t.core, POLLER_CORE);
+    CHECK(!t.finished);
+  }
+  CHECK(found);
+}
+
+TEST(cadence_unchanged_by_router_latency) {
+  router.latency_ms = [](const std::string&) { return 15u; };
+  host::frames(10);
+  std::vector<uint32_t> fast = frameGaps(40);
+  uint32_t fast_polls = router.path_counts["/rest/interface/ethernet/print"];
+
+  // Every reply takes 4.5 s, just inside the 5 s read timeout
+  router.latency_ms = [](const std::string&) { return 4500u; };
+  std::vector<uint32_t> slow = frameGaps(40);
+  uint32_t slow_polls = router.path_counts["/rest/interface/ethernet/print"] - fast_polls;
+
+  CHECK_LE(maxGap(fast), FRAME_INTERVAL_MS + 20);
+  CHECK_LE(maxGap(slow), maxGap(fast));
+  CHECK_NEAR(slow[20], FRAME_INTERVAL_MS, 20);
+  // The router really was slow: a 20 s run fits only a handful of polls
+  CHECK(slow_polls > 0);
+  CHECK_LE(slow_polls, 20000 / 4500 + 1);
+  router.latency_ms = [](const std::string&) { return 15u; };
+}
+
+TEST(cadence_unchanged_by_timeouts) {
+  host::frames(10);
+  // Replies never come; every request runs into the read timeout
+  router.latency_ms = [](const std::string&) { return 60000u; };
+  std::vector<uint32_t> dead = frameGaps(40);
+  CHECK_LE(maxGap(dead), FRAME_INTERVAL_MS + 20);
+
+  // Dropped connections are no different
+  router.latency_ms = [](const std::string&) { return 15u; };
+  router.fail_next = 20;
+  router.fail_code = 0;
+  std::vector<uint32_t> dropped = frameGaps(40);
+  CHECK_LE(maxGap(dropped), FRAME_INTERVAL_MS + 20);
+  router.fail_next = 0;
+  router.fail_code = 503;
+
+  // And the display picks the counters up again once the router answers
+  uint32_t before = snapshot_published.load();
+  host::frames(10);
+  router_snapshot_t snap;
+  CHECK(readSnapshot(snap) > before);
+  CHECK(snap.iface_valid);
+}
+
+TEST(snapshot_is_whole) {
+  host::frames(10);
+  router_snapshot_t a, b;
+  uint32_t seq = readSnapshot(a);
+  CHECK(seq > 0);
+  // A second read without a publish in between sees the same bytes
+  CHECK_EQ(readSnapshot(b), seq);
+  CHECK(memcmp(&a, &b, sizeof(a)) == 0);
+
+  // While the writer fills the other slot the reader keeps the published one
+  snapshot_writing.store(seq + 1);
+  CHECK_EQ(readSnapshot(b), seq);
+  CHECK(memcmp(&a, &b, sizeof(a)) == 0);
+  snapshot_writing.store(seq);
+
+  // Each publish goes to the other slot and bumps the sequence by one
+  publishSnapshot();
+  CHECK_EQ(readSnapshot(b), seq + 1);
+  CHECK(&snapshot_buf[(seq + 1) & 1] != &snapshot_buf[seq & 1]);
+  CHECK(memcmp(&snapshot_buf[seq & 1], &a, sizeof(a)) == 0);
+}
+
+TEST(snapshot_matches_poller_state) {
+  host::frames(20);
+  router_snapshot_t snap;
+  readSnapshot(snap);
+  iface_entry_t* iface = findIface(graph_interface_id);
+  CHECK(iface != nullptr);
+  if (iface) {
+    CHECK_EQ(snap.iface.samples, iface->samples);
+    CHECK_EQ(snap.iface.rx, iface->rx);
+    CHECK_EQ(snap.iface.pos, iface->pos);
+  }
+}
@@ -0,0 +1,161 @@
+// Streaming, filtered parsing of the REST interface reply: bounded heap
+// whatever the interface count, oversized elements, chunked replies, and a
+// reply the parser gave up on never leaking into the next request on the
+// kept-alive socket.
+#include "sketch.h"
+#include "check.h"
+
+#include <ctime>
+
+static mock::RouterModel model(8);
+static mock::RestRouter router(model);
+
+static std::string interfaceReply() {
+  mock::HeapPause pause;
+  mock::HttpRequest req;
+  req.method = "POST";
+  req.path = "/rest/interface/ethernet/print";
+  req.body = "{\".proplist\": \".id,name,rx-bytes,tx-bytes,running\"}";
+  return router.serve(req).body;
+}
+
+static double threadCpuUs() {
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+struct ParseRun {
+  int items;
+  int64_t heap_peak;
+  double cpu_us;
+};
+
+static ParseRun parseOnce(const std::string& body, uint32_t nowMs) {
+  StreamString* s;
+  {
+    mock::HeapPause pause;
+    s = new StreamString();
+    s->write((const uint8_t*)body.data(), body.size());
+  }
+  int64_t live = mock::heap_live();
+  mock::heap_mark();
+  double start = threadCpuUs();
+  ParseRun r;
+  r.items = parseInterfaceReply(*s, nowMs);
+  r.cpu_us = threadCpuUs() - start;
+  r.heap_peak = mock::heap_peak_since_mark() - live;
+  {
+    mock::HeapPause pause;
+    delete s;
+  }
+  return r;
+}
+
+TEST(parse_heap_is_bounded) {
+  host::boot();
+  host::frames(4);
+  const int sizes[] = { 8, 64, 512 };
+  int64_t peak_8 = 0;
+  printf("%-7s %9s %9s %10s %9s\n", "ifaces", "bytes", "items", "heap_peak", "cpu_us");
+  for (int n : sizes) {
+    model.resize(n);
+    std::string body = interfaceReply();
+    // The first reply adds the interfaces, the second computes rates
+    uint32_t now = millis();
+    ParseRun first = parseOnce(body, now);
+    model.advance();
+    ParseRun second = parseOnce(body, now + 1000);
+    printf("%-7d %9zu %9d %10lld %9.1f\n", n, body.size(), second.items, (long long)second.heap_peak, second.cpu_us);
+
+    CHECK_EQ(first.items, n);
+    CHECK_EQ(second.items, n);
+    CHECK(findIface(n) != nullptr);
+    if (n == 8) peak_8 = std::max(first.heap_peak, second.heap_peak);
+    // Nothing on the heap grows with the reply
+    CHECK_LE(first.heap_peak, peak_8);
+    CHECK_LE(second.heap_peak, peak_8);
+  }
+  CHECK_LE(peak_8, 1024);
+  iface_entry_t* last = findIface(512);
+  CHECK(last != nullptr);
+  if (last) CHECK_EQ(last->rx, model.ifaces[511].rx_bytes);
+  model.resize(8);
+}
+
+TEST(rejects_malformed_reply) {
+  const char* bad[] = { "", "{}", "[{\".id\":\"*1\"", "[{\".id\":\"*1\"}  x" };
+  for (const char* b : bad) CHECK_EQ(parseOnce(b, millis()).items, -1);
+  CHECK_EQ(parseOnce("[]", millis()).items, 0);
+}
+
+TEST(long_name_skips_only_its_element) {
+  // A 200-character name is filtered out of the stats parse, and in the
+  // names request it overflows only its own element
+  std::string name = model.ifaces[3].name, renamed = model.ifaces[4].name;
+  model.ifaces[3].name = std::string(200, 'x');
+  model.ifaces[4].name = "uplink";
+  uint32_t now = millis();
+  ParseRun first = parseOnce(interfaceReply(), now);
+  model.advance();
+  ParseRun second = parseOnce(interfaceReply(), now + 1000);
+  CHECK_EQ(first.items, 8);
+  CHECK_EQ(second.items, 8);
+  if (findIface(4)) CHECK_EQ(findIface(4)->rx, model.ifaces[3].rx_bytes);
+
+  // The next poll re-reads the names: interface 4 keeps the last name that
+  // fit, the others pick up renames
+  mock::serial_clear();
+  iface_names_stale = true;
+  host::frames(3);
+  mock::WebResponse r = server.mockRequest(HTTP_GET, "/api/interfaces");
+  DynamicJsonDocument doc(2048);
+  CHECK_EQ(r.code, 200);
+  CHECK(!deserializeJson(doc, r.body.c_str()));
+  JsonArray list = doc["interfaces"];
+  CHECK_EQ(list.size(), 8);
+  int matched = 0;
+  for (JsonObject o : list) {
+    int id = o["id"];
+    if (id == 4) matched += strcmp(o["name"] | "", name.c_str()) == 0;
+    if (id == 5) matched += strcmp(o["name"] | "", "uplink") == 0;
+  }
+  CHECK_EQ(matched, 2);
+  CHECK(mock::serial_log().find("REST reply element over") != std::string::npos);
+  CHECK_EQ(router.stats.desyncs, 0);
+  model.ifaces[3].name = name;
+  model.ifaces[4].name = renamed;
+}
+
+TEST(chunked_reply_parses_like_plain) {
+  router.chunked = true;
+  uint32_t before = findIface(2) ? findIface(2)->samples : 0;
+  host::frames(10);
+  iface_entry_t* iface = findIface(2);
+  CHECK(iface != nullptr);
+  if (iface) CHECK(iface->samples > before + 3);
+  CHECK_EQ(router.stats.desyncs, 0);
+  router.chunked = false;
+}
+
+TEST(unread_body_closes_the_socket) {
+  // A reply larger than one segment, so part of it is still in flight
+  // when the parser stops at the stray byte
+  model.resize(40);
+  host::frames(6);
+  uint32_t dropped = router_stats[ROUTER_EP_INTERFACES].dropped;
+  uint32_t connects = router.stats.connects;
+  router.corrupt_path = "/rest/interface/ethernet/print";
+  router.corrupt_at = 1;
+  host::frames(10);
+  CHECK_EQ(router.stats.desyncs, 0);
+  CHECK(router_stats[ROUTER_EP_INTERFACES].dropped > dropped);
+  CHECK(router.stats.connects > connects);
+
+  // Once the replies are whole again the counters move on
+  router.corrupt_path.clear();
+  uint32_t samples = findIface(2)->samples;
+  host::frames(10);
+  CHECK(findIface(2)->samples > samples);
+  CHECK_EQ(router.stats.desyncs, 0);
+}
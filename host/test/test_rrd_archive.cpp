@@ -0,0 +1,192 @@
+// Traffic archive on the mock LittleFS. Segment files must appear only as
+// flushes reach them and hold the slots the poller closed; changing the
+// graphed interface must keep the previous archive and prune older ones;
+// an archive must not be started when the flash can't hold it, and a
+// failed start is retried once a flush interval.
+#include "sketch.h"
+#include "check.h"
+
+#include <set>
+
+static mock::RouterModel model(6);
+static mock::RestRouter router(model);
+
+// The archive state outlives setup(); each test starts from none. The
+// poller of the previous test runs on until setup() replaces it, so it
+// must not find an interface to archive meanwhile.
+static void resetArchive() {
+  graph_interface_id = 0;
+  rrd_iface_id = 0;
+  rrd_prev_iface_id = 0;
+  rrd_failed_id = 0;
+  rrd_pending_count = 0;
+  rrd_last_samples = 0;
+  memset(rrd_accum, 0, sizeof(rrd_accum));
+}
+
+static void bootArchive(int graph_iface) {
+  model.rate = [](int i, uint64_t, double& rx, double& tx) {
+    rx = 40e6 + i * 1e6;
+    tx = 4e6;
+  };
+  resetArchive();
+  host::BootOptions o;
+  o.graph_iface = graph_iface;
+  host::boot(o);
+}
+
+static bool waitArchive(int id, uint32_t ms = 10000) {
+  for (uint32_t t = 0; t < ms && rrd_iface_id != id; t += 100) mock::run_for(100);
+  return rrd_iface_id == id;
+}
+
+// Segment files of an interface as (tier, segment) pairs, checking each
+// one's size on the way
+static std::set<std::pair<int, uint32_t>> segmentFiles(int id) {
+  std::set<std::pair<int, uint32_t>> out;
+  for (const std::string& path : mock::fs_list()) {
+    int file_id, tier;
+    unsigned seg;
+    char ext;
+    if (sscanf(path.c_str(), "/rrd_%d_%d_%u.bi%c", &file_id, &tier, &seg, &ext) != 4 || file_id != id) continue;
+    std::string bytes;
+    mock::fs_get(path.c_str(), bytes);
+    CHECK_EQ(bytes.size(), rrdSegmentSlots(tier, seg) * sizeof(rrd_slot_t));
+    out.insert({ tier, seg });
+  }
+  return out;
+}
+
+static size_t countOf(const std::string& log, const char* what) {
+  size_t n = 0;
+  for (size_t at = log.find(what); at != std::string::npos; at = log.find(what, at + 1)) n++;
+  return n;
+}
+
+TEST(segments_created_on_first_write) {
+  bootArchive(2);
+  CHECK(waitArchive(2));
+  const uint32_t t0 = routerNow();
+
+  std::string header;
+  CHECK(mock::fs_get("/rrd_2.bin", header));
+  CHECK_EQ(header.size(), sizeof(rrd_header_t));
+  CHECK(header.compare(0, 4, std::string(RRD_MAGIC, 4)) == 0);
+  CHECK(segmentFiles(2).empty());
+
+  mock::run_for(RRD_FLUSH_INTERVAL_MS + 30000);
+  rrdFlush();
+  const uint32_t t1 = routerNow();
+
+  // Only the segments the closed slots fall in exist, never the whole tier
+  std::set<std::pair<int, uint32_t>> files = segmentFiles(2);
+  std::set<std::pair<int, uint32_t>> reached;
+  for (uint32_t t = t0; t < t1; t++) reached.insert({ 0, rrdSlotIndex(0, t) / RRD_SEG_SLOTS });
+  for (uint32_t t = t0 - t0 % 60; t + 60 <= t1; t += 60) reached.insert({ 1, rrdSlotIndex(1, t) / RRD_SEG_SLOTS });
+  CHECK(!files.empty());
+  for (const auto& f : files) CHECK(reached.count(f) == 1);
+  CHECK(files.size() < rrdSegments(0) + rrdSegments(1));
+  CHECK(files.count({ 2, 0 }) == 0 && files.count({ 2, rrdSlotIndex(2, t0) / RRD_SEG_SLOTS }) == 0);
+
+  // The 1 s slots of the last half minute read back with their own time
+  // and the graphed interface's rate (index 1: 41 Mbps RX)
+  int filled = 0;
+  for (uint32_t t = t1 - 30; t < t1 - 2; t++) {
+    rrd_slot_t slot;
+    CHECK_EQ(rrdReadSlots(2, 0, rrdSlotIndex(0, t), &slot, 1), 1);
+    if (slot.t != t) continue;
+    filled++;
+    CHECK(slot.rx_min <= slot.rx_avg && slot.rx_avg <= slot.rx_max);
+    CHECK(slot.rx_avg > 41000 * 9 / 10 && slot.rx_avg < 41000 * 11 / 10);
+  }
+  CHECK(filled >= 20);
+
+  // A slot of a segment never written reads as empty
+  uint32_t missing = 0;
+  while (missing < rrdSegments(2) && files.count({ 2, missing })) missing++;
+  rrd_slot_t slots[4];
+  memset(slots, 0xff, sizeof(slots));
+  CHECK_EQ(rrdReadSlots(2, 2, missing * RRD_SEG_SLOTS, slots, 4), 4);
+  CHECK_EQ(slots[3].t, 0);
+  CHECK_EQ(slots[3].rx_max, 0);
+}
+
+TEST(changing_interface_keeps_previous_and_prunes_older) {
+  bootArchive(0);
+  mock::fs_put("/rrd_7.bin", std::string(sizeof(rrd_header_t), 'x'));
+  mock::fs_put("/rrd_7_0_1.bin", std::string(RRD_SEG_SLOTS * sizeof(rrd_slot_t), '\0'));
+  graph_interface_id = 2;
+  CHECK(waitArchive(2));
+  CHECK(!LittleFS.exists("/rrd_7.bin"));
+  CHECK(!LittleFS.exists("/rrd_7_0_1.bin"));
+  mock::run_for(RRD_FLUSH_INTERVAL_MS + 5000);
+  CHECK(!segmentFiles(2).empty());
+
+  graph_interface_id = 3;
+  CHECK(waitArchive(3));
+  CHECK_EQ(rrd_prev_iface_id, 2);
+  CHECK(LittleFS.exists("/rrd_2.bin"));
+  CHECK(!segmentFiles(2).empty());
+  CHECK(LittleFS.exists("/rrd_3.bin"));
+
+  // Back to 2 reuses its archive as it was
+  graph_interface_id = 2;
+  CHECK(waitArchive(2));
+  CHECK(mock::serial_log().find("✓ Traffic archive /rrd_2.bin") != std::string::npos);
+  CHECK(LittleFS.exists("/rrd_3.bin"));
+
+  // A third interface drops the one graphed two changes ago
+  mock::run_for(RRD_FLUSH_INTERVAL_MS + 5000);
+  graph_interface_id = 4;
+  CHECK(waitArchive(4));
+  CHECK(mock::serial_log().find("Removed stale traffic archive of interface 3") != std::string::npos);
+  CHECK(!LittleFS.exists("/rrd_3.bin"));
+  CHECK(segmentFiles(3).empty());
+  CHECK(LittleFS.exists("/rrd_2.bin"));
+}
+
+TEST(full_flash_is_refused_and_retried) {
+  bootArchive(0);
+  mock::run_for(3000);
+  CHECK_EQ(rrd_iface_id, 0);
+
+  // Leave one block less than the archive and its reserve need
+  const uint32_t need = rrdFlashBytes() + RRD_FS_RESERVE;
+  CHECK(rrdFreeBytes() > need);
+  mock::fs_put("/filler.bin", std::string(rrdFreeBytes() - need + mock::FS_BLOCK, '\0'));
+  CHECK(rrdFreeBytes() < need);
+
+  mock::serial_clear();
+  graph_interface_id = 2;
+  mock::run_for(10000);
+  CHECK_EQ(rrd_iface_id, 0);
+  CHECK_EQ(rrd_failed_id, 2);
+  CHECK(!LittleFS.exists("/rrd_2.bin"));
+  CHECK_EQ(countOf(mock::serial_log(), "ERROR: Not enough flash for /rrd_2.bin"), 1);
+
+  // Once there is room, the next retry starts it
+  LittleFS.remove("/filler.bin");
+  CHECK(waitArchive(2, RRD_FLUSH_INTERVAL_MS + 5000));
+  CHECK_EQ(rrd_failed_id, 0);
+  CHECK(LittleFS.exists("/rrd_2.bin"));
+}
+
+TEST(previous_archive_is_dropped_to_make_room) {
+  bootArchive(2);
+  CHECK(waitArchive(2));
+  mock::run_for(RRD_FLUSH_INTERVAL_MS + 5000);
+  rrdFlush();
+  CHECK(!segmentFiles(2).empty());
+
+  // Short of room by less than archive 2 takes
+  const uint32_t need = rrdFlashBytes() + RRD_FS_RESERVE;
+  mock::fs_put("/filler.bin", std::string(rrdFreeBytes() - need + mock::FS_BLOCK, '\0'));
+  CHECK(rrdFreeBytes() < need);
+
+  graph_interface_id = 3;
+  CHECK(waitArchive(3));
+  CHECK(mock::serial_log().find("Removing traffic archive of interface 2 to make room") != std::string::npos);
+  CHECK(!LittleFS.exists("/rrd_2.bin"));
+  CHECK(segmentFiles(2).empty());
+  CHECK_EQ(rrd_prev_iface_id, 0);
+}
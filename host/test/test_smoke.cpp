@@ -0,0 +1,24 @@
+// Boots the sketch against the fake REST router and checks that a few
+// seconds of frames produce a populated display and API.
+#include "sketch.h"
+#include "check.h"
+
+static mock::RouterModel model(8);
+static mock::RestRouter router(model);
+
+TEST(boots_and_polls) {
+  host::boot();
+  CHECK(!hotspot_mode);
+  host::frames(20);
+  CHECK(router.path_counts["/rest/interface/ethernet/print"] > 3);
+  CHECK(router.path_counts["/rest/system/resource/print"] > 0);
+  CHECK(router.path_counts["/rest/system/clock/print"] > 0);
+  CHECK(mock::tft_stats.panel_pixels > 0);
+  CHECK(strcmp(routerDateStr, "01-Jan-1970") != 0);
+}
+
+TEST(serves_stats) {
+  mock::WebResponse r = server.mockRequest(HTTP_GET, "/api/stats");
+  CHECK_EQ(r.code, 200);
+  CHECK(r.body.find("\"rx") != std::string::npos);
+}
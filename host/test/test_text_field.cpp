@@ -0,0 +1,102 @@
+// Dirty-region text fields against the mock TFT framebuffer: a field drawn
+// through any sequence of strings must look exactly like the last string
+// drawn once on a cleared line, while only the changed glyphs are painted.
+#include "sketch.h"
+#include "check.h"
+
+#include <vector>
+
+static mock::RouterModel model(8);
+static mock::RestRouter router(model);
+
+const int FIELD_X = 10, FIELD_Y = 200, FIELD_W = 338;
+
+static std::vector<uint16_t> region() {
+  mock::HeapPause pause;
+  std::vector<uint16_t> px;
+  int h = tft.fontHeight();
+  for (int y = FIELD_Y; y < FIELD_Y + h; y++) {
+    for (int x = FIELD_X; x < FIELD_X + FIELD_W; x++) px.push_back(mock::panel_pixel(x, y));
+  }
+  return px;
+}
+
+// The same text drawn once on a cleared line
+static std::vector<uint16_t> fresh(const char* text) {
+  text_field_t f = { FIELD_X, FIELD_Y, FIELD_W, TFT_WHITE, false, 0, "" };
+  tft.fillRect(FIELD_X, FIELD_Y, FIELD_W, tft.fontHeight(), TFT_BLACK);
+  drawTextField(f, text);
+  return region();
+}
+
+static uint64_t paint(text_field_t& f, const char* text) {
+  uint64_t before = mock::tft_stats.panel_pixels;
+  drawTextField(f, text);
+  return mock::tft_stats.panel_pixels - before;
+}
+
+TEST(sequence_matches_fresh_draw) {
+  host::boot();
+  host::frames(4);
+  loadDisplayFont(tft, SMALL_FONT);
+  const char* seq[] = {
+    "TX: 12.34 Mbps | RX: 80.12 Mbps",
+    "TX: 12.34 Mbps | RX: 80.19 Mbps",     // one digit
+    "TX: 12.34 Mbps | RX: 180.19 Mbps",    // longer
+    "TX: 2.34 Mbps | RX: 180.19 Mbps",     // shorter in the middle
+    "TX: 2.34 Mbps | RX: 1.01 Mbps",       // shorter at the end
+    "TX: 11.11 Mbps | RX: 11.11 Mbps",     // narrow digits
+    "TX: 88.88 Mbps | RX: 88.88 Mbps",     // wide digits, same length
+    "",
+    "CPU: 7% | RAM: 100/1024 MB | Up: 3d 04:00:00",
+  };
+  text_field_t f = { FIELD_X, FIELD_Y, FIELD_W, TFT_WHITE, false, 0, "" };
+  for (const char* s : seq) {
+    drawTextField(f, s);
+    std::vector<uint16_t> drawn = region();
+    std::vector<uint16_t> want = fresh(s);
+    int differ = 0;
+    for (size_t i = 0; i < drawn.size(); i++) differ += drawn[i] != want[i];
+    CHECK_EQ(differ, 0);
+    // fresh() painted over the field's line; put its last state back
+    tft.fillRect(FIELD_X, FIELD_Y, FIELD_W, tft.fontHeight(), TFT_BLACK);
+    f.drawn = false;
+    drawTextField(f, s);
+  }
+}
+
+TEST(unchanged_text_paints_nothing) {
+  text_field_t f = { FIELD_X, FIELD_Y, FIELD_W, TFT_WHITE, false, 0, "" };
+  const int h = tft.fontHeight();
+  CHECK(paint(f, "CPU: 7% | RAM: 100/1024 MB | Up: 3d 04:00:00") >= (uint64_t)FIELD_W * h);
+  CHECK_EQ(paint(f, "CPU: 7% | RAM: 100/1024 MB | Up: 3d 04:00:00"), 0);
+}
+
+TEST(digit_tick_paints_one_glyph_cell) {
+  text_field_t f = { FIELD_X, FIELD_Y, FIELD_W, TFT_WHITE, false, 0, "" };
+  const int h = tft.fontHeight();
+  paint(f, "CPU: 7% | RAM: 100/1024 MB | Up: 3d 04:00:00");
+  uint64_t px = paint(f, "CPU: 7% | RAM: 100/1024 MB | Up: 3d 04:00:01");
+  CHECK(px > 0);
+  // The cell is cleared and the glyph drawn over it: at most twice the cell
+  CHECK_LE(px, 2 * tft.textWidth("0") * h);
+  // Same-width change in the middle: only that span
+  px = paint(f, "CPU: 9% | RAM: 100/1024 MB | Up: 3d 04:00:01");
+  CHECK_LE(px, 2 * tft.textWidth("9") * h);
+}
+
+TEST(loop_repaints_a_fraction_of_the_lines) {
+  // Steady traffic: the status lines mostly keep their text between frames
+  model.rate = [](int, uint64_t, double& rx, double& tx) {
+    rx = 80e6;
+    tx = 12e6;
+  };
+  host::frames(10);
+  uint64_t before = text_px_painted;
+  const int frames = 40;
+  host::frames(frames);
+  double per_frame = (double)(text_px_painted - before) / frames;
+  double full_lines = 3.0 * FIELD_W * tft.fontHeight();   // time, system and speed lines
+  printf("text: %.0f px per frame, %.0f for full lines\n", per_frame, full_lines);
+  CHECK_LE(per_frame * 5, full_lines);
+}
@@ -0,0 +1,208 @@
+// Usage totals journal. Flushes at a short interval must append records and
+// compact rather than rewrite one file; a record torn by a power cut, a
+// corrupted record and a compaction cut before its rename must all load the
+// latest consistent record, and the next flush must leave a clean journal.
+#include "sketch.h"
+#include "check.h"
+
+static mock::RouterModel model(4);
+static mock::RestRouter router(model);
+
+static const int MAX_RECORDS = TOTALS_JOURNAL_MAX_BYTES / sizeof(totals_record_t);
+
+static std::vector<totals_record_t> readJournal(const char* path) {
+  mock::HeapPause pause;
+  std::vector<totals_record_t> out;
+  std::string bytes;
+  if (!mock::fs_get(path, bytes)) return out;
+  for (size_t pos = 0; pos + sizeof(totals_record_t) <= bytes.size(); pos += sizeof(totals_record_t)) {
+    totals_record_t rec;
+    memcpy(&rec, bytes.data() + pos, sizeof(rec));
+    out.push_back(rec);
+  }
+  return out;
+}
+
+static size_t fileSize(const char* path) {
+  mock::HeapPause pause;
+  std::string bytes;
+  return mock::fs_get(path, bytes) ? bytes.size() : 0;
+}
+
+// Something for the next flush to record
+static void bumpTotals() { usage_totals.period[USAGE_DAY].rx += 1500; }
+
+// What a reboot sees: the in-memory state is gone
+static void reload() {
+  memset(&usage_totals, 0, sizeof(usage_totals));
+  usage_last_rx = 0;
+  usage_last_tx = 0;
+  loadUsageTotals();
+}
+
+TEST(short_flush_interval_appends_and_compacts) {
+  model.rate = [](int, uint64_t, double& rx, double& tx) {
+    rx = 40e6;
+    tx = 4e6;
+  };
+  host::boot();
+  CHECK_EQ(server.mockRequest(HTTP_POST, "/api/totals", "{\"flush_s\":2}").code, 400);
+  CHECK_EQ(server.mockRequest(HTTP_POST, "/api/totals", "{\"flush_s\":5}").code, 200);
+  CHECK_EQ(totals_flush_s, 5u);
+
+  // Forty minutes of traffic: a record every 5 s
+  uint32_t seq_start = totals_seq;
+  unsigned long start = millis();
+  while (millis() - start < 40UL * 60 * 1000) host::frames(1);
+  uint32_t records = totals_seq - seq_start;
+  printf("%u records of %zu bytes, %u compactions, journal %zu bytes\n", records, sizeof(totals_record_t),
+         totals_compactions, fileSize(TOTALS_JOURNAL_PATH));
+  CHECK_NEAR(records, 40 * 60 / 5, 10);
+  CHECK(totals_compactions >= records / MAX_RECORDS - 1);
+  CHECK_LE(fileSize(TOTALS_JOURNAL_PATH), (size_t)TOTALS_JOURNAL_MAX_BYTES);
+
+  // A flush programs one record however long the journal is, where a
+  // whole-file rewrite would program all of it
+  while (totals_records < MAX_RECORDS - 10) {
+    bumpTotals();
+    saveUsageTotals();
+  }
+  mock::FsStats before = mock::fs_stats;
+  for (int i = 0; i < 10; i++) {
+    bumpTotals();
+    saveUsageTotals();
+  }
+  CHECK_EQ(mock::fs_stats.prog_bytes - before.prog_bytes, (uint64_t)10 * sizeof(totals_record_t));
+  CHECK_EQ(mock::fs_stats.commits - before.commits, 10u);
+
+  // Every record on flash is valid and in order; the newest is in memory
+  std::vector<totals_record_t> recs = readJournal(TOTALS_JOURNAL_PATH);
+  CHECK_EQ((int)recs.size(), totals_records);
+  for (size_t i = 0; i < recs.size(); i++) {
+    CHECK(totalsRecordValid(recs[i]));
+    if (i) CHECK_EQ(recs[i].seq, recs[i - 1].seq + 1);
+  }
+  CHECK_EQ(recs.back().seq, totals_seq);
+  CHECK(totals_bad_records == 0);
+}
+
+TEST(torn_append_loads_previous_record) {
+  // No scheduled flushes from here on: every write is the test's
+  CHECK_EQ(server.mockRequest(HTTP_POST, "/api/totals", "{\"flush_s\":3600}").code, 200);
+  bumpTotals();
+  saveUsageTotals();
+  uint32_t good_seq = totals_seq;
+  uint64_t good_rx = usage_totals.period[USAGE_DAY].rx;
+  size_t good_size = fileSize(TOTALS_JOURNAL_PATH);
+
+  // Power fails halfway through the next record
+  bumpTotals();
+  mock::fs_power_cut_after(sizeof(totals_record_t) / 2);
+  saveUsageTotals();
+  mock::fs_power_cut_after(-1);
+  CHECK_EQ(fileSize(TOTALS_JOURNAL_PATH), good_size + sizeof(totals_record_t) / 2);
+
+  uint32_t bad_before = totals_bad_records;
+  reload();
+  CHECK_EQ(totals_seq, good_seq);
+  CHECK_EQ(usage_totals.period[USAGE_DAY].rx, good_rx);
+  CHECK_EQ(totals_bad_records, bad_before + 1);
+  // Appending after the torn tail would be unreadable: the next flush compacts
+  CHECK_EQ(totals_records, MAX_RECORDS);
+  uint32_t compactions = totals_compactions;
+  bumpTotals();
+  saveUsageTotals();
+  CHECK_EQ(totals_compactions, compactions + 1);
+  CHECK_EQ(fileSize(TOTALS_JOURNAL_PATH), sizeof(totals_record_t));
+  CHECK_EQ(fileSize(TOTALS_JOURNAL_NEW_PATH), (size_t)0);
+
+  reload();
+  CHECK_EQ(totals_seq, good_seq + 1);
+  CHECK_EQ(usage_totals.period[USAGE_DAY].rx, good_rx + 1500);
+  CHECK_EQ(totals_bad_records, bad_before + 1);
+  CHECK_EQ(totals_records, 1);
+}
+
+TEST(corrupted_record_is_rejected_by_crc) {
+  for (int i = 0; i < 3; i++) {
+    bumpTotals();
+    saveUsageTotals();
+  }
+  uint32_t last_seq = totals_seq;
+  uint64_t last_rx = usage_totals.period[USAGE_DAY].rx;
+
+  // One flipped bit in the newest record's totals
+  std::string bytes;
+  {
+    mock::HeapPause pause;
+    mock::fs_get(TOTALS_JOURNAL_PATH, bytes);
+    bytes[bytes.size() - sizeof(totals_record_t) + offsetof(totals_record_t, totals)] ^= 0x04;
+    mock::fs_put(TOTALS_JOURNAL_PATH, bytes);
+  }
+  uint32_t bad_before = totals_bad_records;
+  reload();
+  CHECK_EQ(totals_seq, last_seq - 1);
+  CHECK_EQ(usage_totals.period[USAGE_DAY].rx, last_rx - 1500);
+  CHECK_EQ(totals_bad_records, bad_before + 1);
+  CHECK_EQ(totals_records, MAX_RECORDS);
+
+  // The next flush reuses the rejected number in a clean journal
+  bumpTotals();
+  saveUsageTotals();
+  CHECK_EQ(fileSize(TOTALS_JOURNAL_PATH), sizeof(totals_record_t));
+  reload();
+  CHECK_EQ(totals_seq, last_seq);
+  CHECK_EQ(totals_bad_records, bad_before + 1);
+}
+
+TEST(compaction_cut_before_rename) {
+  // Fill the journal so the next flush compacts
+  while (totals_records < MAX_RECORDS) {
+    bumpTotals();
+    saveUsageTotals();
+  }
+  CHECK_EQ(fileSize(TOTALS_JOURNAL_PATH), (size_t)MAX_RECORDS * sizeof(totals_record_t));
+  uint32_t full_seq = totals_seq;
+  uint64_t full_rx = usage_totals.period[USAGE_DAY].rx;
+
+  // Cut while the new file is being written: the full journal still counts
+  uint32_t compactions = totals_compactions;
+  bumpTotals();
+  mock::fs_power_cut_after(sizeof(totals_record_t) - 4);
+  saveUsageTotals();
+  mock::fs_power_cut_after(-1);
+  CHECK_EQ(totals_compactions, compactions);
+  CHECK_EQ(fileSize(TOTALS_JOURNAL_NEW_PATH), sizeof(totals_record_t) - 4);
+  uint32_t bad_before = totals_bad_records;
+  reload();
+  CHECK_EQ(totals_seq, full_seq);
+  CHECK_EQ(usage_totals.period[USAGE_DAY].rx, full_rx);
+  CHECK_EQ(totals_bad_records, bad_before + 1);
+
+  // Cut after the new file was written but before the rename: it wins
+  totals_record_t rec;
+  {
+    uint32_t seq = totals_seq;
+    usage_totals.period[USAGE_DAY].rx += 1500;
+    totals_seq = seq + 1;
+    fillTotalsRecord(rec);
+    totals_seq = seq;
+    mock::HeapPause pause;
+    mock::fs_put(TOTALS_JOURNAL_NEW_PATH, std::string((const char*)&rec, sizeof(rec)));
+  }
+  reload();
+  CHECK_EQ(totals_seq, full_seq + 1);
+  CHECK_EQ(usage_totals.period[USAGE_DAY].rx, full_rx + 1500);
+  CHECK_EQ(totals_bad_records, bad_before + 1);
+
+  // The next flush finishes the compaction
+  bumpTotals();
+  saveUsageTotals();
+  CHECK_EQ(totals_compactions, compactions + 1);
+  CHECK_EQ(fileSize(TOTALS_JOURNAL_NEW_PATH), (size_t)0);
+  std::vector<totals_record_t> recs = readJournal(TOTALS_JOURNAL_PATH);
+  CHECK_EQ(recs.size(), (size_t)1);
+  CHECK_EQ(recs[0].seq, full_seq + 2);
+  reload();
+  CHECK_EQ(usage_totals.period[USAGE_DAY].rx, full_rx + 3000);
+}
@@ -0,0 +1,155 @@
+// Usage accounting fed straight through updateUsage(). Counter resets and
+// 32-bit wraps must count exactly what the router counted; periods must
+// close at the router clock's top of the hour, midnight, Monday and the
+// first of the month, land in the history file and show on /api/usage.
+#include "sketch.h"
+#include "check.h"
+
+static mock::RouterModel model(4);
+static mock::RestRouter router(model);
+
+static uint32_t epochOf(int y, int m, int d, int hh, int mm, int ss) {
+  return (uint32_t)daysFromCivil(y, m, d) * 86400UL + hh * 3600 + mm * 60 + ss;
+}
+
+static std::string periodLabel(int period, uint32_t key) {
+  char buf[24];
+  formatUsagePeriod(period, key, buf, sizeof(buf));
+  return buf;
+}
+
+// Closed period as stored in the history file
+static usage_entry_t archived(int period, uint32_t key) {
+  mock::HeapPause pause;
+  usage_entry_t e;
+  memset(&e, 0, sizeof(e));
+  std::string bytes;
+  if (mock::fs_get(USAGE_PATH, bytes) && usageSlotOffset(period, key) + sizeof(e) <= bytes.size()) {
+    memcpy(&e, bytes.data() + usageSlotOffset(period, key), sizeof(e));
+  }
+  return e;
+}
+
+// With the link down the poller leaves the accounting to the test
+static void startAccounting() {
+  mock::wifi_set_connected(false);
+  host::frames(2);
+  memset(&usage_totals, 0, sizeof(usage_totals));
+  usage_iface = 0;
+  usage_pending_rx = 0;
+  usage_pending_tx = 0;
+}
+
+TEST(resets_and_wraps_count_what_the_router_counted) {
+  host::boot();
+  startAccounting();
+  const uint32_t t = epochOf(2026, 3, 10, 12, 0, 0);
+  const uint32_t resets = usage_counter_resets, wraps = usage_counter_wraps;
+
+  updateUsage(1000, 100, t);           // baseline only
+  CHECK_EQ(usage_totals.period[USAGE_DAY].rx, 0);
+  updateUsage(5000, 600, t + 1);
+  CHECK_EQ(usage_totals.period[USAGE_DAY].rx, 4000);
+  CHECK_EQ(usage_totals.period[USAGE_DAY].tx, 500);
+
+  // reset-counters or a reboot: the new value is all that accrued since
+  updateUsage(300, 50, t + 2);
+  CHECK_EQ(usage_totals.period[USAGE_DAY].rx, 4300);
+  CHECK_EQ(usage_totals.period[USAGE_DAY].tx, 550);
+  CHECK_EQ(usage_counter_resets, resets + 2);
+
+  // A 32-bit counter rolling over the top
+  updateUsage(0xFFFFF000ULL, 1000, t + 3);
+  updateUsage(0x800, 1500, t + 4);
+  CHECK_EQ(usage_totals.period[USAGE_DAY].rx, 4300 + (0xFFFFF000ULL - 300) + 0x1800);
+  CHECK_EQ(usage_totals.period[USAGE_DAY].tx, 2000);
+  CHECK_EQ(usage_counter_wraps, wraps + 1);
+
+  // A 64-bit counter past 32 bits going back is a reset, not a wrap
+  updateUsage(0x100000800ULL, 1500, t + 5);
+  uint64_t rx = usage_totals.period[USAGE_DAY].rx;
+  updateUsage(0x400, 1500, t + 6);
+  CHECK_EQ(usage_totals.period[USAGE_DAY].rx, rx + 0x400);
+  CHECK_EQ(usage_counter_wraps, wraps + 1);
+  CHECK_EQ(usage_counter_resets, resets + 3);
+
+  // Every period got the same bytes; none closed
+  for (int p = 0; p < USAGE_PERIODS; p++) {
+    CHECK_EQ(usage_totals.period[p].rx, usage_totals.period[USAGE_DAY].rx);
+    CHECK_EQ(usage_totals.period[p].key, usagePeriodKey(p, t));
+  }
+
+  // Bytes counted before the router clock is known go to the first period
+  // the clock puts a sample in
+  updateUsage(0x400 + 7000, 1500, 0);
+  CHECK_EQ(usage_pending_rx, 7000);
+  CHECK_EQ(usage_totals.period[USAGE_DAY].rx, rx + 0x400);
+  updateUsage(0x400 + 7500, 1500, t + 8);
+  CHECK_EQ(usage_totals.period[USAGE_DAY].rx, rx + 0x400 + 7500);
+  CHECK_EQ(usage_pending_rx, 0);
+}
+
+TEST(periods_roll_over_on_the_router_clock) {
+  host::boot();
+  startAccounting();
+  uint64_t counter = 1000000;
+  auto poll = [&](uint32_t now, uint64_t bytes) {
+    counter += bytes;
+    updateUsage(counter, counter / 10, now);
+  };
+
+  // Sunday 2026-03-29, last hour of ISO week 13
+  const uint32_t sun = epochOf(2026, 3, 29, 23, 59, 50);
+  poll(sun - 1800, 0);                 // baseline
+  poll(sun - 900, 1000);
+  poll(sun, 2000);
+  const uint32_t hour_key = usagePeriodKey(USAGE_HOUR, sun);
+  CHECK(periodLabel(USAGE_HOUR, hour_key) == "2026-03-29 23:00");
+  CHECK(periodLabel(USAGE_DAY, usagePeriodKey(USAGE_DAY, sun)) == "2026-03-29");
+  CHECK(periodLabel(USAGE_WEEK, usagePeriodKey(USAGE_WEEK, sun)) == "2026-W13");
+  CHECK(periodLabel(USAGE_MONTH, usagePeriodKey(USAGE_MONTH, sun)) == "2026-03");
+  CHECK_EQ(usage_totals.period[USAGE_DAY].rx, 3000);
+
+  // Into Monday: hour, day and week close, the month carries on
+  poll(sun + 20, 500);
+  CHECK_EQ(usage_totals.period[USAGE_HOUR].rx, 500);
+  CHECK_EQ(usage_totals.period[USAGE_DAY].rx, 500);
+  CHECK_EQ(usage_totals.period[USAGE_WEEK].rx, 500);
+  CHECK_EQ(usage_totals.period[USAGE_MONTH].rx, 3500);
+  CHECK(periodLabel(USAGE_WEEK, usage_totals.period[USAGE_WEEK].key) == "2026-W14");
+  usage_entry_t day = archived(USAGE_DAY, usagePeriodKey(USAGE_DAY, sun));
+  CHECK_EQ(day.key, usagePeriodKey(USAGE_DAY, sun));
+  CHECK_EQ(day.rx, 3000);
+  CHECK_EQ(day.tx, 300);
+  CHECK_EQ(archived(USAGE_WEEK, usagePeriodKey(USAGE_WEEK, sun)).rx, 3000);
+  CHECK_EQ(archived(USAGE_HOUR, hour_key).rx, 3000);
+  CHECK_EQ(archived(USAGE_MONTH, usagePeriodKey(USAGE_MONTH, sun)).key, 0);
+
+  // A clock that steps back keeps counting into the current periods
+  poll(sun - 5, 100);
+  CHECK_EQ(usage_totals.period[USAGE_DAY].rx, 600);
+  CHECK(periodLabel(USAGE_DAY, usage_totals.period[USAGE_DAY].key) == "2026-03-30");
+
+  // Tuesday night into April: the month closes, the week doesn't
+  const uint32_t tue = epochOf(2026, 3, 31, 23, 59, 59);
+  poll(tue, 400);
+  poll(tue + 2, 50);
+  CHECK_EQ(usage_totals.period[USAGE_WEEK].rx, 1050);
+  CHECK_EQ(usage_totals.period[USAGE_MONTH].rx, 50);
+  CHECK(periodLabel(USAGE_MONTH, usage_totals.period[USAGE_MONTH].key) == "2026-04");
+  CHECK_EQ(archived(USAGE_MONTH, usagePeriodKey(USAGE_MONTH, tue)).rx, 4000);
+
+  // The closed periods are listed newest first
+  mock::WebResponse res = server.mockRequest(HTTP_GET, "/api/usage");
+  CHECK_EQ(res.code, 200);
+  CHECK(res.body.find("{\"period\":\"2026-03\",\"rx\":4000,\"tx\":400}") != std::string::npos);
+  CHECK(res.body.find("{\"period\":\"2026-W13\",\"rx\":3000,\"tx\":300}") != std::string::npos);
+  size_t d31 = res.body.find("\"2026-03-31\""), d29 = res.body.find("\"2026-03-29\"");
+  CHECK(d31 != std::string::npos && d29 != std::string::npos && d31 < d29);
+
+  // ISO weeks at the turn of the year: 2026 has 53, 2027-01-04 starts W01
+  CHECK(periodLabel(USAGE_WEEK, usagePeriodKey(USAGE_WEEK, epochOf(2026, 12, 28, 0, 0, 0))) == "2026-W53");
+  CHECK(periodLabel(USAGE_WEEK, usagePeriodKey(USAGE_WEEK, epochOf(2027, 1, 3, 23, 59, 59))) == "2026-W53");
+  CHECK(periodLabel(USAGE_WEEK, usagePeriodKey(USAGE_WEEK, epochOf(2027, 1, 4, 0, 0, 0))) == "2027-W01");
+  CHECK(periodLabel(USAGE_WEEK, usagePeriodKey(USAGE_WEEK, epochOf(2025, 12, 29, 0, 0, 0))) == "2026-W01");
+}
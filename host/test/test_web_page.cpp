@@ -0,0 +1,52 @@
+// The web UI from PROGMEM: browsers that take gzip get the pre-compressed
+// page with its ETag, a matching If-None-Match gets a bodyless 304, and
+// clients without gzip get the plain page.
+#include "sketch.h"
+#include "check.h"
+
+static mock::RouterModel model(4);
+static mock::RestRouter router(model);
+
+static std::string header(const mock::WebResponse& r, const char* name) {
+  auto it = r.headers.find(name);
+  return it == r.headers.end() ? std::string() : it->second;
+}
+
+TEST(page_is_served_gzipped_with_etag) {
+  host::boot();
+  CHECK(web_page_gz_current);
+  CHECK(mock::serial_log().find("web_interface_gz.h is stale") == std::string::npos);
+
+  mock::WebResponse r = server.mockRequest(HTTP_GET, "/", "", { { "Accept-Encoding", "gzip, deflate, br" } });
+  CHECK_EQ(r.code, 200);
+  CHECK(header(r, "Content-Encoding") == "gzip");
+  CHECK(header(r, "ETag") == HTML_PAGE_GZ_ETAG);
+  CHECK(header(r, "Cache-Control") == "no-cache");
+  CHECK_EQ(r.body.size(), html_page_gz_len);
+  CHECK(r.body.size() * 3 < strlen(html_page));
+  CHECK(r.body.compare(0, 2, "\x1f\x8b") == 0);
+
+  // A reload revalidates and gets headers only
+  r = server.mockRequest(HTTP_GET, "/", "",
+                         { { "Accept-Encoding", "gzip" }, { "If-None-Match", HTML_PAGE_GZ_ETAG } });
+  CHECK_EQ(r.code, 304);
+  CHECK(r.body.empty());
+  CHECK(header(r, "ETag") == HTML_PAGE_GZ_ETAG);
+
+  // A stale tag gets the page again
+  r = server.mockRequest(HTTP_GET, "/", "", { { "Accept-Encoding", "gzip" }, { "If-None-Match", "\"0\"" } });
+  CHECK_EQ(r.code, 200);
+  CHECK_EQ(r.body.size(), html_page_gz_len);
+}
+
+TEST(clients_without_gzip_get_the_plain_page) {
+  mock::WebResponse r = server.mockRequest(HTTP_GET, "/");
+  CHECK_EQ(r.code, 200);
+  CHECK(header(r, "Content-Encoding").empty());
+  CHECK(r.body == html_page);
+
+  mock::WebResponse m = server.mockRequest(HTTP_GET, "/metrics");
+  CHECK(m.body.find("mtdisplay_web_page_requests_total{result=\"gzip\"} 2") != std::string::npos);
+  CHECK(m.body.find("mtdisplay_web_page_requests_total{result=\"plain\"} 1") != std::string::npos);
+  CHECK(m.body.find("mtdisplay_web_page_requests_total{result=\"not_modified\"} 1") != std::string::npos);
+}
@@ -0,0 +1,53 @@
+#!/usr/bin/env python3
+"""Regenerates web_interface_gz.h from the page in web_interface.h.
+
+Run after every change to web_interface.h:
+
+    python3 tools/gzip_web_interface.py
+
+The page is compressed with a zeroed gzip timestamp, so the output (and the
+ETag derived from it) only changes when the page does.
+"""
+import gzip
+import hashlib
+import os
+import re
+import zlib
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SOURCE = os.path.join(ROOT, "web_interface.h")
+TARGET = os.path.join(ROOT, "web_interface_gz.h")
+
+
+def main():
+    with open(SOURCE, encoding="utf-8") as f:
+        match = re.search(r'R"rawliteral\((.*)\)rawliteral"', f.read(), re.S)
+    if not match:
+        raise SystemExit("html_page raw literal not found in web_interface.h")
+
+    page = match.group(1).encode("utf-8")
+    packed = gzip.compress(page, compresslevel=9, mtime=0)
+    etag = hashlib.sha256(packed).hexdigest()[:16]
+
+    lines = [
+        "// Generated by tools/gzip_web_interface.py from web_interface.h - do not edit",
+        "#ifndef WEB_INTERFACE_GZ_H",
+        "#define WEB_INTERFACE_GZ_H",
+        "",
+        "// %d bytes of HTML, %d bytes gzipped" % (len(page), len(packed)),
+        "#define HTML_PAGE_SOURCE_CRC 0x%08xUL    // CRC-32 of html_page this was made from" % zlib.crc32(page),
+        '#define HTML_PAGE_GZ_ETAG "\\"%s\\""' % etag,
+        "const size_t html_page_gz_len = %d;" % len(packed),
+        "const uint8_t html_page_gz[] PROGMEM = {",
+    ]
+    for i in range(0, len(packed), 16):
+        lines.append("  " + ", ".join("0x%02x" % b for b in packed[i:i + 16]) + ",")
+    lines += ["};", "", "#endif", ""]
+
+    with open(TARGET, "w", encoding="utf-8") as f:
+        f.write("\n".join(lines))
+    print("%s: %d -> %d bytes, ETag %s" % (os.path.basename(TARGET), len(page), len(packed), etag))
+
+
+if __name__ == "__main__":
+    main()
@@ -499,6 +499,7 @@ input[type="range"]::-moz-range-thumb {
         <span class="stat-label">TX Speed</span>
       </div>
     </div>
+    <canvas id="liveGraph" height="90" style="width: 100%; margin-bottom: 20px;"></canvas>
 
     <div class="section-title">Display Settings</div>
     
@@ -555,6 +556,23 @@ input[type="range"]::-moz-range-thumb {
         <input type="password" name="router_pass" id="router_pass" placeholder="Router API password" required>
       </div>
       
+      <div class="form-group">
+        <label>Router Connection</label>
+        <div class="input-group">
+          <div>
+            <select name="transport" id="transport">
+              <option value="rest">REST API (HTTP polling)</option>
+              <option value="api">RouterOS API (port 8728)</option>
+              <option value="api-ssl">RouterOS API-SSL (port 8729)</option>
+            </select>
+          </div>
+          <div>
+            <input type="number" name="api_port" id="api_port" placeholder="API port (default)" min="0" max="65535">
+          </div>
+        </div>
+        <div class="help-text">RouterOS API streams live rates from the router instead of polling. Enable the "api" or "api-ssl" service on the router.</div>
+      </div>
+      
       <div class="form-group">
         <label>Interface to Monitor</label>
         <select name="interface_id" id="interface_id" required>
@@ -586,7 +604,29 @@ input[type="range"]::-moz-range-thumb {
         <div class="help-text">Set the Y-axis range for the traffic graph</div>
       </div>
 
-      <button type="submit" class="btn">💾 Save Graph Settings & Restart</button>
+      <div class="form-group">
+        <label>Time Window</label>
+        <select name="window" id="graph_window">
+          <option value="1m">1 minute</option>
+          <option value="10m">10 minutes</option>
+          <option value="1h">1 hour</option>
+          <option value="24h">24 hours</option>
+          <option value="7d">7 days</option>
+        </select>
+        <div class="help-text">Changing only the window applies without a restart</div>
+      </div>
+
+      <div class="form-group">
+        <label>Screen Layout</label>
+        <select name="layout" id="layout">
+          <option value="single">Single interface graph</option>
+          <option value="multi8">8 interfaces with sparklines</option>
+          <option value="multi16">16 interfaces with sparklines</option>
+        </select>
+        <div class="help-text">Changing the layout restarts the display</div>
+      </div>
+
+      <button type="submit" class="btn">💾 Save Graph Settings</button>
       <div class="alert" id="graphAlert"></div>
     </form>
 
@@ -649,8 +689,7 @@ scanBtn.addEventListener('click', function() {
   this.innerHTML = '<span class="loading"></span> Scanning...';
   this.disabled = true;
   
-  fetch('/api/scan')
-    .then(r => r.json())
+  fetchJob('/api/scan?refresh=1', '/api/scan')
     .then(data => {
       ssidSelect.innerHTML = '<option value="">Select a network</option>';
       
@@ -676,9 +715,19 @@ scanBtn.addEventListener('click', function() {
     });
 });
 
+// Slow endpoints answer 202 while their result is being prepared; ask again
+// at the suggested interval (using retryUrl, if given) until it is ready
+function fetchJob(url, retryUrl, attempts = 20) {
+  return fetch(url).then(r => {
+    if (r.status !== 202) return r.json();
+    if (attempts <= 1) throw new Error('Timed out');
+    return r.json().then(job => new Promise(resolve => setTimeout(resolve, job.retry_ms || 1000)))
+      .then(() => fetchJob(retryUrl || url, retryUrl, attempts - 1));
+  });
+}
+
 function loadInterfaces(selectedInterface) {
-  fetch('/api/interfaces')
-    .then(r => r.json())
+  fetchJob('/api/interfaces')
     .then(data => {
       const ifaceSelect = document.getElementById('interface_id');
       ifaceSelect.innerHTML = '<option value="">Select interface</option>';
@@ -751,6 +800,7 @@ document.getElementById('routerForm').addEventListener('submit', function(e) {
   e.preventDefault();
   const formData = new FormData(e.target);
   const data = Object.fromEntries(formData);
+  data.api_port = parseInt(data.api_port) || 0;
   
   const alertBox = document.getElementById('routerAlert');
   alertBox.textContent = 'Saving router configuration...';
@@ -794,7 +844,7 @@ document.getElementById('graphForm').addEventListener('submit', function(e) {
     return r.json();
   })
   .then(data => {
-    alertBox.textContent = '✓ Graph settings saved! Device restarting...';
+    alertBox.textContent = data.restart ? '✓ Graph settings saved! Device restarting...' : '✓ Graph settings applied';
     alertBox.className = 'alert show';
   })
   .catch(e => {
@@ -815,9 +865,13 @@ fetch('/api/config')
     }
     if (data.router_addr) document.getElementById('router_addr').value = data.router_addr;
     if (data.router_user) document.getElementById('router_user').value = data.router_user;
+    if (data.transport) document.getElementById('transport').value = data.transport;
+    if (data.api_port) document.getElementById('api_port').value = data.api_port;
     loadInterfaces(data.interface_id);
     if (data.max_mbps !== undefined) document.getElementById('max_mbps').value = data.max_mbps;
     if (data.min_mbps !== undefined) document.getElementById('min_mbps').value = data.min_mbps;
+    if (data.graph_window) document.getElementById('graph_window').value = data.graph_window;
+    if (data.layout) document.getElementById('layout').value = data.layout;
     if (data.backlight !== undefined) {
       backlightSlider.value = data.backlight;
       backlightValue.textContent = data.backlight;
@@ -835,8 +889,66 @@ fetch('/api/config')
   })
   .catch(e => console.error('Config load failed:', e));
 
+// Live stats pushed by the device once per poll; plain polling without SSE
+const LIVE_POINTS = 120;
+const liveRx = [], liveTx = [];
+let liveSamples = 0;
+
+function drawLiveGraph() {
+  const canvas = document.getElementById('liveGraph');
+  canvas.width = canvas.clientWidth;
+  const ctx = canvas.getContext('2d');
+  const peak = Math.max(1, ...liveRx, ...liveTx);
+  const step = canvas.width / (LIVE_POINTS - 1);
+  ctx.clearRect(0, 0, canvas.width, canvas.height);
+  [[liveTx, '#3060ff'], [liveRx, '#e0b000']].forEach(([values, color]) => {
+    ctx.strokeStyle = color;
+    ctx.lineWidth = 2;
+    ctx.beginPath();
+    values.forEach((v, i) => {
+      const x = (LIVE_POINTS - values.length + i) * step;
+      const y = canvas.height - 1 - v / peak * (canvas.height - 2);
+      if (i === 0) ctx.moveTo(x, y); else ctx.lineTo(x, y);
+    });
+    ctx.stroke();
+  });
+}
+
+function startLiveStats() {
+  const source = new EventSource('/api/events');
+  source.addEventListener('stats', e => {
+    const d = JSON.parse(e.data);
+    document.getElementById('cpu').textContent = d.cpu + '%';
+    const ramPct = d.ram_total_mb > 0 ? Math.round(d.ram_used_mb * 100 / d.ram_total_mb) : 0;
+    document.getElementById('ram').textContent = d.ram_used_mb + '/' + d.ram_total_mb + ' MB (' + ramPct + '%)';
+    document.getElementById('rx').textContent = (d.rx_kbps / 1024).toFixed(2) + ' Mbps';
+    document.getElementById('tx').textContent = (d.tx_kbps / 1024).toFixed(2) + ' Mbps';
+
+    // Sample numbers restart after a reboot or an interface change
+    if (d.samples < liveSamples) {
+      liveRx.length = 0;
+      liveTx.length = 0;
+      liveSamples = 0;
+    }
+    const first = d.samples - d.rx.length + 1;
+    d.rx.forEach((v, i) => {
+      if (first + i <= liveSamples) return;
+      liveRx.push(v);
+      liveTx.push(d.tx[i]);
+    });
+    liveSamples = d.samples;
+    liveRx.splice(0, Math.max(0, liveRx.length - LIVE_POINTS));
+    liveTx.splice(0, Math.max(0, liveTx.length - LIVE_POINTS));
+    drawLiveGraph();
+  });
+}
+
 updateStats();
-setInterval(updateStats, 5000);
+if (window.EventSource) {
+  startLiveStats();
+} else {
+  setInterval(updateStats, 5000);
+}
 </script>
 </body>
 </html>
@@ -0,0 +1,427 @@
+// Generated by tools/gzip_web_interface.py from web_interface.h - do not edit
+#ifndef WEB_INTERFACE_GZ_H
+#define WEB_INTERFACE_GZ_H
+
+// 26233 bytes of HTML, 6639 bytes gzipped
+#define HTML_PAGE_SOURCE_CRC 0x68b5f4c1UL    // CRC-32 of html_page this was made from
+#define HTML_PAGE_GZ_ETAG "\"bcbe140e539670cc\""
+const size_t html_page_gz_len = 6639;
+const uint8_t html_page_gz[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xe5, 0x3d, 0xdb, 0x8e, 0x23, 0xc7,
+  0x75, 0xef, 0xf3, 0x15, 0x25, 0x2a, 0x12, 0xd9, 0x32, 0xc9, 0x69, 0x5e, 0x67, 0x96, 0x73, 0x71,
+  0xf6, 0x6a, 0x8f, 0xb1, 0x97, 0xc1, 0x72, 0xc6, 0x92, 0xb0, 0x10, 0xd6, 0x45, 0x76, 0x91, 0x6c,
+  0x4d, 0xb3, 0xbb, 0xd3, 0xdd, 0x9c, 0x8b, 0xe4, 0x01, 0xf2, 0x90, 0xc7, 0x00, 0x09, 0xe2, 0x00,
+  0x49, 0x80, 0x00, 0x46, 0xfe, 0x22, 0x4f, 0xf9, 0x18, 0xff, 0x40, 0xfc, 0x09, 0x39, 0xe7, 0x54,
+  0x55, 0x77, 0xf5, 0x85, 0x97, 0xd9, 0x5d, 0x19, 0x8e, 0x6d, 0x59, 0xbb, 0xec, 0xea, 0xaa, 0x53,
+  0xe7, 0x7e, 0xab, 0x22, 0xb5, 0x77, 0xfc, 0xd9, 0xb3, 0x37, 0x4f, 0x2f, 0xbe, 0x3d, 0x7f, 0xce,
+  0x16, 0xc9, 0xd2, 0x3b, 0xdd, 0x3b, 0xd6, 0x7f, 0x09, 0xee, 0xc0, 0x5f, 0x4b, 0x91, 0x70, 0x36,
+  0x5d, 0xf0, 0x28, 0x16, 0xc9, 0x49, 0xed, 0xf2, 0xe2, 0x45, 0xeb, 0xb0, 0xa6, 0x87, 0x7d, 0xbe,
+  0x14, 0x27, 0xb5, 0x6b, 0x57, 0xdc, 0x84, 0x41, 0x94, 0xd4, 0xd8, 0x34, 0xf0, 0x13, 0xe1, 0xc3,
+  0xb4, 0x1b, 0xd7, 0x49, 0x16, 0x27, 0x8e, 0xb8, 0x76, 0xa7, 0xa2, 0x45, 0x0f, 0x4d, 0xe6, 0xfa,
+  0x6e, 0xe2, 0x72, 0xaf, 0x15, 0x4f, 0xb9, 0x27, 0x4e, 0x3a, 0x6d, 0x1b, 0xc1, 0x24, 0x6e, 0xe2,
+  0x89, 0xd3, 0x57, 0xee, 0x55, 0x14, 0x24, 0xee, 0x15, 0x7b, 0xe6, 0xc6, 0xa1, 0xc7, 0xef, 0xd8,
+  0xd3, 0xc0, 0x9f, 0xb9, 0xf3, 0xe3, 0x7d, 0xf9, 0x7a, 0xef, 0x38, 0x4e, 0xee, 0xf0, 0xef, 0x51,
+  0x14, 0x04, 0x09, 0xfb, 0x71, 0x8f, 0xb1, 0x56, 0x2b, 0x8c, 0xdc, 0x25, 0x8f, 0xee, 0x46, 0xec,
+  0xf3, 0xe1, 0xf0, 0x40, 0x08, 0x7e, 0x64, 0x8e, 0xb6, 0x1c, 0x1e, 0x5d, 0xc1, 0xab, 0xc1, 0x60,
+  0x78, 0xe8, 0xf4, 0xe4, 0xab, 0x58, 0x00, 0x7a, 0x8e, 0x5c, 0x72, 0x30, 0xec, 0x4f, 0x78, 0x57,
+  0x8d, 0xaf, 0xa6, 0x53, 0x11, 0xc7, 0x30, 0xda, 0x9f, 0xf2, 0xd9, 0xc0, 0x96, 0xa3, 0x37, 0x3c,
+  0xf2, 0x5d, 0x7f, 0x0e, 0xa3, 0xb3, 0xd9, 0xa3, 0x43, 0x5b, 0x8d, 0x3a, 0xdc, 0x9f, 0x8b, 0x08,
+  0x07, 0xfb, 0xfd, 0x5e, 0x6f, 0xa8, 0x07, 0x69, 0xaf, 0x0e, 0xc7, 0x7f, 0xe4, 0xd0, 0x3c, 0xe2,
+  0x77, 0xad, 0x8e, 0x6d, 0xe3, 0xcc, 0xc3, 0xd9, 0xa3, 0x99, 0x39, 0xdc, 0xa5, 0x61, 0xf1, 0x48,
+  0x4c, 0xc5, 0xcc, 0x18, 0xee, 0xd1, 0xb0, 0x23, 0x44, 0x57, 0x0c, 0x8d, 0xe1, 0x03, 0x1a, 0xee,
+  0x3f, 0x1a, 0xd8, 0x83, 0x03, 0x63, 0xf8, 0x11, 0x0d, 0x77, 0x3b, 0xdd, 0x41, 0xf7, 0x91, 0x1c,
+  0x9e, 0xf2, 0xc8, 0x69, 0x4d, 0x00, 0xe1, 0x68, 0x3e, 0xe1, 0x8d, 0xee, 0x60, 0xd0, 0x64, 0xd9,
+  0x1f, 0x76, 0xfb, 0xd1, 0xc0, 0x92, 0xf3, 0x12, 0x71, 0x9b, 0x18, 0xcc, 0x33, 0x41, 0xd0, 0x2b,
+  0x93, 0x4d, 0xc3, 0xe9, 0xc1, 0xe0, 0xc0, 0x91, 0x2f, 0x5d, 0x3f, 0x5c, 0x25, 0xb4, 0xc1, 0xcd,
+  0xc2, 0x4d, 0x84, 0x39, 0x88, 0xeb, 0x0a, 0xa0, 0xe2, 0x05, 0x77, 0x82, 0x9b, 0x11, 0xb3, 0x59,
+  0xc7, 0x0e, 0x6f, 0x59, 0x1f, 0xff, 0x20, 0xc4, 0xec, 0x26, 0xfd, 0xd3, 0xee, 0x58, 0xe6, 0xc4,
+  0x96, 0x37, 0xc7, 0xb9, 0x5d, 0x9c, 0x36, 0x2c, 0xcd, 0xed, 0xa9, 0xb9, 0x93, 0x20, 0x72, 0x44,
+  0xd4, 0x8a, 0xb8, 0xe3, 0xae, 0x40, 0x5e, 0x9d, 0x6e, 0x78, 0xab, 0x10, 0x8f, 0xb8, 0x1f, 0x83,
+  0x76, 0x05, 0xfe, 0x88, 0x71, 0xcf, 0x03, 0x72, 0x7b, 0x31, 0x9b, 0xae, 0x26, 0xee, 0xb4, 0x35,
+  0x11, 0x3f, 0xb8, 0x22, 0x6a, 0xd8, 0xed, 0x3e, 0x70, 0x01, 0x19, 0xd1, 0x6d, 0x32, 0xdc, 0xfb,
+  0x7e, 0x6f, 0xef, 0x9d, 0xc3, 0x13, 0xde, 0x4a, 0x16, 0x02, 0x95, 0x18, 0x85, 0x58, 0xfb, 0x4e,
+  0xe9, 0x56, 0x9e, 0x97, 0x3d, 0x58, 0xa7, 0xff, 0x5d, 0xcf, 0x48, 0x53, 0xce, 0x25, 0x46, 0x72,
+  0x67, 0x32, 0x98, 0x38, 0x25, 0xdd, 0xe8, 0xf5, 0x7b, 0xbc, 0x6f, 0x97, 0x74, 0xa3, 0x24, 0x6d,
+  0xa9, 0x1b, 0xd5, 0xd2, 0xf8, 0xbc, 0xeb, 0xf4, 0xba, 0xbd, 0xc3, 0x0a, 0x79, 0x98, 0x18, 0x6d,
+  0x95, 0xc7, 0x40, 0xf2, 0xe4, 0x2b, 0xf6, 0x23, 0x83, 0x05, 0x40, 0xd3, 0xdc, 0x05, 0x66, 0xda,
+  0x47, 0xf8, 0x14, 0x72, 0xc7, 0x21, 0x5b, 0x90, 0x8f, 0x93, 0xe0, 0xb6, 0x15, 0xbb, 0x3f, 0xd0,
+  0x88, 0x12, 0x09, 0x0c, 0xc1, 0x2b, 0x58, 0x3f, 0x09, 0x9c, 0x3b, 0x62, 0xe2, 0x0c, 0x5c, 0x41,
+  0x6b, 0xc6, 0x97, 0xae, 0x07, 0xf4, 0xb7, 0x78, 0x18, 0x7a, 0xa2, 0x15, 0xdf, 0xc5, 0x89, 0x58,
+  0x36, 0xd9, 0x13, 0xcf, 0xf5, 0xaf, 0x5e, 0xf1, 0xe9, 0x98, 0x9e, 0x5f, 0xc0, 0xcc, 0x26, 0xab,
+  0x8f, 0xc5, 0x3c, 0x10, 0xec, 0xf2, 0xac, 0xde, 0x64, 0x6f, 0x83, 0x49, 0x90, 0x04, 0x4d, 0xf6,
+  0xe6, 0xf6, 0x6e, 0x2e, 0xfc, 0x26, 0xbb, 0x9c, 0xac, 0xfc, 0x64, 0xd5, 0x64, 0x4f, 0xb9, 0x9f,
+  0xf0, 0x48, 0x78, 0x5e, 0x93, 0xc5, 0x20, 0x70, 0xe0, 0x70, 0xe4, 0x92, 0x09, 0x4d, 0xf8, 0xf4,
+  0x6a, 0x1e, 0x05, 0x2b, 0xdf, 0x19, 0x31, 0x80, 0x2d, 0x78, 0x84, 0x7c, 0x73, 0x5c, 0xf0, 0x45,
+  0x8d, 0x4e, 0x6f, 0xe0, 0x88, 0x79, 0x93, 0x5d, 0xf3, 0xa8, 0x91, 0xfa, 0x07, 0x8b, 0xd9, 0x5f,
+  0xe8, 0xa1, 0x54, 0x4e, 0x16, 0xf0, 0xc6, 0xfe, 0x82, 0xa4, 0xbb, 0x74, 0xfd, 0xd6, 0x42, 0xb8,
+  0xf3, 0x05, 0xf0, 0x11, 0x06, 0xaf, 0x17, 0x47, 0x26, 0x1b, 0x50, 0x4d, 0x71, 0x00, 0xb7, 0xca,
+  0xa6, 0xb5, 0xc9, 0x6c, 0xa7, 0x81, 0x17, 0x80, 0x83, 0x90, 0xa0, 0x4d, 0x15, 0x21, 0xb8, 0xa6,
+  0xa2, 0xaa, 0x29, 0xe9, 0x88, 0x14, 0x40, 0x1b, 0x7d, 0x28, 0x07, 0xc0, 0x11, 0xb1, 0x71, 0xc9,
+  0x6f, 0xa5, 0xff, 0x1c, 0x31, 0x30, 0x79, 0xb9, 0x6d, 0x2a, 0x1c, 0xc6, 0x57, 0x49, 0x20, 0x57,
+  0xa1, 0xb3, 0x56, 0x4b, 0x68, 0x53, 0xee, 0xb9, 0x73, 0x98, 0x32, 0x05, 0x0e, 0x88, 0x28, 0x5b,
+  0x04, 0x82, 0x4a, 0x92, 0x60, 0x39, 0x02, 0x5d, 0x96, 0xb0, 0xb8, 0x0f, 0xc8, 0x49, 0x7c, 0x66,
+  0x00, 0xe1, 0xcc, 0x7f, 0x16, 0xdc, 0xf8, 0xa0, 0xe5, 0xc3, 0x98, 0x09, 0x1e, 0x8b, 0x56, 0xb0,
+  0x4a, 0x72, 0x1b, 0x2c, 0x3a, 0xb4, 0x87, 0xa2, 0x32, 0xf5, 0x04, 0x24, 0x6d, 0xd0, 0x09, 0x01,
+  0x5b, 0x7a, 0x7c, 0x19, 0x36, 0xba, 0xfd, 0xf0, 0xb6, 0xc9, 0x06, 0xd7, 0x37, 0x60, 0x36, 0xc3,
+  0xf0, 0xd6, 0x4a, 0x27, 0xdd, 0x28, 0x76, 0x1d, 0x48, 0x97, 0x5a, 0x40, 0xeb, 0x50, 0x62, 0x25,
+  0xed, 0x27, 0x55, 0x59, 0xb0, 0x73, 0xa9, 0xb6, 0x39, 0x8d, 0xed, 0x5a, 0x39, 0xcc, 0xda, 0xf1,
+  0x6a, 0x42, 0xe1, 0xc2, 0x44, 0x30, 0xf5, 0x85, 0xfa, 0x5f, 0xb0, 0x5f, 0xab, 0x12, 0xe1, 0x0e,
+  0x21, 0xdc, 0x43, 0x84, 0x3b, 0x12, 0x61, 0x84, 0x4d, 0xce, 0xa1, 0x95, 0x04, 0xf3, 0xb9, 0x82,
+  0x1b, 0x06, 0x5a, 0x7c, 0x33, 0xf7, 0x56, 0x90, 0x31, 0x26, 0x41, 0x98, 0xa9, 0x44, 0x24, 0xa9,
+  0xd3, 0x8f, 0x4a, 0x74, 0x03, 0xf5, 0xa8, 0x75, 0x45, 0x3f, 0x17, 0x1c, 0xda, 0xc0, 0xfe, 0xa2,
+  0xa8, 0xcd, 0x52, 0x49, 0x94, 0x3f, 0xb2, 0xb2, 0x35, 0x23, 0xe6, 0x07, 0x3e, 0xb1, 0x7e, 0xba,
+  0x8a, 0x62, 0x24, 0x35, 0x0c, 0x5c, 0x2d, 0x6b, 0x32, 0x50, 0xc5, 0x3d, 0xa5, 0xe3, 0xf4, 0x44,
+  0xeb, 0x1d, 0x19, 0x62, 0x81, 0x00, 0x4f, 0x48, 0x15, 0x40, 0x55, 0x69, 0x81, 0x20, 0x97, 0xb1,
+  0xa9, 0x30, 0xdf, 0xaf, 0xe2, 0xc4, 0x9d, 0xdd, 0xb5, 0x54, 0x4c, 0x37, 0x5f, 0x19, 0xcc, 0x43,
+  0x39, 0xef, 0xa0, 0xd8, 0x8c, 0xfd, 0x00, 0xbe, 0xc9, 0x11, 0xb7, 0x64, 0x4e, 0x76, 0x99, 0xb9,
+  0xa3, 0x45, 0x70, 0xad, 0xf5, 0x17, 0x17, 0xce, 0x82, 0x08, 0xd4, 0x81, 0x52, 0x85, 0x46, 0x07,
+  0x82, 0x05, 0x83, 0xfc, 0x80, 0x27, 0xf0, 0x19, 0x8d, 0x59, 0x5b, 0x0a, 0x70, 0x85, 0x56, 0x6c,
+  0x61, 0x18, 0xbc, 0x75, 0xa2, 0x20, 0x6c, 0xcd, 0x5c, 0x2f, 0x41, 0xce, 0x4d, 0xbc, 0x55, 0xd4,
+  0x40, 0x7d, 0xb2, 0x2a, 0x64, 0x20, 0xd7, 0xe7, 0x06, 0xad, 0x9c, 0xf1, 0xf7, 0x52, 0xd9, 0x55,
+  0x33, 0x19, 0x42, 0x99, 0x55, 0xa1, 0xd9, 0xdd, 0x75, 0x06, 0x77, 0x19, 0x16, 0xcd, 0xcd, 0x98,
+  0x84, 0x38, 0x7b, 0xad, 0x65, 0xe0, 0x08, 0x74, 0xb5, 0xc9, 0x22, 0x23, 0x7c, 0xe4, 0x27, 0x8b,
+  0xd6, 0x74, 0xe1, 0x7a, 0x4e, 0xa3, 0x6b, 0x81, 0xd3, 0xce, 0x96, 0x38, 0x82, 0xc4, 0x0b, 0x21,
+  0x36, 0x3e, 0x62, 0xf7, 0xa5, 0xd9, 0xbd, 0x35, 0xb3, 0xbb, 0x95, 0xb3, 0xfb, 0x6b, 0x66, 0xf7,
+  0x68, 0xf6, 0x5e, 0x3b, 0x06, 0xa9, 0xc4, 0xe0, 0x6c, 0x5d, 0x29, 0x89, 0x54, 0xb9, 0x70, 0x04,
+  0x29, 0xc1, 0xbf, 0xc1, 0x0d, 0x2e, 0x61, 0x34, 0x11, 0xa0, 0x4b, 0xde, 0x6a, 0xe9, 0x03, 0x97,
+  0x23, 0x11, 0x0a, 0x9e, 0x34, 0xd0, 0x7f, 0x01, 0x89, 0xe0, 0xfe, 0xc1, 0xe1, 0x82, 0xab, 0x03,
+  0x2b, 0xb4, 0xd1, 0x0c, 0x3b, 0xb3, 0xc8, 0x22, 0x26, 0xce, 0x39, 0xd8, 0x56, 0x67, 0x60, 0xfa,
+  0xbd, 0x02, 0x47, 0x35, 0x12, 0xad, 0x4a, 0x6d, 0xf8, 0x24, 0xc1, 0xa0, 0xe8, 0xec, 0x4a, 0x71,
+  0x60, 0x47, 0x15, 0xaa, 0x76, 0xcc, 0x5b, 0x2d, 0xa7, 0x64, 0xe0, 0x39, 0x92, 0xab, 0x0d, 0x87,
+  0x3e, 0x22, 0xcb, 0xbf, 0x6d, 0xb4, 0x06, 0xa9, 0xa2, 0xdf, 0x9a, 0x69, 0x00, 0x0c, 0xb3, 0xde,
+  0x40, 0x3b, 0xd5, 0x8e, 0xdd, 0x6d, 0x76, 0xba, 0xc3, 0x66, 0xb7, 0xd7, 0x07, 0x1f, 0xd9, 0xb7,
+  0x8c, 0x5d, 0xae, 0xb9, 0xb7, 0x12, 0x59, 0x4c, 0xcf, 0x39, 0xcd, 0x43, 0x72, 0x9a, 0x6d, 0xf2,
+  0xf3, 0xe8, 0x0a, 0x76, 0xf5, 0xf3, 0x4a, 0xa2, 0xa9, 0xba, 0x4c, 0xbc, 0x60, 0x7a, 0x65, 0xec,
+  0xe9, 0xf1, 0x89, 0xf0, 0x8a, 0x7b, 0x76, 0x3a, 0x72, 0x55, 0x10, 0xf2, 0xa9, 0x9b, 0x90, 0x1a,
+  0x3e, 0x4a, 0xf9, 0x6a, 0x10, 0xbf, 0x0a, 0x43, 0x11, 0x4d, 0xc1, 0x9c, 0x28, 0x46, 0x8b, 0x04,
+  0x98, 0xd6, 0x8a, 0x71, 0x0d, 0xca, 0xac, 0xa3, 0x95, 0xc6, 0xf5, 0x67, 0x41, 0x6b, 0xc2, 0x9d,
+  0xb9, 0xc8, 0x6b, 0xae, 0xeb, 0x53, 0x58, 0x57, 0x18, 0x55, 0x39, 0x17, 0x9d, 0xa9, 0x59, 0xdb,
+  0xe3, 0x7d, 0xaa, 0x2a, 0x87, 0x18, 0xc2, 0x86, 0x95, 0xea, 0xa2, 0xb5, 0xc8, 0xa4, 0xb4, 0x67,
+  0x0c, 0x69, 0x4e, 0x0e, 0x4d, 0x4e, 0x2a, 0x16, 0x12, 0xc3, 0xc4, 0x94, 0x6c, 0xb3, 0x14, 0xfc,
+  0xd6, 0xe0, 0x64, 0x7a, 0x6f, 0x7b, 0xfb, 0x3e, 0xe8, 0xef, 0x74, 0x6a, 0x6e, 0x1b, 0x34, 0xa5,
+  0xb2, 0xec, 0xe4, 0xad, 0x20, 0x35, 0x4f, 0x98, 0x1f, 0x07, 0x1e, 0x38, 0x06, 0x83, 0x6b, 0x3d,
+  0xc5, 0xb5, 0x5d, 0x83, 0x90, 0xb4, 0x7f, 0xbb, 0x92, 0xd4, 0xd1, 0x68, 0x22, 0x40, 0xe0, 0x9a,
+  0x64, 0x15, 0xa5, 0xea, 0x75, 0x23, 0xee, 0xf6, 0xf3, 0x61, 0x57, 0x07, 0xab, 0x87, 0x7b, 0x88,
+  0xb2, 0x7b, 0xa8, 0x8a, 0x1d, 0x5d, 0x8d, 0x27, 0xea, 0x61, 0x0b, 0x77, 0x08, 0x55, 0x12, 0x57,
+  0xed, 0xb8, 0x32, 0x2d, 0x2f, 0x1a, 0xc2, 0x4e, 0x32, 0xac, 0x14, 0x58, 0x31, 0x95, 0x32, 0xb5,
+  0xaa, 0xaf, 0xf6, 0xa5, 0x2a, 0x01, 0x72, 0x68, 0xe1, 0x01, 0x3f, 0x69, 0x7f, 0xc5, 0x2f, 0x74,
+  0x79, 0x39, 0xb5, 0xed, 0x50, 0xea, 0x35, 0x30, 0x05, 0xbc, 0x45, 0xb2, 0x05, 0x96, 0xac, 0xc3,
+  0x62, 0x07, 0xbf, 0x57, 0x36, 0x3c, 0x5d, 0xf4, 0x94, 0x0d, 0x2f, 0xab, 0x7b, 0xac, 0x8c, 0xc2,
+  0xd1, 0x2c, 0x98, 0xae, 0x62, 0x4d, 0xa7, 0x7c, 0x22, 0x6a, 0x21, 0xca, 0xa2, 0xd8, 0xb3, 0x1c,
+  0x4a, 0x21, 0x9d, 0x03, 0x69, 0xb2, 0x3b, 0xef, 0x3a, 0xf1, 0x9f, 0x5e, 0xb5, 0xe3, 0x54, 0x95,
+  0xa5, 0xe2, 0x6c, 0x10, 0x22, 0x31, 0x6b, 0x52, 0x94, 0xdd, 0x89, 0x69, 0xc7, 0xc0, 0x6b, 0x42,
+  0xcf, 0xac, 0x0c, 0x1e, 0x66, 0x42, 0x99, 0xb7, 0x90, 0xb0, 0x68, 0x0f, 0xe9, 0x60, 0x3d, 0xca,
+  0xca, 0x72, 0x6f, 0x33, 0x97, 0x8f, 0x85, 0x90, 0x52, 0x8e, 0xa1, 0x6d, 0x24, 0xe7, 0xa5, 0x30,
+  0x56, 0xa5, 0x91, 0x6b, 0xf9, 0x69, 0xaa, 0xc3, 0x61, 0xd9, 0x26, 0x0d, 0xb5, 0xea, 0x28, 0xb5,
+  0xca, 0x3b, 0xd2, 0x41, 0xa5, 0x23, 0x3d, 0x34, 0xd5, 0xfb, 0x5d, 0x72, 0x17, 0x42, 0x59, 0x1f,
+  0x61, 0xc3, 0x46, 0xd5, 0xf5, 0xda, 0x0d, 0x1c, 0x56, 0x27, 0xdf, 0xdb, 0x7d, 0x43, 0x12, 0xc8,
+  0xfc, 0xbe, 0x89, 0x55, 0x30, 0x2b, 0x6a, 0x3f, 0x65, 0x11, 0xc6, 0x8b, 0x5c, 0x76, 0x51, 0x35,
+  0xae, 0x5c, 0x8a, 0x64, 0x39, 0x86, 0x2c, 0x81, 0x85, 0x30, 0xa5, 0x1d, 0x6b, 0x76, 0xd8, 0xb0,
+  0x82, 0xb8, 0x54, 0x52, 0x6c, 0xa3, 0x72, 0x2f, 0x95, 0x0e, 0xd5, 0x9c, 0x1a, 0x8d, 0x40, 0x8a,
+  0x93, 0x2b, 0x37, 0xd1, 0xdb, 0x24, 0x8b, 0xd5, 0x72, 0x22, 0xfb, 0x22, 0xea, 0x05, 0x14, 0xf3,
+  0xc0, 0x16, 0xee, 0x4f, 0x8d, 0x8d, 0xaa, 0xc6, 0x94, 0xde, 0x74, 0xd7, 0x79, 0xe1, 0xad, 0xc5,
+  0xcf, 0x47, 0xf9, 0xe6, 0x2d, 0x75, 0x51, 0xb1, 0xaa, 0xcc, 0xdb, 0xf1, 0x60, 0xc7, 0x6a, 0x7d,
+  0x67, 0x06, 0x6e, 0xae, 0x6f, 0xba, 0x15, 0x5e, 0x06, 0xb8, 0x24, 0x83, 0x6e, 0x05, 0x7a, 0x07,
+  0x9b, 0x76, 0x5f, 0x06, 0x3f, 0xb4, 0xe8, 0xc9, 0x10, 0xdd, 0x9f, 0xa1, 0x28, 0xf2, 0x55, 0xec,
+  0xc3, 0x44, 0x23, 0xf3, 0x37, 0xf4, 0x92, 0x59, 0x90, 0xdd, 0xb5, 0xf4, 0x80, 0xda, 0x02, 0xff,
+  0xad, 0x70, 0x8d, 0x93, 0xc4, 0xdf, 0x1c, 0x0c, 0x3f, 0x38, 0x7d, 0x78, 0x60, 0x81, 0x51, 0x66,
+  0xce, 0xb6, 0x98, 0x3a, 0x5c, 0x9f, 0xc7, 0x55, 0x30, 0x7f, 0x6b, 0xe8, 0x55, 0xa9, 0x04, 0x75,
+  0x36, 0x74, 0x7a, 0x97, 0x75, 0x3e, 0x22, 0x28, 0x02, 0x13, 0xf7, 0x9a, 0x50, 0x43, 0xad, 0x9e,
+  0x79, 0x28, 0xb5, 0x85, 0xeb, 0x38, 0xc2, 0x4f, 0x39, 0xb9, 0x29, 0x3b, 0xcb, 0x40, 0xf1, 0x09,
+  0x24, 0x12, 0x2b, 0x49, 0x35, 0xed, 0xa6, 0x54, 0xcf, 0x13, 0xb3, 0x24, 0x7d, 0x50, 0xf2, 0xb0,
+  0x4d, 0xcd, 0xb5, 0x77, 0x53, 0xdb, 0x8a, 0xfe, 0x4f, 0x2f, 0x33, 0xed, 0x42, 0xad, 0x04, 0xa5,
+  0x12, 0xca, 0x09, 0xff, 0x2c, 0x99, 0x3f, 0xe1, 0x40, 0x85, 0x7a, 0x53, 0xe1, 0x40, 0x0f, 0x19,
+  0xb9, 0x64, 0xdf, 0x39, 0xa2, 0x15, 0xda, 0x3d, 0xbb, 0xd0, 0xfc, 0x51, 0x03, 0xb9, 0x85, 0x9b,
+  0xea, 0xb7, 0x6e, 0x75, 0xfd, 0x86, 0xe6, 0xd1, 0x5d, 0x53, 0xbf, 0xf5, 0xac, 0x0c, 0x3e, 0x9f,
+  0xa2, 0xac, 0x36, 0x6c, 0x60, 0x67, 0x93, 0xf1, 0x6c, 0xc6, 0xdf, 0xb9, 0x88, 0xfe, 0xdc, 0xb6,
+  0x27, 0x53, 0xa7, 0x4f, 0x1f, 0x1e, 0x0d, 0x0f, 0x0f, 0xab, 0xda, 0x1e, 0x59, 0xee, 0x0e, 0x9e,
+  0x2e, 0x4a, 0x4a, 0xb0, 0x09, 0xf9, 0x83, 0x61, 0xb3, 0x73, 0x30, 0x68, 0x1e, 0x66, 0xe7, 0x02,
+  0x4a, 0xb2, 0x52, 0x0d, 0xfa, 0x85, 0x7c, 0x53, 0x1d, 0xd8, 0xe4, 0xf3, 0x82, 0x4d, 0x39, 0x41,
+  0x5e, 0xa1, 0x75, 0xd1, 0x93, 0x3a, 0x8c, 0x34, 0x86, 0x65, 0xad, 0x19, 0x72, 0xdd, 0x67, 0xbe,
+  0x3c, 0x48, 0xc8, 0x37, 0x42, 0x89, 0x8e, 0x76, 0xbc, 0x08, 0x6e, 0x64, 0xab, 0xbc, 0x90, 0xba,
+  0x33, 0x63, 0x92, 0x88, 0xa2, 0x20, 0xaa, 0x26, 0xb9, 0xdb, 0xef, 0x37, 0x87, 0x07, 0xcd, 0x41,
+  0xbf, 0x8a, 0xe4, 0x7c, 0x22, 0x2a, 0xcf, 0x9c, 0x2c, 0x73, 0x77, 0x75, 0x38, 0xb5, 0x06, 0x34,
+  0xa8, 0x79, 0x67, 0xd0, 0x6d, 0xda, 0xdb, 0x41, 0x2b, 0x38, 0x69, 0x23, 0xd5, 0x0b, 0x29, 0xed,
+  0x2c, 0x15, 0xde, 0xea, 0xa0, 0xa5, 0x5c, 0x93, 0x64, 0xde, 0xac, 0xc8, 0xe5, 0xd4, 0xab, 0x06,
+  0x09, 0x6f, 0xa9, 0xba, 0xcd, 0x2c, 0x86, 0x68, 0x92, 0xee, 0xa5, 0xe9, 0x92, 0x32, 0x37, 0xa8,
+  0xb0, 0x96, 0x32, 0x03, 0x15, 0x70, 0x78, 0xbc, 0x10, 0x15, 0x35, 0x87, 0xde, 0x04, 0x0f, 0x15,
+  0x2a, 0x4b, 0xf9, 0x5d, 0x12, 0xe4, 0xc3, 0x1c, 0x22, 0xaa, 0xf0, 0x79, 0x78, 0xbd, 0xa8, 0x19,
+  0xda, 0xc4, 0x63, 0xc3, 0xe1, 0x2c, 0xdf, 0x23, 0x48, 0xfd, 0x3b, 0xb1, 0xce, 0x01, 0xd6, 0x45,
+  0x4a, 0xdd, 0x76, 0x70, 0xf4, 0x05, 0xaf, 0xbe, 0xbd, 0x7a, 0x2a, 0x25, 0x13, 0x9d, 0xd4, 0x59,
+  0x98, 0x1a, 0xd2, 0x2b, 0x70, 0xf0, 0x43, 0xfd, 0xd1, 0x30, 0x97, 0xae, 0x98, 0x3b, 0xe8, 0x66,
+  0x92, 0x17, 0x70, 0x47, 0x2b, 0xed, 0xda, 0x6e, 0x8b, 0x8e, 0xbd, 0xc3, 0xbc, 0xcf, 0xcc, 0xb7,
+  0x4e, 0x46, 0x54, 0x7e, 0x49, 0x97, 0x50, 0xf2, 0xf0, 0xca, 0xc1, 0xaf, 0x89, 0x0d, 0xa9, 0x4e,
+  0xb5, 0x8a, 0x42, 0x31, 0xad, 0x3f, 0x74, 0x7d, 0xd6, 0x51, 0x86, 0x0f, 0xba, 0x0a, 0xb6, 0x0f,
+  0x88, 0xce, 0xf0, 0x00, 0x5b, 0xe6, 0xcd, 0x7f, 0x7b, 0x25, 0xee, 0x66, 0x11, 0x5f, 0x8a, 0x58,
+  0xce, 0x25, 0x6e, 0x05, 0xe0, 0x0f, 0x0c, 0x96, 0xa9, 0x86, 0x75, 0x6f, 0x68, 0x53, 0xc7, 0x9a,
+  0xdd, 0x17, 0x16, 0x1a, 0xc7, 0x2d, 0x64, 0x6e, 0x51, 0xb0, 0xa4, 0x0f, 0x66, 0x7f, 0xeb, 0x88,
+  0x9e, 0xd7, 0xc9, 0x41, 0x77, 0xb0, 0xef, 0xd5, 0xee, 0xf9, 0xc5, 0x9d, 0x4d, 0x8b, 0x6d, 0xb5,
+  0xb0, 0x0a, 0xa5, 0xcb, 0xf0, 0xc3, 0x10, 0xfa, 0xf4, 0xf8, 0x68, 0x2f, 0xfc, 0x01, 0xe8, 0x7c,
+  0xf3, 0x31, 0xfc, 0xf9, 0x26, 0x87, 0xcf, 0x52, 0x38, 0x2e, 0x67, 0x0d, 0xe3, 0x24, 0xee, 0x60,
+  0x08, 0x96, 0x69, 0x49, 0xef, 0xab, 0xcf, 0x3b, 0x4d, 0xdf, 0xa1, 0x1c, 0x18, 0xee, 0x0b, 0xff,
+  0xcf, 0xce, 0x29, 0x2a, 0x5a, 0xc7, 0x7a, 0x4e, 0xa1, 0x8f, 0xbe, 0xad, 0x71, 0xde, 0x95, 0x3d,
+  0x72, 0x13, 0x42, 0xe9, 0xa8, 0x2a, 0xeb, 0x82, 0xa9, 0xd0, 0x98, 0x99, 0x53, 0x36, 0x22, 0x53,
+  0xbc, 0xf4, 0x51, 0x1d, 0x5f, 0xe9, 0x01, 0x0d, 0xbb, 0x98, 0x6b, 0x6f, 0x4a, 0xae, 0x35, 0xe3,
+  0x8e, 0xf7, 0xd5, 0xa5, 0x8d, 0xe3, 0x7d, 0x75, 0x93, 0x04, 0x79, 0x85, 0x7f, 0xad, 0x20, 0x35,
+  0xf0, 0xb1, 0x83, 0x1c, 0xc7, 0x27, 0x35, 0x13, 0xed, 0x1a, 0x73, 0x1d, 0x35, 0x72, 0xa1, 0x06,
+  0x78, 0xe4, 0x72, 0xd9, 0x0d, 0x3e, 0xa9, 0xc9, 0x31, 0x46, 0xef, 0x6b, 0xa7, 0x7f, 0xfc, 0xfd,
+  0x3f, 0xfe, 0xc7, 0xf1, 0xbe, 0x04, 0x76, 0xba, 0xb7, 0x77, 0xec, 0xb8, 0xd7, 0x1a, 0x66, 0xda,
+  0x28, 0xa9, 0x9d, 0x02, 0x32, 0xe6, 0x1b, 0x79, 0x56, 0x48, 0xc3, 0xf0, 0x62, 0xd1, 0x41, 0x28,
+  0xff, 0xcc, 0x8a, 0xd7, 0x4f, 0x00, 0xe3, 0x8e, 0x9a, 0x62, 0xac, 0xd5, 0xe7, 0x8b, 0xb5, 0xd3,
+  0xd7, 0x22, 0xb9, 0x09, 0xa2, 0x2b, 0xf6, 0x2a, 0x00, 0x8f, 0x10, 0x44, 0xe8, 0xd4, 0x9e, 0x41,
+  0x70, 0x9a, 0x04, 0x20, 0xe8, 0xe3, 0x7d, 0x58, 0x42, 0xdb, 0xca, 0x0f, 0x05, 0x04, 0x50, 0x17,
+  0x6a, 0x06, 0x6c, 0x24, 0x58, 0x5e, 0x93, 0x39, 0xf3, 0x67, 0x41, 0x8d, 0x11, 0xcf, 0x80, 0x07,
+  0xe5, 0x1e, 0x4b, 0x65, 0x17, 0x51, 0x81, 0x02, 0x60, 0x71, 0xc8, 0x53, 0x9e, 0x66, 0xad, 0x6d,
+  0xc9, 0x51, 0x37, 0x7c, 0xec, 0x38, 0x11, 0xa4, 0x4c, 0xb5, 0xd3, 0xb3, 0xf3, 0x11, 0x7b, 0x29,
+  0x1d, 0x71, 0xbb, 0xdd, 0x06, 0x19, 0xc1, 0x32, 0x85, 0x4e, 0x8a, 0x6f, 0x81, 0xec, 0x54, 0x33,
+  0x25, 0x30, 0x7a, 0xce, 0xf6, 0x2d, 0xcc, 0x6c, 0x19, 0x04, 0x96, 0xf0, 0xca, 0x8e, 0x13, 0x24,
+  0xa8, 0x69, 0xb8, 0xaa, 0x9d, 0xb6, 0x5a, 0x26, 0x16, 0xd5, 0x6b, 0x48, 0x01, 0x6a, 0xa7, 0x4f,
+  0xcf, 0x2f, 0x09, 0xf9, 0xfc, 0x82, 0x94, 0xe3, 0x1f, 0x8d, 0x0f, 0x78, 0x9d, 0x07, 0xe1, 0xf3,
+  0xf6, 0xf1, 0x2b, 0x76, 0x19, 0x8b, 0x9f, 0x0e, 0x9f, 0xdb, 0x87, 0xa1, 0xf3, 0x0d, 0x1b, 0x87,
+  0xe2, 0xa7, 0x43, 0x27, 0x79, 0x18, 0x3a, 0x17, 0xdb, 0xd0, 0x31, 0x3f, 0x42, 0xdd, 0x71, 0xcd,
+  0x63, 0xda, 0xc6, 0x83, 0x72, 0xe5, 0x17, 0x11, 0x0f, 0x17, 0x35, 0xe5, 0xaf, 0x4e, 0x6a, 0x8f,
+  0xec, 0xd4, 0x32, 0xcc, 0xe2, 0x7c, 0x8d, 0x49, 0x1c, 0xef, 0x4b, 0x68, 0x55, 0xca, 0x6c, 0x1e,
+  0x20, 0xd4, 0x4e, 0xf5, 0x75, 0xb3, 0xb1, 0x48, 0x12, 0xb0, 0x88, 0xd8, 0xc0, 0xa8, 0xb4, 0x34,
+  0xeb, 0xe9, 0x67, 0xca, 0x4f, 0x94, 0x9e, 0x3e, 0x81, 0xf4, 0xd0, 0xa3, 0x92, 0xf0, 0x09, 0xf9,
+  0x4f, 0x1f, 0x2c, 0xed, 0x78, 0x5f, 0xbe, 0xab, 0xe2, 0x7b, 0xa1, 0x9b, 0x6b, 0xb2, 0x5f, 0xb6,
+  0x65, 0xcd, 0x8e, 0x4e, 0x61, 0x15, 0x4d, 0x90, 0xe2, 0x98, 0xe8, 0x6d, 0xc7, 0xf4, 0xaa, 0x86,
+  0xbd, 0xda, 0x93, 0x1a, 0x70, 0x0a, 0x22, 0xd5, 0x49, 0x0d, 0x18, 0x54, 0x63, 0x24, 0x3c, 0xf9,
+  0xd9, 0xd8, 0xa4, 0x8c, 0x8b, 0x14, 0xf2, 0xa9, 0x14, 0x65, 0x0e, 0xf6, 0xaf, 0xe5, 0x1b, 0x80,
+  0xa0, 0xc4, 0xf8, 0x45, 0x5e, 0x9f, 0xd6, 0x29, 0x57, 0x5a, 0x4b, 0xd4, 0x4e, 0x1f, 0x3b, 0x78,
+  0x95, 0x80, 0xc5, 0xd3, 0x48, 0x08, 0x9f, 0x4d, 0x52, 0x16, 0xb1, 0x86, 0xdd, 0xa2, 0x16, 0x48,
+  0x95, 0x4a, 0xec, 0xe6, 0x3d, 0xab, 0xa5, 0xfa, 0xb5, 0xfb, 0xc2, 0xad, 0x12, 0xe9, 0x31, 0x8a,
+  0x90, 0xc8, 0xbb, 0x71, 0x67, 0xee, 0x0b, 0x78, 0xc8, 0x24, 0xa9, 0x82, 0x92, 0xe4, 0xbc, 0x7c,
+  0x48, 0x59, 0x8f, 0x7d, 0x21, 0x5d, 0x1c, 0x2b, 0x1f, 0x08, 0x9f, 0x9e, 0x24, 0xbe, 0xc1, 0xd4,
+  0x3f, 0xfe, 0xfe, 0x77, 0xff, 0xc5, 0xc6, 0x58, 0x3d, 0xd3, 0xee, 0x2a, 0x42, 0xc4, 0x29, 0x9b,
+  0x74, 0x9c, 0x92, 0xcf, 0x15, 0x0c, 0xab, 0x50, 0xaf, 0x54, 0xc1, 0x4c, 0x90, 0x05, 0xc5, 0x42,
+  0xfb, 0x93, 0x87, 0x0d, 0xf2, 0x2e, 0x66, 0x1c, 0xa7, 0x7e, 0x9a, 0x3e, 0x45, 0xe2, 0xef, 0x56,
+  0x6e, 0x24, 0x9c, 0x6c, 0x3e, 0xac, 0x50, 0xe7, 0x12, 0x4a, 0x3b, 0xc0, 0xaf, 0x7a, 0xee, 0xf4,
+  0x8a, 0xd5, 0xcb, 0xe8, 0xd7, 0xd9, 0xcc, 0x8d, 0xe2, 0xe4, 0x78, 0x5f, 0xae, 0x30, 0x36, 0xdd,
+  0x97, 0xbb, 0x56, 0xea, 0xc1, 0x87, 0x50, 0x77, 0x0e, 0xd3, 0x60, 0x4b, 0xa7, 0x4c, 0x9e, 0x69,
+  0x12, 0xa1, 0x9a, 0x55, 0x53, 0xd4, 0x66, 0xcf, 0x48, 0x71, 0xf6, 0x04, 0x46, 0x3d, 0x15, 0x8b,
+  0xc0, 0x03, 0xdd, 0x3e, 0xa9, 0x3d, 0xc7, 0xf0, 0x29, 0xe9, 0xca, 0x66, 0x14, 0xf9, 0x62, 0x46,
+  0xbf, 0xa2, 0x3a, 0x40, 0xe0, 0x5f, 0xba, 0x89, 0xa9, 0x0e, 0x98, 0x7d, 0xfc, 0xcb, 0xff, 0xb0,
+  0x31, 0xbf, 0x16, 0x12, 0xf0, 0x97, 0xec, 0xad, 0x00, 0xdf, 0x17, 0x25, 0x45, 0x49, 0x9b, 0x4c,
+  0xa0, 0xda, 0xbd, 0x96, 0x2a, 0xe0, 0x63, 0x7a, 0x3c, 0xcd, 0x69, 0x3f, 0xf2, 0xe9, 0x63, 0xd5,
+  0xff, 0x2d, 0x94, 0x2b, 0x40, 0xf0, 0x46, 0x03, 0x88, 0x68, 0x4e, 0xde, 0x04, 0x76, 0x14, 0x97,
+  0x02, 0xaf, 0x32, 0x8a, 0xcd, 0xf2, 0x22, 0x07, 0xa0, 0x64, 0x25, 0xb7, 0x7c, 0x0f, 0x09, 0x70,
+  0x54, 0x33, 0x70, 0x50, 0x03, 0x39, 0x89, 0x2d, 0x92, 0x24, 0x1c, 0xed, 0xef, 0x77, 0x1e, 0x75,
+  0xdb, 0x9d, 0xe1, 0x61, 0xbb, 0xd3, 0xee, 0x54, 0x29, 0xf2, 0x1a, 0x77, 0xf3, 0x62, 0xe5, 0x79,
+  0xec, 0xf2, 0xed, 0x4b, 0xa8, 0xd8, 0xa6, 0xde, 0x8a, 0x2a, 0x4e, 0x05, 0x6f, 0xbd, 0xe7, 0xfa,
+  0x40, 0x16, 0x9c, 0x9f, 0xb1, 0xc7, 0xd3, 0x69, 0xb0, 0xf2, 0x13, 0x4c, 0x03, 0x22, 0xa4, 0xf3,
+  0xc1, 0xfc, 0x58, 0xc5, 0x22, 0xcf, 0x0f, 0x39, 0x90, 0xe3, 0x07, 0x6c, 0x74, 0x49, 0xa3, 0x6b,
+  0xb4, 0xf6, 0x53, 0x11, 0xf1, 0x61, 0x46, 0xa8, 0xf0, 0xc6, 0xe1, 0x1c, 0x21, 0x72, 0x20, 0x47,
+  0x88, 0xb1, 0xe7, 0x56, 0x53, 0xfc, 0x18, 0xa2, 0x9e, 0x06, 0xbe, 0x2f, 0x8d, 0xa2, 0x4c, 0x8a,
+  0x01, 0xc9, 0x28, 0x6b, 0x6a, 0x39, 0x07, 0x69, 0x20, 0x50, 0xe5, 0x64, 0xa9, 0x50, 0x94, 0x37,
+  0xde, 0x29, 0x2f, 0x4a, 0x1f, 0xf3, 0x8b, 0x4a, 0x9e, 0x16, 0x0c, 0x06, 0xe6, 0xbc, 0x7d, 0x3e,
+  0xbe, 0x20, 0x16, 0x34, 0x7e, 0x79, 0x71, 0x71, 0xce, 0xc2, 0xc0, 0xf3, 0xb0, 0x65, 0x54, 0x76,
+  0xb2, 0x95, 0x30, 0x78, 0xe8, 0x6a, 0x13, 0x7f, 0x33, 0x96, 0x60, 0x70, 0x6b, 0x76, 0x78, 0xd0,
+  0x3d, 0x7c, 0x00, 0x8c, 0x56, 0x1c, 0x7b, 0x79, 0x38, 0xad, 0xf1, 0xf8, 0x65, 0x06, 0xeb, 0xd1,
+  0x1a, 0x58, 0x45, 0xc7, 0x5f, 0x12, 0xd8, 0x1a, 0xfe, 0x99, 0x0a, 0xe4, 0xaf, 0x96, 0x13, 0xd4,
+  0x66, 0xc9, 0x4c, 0x40, 0xe6, 0x7d, 0xc6, 0xcb, 0xec, 0xa9, 0x68, 0x01, 0x8c, 0x50, 0x6b, 0x38,
+  0x62, 0xc6, 0x57, 0x5e, 0x62, 0x15, 0xd2, 0x9d, 0xe1, 0x60, 0xd0, 0x1b, 0xd4, 0x36, 0x60, 0x55,
+  0x7c, 0xac, 0x76, 0x1e, 0x39, 0xc6, 0xc6, 0x49, 0x24, 0xf8, 0x32, 0x66, 0x98, 0x90, 0xb2, 0x08,
+  0xea, 0xdc, 0x58, 0x76, 0x21, 0xa0, 0x00, 0x65, 0x52, 0xc7, 0xc1, 0xc7, 0xc4, 0x09, 0x94, 0x94,
+  0x2c, 0x98, 0x69, 0x39, 0xb6, 0xd9, 0x73, 0x9f, 0x4f, 0x64, 0x99, 0xca, 0x48, 0x5a, 0x2c, 0x88,
+  0x58, 0xca, 0x72, 0x06, 0x76, 0x8c, 0xd5, 0x1e, 0xc3, 0xe8, 0x92, 0xc2, 0x69, 0x7f, 0x32, 0xd7,
+  0x74, 0x86, 0xc1, 0x6e, 0x06, 0x9c, 0xc3, 0x8e, 0x87, 0xaa, 0x4f, 0xb7, 0xa4, 0x0c, 0xae, 0x5e,
+  0xf2, 0x5e, 0xa7, 0x0e, 0xf9, 0x91, 0x9d, 0x52, 0x08, 0x55, 0x53, 0xb2, 0x74, 0x69, 0x4c, 0xe5,
+  0xe5, 0xb6, 0xbc, 0x61, 0xad, 0x20, 0xc6, 0x12, 0x43, 0x64, 0x91, 0xaf, 0xaa, 0x6d, 0xd7, 0x24,
+  0x6d, 0xa9, 0x49, 0x2b, 0xf3, 0xed, 0x03, 0x62, 0x78, 0x21, 0x64, 0x3e, 0x38, 0x9c, 0x4b, 0x29,
+  0xfe, 0x54, 0x01, 0x9d, 0x8a, 0xa1, 0xcd, 0xf1, 0x7c, 0x8e, 0x53, 0x3e, 0x28, 0x9c, 0x2b, 0xe0,
+  0x58, 0xa8, 0xb1, 0xb7, 0x58, 0x71, 0x7c, 0x2a, 0x8f, 0x29, 0x2f, 0x37, 0xa9, 0xaa, 0xad, 0x78,
+  0x98, 0x90, 0xef, 0x69, 0xfb, 0x80, 0x1f, 0xf7, 0xa0, 0x72, 0x7b, 0xe5, 0xfa, 0xee, 0x72, 0xb5,
+  0x64, 0x8d, 0x57, 0x93, 0x30, 0xb6, 0x4a, 0x98, 0x6c, 0xf1, 0x24, 0xe0, 0x10, 0xde, 0x2f, 0x61,
+  0xa1, 0x94, 0x49, 0xf6, 0xa4, 0x94, 0xd4, 0x2e, 0x57, 0x48, 0x58, 0x23, 0x55, 0xaa, 0xf7, 0x0e,
+  0x1e, 0xed, 0x83, 0xe8, 0xe3, 0xb7, 0x1f, 0x43, 0x1f, 0xbf, 0x35, 0xe9, 0x4b, 0x9f, 0x14, 0x7d,
+  0xfd, 0x43, 0x4d, 0x61, 0xe7, 0xc1, 0x14, 0xee, 0xe6, 0x1d, 0x41, 0x05, 0xc9, 0x22, 0xbf, 0x6d,
+  0x01, 0x1d, 0x31, 0xa3, 0x02, 0x15, 0x28, 0x8d, 0x68, 0x10, 0xa2, 0xe0, 0x6c, 0xe6, 0x4e, 0x19,
+  0xa9, 0xe2, 0x26, 0xbb, 0xdc, 0x51, 0x31, 0x2f, 0xdc, 0x25, 0x26, 0xd7, 0xbe, 0x13, 0xdc, 0x6c,
+  0x71, 0x60, 0x37, 0x34, 0xa9, 0x96, 0x19, 0xc2, 0x7b, 0x35, 0xb2, 0xc1, 0x63, 0x75, 0xc0, 0x52,
+  0x3a, 0xc8, 0x2d, 0x30, 0xdc, 0xaa, 0x48, 0x57, 0x9c, 0x6e, 0xe3, 0x7c, 0x5b, 0x2d, 0x88, 0x77,
+  0x59, 0xb1, 0xc0, 0x0d, 0x16, 0xc1, 0x2a, 0xda, 0x61, 0x72, 0xb7, 0x0f, 0xb3, 0xbb, 0x7d, 0x9a,
+  0xbe, 0x0b, 0xf0, 0x03, 0xf0, 0x1a, 0x07, 0xcc, 0xe1, 0x77, 0xf1, 0x47, 0xb8, 0xd8, 0xa7, 0x0b,
+  0x90, 0x1f, 0xfa, 0xec, 0xc0, 0xf7, 0xee, 0x48, 0x84, 0x92, 0x6d, 0x78, 0x97, 0xc7, 0x73, 0x21,
+  0xd8, 0xdd, 0xb8, 0xc9, 0x02, 0x8f, 0x3e, 0x38, 0x8b, 0xb4, 0x37, 0xfc, 0x68, 0xa9, 0x8e, 0x65,
+  0x17, 0xe0, 0x25, 0xbf, 0x03, 0xc8, 0x5b, 0xe4, 0xea, 0xd1, 0x24, 0x29, 0x57, 0xf5, 0x79, 0x03,
+  0x4f, 0x62, 0x20, 0x05, 0xbd, 0xe5, 0x98, 0xfe, 0x36, 0xa2, 0x85, 0x52, 0xc8, 0xad, 0x4c, 0x5d,
+  0x42, 0x5a, 0xe1, 0x1e, 0xd6, 0x4e, 0x0f, 0x8d, 0x20, 0x46, 0x3c, 0x60, 0x71, 0xc8, 0xa3, 0x2b,
+  0x3c, 0xa7, 0x8a, 0x77, 0x05, 0xd3, 0x19, 0x82, 0xf4, 0x87, 0x0f, 0x02, 0xf4, 0x70, 0xb9, 0xa1,
+  0xc8, 0x24, 0x5f, 0xb4, 0x80, 0x62, 0x1a, 0x73, 0x74, 0x17, 0xfb, 0x93, 0xc4, 0xc6, 0x62, 0xf4,
+  0xd9, 0x29, 0x20, 0x12, 0xcf, 0xd7, 0xc7, 0xc3, 0x52, 0xc4, 0x33, 0x0e, 0x89, 0xab, 0x5b, 0xcb,
+  0xf9, 0x88, 0xf8, 0xc2, 0x8d, 0x96, 0x37, 0x3c, 0x12, 0xec, 0x32, 0x74, 0x38, 0x1a, 0xb0, 0x49,
+  0x29, 0x67, 0x8b, 0x48, 0xcc, 0x4e, 0x6a, 0xfb, 0x2b, 0x7a, 0x59, 0x33, 0xf7, 0xc0, 0x13, 0xce,
+  0x1a, 0x03, 0x56, 0xcd, 0xf1, 0xcb, 0xac, 0xef, 0x27, 0x1e, 0x87, 0xe7, 0x42, 0x2f, 0x13, 0x68,
+  0xff, 0xd7, 0x7f, 0xa8, 0xec, 0x72, 0x9e, 0xbe, 0x09, 0x41, 0x77, 0xdf, 0x5c, 0x3c, 0x56, 0xfb,
+  0xb2, 0x73, 0x48, 0x49, 0xb9, 0x57, 0x6c, 0x70, 0xf2, 0xcd, 0x0d, 0x31, 0x1d, 0x33, 0x4a, 0x97,
+  0x6c, 0x6a, 0xa7, 0x97, 0x21, 0x1e, 0x92, 0x42, 0xc6, 0x73, 0x83, 0x8d, 0x17, 0x49, 0xe2, 0x0d,
+  0xb8, 0x6e, 0x0f, 0x2a, 0x6d, 0xb0, 0x51, 0x6d, 0x90, 0x97, 0xe3, 0x27, 0x6c, 0x8a, 0x49, 0xe6,
+  0x86, 0xce, 0x99, 0x16, 0xf8, 0x71, 0x3c, 0x8d, 0xdc, 0x10, 0xb4, 0x6a, 0x1a, 0x40, 0xae, 0xca,
+  0x8c, 0xc3, 0x15, 0x76, 0xc2, 0x9c, 0x60, 0xba, 0x5a, 0x0a, 0x3f, 0x69, 0x03, 0x3b, 0x9e, 0x7b,
+  0x02, 0x3f, 0x3e, 0xb9, 0x3b, 0x73, 0x1a, 0x75, 0x63, 0x5a, 0xdd, 0x3a, 0x52, 0x6b, 0xf1, 0x7b,
+  0xc1, 0xe6, 0x22, 0xfd, 0x41, 0xad, 0xd4, 0xd3, 0x0a, 0x7d, 0xc9, 0x4d, 0xdb, 0x14, 0xa6, 0x66,
+  0x5b, 0xe5, 0xfb, 0x8f, 0x3b, 0x81, 0xa0, 0x99, 0x19, 0x04, 0xd5, 0xa2, 0xdb, 0xb4, 0x54, 0x4d,
+  0x31, 0xd6, 0xc4, 0xae, 0xa3, 0x12, 0xcf, 0x4d, 0xcb, 0x60, 0x16, 0xae, 0xd9, 0xf3, 0x20, 0x1c,
+  0x4e, 0x57, 0x51, 0x04, 0x6f, 0x2e, 0x90, 0x5f, 0xb0, 0xc8, 0x0b, 0xa6, 0xdc, 0x1b, 0x43, 0x62,
+  0xca, 0xe7, 0x02, 0x17, 0x9e, 0x25, 0x62, 0xa9, 0xb8, 0x59, 0xb7, 0xd8, 0x6f, 0x7f, 0xcb, 0xea,
+  0x84, 0x6b, 0xfd, 0x68, 0x0f, 0x99, 0xd9, 0x8e, 0x45, 0xf2, 0x38, 0x49, 0x22, 0x17, 0x6c, 0x4a,
+  0x34, 0xea, 0xd9, 0xd7, 0x51, 0xeb, 0xcd, 0x1c, 0x60, 0xd8, 0xcc, 0x10, 0x48, 0x1b, 0xb5, 0xe8,
+  0xa9, 0xbc, 0x51, 0x05, 0x5b, 0xe6, 0x31, 0x38, 0x39, 0x61, 0x75, 0xfc, 0x2a, 0x6b, 0x9d, 0xfd,
+  0x9c, 0xd5, 0xff, 0xf0, 0xef, 0x7f, 0xff, 0xbf, 0xff, 0xfd, 0x4f, 0x75, 0x36, 0x62, 0x75, 0x3c,
+  0x2d, 0x83, 0x5d, 0x73, 0x70, 0xb8, 0xe3, 0x3c, 0xbf, 0x86, 0xa5, 0x2f, 0x5d, 0x28, 0x62, 0x7c,
+  0x11, 0x35, 0xea, 0x53, 0x6c, 0x04, 0xc2, 0xe6, 0x0d, 0x8b, 0x9d, 0x9c, 0xca, 0x9b, 0x5b, 0x79,
+  0xfa, 0xca, 0x9b, 0x49, 0x7a, 0x70, 0x37, 0xb9, 0xed, 0x28, 0x23, 0x91, 0xb1, 0x07, 0x12, 0xc9,
+  0xf2, 0xfc, 0x8b, 0xf3, 0xfc, 0xab, 0x98, 0xfe, 0x89, 0xb8, 0x42, 0x55, 0xd6, 0x4c, 0x24, 0xd3,
+  0x45, 0xa3, 0xbe, 0x0f, 0x95, 0xda, 0xbe, 0xde, 0x50, 0x9e, 0x75, 0x2e, 0x05, 0x98, 0x9d, 0x03,
+  0xd3, 0xcf, 0xdf, 0x8c, 0x2f, 0xea, 0x4d, 0x75, 0x92, 0x8a, 0x07, 0x89, 0xf1, 0x88, 0xfd, 0x58,
+  0x57, 0x9b, 0xb6, 0x2e, 0xc0, 0x99, 0xd6, 0x61, 0x16, 0x85, 0xcf, 0x29, 0x5d, 0x25, 0xd8, 0xff,
+  0x3e, 0x0e, 0xfc, 0xfa, 0xbd, 0x5c, 0x82, 0xc7, 0x9f, 0x23, 0xf6, 0xab, 0xf1, 0x9b, 0xd7, 0x6d,
+  0xa8, 0x2c, 0xc1, 0x99, 0xba, 0xb3, 0xbb, 0xc6, 0x8f, 0xb4, 0xd5, 0x28, 0x87, 0xef, 0xbd, 0x85,
+  0x47, 0xa8, 0x56, 0x1b, 0x60, 0x00, 0x46, 0x02, 0x45, 0x81, 0xfa, 0x19, 0x00, 0x91, 0x74, 0xa3,
+  0xa8, 0x51, 0x97, 0x64, 0xc5, 0xe8, 0x9e, 0x67, 0xdc, 0xf5, 0x84, 0x33, 0x02, 0x64, 0x05, 0x5e,
+  0xb6, 0xbc, 0x47, 0xc5, 0x9c, 0xad, 0x7c, 0x79, 0xdf, 0x46, 0x7a, 0x40, 0x69, 0x5c, 0x4f, 0xd2,
+  0x4b, 0x2c, 0x0d, 0xd9, 0xf5, 0x6f, 0xca, 0x88, 0x65, 0xe9, 0x1b, 0x7a, 0x60, 0x00, 0xea, 0x4a,
+  0x31, 0xf0, 0x4f, 0xde, 0x00, 0x07, 0x85, 0x95, 0x73, 0xdb, 0xf4, 0x8c, 0x9c, 0x52, 0xcf, 0xe4,
+  0xc3, 0x50, 0x42, 0xe7, 0x51, 0x00, 0xab, 0x92, 0xbb, 0x46, 0xbd, 0x78, 0x31, 0x19, 0x50, 0xd2,
+  0xf0, 0x7e, 0xc6, 0xea, 0x5f, 0xd4, 0xe5, 0x35, 0x90, 0x82, 0xc9, 0x57, 0x28, 0x21, 0x25, 0xc0,
+  0xb0, 0x58, 0x53, 0xd1, 0xb0, 0xd2, 0x7b, 0x4e, 0x99, 0xa1, 0x17, 0xc4, 0x9d, 0x2c, 0xdc, 0x38,
+  0xc3, 0x71, 0x0d, 0xd9, 0x38, 0xc9, 0xaa, 0x90, 0x76, 0x0a, 0xf9, 0x4f, 0x23, 0xf1, 0xec, 0x04,
+  0x64, 0xc4, 0x42, 0xfc, 0x59, 0x85, 0x33, 0xbc, 0x5a, 0x9e, 0x12, 0x60, 0x6d, 0x17, 0x7f, 0x76,
+  0xe0, 0x24, 0x29, 0xad, 0x54, 0x82, 0x35, 0x4c, 0x28, 0xf0, 0x1f, 0x67, 0x2a, 0x3f, 0xb8, 0xc1,
+  0x1f, 0x14, 0x44, 0x21, 0x95, 0x25, 0x00, 0x3a, 0x5c, 0x9f, 0x7b, 0x17, 0x78, 0x63, 0x4c, 0x89,
+  0xc0, 0xf5, 0x61, 0xdd, 0x2f, 0x2f, 0x5e, 0xbd, 0x94, 0xd6, 0x69, 0x8e, 0xc0, 0x94, 0x7a, 0xee,
+  0xac, 0x50, 0xdd, 0x07, 0xc2, 0x04, 0x81, 0xe2, 0x27, 0x1d, 0x9f, 0xf8, 0xf2, 0x60, 0xba, 0x9e,
+  0xae, 0x87, 0x64, 0x06, 0x23, 0x9d, 0x83, 0x3b, 0x44, 0x52, 0xbc, 0x5a, 0x7c, 0xbf, 0x0a, 0x26,
+  0x4a, 0x82, 0x48, 0xc1, 0xcf, 0x21, 0xe8, 0x43, 0x1a, 0xb4, 0x38, 0xe9, 0x00, 0xc2, 0xd9, 0x70,
+  0xdd, 0x22, 0x51, 0xe0, 0xf5, 0x08, 0xbf, 0x81, 0xce, 0x47, 0x7b, 0x36, 0xfc, 0x5f, 0xe6, 0xf0,
+  0x0b, 0x78, 0x16, 0xdb, 0x1b, 0x2a, 0x2a, 0x70, 0xdd, 0x8c, 0x48, 0xd3, 0xb7, 0xfa, 0x51, 0xbe,
+  0x4f, 0xe3, 0xce, 0x18, 0xed, 0xd2, 0x56, 0x13, 0x63, 0xf6, 0xe5, 0x97, 0x2c, 0x37, 0xd0, 0xf6,
+  0x84, 0x3f, 0x87, 0x5c, 0xf0, 0x94, 0xd9, 0x56, 0x8a, 0x08, 0x2b, 0xcc, 0x81, 0x34, 0xe9, 0x39,
+  0x07, 0xe9, 0xc3, 0x80, 0x89, 0x2f, 0xfe, 0x4f, 0x31, 0x5f, 0x22, 0x68, 0x84, 0x29, 0x48, 0xac,
+  0x41, 0xde, 0x2a, 0x52, 0x35, 0xea, 0x72, 0x42, 0xdd, 0x3a, 0x32, 0x96, 0xca, 0x31, 0xa9, 0x66,
+  0xb0, 0x14, 0x80, 0xb7, 0x91, 0x03, 0x15, 0x53, 0x4c, 0x6e, 0xfc, 0xe6, 0x6f, 0x7e, 0xd4, 0x33,
+  0xef, 0x59, 0x43, 0x3d, 0x24, 0x11, 0x51, 0x71, 0xcf, 0xe4, 0x73, 0x04, 0x6f, 0xef, 0x9d, 0x27,
+  0x4b, 0xeb, 0x37, 0x26, 0x30, 0x83, 0xbd, 0xf8, 0xfd, 0x00, 0xdf, 0x79, 0x4a, 0xdf, 0x29, 0x95,
+  0x7b, 0x18, 0x98, 0xdd, 0xa7, 0x9f, 0xef, 0x99, 0xf0, 0x62, 0x61, 0xd0, 0xbb, 0xb3, 0x84, 0x5e,
+  0x07, 0x2c, 0x65, 0xf9, 0x0c, 0x35, 0xbd, 0x2c, 0xa2, 0xfb, 0xbc, 0xa8, 0x4a, 0xea, 0x69, 0x2a,
+  0xf4, 0x91, 0x39, 0xc9, 0xd0, 0xc1, 0x19, 0xf7, 0xe4, 0xf7, 0x0a, 0x11, 0x6b, 0xa9, 0x59, 0x86,
+  0x9d, 0x6a, 0xbc, 0x0b, 0xf6, 0x4a, 0x47, 0x44, 0x74, 0xb5, 0xd6, 0x34, 0xd4, 0xa3, 0x4f, 0x84,
+  0x07, 0x5e, 0x6c, 0x04, 0x0f, 0x5c, 0xde, 0xa6, 0xcd, 0xce, 0x3d, 0xbc, 0xc2, 0x06, 0x86, 0x73,
+  0xc7, 0xf8, 0x9c, 0xbb, 0x7e, 0x5b, 0xeb, 0xc3, 0xbd, 0xf6, 0x12, 0xfb, 0xfb, 0x6c, 0xec, 0x41,
+  0xcd, 0x07, 0xc2, 0xa1, 0x0b, 0xe2, 0x31, 0xe3, 0x7e, 0x7c, 0x03, 0x59, 0x5b, 0xd7, 0xee, 0xe2,
+  0xdd, 0x38, 0xd9, 0xc8, 0x74, 0x23, 0xac, 0x30, 0xa0, 0xb0, 0x61, 0x50, 0xf6, 0x4f, 0x04, 0x16,
+  0x1f, 0x61, 0x24, 0xc0, 0x79, 0x09, 0xe7, 0x88, 0xf1, 0xf8, 0x4a, 0x42, 0x47, 0x60, 0x5c, 0x76,
+  0x08, 0xe2, 0xd5, 0x7c, 0x0e, 0x25, 0x09, 0xa0, 0x4a, 0x25, 0x10, 0x48, 0x89, 0x35, 0x56, 0x58,
+  0xa1, 0x01, 0x1c, 0xc0, 0xe6, 0x32, 0xf2, 0x9a, 0x68, 0x2a, 0x73, 0x17, 0xfc, 0x8d, 0xc5, 0x56,
+  0x7e, 0xe2, 0x7a, 0xcc, 0x25, 0xe8, 0xa0, 0xc5, 0xce, 0x5d, 0x16, 0xc1, 0x52, 0x43, 0x5f, 0xe1,
+  0x92, 0x6c, 0x31, 0x4f, 0xf0, 0xf2, 0x11, 0xa0, 0x7b, 0x02, 0x98, 0x4a, 0x3b, 0x82, 0x97, 0xab,
+  0x48, 0xad, 0xc0, 0xe9, 0x96, 0xb4, 0xf9, 0x28, 0x13, 0x0c, 0x1a, 0x67, 0x44, 0x57, 0xad, 0x56,
+  0x31, 0xfb, 0xec, 0x04, 0x97, 0x76, 0x2d, 0xbd, 0x2e, 0x6a, 0xa3, 0xeb, 0x6e, 0x28, 0x06, 0xe1,
+  0xd4, 0x74, 0x8f, 0xe3, 0x13, 0xd6, 0xb1, 0x80, 0xae, 0x08, 0x18, 0x85, 0xb9, 0xf9, 0x73, 0x15,
+  0x85, 0xdd, 0x25, 0x10, 0x08, 0x09, 0xb9, 0xe6, 0x6a, 0x01, 0x92, 0xdc, 0xff, 0xfb, 0x60, 0x82,
+  0x18, 0xe0, 0x3a, 0x88, 0x95, 0x4b, 0x37, 0x16, 0x0d, 0xe0, 0x65, 0xe0, 0x5d, 0x93, 0xc6, 0x40,
+  0x04, 0x45, 0x30, 0x00, 0x44, 0x8f, 0x36, 0x19, 0xac, 0x68, 0x13, 0xa5, 0xef, 0x97, 0x31, 0x86,
+  0x60, 0x6c, 0xe3, 0x58, 0x96, 0xa5, 0x84, 0x2d, 0xa1, 0xca, 0x0c, 0x2d, 0xe5, 0x8e, 0x66, 0x0c,
+  0x4e, 0x5f, 0xc7, 0xa9, 0x16, 0x10, 0x21, 0x6f, 0x8c, 0xc9, 0x48, 0x9c, 0xf2, 0x18, 0x1d, 0x71,
+  0xda, 0x37, 0x8e, 0x1b, 0xb2, 0x0c, 0x15, 0xd9, 0x90, 0x64, 0x6f, 0xc1, 0xe5, 0x66, 0xa5, 0xed,
+  0x46, 0x0f, 0x2b, 0xbd, 0x95, 0x8b, 0x13, 0xb7, 0x67, 0xd6, 0x66, 0xdf, 0x39, 0xf3, 0x5c, 0xc6,
+  0xe2, 0xdd, 0xbc, 0x74, 0x0a, 0x66, 0xbb, 0x97, 0x36, 0x0a, 0x74, 0xed, 0xa7, 0x8d, 0x0e, 0xf6,
+  0x06, 0x4f, 0x6d, 0xcc, 0xd2, 0xbe, 0x9a, 0xf0, 0xfc, 0xe9, 0xbc, 0x35, 0x81, 0x6f, 0x57, 0x7a,
+  0xeb, 0x7c, 0x2e, 0x04, 0xfe, 0x5a, 0xce, 0xc5, 0x2e, 0x0a, 0x78, 0xec, 0xb3, 0x67, 0x23, 0xa6,
+  0x87, 0xc0, 0x85, 0xe7, 0x5d, 0x34, 0x72, 0xa2, 0x24, 0x70, 0xe4, 0x85, 0x9e, 0x0f, 0xc9, 0x33,
+  0x5b, 0xa3, 0x11, 0x25, 0x3c, 0xf4, 0x3c, 0x23, 0x56, 0xa7, 0x2e, 0x3e, 0xb7, 0x67, 0x26, 0xd0,
+  0x5d, 0xe3, 0xc2, 0x3a, 0x8f, 0x5b, 0xf0, 0xb4, 0x19, 0x09, 0x54, 0x48, 0x17, 0xf3, 0xa2, 0x72,
+  0x6a, 0x8c, 0x97, 0xd9, 0x1a, 0x86, 0x82, 0xeb, 0x84, 0x02, 0xc7, 0x73, 0x8a, 0x4d, 0x6e, 0x44,
+  0x5b, 0xf6, 0x26, 0x8d, 0x5f, 0xab, 0xdd, 0xd3, 0x70, 0x55, 0xb7, 0x0a, 0xb2, 0x22, 0x5d, 0x82,
+  0x17, 0x32, 0x43, 0x3e, 0xda, 0x06, 0x22, 0xe2, 0xcb, 0x6a, 0x10, 0xf0, 0x62, 0xfb, 0xe2, 0xdb,
+  0x35, 0x6b, 0x6f, 0x71, 0x77, 0x86, 0x2d, 0xe9, 0xed, 0x18, 0x24, 0x6b, 0x80, 0x24, 0x15, 0x40,
+  0x4a, 0xc6, 0x16, 0xe6, 0xcc, 0x68, 0xad, 0x17, 0xd0, 0xb7, 0x15, 0x4b, 0x3b, 0xd5, 0xf1, 0xf6,
+  0x62, 0x1d, 0x36, 0x52, 0xe0, 0xb6, 0x6a, 0xc7, 0x9a, 0x78, 0x4c, 0x52, 0x97, 0xf2, 0xae, 0x8c,
+  0xc8, 0xef, 0x48, 0x56, 0x90, 0x45, 0x22, 0xbf, 0xf1, 0xaf, 0x5b, 0xfc, 0x13, 0x48, 0xff, 0x2e,
+  0x33, 0x76, 0x27, 0x6f, 0xe9, 0xeb, 0xa8, 0x71, 0x9d, 0x12, 0x11, 0xaf, 0xf7, 0x1f, 0x67, 0x29,
+  0x89, 0x19, 0x8f, 0xf7, 0xf6, 0xd6, 0xf2, 0x44, 0x5f, 0x58, 0x02, 0x96, 0x94, 0xb3, 0x74, 0xd9,
+  0xbf, 0x33, 0xd3, 0x74, 0x65, 0xa0, 0xa2, 0x0d, 0x51, 0x1a, 0xe7, 0x3e, 0x93, 0x87, 0xa6, 0x0d,
+  0xf5, 0x6d, 0x04, 0x74, 0x49, 0xd8, 0x88, 0x7b, 0x46, 0xaa, 0x4b, 0xa1, 0xe9, 0x85, 0x7a, 0x6c,
+  0x40, 0x65, 0x45, 0xdd, 0x31, 0x63, 0xaa, 0xd4, 0x70, 0xf6, 0x66, 0xf2, 0x3d, 0x5a, 0x2c, 0x1e,
+  0x81, 0x3e, 0xf7, 0xa1, 0x9c, 0x81, 0x50, 0xa1, 0x81, 0xe8, 0xaa, 0x4a, 0xce, 0xa7, 0x74, 0xe4,
+  0x49, 0x70, 0xbb, 0xc9, 0xd5, 0xa7, 0x17, 0x60, 0xa4, 0xcf, 0xd3, 0x4b, 0x8a, 0xbc, 0x1a, 0xf3,
+  0x6b, 0x4c, 0x1a, 0x28, 0xb3, 0x99, 0xd2, 0x6f, 0xc2, 0xad, 0xe4, 0x77, 0x26, 0x74, 0x8d, 0x90,
+  0x2e, 0xa4, 0xa2, 0xe2, 0x35, 0xa7, 0x2e, 0x45, 0x5d, 0x7e, 0xd7, 0x08, 0xbf, 0xa3, 0x53, 0xac,
+  0xee, 0xb1, 0x66, 0x6e, 0xe1, 0xe6, 0x7f, 0x92, 0x5a, 0x0f, 0x39, 0x27, 0xab, 0xb9, 0xbd, 0x9c,
+  0x1f, 0xc9, 0xd2, 0x91, 0xcf, 0xa2, 0x76, 0x70, 0x55, 0x91, 0x5b, 0x8c, 0xb3, 0xda, 0x7e, 0x4d,
+  0x76, 0x71, 0x94, 0x87, 0x9b, 0x77, 0x43, 0xeb, 0xf8, 0xf9, 0x87, 0xff, 0xfc, 0x5d, 0x05, 0x33,
+  0xa9, 0x93, 0xe0, 0x7c, 0xc6, 0x9e, 0xd1, 0x45, 0x64, 0xdd, 0x4c, 0x36, 0x2a, 0xb1, 0x1d, 0xf9,
+  0x2c, 0xd1, 0x29, 0xd9, 0xdf, 0x7a, 0x64, 0xfe, 0x4d, 0x92, 0x2b, 0x8d, 0x5a, 0xb4, 0x97, 0x60,
+  0xf4, 0x7c, 0x2e, 0x76, 0xdb, 0x91, 0x91, 0x31, 0xd7, 0xd3, 0x84, 0x06, 0xb3, 0xd9, 0xf5, 0xbe,
+  0x2f, 0xbd, 0xef, 0xf4, 0xe7, 0x6c, 0x41, 0xe4, 0xd6, 0xf4, 0x0d, 0x08, 0x98, 0x9f, 0x76, 0x07,
+  0x72, 0x2f, 0xa8, 0x8f, 0x68, 0x3f, 0xd8, 0xe2, 0x8c, 0x33, 0xea, 0x9d, 0x6c, 0x4e, 0xdd, 0x70,
+  0xf8, 0x74, 0x56, 0x27, 0x01, 0xfe, 0xf5, 0xda, 0xdd, 0xdb, 0x0a, 0x86, 0xfe, 0xe5, 0x5b, 0x5e,
+  0x7a, 0x33, 0xe1, 0x2f, 0x26, 0x74, 0x65, 0x67, 0x5b, 0x3b, 0xd9, 0x11, 0x4d, 0xc7, 0x3a, 0x8f,
+  0xce, 0xcf, 0x3e, 0xca, 0x82, 0x08, 0xd4, 0x5f, 0xa5, 0x01, 0xc9, 0x44, 0x55, 0x5a, 0x07, 0xf5,
+  0xf0, 0xc1, 0x9e, 0x7e, 0x91, 0x63, 0xec, 0x46, 0x4b, 0xc2, 0x5e, 0x7f, 0xc5, 0x12, 0x79, 0xd0,
+  0xed, 0xfc, 0xbf, 0x32, 0x34, 0xb3, 0x4a, 0x91, 0xae, 0xa4, 0x5e, 0x90, 0x91, 0x59, 0xa4, 0x54,
+  0xb1, 0x38, 0xcd, 0xc7, 0xb1, 0xb7, 0x66, 0x15, 0x2a, 0xf5, 0x07, 0x57, 0xaa, 0x85, 0x2a, 0x35,
+  0x05, 0x5c, 0x78, 0x5f, 0x21, 0x4e, 0x9c, 0x45, 0x45, 0x43, 0x43, 0x1d, 0x7e, 0x58, 0xf5, 0xc2,
+  0xa2, 0x35, 0xf5, 0xe4, 0x2e, 0x6d, 0xc5, 0xfb, 0x3c, 0xa9, 0xc6, 0x5d, 0x63, 0x6b, 0x5b, 0x88,
+  0xa4, 0x59, 0xe0, 0xad, 0x72, 0x24, 0x19, 0xaf, 0x8e, 0x2a, 0x41, 0xe3, 0xb5, 0xdd, 0xed, 0xa0,
+  0x71, 0xd6, 0x1a, 0xd0, 0xf8, 0xaa, 0x00, 0x3a, 0xbd, 0x58, 0xba, 0x01, 0x70, 0x3a, 0xa7, 0x08,
+  0x36, 0x7d, 0x51, 0x00, 0x9a, 0xa5, 0x11, 0x6b, 0x61, 0xea, 0x29, 0x45, 0x90, 0x7a, 0x5c, 0x42,
+  0x2c, 0xb4, 0x8d, 0xf2, 0x6d, 0x91, 0xf7, 0xa0, 0x5a, 0x85, 0x8d, 0xf5, 0x85, 0x25, 0xea, 0xbc,
+  0xad, 0x7c, 0x47, 0xcc, 0x5c, 0x5f, 0x38, 0x1b, 0xd0, 0xd0, 0x0b, 0x8a, 0x68, 0xe8, 0xf1, 0x22,
+  0x7c, 0x75, 0xe1, 0x6b, 0x77, 0xf8, 0x6a, 0x41, 0x09, 0xbe, 0x1a, 0x2f, 0xc0, 0x37, 0xaf, 0x16,
+  0x59, 0x5b, 0xc2, 0x83, 0x9a, 0x56, 0x84, 0x6c, 0xbe, 0x2b, 0x40, 0x97, 0x17, 0x39, 0x36, 0xc0,
+  0x95, 0x13, 0x8a, 0x10, 0xe5, 0x68, 0x01, 0x56, 0x7a, 0xc6, 0x53, 0x64, 0x85, 0xb6, 0xf5, 0xe2,
+  0x21, 0x5c, 0x0e, 0x64, 0xfa, 0xf2, 0xa8, 0x38, 0xbb, 0xea, 0xe4, 0xad, 0x7a, 0xc9, 0xce, 0x87,
+  0x4f, 0x15, 0xb6, 0x4a, 0x27, 0xa2, 0x86, 0x5f, 0xca, 0x9f, 0x40, 0x67, 0x53, 0xf4, 0x5e, 0x0f,
+  0x3e, 0x64, 0x96, 0xca, 0xfb, 0xa0, 0x83, 0x66, 0xd9, 0x82, 0xff, 0x44, 0x87, 0xcd, 0x25, 0x8a,
+  0xcd, 0xc6, 0xc8, 0x27, 0x6b, 0x8b, 0xdc, 0x57, 0x45, 0xab, 0x42, 0x23, 0x44, 0xfe, 0xcc, 0x7a,
+  0x65, 0xaf, 0x0c, 0x9b, 0xf9, 0x2f, 0xf1, 0xe2, 0x33, 0xb5, 0xc2, 0x58, 0xb8, 0xa2, 0x1f, 0x5f,
+  0x98, 0xc8, 0x8b, 0x62, 0xf2, 0x1b, 0xab, 0x2c, 0xf0, 0xe1, 0x8f, 0x10, 0x72, 0x5a, 0xbc, 0xfb,
+  0x7c, 0x84, 0x37, 0xb6, 0x5d, 0x5f, 0xdf, 0x83, 0x4e, 0x2f, 0xab, 0x8c, 0xc7, 0xcf, 0xd5, 0xf5,
+  0x8a, 0x97, 0x67, 0xbf, 0x7e, 0xfe, 0xfe, 0xfc, 0xcd, 0xd9, 0xeb, 0x8b, 0x31, 0x60, 0xdd, 0xe9,
+  0xda, 0xfa, 0xde, 0x05, 0x5e, 0xb0, 0x7e, 0x8b, 0x39, 0xd7, 0xbb, 0xef, 0x9a, 0xf4, 0x70, 0x21,
+  0x1f, 0x8e, 0xe8, 0x8a, 0x05, 0x0e, 0x8c, 0xf9, 0x32, 0xf4, 0x04, 0x76, 0xfb, 0x6d, 0xf3, 0x7c,
+  0xdb, 0x89, 0xf8, 0xcd, 0x4b, 0xfd, 0x75, 0xc1, 0xdc, 0xe1, 0xa4, 0xfa, 0x3e, 0xe1, 0x86, 0x34,
+  0x2e, 0xfd, 0x9a, 0xa1, 0x8c, 0x65, 0x72, 0x41, 0x5b, 0xfe, 0xce, 0xcb, 0x89, 0x7e, 0x9c, 0x7a,
+  0xf8, 0x23, 0x0f, 0x5f, 0xe3, 0x60, 0x96, 0x54, 0x4e, 0x93, 0xdb, 0x6c, 0x06, 0x80, 0x25, 0x49,
+  0xdc, 0x42, 0x6c, 0xec, 0xaa, 0x94, 0x47, 0x1f, 0xa6, 0xf3, 0x2b, 0x98, 0xf7, 0x8a, 0x27, 0x8b,
+  0x36, 0xfd, 0xb6, 0x69, 0x93, 0x41, 0x2e, 0x22, 0x69, 0x4d, 0x3f, 0x5e, 0xdc, 0x1a, 0x2b, 0x20,
+  0x2b, 0x0e, 0x33, 0xc8, 0x12, 0x95, 0x7d, 0xd6, 0x30, 0xf9, 0xd6, 0x62, 0xf2, 0x27, 0x3d, 0x00,
+  0x07, 0x40, 0x4e, 0xf0, 0xe8, 0x2d, 0x84, 0xc1, 0x86, 0x4d, 0xbf, 0x6d, 0x6e, 0xae, 0x4b, 0x9f,
+  0xe4, 0x57, 0x28, 0x69, 0xcd, 0xbb, 0x77, 0x72, 0xc7, 0x26, 0xab, 0x7f, 0xde, 0xb3, 0x87, 0xf6,
+  0x6c, 0x56, 0x07, 0x7e, 0xbf, 0xd3, 0x18, 0xd5, 0x3f, 0x17, 0xf6, 0xc4, 0xb6, 0xed, 0xfa, 0x77,
+  0x59, 0x9b, 0xab, 0xf1, 0x8e, 0x5c, 0x43, 0xdc, 0x94, 0xbf, 0x61, 0xf1, 0x9d, 0x95, 0xa5, 0x11,
+  0x88, 0x01, 0x24, 0x8c, 0xc1, 0x95, 0x18, 0xe3, 0x5d, 0x00, 0xc4, 0x1b, 0xa7, 0x1c, 0xa5, 0x2f,
+  0xf1, 0x9e, 0xdb, 0xd7, 0x8a, 0x9d, 0xdd, 0x6c, 0x78, 0x22, 0xe6, 0xae, 0x7f, 0x0e, 0x4c, 0xd1,
+  0x47, 0x2d, 0x72, 0x87, 0x6c, 0xcb, 0xeb, 0x26, 0x73, 0xad, 0xf2, 0x19, 0x02, 0xf2, 0xbc, 0xc0,
+  0x0a, 0xb5, 0x52, 0xb5, 0xe9, 0x7f, 0x86, 0xcb, 0xbe, 0x22, 0x26, 0x1e, 0xe5, 0x56, 0xde, 0x65,
+  0x3c, 0x55, 0x3f, 0xdd, 0x03, 0x5c, 0xc4, 0xe5, 0xc0, 0x5c, 0x12, 0xd2, 0x57, 0x90, 0x82, 0x14,
+  0xde, 0x77, 0x8d, 0xe3, 0x07, 0xd6, 0x70, 0xc9, 0xaa, 0x6d, 0x8b, 0x08, 0x58, 0x06, 0xc0, 0xc4,
+  0xa0, 0x01, 0x1c, 0xbb, 0xb3, 0x8e, 0xe4, 0x79, 0xa5, 0x26, 0x37, 0x1d, 0xde, 0x33, 0x9b, 0x7b,
+  0x19, 0xa7, 0x1a, 0x95, 0xe7, 0x2f, 0x94, 0xa9, 0xa2, 0x1a, 0x9b, 0xdd, 0x68, 0xa5, 0x11, 0xc1,
+  0x2a, 0x9a, 0x0a, 0x55, 0xe8, 0x50, 0xed, 0x34, 0xa6, 0x11, 0x95, 0x00, 0x52, 0x85, 0x14, 0x4b,
+  0xa5, 0x93, 0x53, 0xab, 0x6a, 0x2c, 0xea, 0x65, 0x83, 0x59, 0x1b, 0xb2, 0x93, 0xc5, 0x11, 0xc0,
+  0xa5, 0xbc, 0x9f, 0xfa, 0x0c, 0x50, 0x3e, 0x39, 0xba, 0x1e, 0x7a, 0x68, 0x17, 0xbb, 0xd8, 0xc2,
+  0x96, 0xf0, 0x23, 0xbe, 0x3c, 0x97, 0x07, 0x3e, 0xd8, 0x9f, 0x7e, 0x9f, 0x04, 0x09, 0xf7, 0x20,
+  0xb0, 0xe2, 0x79, 0x0a, 0xb8, 0x46, 0xb2, 0x0b, 0x19, 0x16, 0xe4, 0x7b, 0x48, 0x80, 0x1c, 0x7c,
+  0xfd, 0x15, 0x1e, 0x78, 0x81, 0x68, 0xf2, 0xab, 0x2c, 0x96, 0xfe, 0xde, 0xc3, 0xc3, 0xda, 0xe3,
+  0x39, 0xd8, 0x80, 0xe3, 0x3e, 0x79, 0xca, 0x3c, 0x46, 0xd4, 0xba, 0x7e, 0xc2, 0x1a, 0xf8, 0x4a,
+  0x61, 0x8d, 0xd4, 0xe8, 0x84, 0xf4, 0x21, 0x2d, 0x75, 0x24, 0xe6, 0xf6, 0xfd, 0x15, 0xe6, 0x21,
+  0xfb, 0x40, 0x48, 0xb7, 0x0f, 0x13, 0x82, 0x17, 0xf8, 0x5b, 0xe1, 0xf8, 0x3b, 0xcd, 0x85, 0x1e,
+  0xf9, 0x43, 0xda, 0xec, 0x00, 0x38, 0xd9, 0x09, 0x30, 0x41, 0xc6, 0x73, 0x5d, 0xf2, 0x99, 0x4c,
+  0xde, 0x21, 0x8f, 0x75, 0x45, 0xc4, 0xf8, 0x0c, 0xbb, 0x10, 0x78, 0xa7, 0x77, 0x82, 0xff, 0x31,
+  0x8d, 0x00, 0x3e, 0xfb, 0xc6, 0x6d, 0xd9, 0x29, 0xde, 0x2e, 0x15, 0x59, 0x7c, 0x6a, 0xc7, 0xca,
+  0xf5, 0x1e, 0x9b, 0x8e, 0x38, 0x8b, 0x57, 0xd2, 0x7b, 0x68, 0x1b, 0x3c, 0xd1, 0x32, 0x62, 0xca,
+  0x8f, 0xaf, 0x79, 0x91, 0xf3, 0xe7, 0x59, 0x44, 0x54, 0xf5, 0x3d, 0x7e, 0xe7, 0x94, 0x44, 0xa7,
+  0xf7, 0x6e, 0xa1, 0xc0, 0x6e, 0x33, 0x43, 0x57, 0xbf, 0xdd, 0x41, 0x83, 0xeb, 0xfd, 0x06, 0xe2,
+  0x2f, 0x61, 0x81, 0x6b, 0xc0, 0x43, 0xdc, 0x1c, 0x01, 0xb2, 0x2a, 0x3d, 0xca, 0x93, 0x81, 0x61,
+  0xae, 0x71, 0x6d, 0x15, 0x68, 0xa0, 0x51, 0x64, 0xff, 0x3b, 0xf7, 0xbb, 0x82, 0x6d, 0xe7, 0x89,
+  0x49, 0x31, 0xce, 0x5e, 0x02, 0xd0, 0x18, 0x0b, 0x6f, 0x81, 0x4e, 0x3a, 0x8d, 0x05, 0x76, 0xb3,
+  0xc0, 0xb8, 0x96, 0x19, 0x1d, 0x2d, 0x03, 0xf8, 0xc5, 0xa6, 0xf5, 0x17, 0x9b, 0xd7, 0x17, 0xc2,
+  0xa3, 0xe1, 0x7b, 0x72, 0xa7, 0x5f, 0x47, 0x7b, 0xc8, 0x29, 0x99, 0x95, 0xb6, 0x0d, 0x27, 0x23,
+  0x85, 0x5c, 0xf4, 0x4e, 0xb0, 0x3e, 0xbb, 0xa4, 0x81, 0x99, 0x93, 0x3a, 0xe0, 0x6f, 0x18, 0x30,
+  0x9b, 0x6c, 0x60, 0xab, 0xdf, 0x66, 0x3a, 0xde, 0xd7, 0x17, 0x50, 0x8f, 0xf7, 0xd5, 0x0f, 0x80,
+  0xec, 0xcb, 0xff, 0xc0, 0xcc, 0xff, 0x01, 0xc1, 0xf4, 0xb5, 0x68, 0x79, 0x66, 0x00, 0x00,
+};
+
+#endif